@@ -3,8 +3,23 @@
 using namespace Microsoft::WRL;
 using namespace DirectX;
 
+namespace
+{
+	//워커에서 준비하는 skull 지오메트리.
+	//.d12mesh면 File이 매핑을 들고 있고, 아니면 Vertices/Indices에 파싱 결과가 있다.
+	struct SkullGeometryData
+	{
+		MeshFile File;
+		std::vector<Vertex> Vertices;
+		std::vector<std::uint32_t> Indices;
+	};
+}
+
 AppD3D::~AppD3D()
 {
+	//워커가 this를 참조하는 작업을 끝내도록 먼저 정리.
+	mAssetLoader.reset();
+
 	if (md3dDevice != nullptr)
 		FlushCommandQueue();
 }
@@ -15,9 +30,20 @@ bool AppD3D::Initialize()
 		return false;
 
 	ThrowIfFailed(mDirectCmdListAlloc->Reset());
-	// OnResize() closeǾǷ   Reset.
+	// OnResize()에서 close되었으므로 재사용을 위해 Reset.
 	ThrowIfFailed(mCommandList->Reset(mDirectCmdListAlloc.Get(), nullptr));
 
+	//무거운 에셋은 워커에서 읽고, 로드가 끝나는 대로 Update()에서 업로드한다.
+	mAssetLoader = std::make_unique<AssetLoader>();
+	ThrowIfFailed(md3dDevice->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(mUploadCmdListAlloc.GetAddressOf())));
+	ThrowIfFailed(md3dDevice->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, mUploadCmdListAlloc.Get(), nullptr, IID_PPV_ARGS(mUploadCmdList.GetAddressOf())));
+	mUploadCmdList->Close();
+	mHeapAllocator = std::make_unique<GpuHeapAllocator>(md3dDevice.Get(), mReleaseQueue);
+	mGeometryPool = std::make_unique<GeometryPool>(md3dDevice.Get(), mHeapAllocator.get(), (UINT)sizeof(Vertex));
+	mTextureStreamer = std::make_unique<TextureStreamer>(md3dDevice.Get(), mReleaseQueue, mHeapAllocator.get());
+	mTextureResidency = std::make_unique<TextureResidency>(TextureMemoryBudget);
+
+	RequestSkullGeometry();
 	LoadTextures();
 	BuildDescriptorHeaps();
 	BuildRootsignature();
@@ -28,9 +54,15 @@ bool AppD3D::Initialize()
 	BuildMaterials();
 	BuildRenderItems();
 	BuildFrameResources();
-	//BuildConstantsBufferView();
 	BuildPSO();
 
+	//초기 업로드가 끝나면 지오메트리 스테이징 버퍼를 놓는다. (아래 FlushCommandQueue()가 mCurrentFence + 1을 시그널)
+	for (auto& [name, geo] : mGeometries)
+	{
+		mHeapAllocator->Free(geo->VertexBufferUploader, mCurrentFence + 1);
+		mHeapAllocator->Free(geo->IndexBufferUploader, mCurrentFence + 1);
+	}
+
 	ThrowIfFailed(mCommandList->Close());
 	ID3D12CommandList* cmdsLists[] = { mCommandList.Get() };
 	mCommandQueue->ExecuteCommandLists(_countof(cmdsLists), cmdsLists);
@@ -44,13 +76,16 @@ void AppD3D::OnResize()
 {
 	__super::OnResize();	//InitAppD3D::OnResize();
 
-	//  Ⱦ     ʱȭϹǷ OnResize() ġ.
+	//투영 행렬은 종횡비가 변할 때 한 번 초기화하므로 OnResize()에 위치.
 	XMMATRIX P = XMMatrixPerspectiveFovLH(0.25f * MathHelper::Pi, AspectRatio(), 1.0f, 1000.0f);
 	XMStoreFloat4x4(&mProj, P);
 }
 
 void AppD3D::Update(const GameTimer& gt)
 {
+	//지난 프레임의 임시 메모리를 한 번에 비운다.
+	FrameArena::ThreadLocal().Reset();
+
 	OnKeyboardInput(gt);
 	UpdateCamera(gt);
 
@@ -65,13 +100,27 @@ void AppD3D::Update(const GameTimer& gt)
 		CloseHandle(eventHandle);
 	}
 
+	//GPU가 이 프레임 리소스를 다 썼으므로 지난번 할당을 한 번에 돌려준다.
+	mCurrFrameResource->Upload.Reset();
+	//펜스가 지난 리소스를 놓고, 그 힙 구간을 회수.
+	//펜스 값은 한 번만 읽는다. 사이에 펜스가 나아가면 큐에 남은 리소스 밑의 힙 구간을 먼저 돌려주게 된다.
+	const UINT64 completedFence = mFence->GetCompletedValue();
+	mReleaseQueue.ReleaseCompleted(completedFence);
+	mHeapAllocator->ReleaseCompleted(completedFence);
+	mGeometryPool->ReleaseCompleted(completedFence);
+	mSrvAllocator.ReleaseCompleted(completedFence);
+	mSrvAllocator.BeginFrame(mCurrFrameResourceIndex);
+
+	UpdateTextureResidency();
+	FinalizeAssets();
+
 	AnimateMaterials(gt);
 	UpdateObjectCBs(gt);
 	UpdateMainPassCB(gt);
 	UpdateWaves(gt);
 	UpdateMaterialCBs(gt);
 
-	//̵ . ȸ  ȵ.
+	//이동 로직. 회전과 연동 안됨.
 	float dt = gt.DeltaTime();
 	if (isMoving)
 	{
@@ -111,7 +160,7 @@ void AppD3D::Draw(const GameTimer& gt)
 		ThrowIfFailed(mCommandList->Reset(cmdListAlloc.Get(), mPSOs["opaque"].Get()));
 	}*/
 
-	mCommandList->RSSetViewports(1, &mScreenViewport);	//Rasterizer ܰ
+	mCommandList->RSSetViewports(1, &mScreenViewport);	//Rasterizer 단계
 	mCommandList->RSSetScissorRects(1, &mScissorRect);
 	auto barrier1 = CD3DX12_RESOURCE_BARRIER::Transition(
 		CurrentBackBuffer(),
@@ -134,7 +183,7 @@ void AppD3D::Draw(const GameTimer& gt)
 		nullptr);
 	mCommandList->OMSetRenderTargets(1, &rtvHandle, true, &dsvHandle);
 	
-	// Ⱦ. ũ ̺->Ʈ ũͷ 
+	//지금은 힙안씀. 디스크립터 테이블->루트 디스크립터로 변경
 	ID3D12DescriptorHeap* descriptorHeaps[] = { mSrvHeap.Get() };
 	mCommandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
 	mCommandList->SetGraphicsRootSignature(mRootSignature.Get());
@@ -144,8 +193,12 @@ void AppD3D::Draw(const GameTimer& gt)
 	passCbvHandle.Offset(passCbvIndex, mCbvSrvUavDescriptorSize);*/
 	//mCommandList->SetGraphicsRootDescriptorTable(1, passCbvHandle);
 
-	auto passCB = mCurrFrameResource->PassCB->Resource();
-	mCommandList->SetGraphicsRootConstantBufferView(4, passCB->GetGPUVirtualAddress());
+	mCommandList->SetGraphicsRootConstantBufferView(4, mPassCBAddress);
+	if (gStructuredObjectData)
+	{
+		mCommandList->SetGraphicsRootShaderResourceView(3, mObjectCBAddress);
+		mCommandList->SetGraphicsRootShaderResourceView(5, mMaterialCBAddress);
+	}
 
 	DrawRenderItems(mCommandList.Get(), mRenderItemLayer);
 
@@ -169,43 +222,37 @@ void AppD3D::Draw(const GameTimer& gt)
 
 void AppD3D::BuildDescriptorHeaps()
 {
+	//자리표시자 슬롯 + 스트리밍 텍스처마다 gNumFrameResources개의 슬롯 + 여유분, 그 뒤에 프레임별 임시 영역.
+	mSrvAllocator.Reset((UINT)mTextures.Size() * (1 + gNumFrameResources) + SrvPersistentHeadroom, SrvTransientPerFrame, gNumFrameResources);
+
 	D3D12_DESCRIPTOR_HEAP_DESC srvHeapDesc = {};
-	srvHeapDesc.NumDescriptors = mTextures.size();
+	srvHeapDesc.NumDescriptors = mSrvAllocator.Capacity();
 	srvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
 	srvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
 	ThrowIfFailed(md3dDevice->CreateDescriptorHeap(&srvHeapDesc, IID_PPV_ARGS(mSrvHeap.GetAddressOf())));
 
-	CD3DX12_CPU_DESCRIPTOR_HANDLE hDescriptor(mSrvHeap->GetCPUDescriptorHandleForHeapStart());
+	//아직 로드 중인 텍스처 자리에는 defaultTex를 넣어 둔다.
+	ID3D12Resource* placeholder = FindTexture("defaultTex")->Resource.Get();
 
-	int i = 0;
-	for (auto& tex : mTextures)
-	{
-		auto resource = tex.second->Resource;
-		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-		srvDesc.Format = resource->GetDesc().Format;
-		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-		srvDesc.Texture2D.MostDetailedMip = 0;
-		srvDesc.Texture2D.MipLevels = resource->GetDesc().MipLevels;
-		srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
-
-		md3dDevice->CreateShaderResourceView(resource.Get(), &srvDesc, hDescriptor);
-		hDescriptor.Offset(1, mCbvSrvUavDescriptorSize);
-
-		tex.second->DiffuseSrvHeapIndex = i;
-		i++;
-	}
+	mTextures.ForEach([&](Texture& tex)
+		{
+			const int heapIndex = (int)mSrvAllocator.Allocate();
+			auto resource = tex.Resource ? tex.Resource.Get() : placeholder;
+			CreateTextureSrv(resource, heapIndex);
+
+			tex.DiffuseSrvHeapIndex = heapIndex;
+		});
 
-	//--------- mCbvHeap ̻---------//
+	//---------현재 mCbvHeap 미사용---------//
 
 	UINT objCount = 0;
 	for(auto l : mRenderItemLayer)
 		objCount += l.size();
 
-	// Ӹ objCount + PassCBV
+	//각 프레임마다 objCount + PassCBV
 	UINT numDescriptors = (objCount + 1) * gNumFrameResources;
 
-	//objCBV  passCBV
+	//objCBV 다음 passCBV
 	mPassCbvOffset = objCount * gNumFrameResources;
 
 	D3D12_DESCRIPTOR_HEAP_DESC cbvHeapDesc;
@@ -216,12 +263,145 @@ void AppD3D::BuildDescriptorHeaps()
 	ThrowIfFailed(md3dDevice->CreateDescriptorHeap(&cbvHeapDesc, IID_PPV_ARGS(mCbvHeap.GetAddressOf())));
 }
 
+void AppD3D::CreateTextureSrv(ID3D12Resource* resource, int heapIndex, float minLod)
+{
+	CD3DX12_CPU_DESCRIPTOR_HANDLE hDescriptor(mSrvHeap->GetCPUDescriptorHandleForHeapStart());
+	hDescriptor.Offset(heapIndex, mCbvSrvUavDescriptorSize);
+
+	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srvDesc.Format = resource->GetDesc().Format;
+	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+	srvDesc.Texture2D.MostDetailedMip = 0;
+	srvDesc.Texture2D.MipLevels = resource->GetDesc().MipLevels;
+	srvDesc.Texture2D.ResourceMinLODClamp = minLod;
+
+	md3dDevice->CreateShaderResourceView(resource, &srvDesc, hDescriptor);
+}
+
+void AppD3D::SetTextureSrvHeapIndex(Texture* texture, int heapIndex)
+{
+	const int oldIndex = texture->DiffuseSrvHeapIndex;
+	mMaterials.ForEach([&](Material& mat)
+		{
+			if (mat.DiffuseSrvHeapIndex == oldIndex)
+				mat.DiffuseSrvHeapIndex = heapIndex;
+		});
+
+	//같은 SRV를 쓰는 별칭 텍스처(TextureDedup)도 같이 옮긴다.
+	mTextures.ForEach([&](Texture& tex)
+		{
+			if (tex.DiffuseSrvHeapIndex == oldIndex)
+				tex.DiffuseSrvHeapIndex = heapIndex;
+		});
+	texture->DiffuseSrvHeapIndex = heapIndex;
+}
+
+void AppD3D::UpdateStreamedTextureSrv(Texture* texture)
+{
+	//상주 밉이 바뀔 때마다 링의 다음 슬롯에 SRV를 만든다. (아직 없는 밉은 ResourceMinLODClamp로 막는다)
+	//스트리밍은 프레임당 한 번이므로 같은 슬롯은 gNumFrameResources 프레임 뒤에 다시 쓰이고,
+	//그때는 이전 내용을 쓰던 프레임이 이미 끝나 있다.
+	const auto it = mStreamedSrvs.find(texture);
+	if (it == mStreamedSrvs.end())
+		return;
+
+	SrvRing& ring = it->second;
+	int heapIndex = ring.Base + ring.Next;
+	ring.Next = (ring.Next + 1) % gNumFrameResources;
+
+	CreateTextureSrv(texture->Resource.Get(), heapIndex, static_cast<float>(texture->ResidentMip - texture->BaseMip));
+	SetTextureSrvHeapIndex(texture, heapIndex);
+
+	//자리표시자 슬롯은 지금까지 제출한 프레임(mCurrentFence)이 끝나면 다시 쓸 수 있다.
+	if (ring.Placeholder >= 0)
+	{
+		mSrvAllocator.Free(ring.Placeholder, mCurrentFence);
+		ring.Placeholder = -1;
+	}
+}
+
+float AppD3D::TextureScreenPixels(const RenderItem& ri)const
+{
+	//서브메시 경계 상자. 없으면 단위 상자로 본다.
+	BoundingBox bounds(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(1.0f, 1.0f, 1.0f));
+	for (const auto& [name, submesh] : ri.Geo->DrawArgs)
+	{
+		if (submesh.StartIndexLocation == ri.StartIndexLocation && submesh.BaseVertexLocation == ri.BaseVertexLocation &&
+			submesh.IndexCount == ri.IndexCount && submesh.Bounds.Extents.x + submesh.Bounds.Extents.y + submesh.Bounds.Extents.z > 0.0f)
+		{
+			bounds = submesh.Bounds;
+			break;
+		}
+	}
+
+	//경계 구를 뷰 공간으로. 카메라 뒤에 있으면 0.
+	BoundingSphere sphere;
+	BoundingSphere::CreateFromBoundingBox(sphere, bounds);
+	sphere.Transform(sphere, XMLoadFloat4x4(&ri.World) * XMLoadFloat4x4(&mView));
+	if (sphere.Center.z + sphere.Radius <= 0.0f)
+		return 0.0f;
+
+	//투영된 원의 넓이. 카메라가 구 안에 있으면 화면 전체.
+	const float screenPixels = static_cast<float>(mClientWidth) * static_cast<float>(mClientHeight);
+	float pixels = screenPixels;
+	if (sphere.Center.z > sphere.Radius)
+	{
+		const float radiusPixels = sphere.Radius * mProj._22 * 0.5f * static_cast<float>(mClientHeight) / sphere.Center.z;
+		pixels = (std::min)(screenPixels, MathHelper::Pi * radiusPixels * radiusPixels);
+	}
+
+	//텍스처 좌표를 반복하면 텍스처 한 장이 덮는 넓이는 그만큼 줄어든다.
+	XMFLOAT4X4 texTransform;
+	XMStoreFloat4x4(&texTransform, XMLoadFloat4x4(&ri.TexTransform) * XMLoadFloat4x4(&ri.Mat->MatTransform));
+	const float tileU = std::sqrt(texTransform._11 * texTransform._11 + texTransform._12 * texTransform._12);
+	const float tileV = std::sqrt(texTransform._21 * texTransform._21 + texTransform._22 * texTransform._22);
+	return pixels / (std::max)(1e-3f, tileU * tileV);
+}
+
+void AppD3D::UpdateTextureResidency()
+{
+	mResidencyFrame++;
+
+	//머티리얼은 SRV 인덱스로만 텍스처를 가리킨다.
+	FrameUnorderedMap<int, TextureResidency::Id> bySrv;
+	for (const auto& [texture, id] : mResidencyIds)
+		bySrv[texture->DiffuseSrvHeapIndex] = id;
+
+	const auto maskIt = mResidencyIds.find(mTextureDedup.Owner(FindTexture("swirlingMaskTex")));
+	for (int layer = 0; layer < (int)RenderLayer::Count; layer++)
+	{
+		for (const RenderItem* ri : mRenderItemLayer[layer])
+		{
+			if (ri->Geo == nullptr || ri->Mat == nullptr)
+				continue;
+
+			const float pixels = TextureScreenPixels(*ri);
+			if (pixels <= 0.0f)
+				continue;
+
+			const auto it = bySrv.find(ri->Mat->DiffuseSrvHeapIndex);
+			if (it != bySrv.end())
+				mTextureResidency->Touch(it->second, mResidencyFrame, pixels);
+
+			//Multi 레이어는 마스크 텍스처도 같이 샘플링한다.
+			if (layer == (int)RenderLayer::Multi && maskIt != mResidencyIds.end())
+				mTextureResidency->Touch(maskIt->second, mResidencyFrame, pixels);
+		}
+	}
+
+	FrameVector<TextureResidency::Change> changes;
+	mTextureResidency->Update(mResidencyFrame, changes);
+	for (const TextureResidency::Change& change : changes)
+		mTextureStreamer->SetTargetMip(mResidencyTextures[change.Texture], change.TargetMip);
+}
+
 void AppD3D::BuildRootsignature()
 {
 	//CD3DX12_DESCRIPTOR_RANGE cbvTable0;
-	//cbvTable0.Init(D3D12_DESCRIPTOR_RANGE_TYPE_CBV, 1, 0); //b0 
+	//cbvTable0.Init(D3D12_DESCRIPTOR_RANGE_TYPE_CBV, 1, 0); //b0 매핑
 	//CD3DX12_DESCRIPTOR_RANGE cbvTable1;
-	//cbvTable1.Init(D3D12_DESCRIPTOR_RANGE_TYPE_CBV, 1, 1); //b1 
+	//cbvTable1.Init(D3D12_DESCRIPTOR_RANGE_TYPE_CBV, 1, 1); //b1 매핑
 
 	/*CD3DX12_ROOT_PARAMETER slotRootParameter[2] = {};
 	slotRootParameter[0].InitAsDescriptorTable(1, &cbvTable0);
@@ -232,30 +412,41 @@ void AppD3D::BuildRootsignature()
 	slotRootParameter[1].InitAsDescriptorTable(1, &cbvTable1);*/
 
 	CD3DX12_DESCRIPTOR_RANGE texTable1;
-	texTable1.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0); //t0 
+	texTable1.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0); //t0 매핑
 	CD3DX12_DESCRIPTOR_RANGE texTable2;
-	texTable2.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 1); //t1 
+	texTable2.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 1); //t1 매핑
 
-	CD3DX12_ROOT_PARAMETER slotRootParameter[5] = {};
+	//패스 cbuffer는 두 경로 모두 4번.
+	CD3DX12_ROOT_PARAMETER slotRootParameter[6] = {};
 	slotRootParameter[0].InitAsDescriptorTable(1, &texTable1, D3D12_SHADER_VISIBILITY_PIXEL);
 	slotRootParameter[1].InitAsDescriptorTable(1, &texTable2, D3D12_SHADER_VISIBILITY_PIXEL);
-	slotRootParameter[2].InitAsConstantBufferView(0);
-	slotRootParameter[3].InitAsConstantBufferView(1);
-	slotRootParameter[4].InitAsConstantBufferView(2);
+	if (gStructuredObjectData)
+	{
+		slotRootParameter[2].InitAsConstants(2, 0);				//b0: 객체/재질 인덱스
+		slotRootParameter[3].InitAsShaderResourceView(0, 1);	//t0, space1: 객체 데이터
+		slotRootParameter[4].InitAsConstantBufferView(2);
+		slotRootParameter[5].InitAsShaderResourceView(1, 1);	//t1, space1: 재질 데이터
+	}
+	else
+	{
+		slotRootParameter[2].InitAsConstantBufferView(0);
+		slotRootParameter[3].InitAsConstantBufferView(1);
+		slotRootParameter[4].InitAsConstantBufferView(2);
+	}
 
 	auto staticsSamplers = GetStaticSamplers();
 
-	//׷ .
+	//그래프 구조.
 	CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(
-		5,
+		gStructuredObjectData ? 6 : 5,
 		slotRootParameter,
 		staticsSamplers.size(),
 		staticsSamplers.data(),
 		D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
 
-	//Ʈ ñ״ó  DESC  Serialize(Blob)  Create
-	//ǥ ̳ʸ ȭϸ鼭 Ʈ ñ״ó ü //  ȿ
-	//ȭ Blob ǥȭ ̳ʸ ǥ̶ //(ؽ) ϴ.
+	//루트 시그니처는 보통 DESC → Serialize(Blob) → Create
+	//표준 바이너리로 직렬화하면서 루트 시그니처 자체가 문법/제약/버전 관점에서 유효한지
+	//직렬화된 Blob은 표준화된 바이너리 표현이라 저장/전달/비교(해시)에 유리하다.
 	ComPtr<ID3DBlob> serializedRootsig = nullptr;
 	ComPtr<ID3DBlob> errorBlob = nullptr;
 	HRESULT hr = D3D12SerializeRootSignature(
@@ -277,16 +468,23 @@ void AppD3D::BuildRootsignature()
 
 void AppD3D::BuildShadersAndInputLayout()
 {
-	//ũ ׽Ʈ. HLSL #ifdef ALPHA_TEST б .
+	//매크로 테스트. HLSL에서 #ifdef ALPHA_TEST으로 분기 가능.
 	const D3D_SHADER_MACRO alphaTestDefines[] =
 	{
 		"ALPHA_TEST", "1",
 		NULL, NULL
 	};
 
-	mShaders["standardVS"] = d3dUtil::CompileShader(L"Shaders\\Default.hlsl", nullptr, "VS", "vs_5_1");
-	mShaders["opaquePS"] = d3dUtil::CompileShader(L"Shaders\\Default.hlsl", nullptr, "PS", "ps_5_1");
-	mShaders["multiPS"] = d3dUtil::CompileShader(L"Shaders\\Default.hlsl", nullptr, "PS_multiTexture", "ps_5_1");
+	const D3D_SHADER_MACRO structuredDefines[] =
+	{
+		"STRUCTURED_OBJECT_DATA", "1",
+		NULL, NULL
+	};
+	const D3D_SHADER_MACRO* defaultDefines = gStructuredObjectData ? structuredDefines : nullptr;
+
+	mShaders["standardVS"] = d3dUtil::CompileShader(L"Shaders\\Default.hlsl", defaultDefines, "VS", "vs_5_1");
+	mShaders["opaquePS"] = d3dUtil::CompileShader(L"Shaders\\Default.hlsl", defaultDefines, "PS", "ps_5_1");
+	mShaders["multiPS"] = d3dUtil::CompileShader(L"Shaders\\Default.hlsl", defaultDefines, "PS_multiTexture", "ps_5_1");
 
 	mInputLayout =
 	{
@@ -298,7 +496,8 @@ void AppD3D::BuildShadersAndInputLayout()
 
 void AppD3D::BuildShapeGeometry()
 {
-	GeometryGenerator::MeshData skull = LoadModelFile(L"Resource/skull.txt");
+	//합친 정점/인덱스는 풀에 복사하고 나면 필요 없으므로 스크래치로.
+	FrameArenaScope scratch;
 
 	GeometryGenerator geoGen;
 	GeometryGenerator::MeshData box = geoGen.CreateBox(1.5, 0.5, 1.5, 3);
@@ -312,14 +511,12 @@ void AppD3D::BuildShapeGeometry()
 	UINT sphereVertexOffset = gridVertexOffset + (UINT)grid.Vertices.size();
 	UINT geoSphereVertexOffset = sphereVertexOffset + (UINT)sphere.Vertices.size();
 	UINT cylinderVertexOffset = geoSphereVertexOffset + (UINT)geoSphere.Vertices.size();
-	UINT skullVertexOffset = cylinderVertexOffset + (UINT)cylinder.Vertices.size();
 
 	UINT boxIndexOffset = 0;
 	UINT gridIndexOffset = (UINT)box.Indices32.size();
 	UINT sphereIndexOffset = gridIndexOffset + (UINT)grid.Indices32.size();
 	UINT geoSphereIndexOffset = sphereIndexOffset + (UINT)sphere.Indices32.size();
 	UINT cylinderIndexOffset = geoSphereIndexOffset + (UINT)geoSphere.Indices32.size();
-	UINT skullIndexOffset = cylinderIndexOffset + (UINT)cylinder.Indices32.size();
 
 	SubmeshGeometry boxSubmesh;
 	boxSubmesh.IndexCount = (UINT)box.Indices32.size();
@@ -346,21 +543,24 @@ void AppD3D::BuildShapeGeometry()
 	cylinderSubmesh.StartIndexLocation = cylinderIndexOffset;
 	cylinderSubmesh.BaseVertexLocation = cylinderVertexOffset;
 
-	SubmeshGeometry skullSubmesh;
-	skullSubmesh.IndexCount = (UINT)skull.Indices32.size();
-	skullSubmesh.StartIndexLocation = skullIndexOffset;
-	skullSubmesh.BaseVertexLocation = skullVertexOffset;
+	//텍스처 상주 관리에서 화면 크기를 어림할 때 쓴다.
+	const std::pair<SubmeshGeometry*, const GeometryGenerator::MeshData*> boundsSources[] =
+	{
+		{ &boxSubmesh, &box }, { &gridSubmesh, &grid }, { &sphereSubmesh, &sphere },
+		{ &geoSphereSubmesh, &geoSphere }, { &cylinderSubmesh, &cylinder },
+	};
+	for (const auto& [submesh, mesh] : boundsSources)
+		BoundingBox::CreateFromPoints(submesh->Bounds, mesh->Vertices.size(), &mesh->Vertices[0].Position, sizeof(GeometryGenerator::Vertex));
 
-	// ޽õ  ۿ .
+	//여러 메시들을 한 버퍼에 관리.
 	auto totalVertexCount =
 		box.Vertices.size() +
 		grid.Vertices.size() +
 		sphere.Vertices.size() +
 		geoSphere.Vertices.size() +
-		cylinder.Vertices.size() +
-		skull.Vertices.size();
+		cylinder.Vertices.size();
 
-	std::vector<Vertex> vertices(totalVertexCount);
+	FrameVector<Vertex> vertices(totalVertexCount);
 
 	UINT k = 0;
 	for (size_t i = 0; i < box.Vertices.size(); i++, k++)
@@ -398,21 +598,14 @@ void AppD3D::BuildShapeGeometry()
 		vertices[k].TexC = cylinder.Vertices[i].TexC;
 		//vertices[k].Color = XMFLOAT4(Colors::SteelBlue);
 	}
-	for (size_t i = 0; i < skull.Vertices.size(); i++, k++)
-	{
-		vertices[k].Pos = skull.Vertices[i].Position;
-		vertices[k].Normal = skull.Vertices[i].Normal;
-		vertices[k].TexC = skull.Vertices[i].TexC;
-		//vertices[k].Color = XMFLOAT4(Colors::GhostWhite);
-	}
 
-	std::vector<std::uint32_t> indices;
+	FrameVector<std::uint32_t> indices;
+	indices.reserve(box.Indices32.size() + grid.Indices32.size() + sphere.Indices32.size() + geoSphere.Indices32.size() + cylinder.Indices32.size());
 	indices.insert(indices.end(), box.Indices32.begin(), box.Indices32.end());
 	indices.insert(indices.end(), grid.Indices32.begin(), grid.Indices32.end());
 	indices.insert(indices.end(), sphere.Indices32.begin(), sphere.Indices32.end());
 	indices.insert(indices.end(), geoSphere.Indices32.begin(), geoSphere.Indices32.end());
 	indices.insert(indices.end(), cylinder.Indices32.begin(), cylinder.Indices32.end());
-	indices.insert(indices.end(), skull.Indices32.begin(), skull.Indices32.end());
 
 	const UINT vbByteSize = (UINT)vertices.size() * sizeof(Vertex);
 	const UINT ibByteSize = (UINT)indices.size() * sizeof(std::uint32_t);
@@ -426,33 +619,136 @@ void AppD3D::BuildShapeGeometry()
 	ThrowIfFailed(D3DCreateBlob(ibByteSize, &geo->IndexBufferCPU));
 	CopyMemory(geo->IndexBufferCPU->GetBufferPointer(), indices.data(), ibByteSize);
 
-	geo->VertexBufferGPU = d3dUtil::CreateDefaultBuffer(md3dDevice.Get(), mCommandList.Get(), vertices.data(), vbByteSize, geo->VertexBufferUploader);
-
-	geo->IndexBufferGPU = d3dUtil::CreateDefaultBuffer(md3dDevice.Get(), mCommandList.Get(), indices.data(), ibByteSize, geo->IndexBufferUploader);
-
-	geo->VertexByteStride = sizeof(Vertex);
-	geo->VertexBufferByteSize = vbByteSize;
-	geo->IndexFormat = DXGI_FORMAT_R32_UINT;
-	geo->IndexBufferByteSize = ibByteSize;
+	//공용 정점/인덱스 버퍼에 올리고 서브메시를 풀 안의 위치로 옮긴다.
+	GeometryPool::Range range;
+	if (!mGeometryPool->Add(mCommandList.Get(), mReleaseQueue, mCurrentFence + 1, vertices.data(), (UINT)vertices.size(), indices.data(), (UINT)indices.size(), range))
+		ThrowIfFailed(E_OUTOFMEMORY);
+	mGeometryPool->Bind(*geo);
 
 	geo->DrawArgs["box"] = boxSubmesh;
 	geo->DrawArgs["grid"] = gridSubmesh;
 	geo->DrawArgs["sphere"] = sphereSubmesh;
 	geo->DrawArgs["geoSphere"] = geoSphereSubmesh;
 	geo->DrawArgs["cylinder"] = cylinderSubmesh;
-	geo->DrawArgs["skull"] = skullSubmesh;
+	for (auto& [name, submesh] : geo->DrawArgs)
+	{
+		submesh.StartIndexLocation += range.StartIndex;
+		submesh.BaseVertexLocation += range.BaseVertex;
+	}
 
 	mGeometries[geo->Name] = std::move(geo);
 }
 
+void AppD3D::RequestSkullGeometry()
+{
+	mAssetLoader->Submit<SkullGeometryData>(
+		[this](SkullGeometryData& data)
+		{
+			//변환된 .d12mesh가 있고 skull.txt에서 만든 그대로면 매핑만 해 둔다. 업로드 때 매핑한 구간을 그대로 넘긴다.
+			//원본 해시는 AssetCache 인덱스에 있으므로 skull.txt가 그대로면 다시 읽지 않는다.
+			std::uint64_t sourceHash = 0;
+			if (MeshFile::SourceHash({ L"Resource/skull.txt" }, sourceHash) &&
+				data.File.Open(L"Resource/skull.d12mesh") && data.File.Header().SourceHash == sourceHash && data.File.FindSubmesh("skull"))
+				return true;
+			if (data.File.IsOpen())
+				OutputDebugStringW(L"skull.d12mesh is out of date, loading skull.txt (rebuild it with MeshConverter)\n");
+			data.File.Close();
+
+			//없거나 오래됐으면 텍스트 원본을 파싱해 엔진 정점으로 변환.
+			GeometryGenerator::MeshData skull = LoadModelFile(L"Resource/skull.txt");
+			data.Vertices.resize(skull.Vertices.size());
+			for (size_t i = 0; i < skull.Vertices.size(); i++)
+			{
+				data.Vertices[i].Pos = skull.Vertices[i].Position;
+				data.Vertices[i].Normal = skull.Vertices[i].Normal;
+				data.Vertices[i].TexC = skull.Vertices[i].TexC;
+			}
+			data.Indices = std::move(skull.Indices32);
+			return true;
+		},
+		[this](SkullGeometryData& data, bool loaded)
+		{
+			if (!loaded)
+			{
+				OutputDebugStringW(L"skull geometry load failed\n");
+				return false;
+			}
+
+			auto geo = std::make_unique<MeshGeometry>();
+			geo->Name = "skullGeo";
+			geo->VertexByteStride = sizeof(Vertex);
+
+			//VertexBufferCPU/IndexBufferCPU는 사용처가 없으므로 비워 둔다.
+			if (data.File.IsOpen())
+			{
+				static_assert(sizeof(MeshFileVertex) == sizeof(Vertex), "Vertex layout mismatch");
+
+				const MeshFileHeader& header = data.File.Header();
+				const UINT vertexCount = (UINT)header.VertexCount;
+				const UINT indexCount = (UINT)header.IndexCount;
+
+				//풀은 32비트 인덱스만 저장한다. 16비트 파일은 Add()에서 넓힌다.
+				GeometryPool::Range range;
+				const bool added = header.IndexStride == 2
+					? mGeometryPool->Add(mUploadCmdList.Get(), mReleaseQueue, mCurrentFence + 1, data.File.Vertices().Data, vertexCount, static_cast<const std::uint16_t*>(data.File.IndexData()), indexCount, range)
+					: mGeometryPool->Add(mUploadCmdList.Get(), mReleaseQueue, mCurrentFence + 1, data.File.Vertices().Data, vertexCount, static_cast<const std::uint32_t*>(data.File.IndexData()), indexCount, range);
+				if (!added)
+					return false;
+
+				for (const MeshFileSubmesh& sm : data.File.Submeshes())
+				{
+					SubmeshGeometry submesh;
+					submesh.IndexCount = sm.IndexCount;
+					submesh.StartIndexLocation = sm.StartIndexLocation + range.StartIndex;
+					submesh.BaseVertexLocation = sm.BaseVertexLocation + range.BaseVertex;
+					submesh.Bounds.Center = XMFLOAT3(sm.BoundsCenter);
+					submesh.Bounds.Extents = XMFLOAT3(sm.BoundsExtents);
+
+					geo->DrawArgs[std::string(data.File.SubmeshName(sm))] = submesh;
+				}
+			}
+			else
+			{
+				GeometryPool::Range range;
+				if (!mGeometryPool->Add(mUploadCmdList.Get(), mReleaseQueue, mCurrentFence + 1, data.Vertices.data(), (UINT)data.Vertices.size(), data.Indices.data(), (UINT)data.Indices.size(), range))
+					return false;
+
+				SubmeshGeometry submesh;
+				submesh.IndexCount = range.IndexCount;
+				submesh.StartIndexLocation = range.StartIndex;
+				submesh.BaseVertexLocation = range.BaseVertex;
+				BoundingBox::CreateFromPoints(submesh.Bounds, data.Vertices.size(), &data.Vertices[0].Pos, sizeof(Vertex));
+				geo->DrawArgs["skull"] = submesh;
+			}
+
+			//스테이징은 Add()가 mCurrentFence + 1에 묶었다. (FinalizeAssets()에서 이 값을 시그널)
+			mGeometryPool->Bind(*geo);
+
+			//로드가 끝났으니 렌더 아이템에 연결. 이 시점부터 그려진다.
+			//로드 중에 렌더 아이템이 지워졌으면 핸들이 무효가 된다.
+			if (RenderItem* skullRI = mRenderItems.Get(mSkullRenderItem))
+			{
+				skullRI->Geo = geo.get();
+				skullRI->IndexCount = geo->DrawArgs["skull"].IndexCount;
+				skullRI->StartIndexLocation = geo->DrawArgs["skull"].StartIndexLocation;
+				skullRI->BaseVertexLocation = geo->DrawArgs["skull"].BaseVertexLocation;
+			}
+
+			mGeometries[geo->Name] = std::move(geo);
+			return true;
+		},
+		AssetPriority::High);
+}
+
 void AppD3D::BuildLandGeometry()
 {
 	GeometryGenerator geoGen;
 	GeometryGenerator::MeshData grid = geoGen.CreateGrid(160, 160, 50, 50);
 
-	//Ϻ  ̸ ϰ ̿   .
+	//일부 정점의 높이를 조절하고 높이에 따른 색상 설정.
 
-	std::vector<Vertex> vertices(grid.Vertices.size());
+	FrameArenaScope scratch;
+	FrameVector<Vertex> vertices(grid.Vertices.size());
 	for (size_t i = 0; i < grid.Vertices.size(); i++)
 	{
 		auto& p = grid.Vertices[i].Position;
@@ -477,8 +773,8 @@ void AppD3D::BuildLandGeometry()
 
 	const UINT vbByteSize = (UINT)vertices.size() * sizeof(Vertex);
 
-	std::vector<std::uint16_t> indices = grid.GetIndices16();
-	const UINT ibByteSize = (UINT)indices.size() * sizeof(std::uint16_t);
+	std::vector<std::uint32_t>& indices = grid.Indices32;
+	const UINT ibByteSize = (UINT)indices.size() * sizeof(std::uint32_t);
 
 	auto geo = std::make_unique<MeshGeometry>();
 	geo->Name = "landGeo";
@@ -489,18 +785,16 @@ void AppD3D::BuildLandGeometry()
 	ThrowIfFailed(D3DCreateBlob(ibByteSize, &geo->IndexBufferCPU));
 	CopyMemory(geo->IndexBufferCPU->GetBufferPointer(), indices.data(), ibByteSize);
 
-	geo->VertexBufferGPU = d3dUtil::CreateDefaultBuffer(md3dDevice.Get(), mCommandList.Get(), vertices.data(), vbByteSize, geo->VertexBufferUploader);
-	geo->IndexBufferGPU = d3dUtil::CreateDefaultBuffer(md3dDevice.Get(), mCommandList.Get(), indices.data(), ibByteSize, geo->IndexBufferUploader);
-
-	geo->VertexByteStride = sizeof(Vertex);
-	geo->VertexBufferByteSize = vbByteSize;
-	geo->IndexFormat = DXGI_FORMAT_R16_UINT;
-	geo->IndexBufferByteSize = ibByteSize;
+	GeometryPool::Range range;
+	if (!mGeometryPool->Add(mCommandList.Get(), mReleaseQueue, mCurrentFence + 1, vertices.data(), (UINT)vertices.size(), indices.data(), (UINT)indices.size(), range))
+		ThrowIfFailed(E_OUTOFMEMORY);
+	mGeometryPool->Bind(*geo);
 
 	SubmeshGeometry sm;
-	sm.IndexCount = (UINT)indices.size();
-	sm.StartIndexLocation = 0;
-	sm.BaseVertexLocation = 0;
+	sm.IndexCount = range.IndexCount;
+	sm.StartIndexLocation = range.StartIndex;
+	sm.BaseVertexLocation = range.BaseVertex;
+	BoundingBox::CreateFromPoints(sm.Bounds, vertices.size(), &vertices[0].Pos, sizeof(Vertex));
 
 	geo->DrawArgs["grid"] = sm;
 
@@ -511,7 +805,8 @@ void AppD3D::BuildWavesGeometryBuffers()
 {
 	mWaves = std::make_unique<Waves>(128, 128, 1.0f, 0.03f, 4.0f, 0.2f);
 
-	std::vector<std::uint16_t> indices(3 * mWaves->TriangleCount());
+	FrameArenaScope scratch;
+	FrameVector<std::uint16_t> indices(3 * mWaves->TriangleCount());
 	assert(mWaves->VertexCount() < 0x0000ffff);
 
 	int m = mWaves->RowCount();
@@ -538,14 +833,14 @@ void AppD3D::BuildWavesGeometryBuffers()
 
 	auto geo = std::make_unique<MeshGeometry>();
 	geo->Name = "waterGeo";
-	//̳ ̹Ƿ  .
-	geo->VertexBufferCPU = nullptr;	// x. FrameResource->UpdateBuffer .
-	geo->VertexBufferGPU = nullptr; //UpdateWaves() .
+	//다이나믹 버퍼이므로 동적으로 설정.
+	geo->VertexBufferCPU = nullptr;	//따로 설정x. FrameResource->UpdateBuffer에 존재.
+	geo->VertexBufferGPU = nullptr; //UpdateWaves()에서 설정.
 
 	ThrowIfFailed(D3DCreateBlob(ibByteSize, &geo->IndexBufferCPU));
 	CopyMemory(geo->IndexBufferCPU->GetBufferPointer(), indices.data(), ibByteSize);
 
-	geo->IndexBufferGPU = d3dUtil::CreateDefaultBuffer(md3dDevice.Get(), mCommandList.Get(), indices.data(), ibByteSize, geo->IndexBufferUploader);
+	geo->IndexBufferGPU = d3dUtil::CreateDefaultBuffer(md3dDevice.Get(), mCommandList.Get(), indices.data(), ibByteSize, geo->IndexBufferUploader, mHeapAllocator.get());
 	geo->VertexByteStride = sizeof(Vertex);
 	geo->VertexBufferByteSize = vbByteSize;
 	geo->IndexFormat = DXGI_FORMAT_R16_UINT;
@@ -555,6 +850,8 @@ void AppD3D::BuildWavesGeometryBuffers()
 	sm.IndexCount = (UINT)indices.size();
 	sm.StartIndexLocation = 0;
 	sm.BaseVertexLocation = 0;
+	//정점은 매 프레임 바뀌므로 물결 높이 여유만 둔다.
+	sm.Bounds = BoundingBox(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(0.5f * mWaves->Width(), 1.0f, 0.5f * mWaves->Depth()));
 
 	geo->DrawArgs["grid"] = sm;
 
@@ -578,9 +875,9 @@ void AppD3D::BuildPSO()
 		mShaders["opaquePS"]->GetBufferSize()
 	};
 	opaquePsoDesc.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
-	opaquePsoDesc.BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT); // ռ
+	opaquePsoDesc.BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT); //색 합성
 	opaquePsoDesc.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
-	opaquePsoDesc.SampleMask = UINT_MAX; //  .
+	opaquePsoDesc.SampleMask = UINT_MAX; //모든 샘플 사용.
 	opaquePsoDesc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
 	opaquePsoDesc.NumRenderTargets = 1;
 	opaquePsoDesc.RTVFormats[0] = mBackBufferFormat;
@@ -604,37 +901,35 @@ void AppD3D::BuildPSO()
 
 void AppD3D::BuildRenderItems()
 {
-	auto boxRI = std::make_unique<RenderItem>();
+	RenderItem* boxRI = mRenderItems.Get(mRenderItems.Create());
 	XMStoreFloat4x4(&boxRI->World, XMMatrixScaling(2.f, 2.f, 2.f) * XMMatrixTranslation(0.f, 0.5f, 0.f));
 	//XMStoreFloat4x4(&boxRI->TexTransform, XMMatrixScaling(5.f, 5.f, 1.0f) * XMMatrixTranslation(-1, -1, 0.f));
 	boxRI->ObjCBIndex = 0;
 	boxRI->Geo = mGeometries["shapeGeo"].get();
-	boxRI->Mat = mMaterials["woodCrate"].get();
+	boxRI->Mat = FindMaterial("woodCrate");
 	boxRI->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 	boxRI->IndexCount = boxRI->Geo->DrawArgs["box"].IndexCount;
 	boxRI->StartIndexLocation = boxRI->Geo->DrawArgs["box"].StartIndexLocation;
 	boxRI->BaseVertexLocation = boxRI->Geo->DrawArgs["box"].BaseVertexLocation;
-	mAllRenderItems.push_back(std::move(boxRI));
 
-	auto gridRI = std::make_unique<RenderItem>();
+	RenderItem* gridRI = mRenderItems.Get(mRenderItems.Create());
 	gridRI->World = MathHelper::Identity4x4();
 	XMStoreFloat4x4(&gridRI->TexTransform, XMMatrixScaling(8.0f, 8.0f, 1.0f));
 	gridRI->ObjCBIndex = 1;
 	gridRI->Geo = mGeometries["shapeGeo"].get();
-	gridRI->Mat = mMaterials["tile0"].get();
+	gridRI->Mat = FindMaterial("tile0");
 	gridRI->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 	gridRI->IndexCount = gridRI->Geo->DrawArgs["grid"].IndexCount;
 	gridRI->StartIndexLocation = gridRI->Geo->DrawArgs["grid"].StartIndexLocation;
 	gridRI->BaseVertexLocation = gridRI->Geo->DrawArgs["grid"].BaseVertexLocation;
-	mAllRenderItems.push_back(std::move(gridRI));
 
 	UINT objCBIndex = 2;
 	for (int i = 0; i < 5; ++i)
 	{
-		auto leftCylRitem = std::make_unique<RenderItem>();
-		auto rightCylRitem = std::make_unique<RenderItem>();
-		auto leftSphereRitem = std::make_unique<RenderItem>();
-		auto rightGeoSphereRitem = std::make_unique<RenderItem>();
+		RenderItem* leftCylRitem = mRenderItems.Get(mRenderItems.Create());
+		RenderItem* rightCylRitem = mRenderItems.Get(mRenderItems.Create());
+		RenderItem* leftSphereRitem = mRenderItems.Get(mRenderItems.Create());
+		RenderItem* rightGeoSphereRitem = mRenderItems.Get(mRenderItems.Create());
 
 		XMMATRIX leftCylWorld = XMMatrixTranslation(-5.0f, 1.5f, -10.0f + i * 5.0f);
 		XMMATRIX rightCylWorld = XMMatrixTranslation(+5.0f, 1.5f, -10.0f + i * 5.0f);
@@ -645,7 +940,7 @@ void AppD3D::BuildRenderItems()
 		XMStoreFloat4x4(&leftCylRitem->World, leftCylWorld);
 		leftCylRitem->ObjCBIndex = objCBIndex++;
 		leftCylRitem->Geo = mGeometries["shapeGeo"].get();
-		leftCylRitem->Mat = mMaterials["bricks0"].get();
+		leftCylRitem->Mat = FindMaterial("bricks0");
 		leftCylRitem->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 		leftCylRitem->IndexCount = leftCylRitem->Geo->DrawArgs["cylinder"].IndexCount;
 		leftCylRitem->StartIndexLocation = leftCylRitem->Geo->DrawArgs["cylinder"].StartIndexLocation;
@@ -654,7 +949,7 @@ void AppD3D::BuildRenderItems()
 		XMStoreFloat4x4(&rightCylRitem->World, rightCylWorld);
 		rightCylRitem->ObjCBIndex = objCBIndex++;
 		rightCylRitem->Geo = mGeometries["shapeGeo"].get();
-		rightCylRitem->Mat = mMaterials["bricks0"].get();
+		rightCylRitem->Mat = FindMaterial("bricks0");
 		rightCylRitem->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 		rightCylRitem->IndexCount = rightCylRitem->Geo->DrawArgs["cylinder"].IndexCount;
 		rightCylRitem->StartIndexLocation = rightCylRitem->Geo->DrawArgs["cylinder"].StartIndexLocation;
@@ -663,7 +958,7 @@ void AppD3D::BuildRenderItems()
 		XMStoreFloat4x4(&leftSphereRitem->World, leftSphereWorld);
 		leftSphereRitem->ObjCBIndex = objCBIndex++;
 		leftSphereRitem->Geo = mGeometries["shapeGeo"].get();
-		leftSphereRitem->Mat = mMaterials["stone0"].get();
+		leftSphereRitem->Mat = FindMaterial("stone0");
 		leftSphereRitem->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 		leftSphereRitem->IndexCount = leftSphereRitem->Geo->DrawArgs["sphere"].IndexCount;
 		leftSphereRitem->StartIndexLocation = leftSphereRitem->Geo->DrawArgs["sphere"].StartIndexLocation;
@@ -672,220 +967,174 @@ void AppD3D::BuildRenderItems()
 		XMStoreFloat4x4(&rightGeoSphereRitem->World, rightSphereWorld);
 		rightGeoSphereRitem->ObjCBIndex = objCBIndex++;
 		rightGeoSphereRitem->Geo = mGeometries["shapeGeo"].get();
-		rightGeoSphereRitem->Mat = mMaterials["stone0"].get();
+		rightGeoSphereRitem->Mat = FindMaterial("stone0");
 		rightGeoSphereRitem->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 		rightGeoSphereRitem->IndexCount = rightGeoSphereRitem->Geo->DrawArgs["geoSphere"].IndexCount;
 		rightGeoSphereRitem->StartIndexLocation = rightGeoSphereRitem->Geo->DrawArgs["geoSphere"].StartIndexLocation;
 		rightGeoSphereRitem->BaseVertexLocation = rightGeoSphereRitem->Geo->DrawArgs["geoSphere"].BaseVertexLocation;
 
-		mAllRenderItems.push_back(std::move(leftCylRitem));
-		mAllRenderItems.push_back(std::move(rightCylRitem));
-		mAllRenderItems.push_back(std::move(leftSphereRitem));
-		mAllRenderItems.push_back(std::move(rightGeoSphereRitem));
 	}
 
-	//skull
-	auto skullRI = std::make_unique<RenderItem>();
+	//skull용. Geo와 드로우 인자는 비동기 로드가 끝나면 채워진다. (RequestSkullGeometry)
+	mSkullRenderItem = mRenderItems.Create();
+	RenderItem* skullRI = mRenderItems.Get(mSkullRenderItem);
 	XMStoreFloat4x4(&skullRI->World, XMMatrixScaling(0.2f, 0.2f, 0.2f) * XMMatrixTranslation(0.f, 1.f, 0.f));
 	skullRI->ObjCBIndex = objCBIndex++;
-	skullRI->Geo = mGeometries["shapeGeo"].get();
-	skullRI->Mat = mMaterials["skullMat"].get();
+	skullRI->Mat = FindMaterial("skullMat");
 	skullRI->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
-	skullRI->IndexCount = skullRI->Geo->DrawArgs["skull"].IndexCount;
-	skullRI->StartIndexLocation = skullRI->Geo->DrawArgs["skull"].StartIndexLocation;
-	skullRI->BaseVertexLocation = skullRI->Geo->DrawArgs["skull"].BaseVertexLocation;
-	mAllRenderItems.push_back(std::move(skullRI));
 
-	//land
-	auto landRI = std::make_unique<RenderItem>();
+	//land용
+	RenderItem* landRI = mRenderItems.Get(mRenderItems.Create());
 	XMStoreFloat4x4(&landRI->World, XMMatrixScaling(1, 1, 1) * XMMatrixTranslation(0, -5, 0));
 	XMStoreFloat4x4(&landRI->TexTransform, XMMatrixScaling(5.0f, 5.0f, 1.0f));
 	landRI->ObjCBIndex = objCBIndex++;
 	landRI->Geo = mGeometries["landGeo"].get();
-	landRI->Mat = mMaterials["grass0"].get();
+	landRI->Mat = FindMaterial("grass0");
 	landRI->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 	landRI->IndexCount = landRI->Geo->DrawArgs["grid"].IndexCount;
 	landRI->StartIndexLocation = landRI->Geo->DrawArgs["grid"].StartIndexLocation;
 	landRI->BaseVertexLocation = landRI->Geo->DrawArgs["grid"].BaseVertexLocation;
-	mAllRenderItems.push_back(std::move(landRI));
 
-	//waves
-	auto waveRI = std::make_unique<RenderItem>();
+	//waves용
+	mWavesRenderItem = mRenderItems.Create();
+	RenderItem* waveRI = mRenderItems.Get(mWavesRenderItem);
 	XMStoreFloat4x4(&waveRI->World, XMMatrixScaling(1, 1, 1) * XMMatrixTranslation(0, -1, 0));
 	XMStoreFloat4x4(&waveRI->TexTransform, XMMatrixScaling(5.0f, 5.0f, 1.0f));
 	waveRI->ObjCBIndex = objCBIndex++;
 	waveRI->Geo = mGeometries["waterGeo"].get();
-	waveRI->Mat = mMaterials["water0"].get();
+	waveRI->Mat = FindMaterial("water0");
 	waveRI->PrimitiveType = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 	waveRI->IndexCount = waveRI->Geo->DrawArgs["grid"].IndexCount;
 	waveRI->StartIndexLocation = waveRI->Geo->DrawArgs["grid"].StartIndexLocation;
 	waveRI->BaseVertexLocation = waveRI->Geo->DrawArgs["grid"].BaseVertexLocation;
-	mWavesRenderItem = waveRI.get();
-	mAllRenderItems.push_back(std::move(waveRI));
 
-	for (auto& e : mAllRenderItems)
-		mRenderItemLayer[(int)RenderLayer::Opaque].push_back(e.get());
+	mRenderItems.ForEach([this](const RenderItem& ri) { mRenderItemLayer[(int)RenderLayer::Opaque].push_back(&ri); });
 
-	auto boxRI2 = std::make_unique<RenderItem>();
+	RenderItem* boxRI2 = mRenderItems.Get(mRenderItems.Create());
 	XMStoreFloat4x4(&boxRI2->World, XMMatrixScaling(2.f, 6.f, 2.f) * XMMatrixTranslation(0.f, 2.f, 5.f));
 	////XMStoreFloat4x4(&boxRI->TexTransform, XMMatrixScaling(5.f, 5.f, 1.0f) * XMMatrixTranslation(-1, -1, 0.f));
 	boxRI2->ObjCBIndex = objCBIndex++;
 	boxRI2->Geo = mGeometries["shapeGeo"].get();
-	boxRI2->Mat = mMaterials["swirling"].get();
+	boxRI2->Mat = FindMaterial("swirling");
 	boxRI2->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 	boxRI2->IndexCount = boxRI2->Geo->DrawArgs["box"].IndexCount;
 	boxRI2->StartIndexLocation = boxRI2->Geo->DrawArgs["box"].StartIndexLocation;
 	boxRI2->BaseVertexLocation = boxRI2->Geo->DrawArgs["box"].BaseVertexLocation;
-	mRenderItemLayer[(int)RenderLayer::Multi].push_back(boxRI2.get());
-	mAllRenderItems.push_back(std::move(boxRI2));
+	mRenderItemLayer[(int)RenderLayer::Multi].push_back(boxRI2);
 }
 
 void AppD3D::BuildFrameResources()
 {
 	for (int i = 0; i < gNumFrameResources; i++)
 	{
-		mFrameResources.push_back(
-			std::make_unique<FrameResource>(
-				md3dDevice.Get(),
-				1,
-				(UINT)mAllRenderItems.size(),
-				(UINT)mWaves->VertexCount(),
-				(UINT)mMaterials.size()));
+		mFrameResources.push_back(std::make_unique<FrameResource>(md3dDevice.Get(), (UINT)mRenderItems.Size(), (UINT)mMaterials.Size(), gStructuredObjectData));
 	}
-}
-
-void AppD3D::BuildConstantsBufferView()
-{
-	UINT objCBByteSize = d3dUtil::CalcConstantBufferByteSize(sizeof(ObjectConstants));
-	UINT objCount = 0;
-	for (auto l : mRenderItemLayer)
-		objCount += l.size();
 
-	//// |(Frame i) -> (Obj0)(Obj1)(Obj2)...| for i in [0, gNumFrameResources)  
-	/*for (int frameIndex = 0; frameIndex < gNumFrameResources; frameIndex++)
-	{
-		auto objectCB = mFrameResources[frameIndex]->ObjectCB->Resource();
-		for (UINT i = 0; i < objCount; i++)
-		{
-			D3D12_GPU_VIRTUAL_ADDRESS cbAddress = objectCB->GetGPUVirtualAddress();
-
-			cbAddress += i * objCBByteSize;
-
-			int heapIndex = frameIndex * objCount + i;
-			auto handle = CD3DX12_CPU_DESCRIPTOR_HANDLE(mCbvHeap->GetCPUDescriptorHandleForHeapStart());
-			handle.Offset(heapIndex, mCbvSrvUavDescriptorSize);
-
-			D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc;
-			cbvDesc.BufferLocation = cbAddress;
-			cbvDesc.SizeInBytes = objCBByteSize;
-
-			md3dDevice->CreateConstantBufferView(&cbvDesc, handle);
-		}
-	}*/
-
-	UINT passCBByteSize = d3dUtil::CalcConstantBufferByteSize(sizeof(PassConstants));
-
-	// objCB Ŀ (Frame0-passCB0),(Frame1-passCB1),(Frame2-passCB2)...
-	for (int frameIndex = 0; frameIndex < gNumFrameResources; frameIndex++)
-	{
-		auto passCB = mFrameResources[frameIndex]->PassCB->Resource();
-		D3D12_GPU_VIRTUAL_ADDRESS cbAddress = passCB->GetGPUVirtualAddress();
-
-		int heapIndex = mPassCbvOffset + frameIndex;
-		auto handle = CD3DX12_CPU_DESCRIPTOR_HANDLE(mCbvHeap->GetCPUDescriptorHandleForHeapStart());
-		handle.Offset(heapIndex, mCbvSrvUavDescriptorSize);
-
-		D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc;
-		cbvDesc.BufferLocation = cbAddress;
-		cbvDesc.SizeInBytes = passCBByteSize;
+	//처음에는 모든 원소가 변경 상태. 이후로는 Set*Constants()로 고친 것만 복사된다.
+	mObjectConstants.Reset(mRenderItems.Size(), gNumFrameResources);
+	mRenderItems.ForEach([this](const RenderItem& ri) { SetObjectConstants(ri); });
 
-		md3dDevice->CreateConstantBufferView(&cbvDesc, handle);
-	}
+	mMaterialConstants.Reset(mMaterials.Size(), gNumFrameResources);
+	mMaterials.ForEach([this](const Material& mat) { SetMaterialConstants(mat); });
 }
 
 void AppD3D::BuildMaterials()
 {
-	auto skullMat = std::make_unique<Material>();
-	skullMat->Name = "skullMat";
+	Material* skullMat = CreateMaterial("skullMat");
 	skullMat->MatCBIndex = 0;
-	skullMat->DiffuseSrvHeapIndex = mTextures["defaultTex"]->DiffuseSrvHeapIndex; //ؽó .
+	skullMat->DiffuseSrvHeapIndex = FindTexture("defaultTex")->DiffuseSrvHeapIndex; //텍스처 없음.
 	skullMat->DiffuseAlbedo = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 	skullMat->FresnelR0 = XMFLOAT3(0.05f, 0.05f, 0.05);
 	skullMat->Roughness = 0.3f;
 
-	auto tileMat = std::make_unique<Material>();
-	tileMat->Name = "tile0";
+	Material* tileMat = CreateMaterial("tile0");
 	tileMat->MatCBIndex = 1;
-	tileMat->DiffuseSrvHeapIndex = mTextures["tileTex"]->DiffuseSrvHeapIndex;
+	tileMat->DiffuseSrvHeapIndex = FindTexture("tileTex")->DiffuseSrvHeapIndex;
 	tileMat->DiffuseAlbedo = XMFLOAT4(Colors::LightGray);
 	tileMat->FresnelR0 = XMFLOAT3(0.02f, 0.02f, 0.02f);
 	tileMat->Roughness = 0.2f;
 
-	auto brickMat = std::make_unique<Material>();
-	brickMat->Name = "bricks0";
+	Material* brickMat = CreateMaterial("bricks0");
 	brickMat->MatCBIndex = 2;
-	brickMat->DiffuseSrvHeapIndex = mTextures["brickTex"]->DiffuseSrvHeapIndex;
+	brickMat->DiffuseSrvHeapIndex = FindTexture("brickTex")->DiffuseSrvHeapIndex;
 	brickMat->DiffuseAlbedo = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 	brickMat->FresnelR0 = XMFLOAT3(0.02f, 0.02f, 0.02f);
 	brickMat->Roughness = 0.1f;
 
-	auto stoneMat = std::make_unique<Material>();
-	stoneMat->Name = "stone0";
+	Material* stoneMat = CreateMaterial("stone0");
 	stoneMat->MatCBIndex = 3;
-	stoneMat->DiffuseSrvHeapIndex = mTextures["stoneTex"]->DiffuseSrvHeapIndex;
+	stoneMat->DiffuseSrvHeapIndex = FindTexture("stoneTex")->DiffuseSrvHeapIndex;
 	stoneMat->DiffuseAlbedo = XMFLOAT4(Colors::LightSteelBlue);
 	stoneMat->FresnelR0 = XMFLOAT3(0.05f, 0.05f, 0.05f);
 	stoneMat->Roughness = 0.3f;
 
-	auto grassMat = std::make_unique<Material>();
-	grassMat->Name = "grass0";
+	Material* grassMat = CreateMaterial("grass0");
 	grassMat->MatCBIndex = 4;
-	grassMat->DiffuseSrvHeapIndex = mTextures["grassTex"]->DiffuseSrvHeapIndex;
+	grassMat->DiffuseSrvHeapIndex = FindTexture("grassTex")->DiffuseSrvHeapIndex;
 	grassMat->DiffuseAlbedo = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 	grassMat->FresnelR0 = XMFLOAT3(0.01f, 0.01f, 0.01f);
 	grassMat->Roughness = 0.125f;
 
-	auto waterMat = std::make_unique<Material>();
-	waterMat->Name = "water0";
+	Material* waterMat = CreateMaterial("water0");
 	waterMat->MatCBIndex = 5;
-	waterMat->DiffuseSrvHeapIndex = mTextures["waterTex"]->DiffuseSrvHeapIndex;
+	waterMat->DiffuseSrvHeapIndex = FindTexture("waterTex")->DiffuseSrvHeapIndex;
 	waterMat->DiffuseAlbedo = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 	waterMat->FresnelR0 = XMFLOAT3(0.2f, 0.2f, 0.2f);
 	waterMat->Roughness = 0.0f;
 
-	auto woodCrateMat = std::make_unique<Material>();
-	woodCrateMat->Name = "woodCrate";
+	Material* woodCrateMat = CreateMaterial("woodCrate");
 	woodCrateMat->MatCBIndex = 6;
-	woodCrateMat->DiffuseSrvHeapIndex = mTextures["woodCrateTex"]->DiffuseSrvHeapIndex;
+	woodCrateMat->DiffuseSrvHeapIndex = FindTexture("woodCrateTex")->DiffuseSrvHeapIndex;
 	woodCrateMat->DiffuseAlbedo = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 	woodCrateMat->FresnelR0 = XMFLOAT3(0.2f, 0.2f, 0.2f);
 	woodCrateMat->Roughness = 0.0f;
 
-	auto swirlingMat = std::make_unique<Material>();
-	swirlingMat->Name = "swirling";
+	Material* swirlingMat = CreateMaterial("swirling");
 	swirlingMat->MatCBIndex = 7;
-	swirlingMat->DiffuseSrvHeapIndex = mTextures["swirlingTex"]->DiffuseSrvHeapIndex;
+	swirlingMat->DiffuseSrvHeapIndex = FindTexture("swirlingTex")->DiffuseSrvHeapIndex;
 	swirlingMat->DiffuseAlbedo = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 	swirlingMat->FresnelR0 = XMFLOAT3(0.2f, 0.2f, 0.2f);
 	swirlingMat->Roughness = 0.0f;
 
-	auto swirlingMaskMat = std::make_unique<Material>();
-	swirlingMaskMat->Name = "swirlingMask";
+	Material* swirlingMaskMat = CreateMaterial("swirlingMask");
 	swirlingMaskMat->MatCBIndex = 8;
-	swirlingMaskMat->DiffuseSrvHeapIndex = mTextures["swirlingMaskTex"]->DiffuseSrvHeapIndex;
+	swirlingMaskMat->DiffuseSrvHeapIndex = FindTexture("swirlingMaskTex")->DiffuseSrvHeapIndex;
 	swirlingMaskMat->DiffuseAlbedo = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 	swirlingMaskMat->FresnelR0 = XMFLOAT3(0.2f, 0.2f, 0.2f);
 	swirlingMaskMat->Roughness = 0.0f;
 
-	mMaterials[skullMat->Name] = std::move(skullMat);
-	mMaterials[tileMat->Name] = std::move(tileMat);
-	mMaterials[brickMat->Name] = std::move(brickMat);
-	mMaterials[stoneMat->Name] = std::move(stoneMat);
-	mMaterials[grassMat->Name] = std::move(grassMat);
-	mMaterials[waterMat->Name] = std::move(waterMat);
-	mMaterials[woodCrateMat->Name] = std::move(woodCrateMat);
-	mMaterials[swirlingMat->Name] = std::move(swirlingMat);
-	mMaterials[swirlingMaskMat->Name] = std::move(swirlingMaskMat);
+}
+
+Material* AppD3D::CreateMaterial(const std::string& name)
+{
+	const Handle<Material> handle = mMaterials.Create();
+	mMaterialNames[name] = handle;
+
+	Material* mat = mMaterials.Get(handle);
+	mat->Name = name;
+	return mat;
+}
+
+Texture* AppD3D::CreateTexture(const std::string& name)
+{
+	const Handle<Texture> handle = mTextures.Create();
+	mTextureNames[name] = handle;
+
+	Texture* tex = mTextures.Get(handle);
+	tex->Name = name;
+	return tex;
+}
+
+Material* AppD3D::FindMaterial(const std::string& name)
+{
+	const auto it = mMaterialNames.find(name);
+	return it != mMaterialNames.end() ? mMaterials.Get(it->second) : nullptr;
+}
+
+Texture* AppD3D::FindTexture(const std::string& name)
+{
+	const auto it = mTextureNames.find(name);
+	return it != mTextureNames.end() ? mTextures.Get(it->second) : nullptr;
 }
 
 void AppD3D::DrawRenderItems(ID3D12GraphicsCommandList* cmdList, const std::vector<const RenderItem*>* allRenderItem)
@@ -893,8 +1142,6 @@ void AppD3D::DrawRenderItems(ID3D12GraphicsCommandList* cmdList, const std::vect
 	UINT objCBByteSize = d3dUtil::CalcConstantBufferByteSize(sizeof(ObjectConstants));
 	UINT matCBByteSize = d3dUtil::CalcConstantBufferByteSize(sizeof(MaterialConstants));
 
-	auto objectCB = mCurrFrameResource->ObjectCB->Resource();
-	auto matCB = mCurrFrameResource->MaterialCB->Resource();
 
 	for (size_t layer = 0; layer < (int)RenderLayer::Count; layer++)
 	{
@@ -913,19 +1160,40 @@ void AppD3D::DrawRenderItems(ID3D12GraphicsCommandList* cmdList, const std::vect
 		}
 
 		CD3DX12_GPU_DESCRIPTOR_HANDLE hT1(mSrvHeap->GetGPUDescriptorHandleForHeapStart());
-		hT1.Offset(mTextures["swirlingMaskTex"]->DiffuseSrvHeapIndex, mCbvSrvUavDescriptorSize);
+		hT1.Offset(FindTexture("swirlingMaskTex")->DiffuseSrvHeapIndex, mCbvSrvUavDescriptorSize);
 		cmdList->SetGraphicsRootDescriptorTable(1, hT1);
 
+		//풀에 든 메시는 모두 같은 버퍼를 쓰므로 버퍼가 바뀔 때만 다시 바인딩한다.
+		D3D12_GPU_VIRTUAL_ADDRESS boundVB = 0;
+		D3D12_GPU_VIRTUAL_ADDRESS boundIB = 0;
+		D3D_PRIMITIVE_TOPOLOGY boundTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+
 		for (size_t i = 0; i < rItems.size(); i++)
 		{
 			auto ri = rItems[i];
 
+			//지오메트리가 아직 로드 중.
+			if (ri->Geo == nullptr)
+				continue;
+
 			auto vbv = ri->Geo->VertexBufferView();
 			auto ibv = ri->Geo->IndexBufferView();
 
-			cmdList->IASetVertexBuffers(0, 1, &vbv);
-			cmdList->IASetIndexBuffer(&ibv);
-			cmdList->IASetPrimitiveTopology(ri->PrimitiveType);
+			if (vbv.BufferLocation != boundVB)
+			{
+				cmdList->IASetVertexBuffers(0, 1, &vbv);
+				boundVB = vbv.BufferLocation;
+			}
+			if (ibv.BufferLocation != boundIB)
+			{
+				cmdList->IASetIndexBuffer(&ibv);
+				boundIB = ibv.BufferLocation;
+			}
+			if (ri->PrimitiveType != boundTopology)
+			{
+				cmdList->IASetPrimitiveTopology(ri->PrimitiveType);
+				boundTopology = ri->PrimitiveType;
+			}
 
 			/*UINT cbvIndex = mCurrFrameResourceIndex * (UINT)mRenderItemLayer[(int)RenderLayer::Opaque].size() + ri->ObjCBIndex;
 			auto cbvHandle = CD3DX12_GPU_DESCRIPTOR_HANDLE(mCbvHeap->GetGPUDescriptorHandleForHeapStart());
@@ -947,14 +1215,24 @@ void AppD3D::DrawRenderItems(ID3D12GraphicsCommandList* cmdList, const std::vect
 			CD3DX12_GPU_DESCRIPTOR_HANDLE tex(mSrvHeap->GetGPUDescriptorHandleForHeapStart());
 			tex.Offset(ri->Mat->DiffuseSrvHeapIndex, mCbvSrvUavDescriptorSize);
 
-			D3D12_GPU_VIRTUAL_ADDRESS objCBAddress = objectCB->GetGPUVirtualAddress();
-			objCBAddress += ri->ObjCBIndex * objCBByteSize;
-			D3D12_GPU_VIRTUAL_ADDRESS matCBAddress = matCB->GetGPUVirtualAddress();
-			matCBAddress += ri->Mat->MatCBIndex * matCBByteSize;
-
 			cmdList->SetGraphicsRootDescriptorTable(0, tex);
-			cmdList->SetGraphicsRootConstantBufferView(2, objCBAddress);
-			cmdList->SetGraphicsRootConstantBufferView(3, matCBAddress);
+
+			if (gStructuredObjectData)
+			{
+				//버퍼는 Draw()에서 한 번 바인딩. 드로우마다 인덱스만.
+				const UINT drawIds[2] = { ri->ObjCBIndex, (UINT)ri->Mat->MatCBIndex };
+				cmdList->SetGraphicsRoot32BitConstants(2, _countof(drawIds), drawIds, 0);
+			}
+			else
+			{
+				D3D12_GPU_VIRTUAL_ADDRESS objCBAddress = mObjectCBAddress;
+				objCBAddress += ri->ObjCBIndex * objCBByteSize;
+				D3D12_GPU_VIRTUAL_ADDRESS matCBAddress = mMaterialCBAddress;
+				matCBAddress += ri->Mat->MatCBIndex * matCBByteSize;
+
+				cmdList->SetGraphicsRootConstantBufferView(2, objCBAddress);
+				cmdList->SetGraphicsRootConstantBufferView(3, matCBAddress);
+			}
 
 			cmdList->DrawIndexedInstanced(ri->IndexCount, 1, ri->StartIndexLocation, ri->BaseVertexLocation, 0);
 		}
@@ -963,122 +1241,316 @@ void AppD3D::DrawRenderItems(ID3D12GraphicsCommandList* cmdList, const std::vect
 
 void AppD3D::LoadTextures()
 {
-	auto defaultTex = std::make_unique<Texture>();
-	defaultTex->Name = "defaultTex";
+	//defaultTex는 다른 텍스처가 로드되기 전까지 자리표시자로 쓰이므로 초기화 명령 리스트에 바로 올린다.
+	//스테이징은 다른 텍스처와 같은 링을 쓰고, Initialize()의 FlushCommandQueue()가 시그널할 펜스 값에 묶는다.
+	Texture* defaultTex = CreateTexture("defaultTex");
 	defaultTex->Filename = L"../Textures/white1x1.dds";
-	ThrowIfFailed(CreateDDSTextureFromFile12(md3dDevice.Get(), mCommandList.Get(), defaultTex->Filename.c_str(), defaultTex->Resource, defaultTex->UploadHeap));
-
-	auto woodCrateTex = std::make_unique<Texture>();
-	woodCrateTex->Name = "woodCrateTex";
-	woodCrateTex->Filename = L"../Textures/MipmapTest.dds";
-	ThrowIfFailed(CreateDDSTextureFromFile12(md3dDevice.Get(), mCommandList.Get(), woodCrateTex->Filename.c_str(), woodCrateTex->Resource, woodCrateTex->UploadHeap));
-
-	auto brickTex = std::make_unique<Texture>();
-	brickTex->Name = "brickTex";
-	brickTex->Filename = L"../Textures/bricks.dds";
-	ThrowIfFailed(CreateDDSTextureFromFile12(md3dDevice.Get(), mCommandList.Get(), brickTex->Filename.c_str(), brickTex->Resource, brickTex->UploadHeap));
-
-	auto stoneTex = std::make_unique<Texture>();
-	stoneTex->Name = "stoneTex";
-	stoneTex->Filename = L"../Textures/stone.dds";
-	ThrowIfFailed(CreateDDSTextureFromFile12(md3dDevice.Get(), mCommandList.Get(), stoneTex->Filename.c_str(), stoneTex->Resource, stoneTex->UploadHeap));
-
-	auto tileTex = std::make_unique<Texture>();
-	tileTex->Name = "tileTex";
-	tileTex->Filename = L"../Textures/tile.dds";
-	ThrowIfFailed(CreateDDSTextureFromFile12(md3dDevice.Get(), mCommandList.Get(), tileTex->Filename.c_str(), tileTex->Resource, tileTex->UploadHeap));
-
-	auto grassTex = std::make_unique<Texture>();
-	grassTex->Name = "grassTex";
-	grassTex->Filename = L"../Textures/grass.dds";
-	ThrowIfFailed(CreateDDSTextureFromFile12(md3dDevice.Get(), mCommandList.Get(), grassTex->Filename.c_str(), grassTex->Resource, grassTex->UploadHeap));
-
-	auto waterTex = std::make_unique<Texture>();
-	waterTex->Name = "waterTex";
-	waterTex->Filename = L"../Textures/water1.dds";
-	ThrowIfFailed(CreateDDSTextureFromFile12(md3dDevice.Get(), mCommandList.Get(), waterTex->Filename.c_str(), waterTex->Resource, waterTex->UploadHeap));
-
-	auto swirlingTex = std::make_unique<Texture>();
-	swirlingTex->Name = "swirlingTex";
-	swirlingTex->Filename = L"../Textures/swirling.dds";
-	ThrowIfFailed(CreateDDSTextureFromFile12(md3dDevice.Get(), mCommandList.Get(), swirlingTex->Filename.c_str(), swirlingTex->Resource, swirlingTex->UploadHeap));
-
-	auto swirlingMaskTex = std::make_unique<Texture>();
-	swirlingMaskTex->Name = "swirlingMaskTex";
-	swirlingMaskTex->Filename = L"../Textures/swirling_Mask.dds";
-	ThrowIfFailed(CreateDDSTextureFromFile12(md3dDevice.Get(), mCommandList.Get(), swirlingMaskTex->Filename.c_str(), swirlingMaskTex->Resource, swirlingMaskTex->UploadHeap));
-
-	mTextures[defaultTex->Name] = std::move(defaultTex);
-	mTextures[woodCrateTex->Name] = std::move(woodCrateTex);
-	mTextures[brickTex->Name] = std::move(brickTex);
-	mTextures[stoneTex->Name] = std::move(stoneTex);
-	mTextures[tileTex->Name] = std::move(tileTex);
-	mTextures[grassTex->Name] = std::move(grassTex);
-	mTextures[waterTex->Name] = std::move(waterTex);
-	mTextures[swirlingTex->Name] = std::move(swirlingTex);
-	mTextures[swirlingMaskTex->Name] = std::move(swirlingMaskTex);
+
+	//묶음 파일(Tools/TexturePacker)이 있으면 한 번만 매핑하고 이름으로 찾는다. 없는 텍스처는 낱개 파일에서.
+	mTexturePack.Open(L"../Textures/textures.d12pak");
+
+	const TexturePackEntry* defaultEntry = mTexturePack.Find(std::filesystem::path(defaultTex->Filename).filename().string());
+	const std::uint8_t* defaultPacked = defaultEntry ? mTexturePack.View(*defaultEntry) : nullptr;
+	std::vector<std::uint8_t> defaultData;
+	MappedFile defaultFile;
+	if (defaultPacked == nullptr && !(defaultEntry && mTexturePack.Read(*defaultEntry, defaultData)))
+		defaultFile.Open(defaultTex->Filename);
+
+	//같은 이미지를 쓰는 텍스처(1x1 흰색 등)는 defaultTex를 같이 쓴다.
+	const std::uint8_t* defaultBytes = defaultPacked ? defaultPacked : defaultFile.IsOpen() ? defaultFile.Data() : defaultData.data();
+	const std::size_t defaultSize = defaultPacked ? static_cast<std::size_t>(defaultEntry->RawSize) : defaultFile.IsOpen() ? defaultFile.Size() : defaultData.size();
+	mTextureDedup.Acquire(defaultTex, AssetCache::Hash(defaultBytes, defaultSize), defaultSize);
+
+	if (defaultPacked)
+		ThrowIfFailed(mTextureStreamer->Add(defaultTex, defaultPacked, defaultSize));
+	else if (defaultFile.IsOpen())
+		ThrowIfFailed(mTextureStreamer->Add(defaultTex, std::move(defaultFile)));
+	else
+		ThrowIfFailed(mTextureStreamer->Add(defaultTex, std::move(defaultData)));
+
+	FrameVector<Texture*> uploaded;
+	mTextureStreamer->Update(mCommandList.Get(), TextureStreamer::DefaultFrameBudget, mCurrentFence + 1, uploaded);
+
+	const std::pair<std::string, std::wstring> textures[] =
+	{
+		{ "woodCrateTex", L"../Textures/MipmapTest.dds" },
+		{ "brickTex", L"../Textures/bricks.dds" },
+		{ "stoneTex", L"../Textures/stone.dds" },
+		{ "tileTex", L"../Textures/tile.dds" },
+		{ "grassTex", L"../Textures/grass.dds" },
+		{ "waterTex", L"../Textures/water1.dds" },
+		{ "swirlingTex", L"../Textures/swirling.dds" },
+		{ "swirlingMaskTex", L"../Textures/swirling_Mask.dds" },
+	};
+
+	//나머지는 워커에서 파일을 매핑하고, Update()에서 밉 스트리밍으로 올리며 새 SRV 슬롯으로 교체.
+	struct TextureSource
+	{
+		MappedFile File;
+		const std::uint8_t* Packed = nullptr;	//묶음 파일 매핑 안의 무압축 이미지
+		std::size_t PackedSize = 0;
+		std::vector<std::uint8_t> Data;			//묶음에서 압축을 푼 이미지, 또는 밉이 없는 파일이면 만든 밉 체인 DDS
+		std::uint64_t ContentHash = 0;			//올릴 DDS 이미지 전체의 해시
+		std::size_t ContentSize = 0;
+	};
+
+	for (const auto& [name, filename] : textures)
+	{
+		Texture* texture = CreateTexture(name);
+		texture->Filename = filename;
+
+		//워커에서는 매핑(+ 필요하면 밉 생성)만 한다. 픽셀 데이터는 스트리머가 작은 밉부터 필요한 구간만 읽어 올린다.
+		mAssetLoader->Submit<TextureSource>(
+			[this, texture](TextureSource& source)
+			{
+				if (const TexturePackEntry* entry = mTexturePack.Find(std::filesystem::path(texture->Filename).filename().string()))
+				{
+					source.Packed = mTexturePack.View(*entry);
+					source.PackedSize = static_cast<std::size_t>(entry->RawSize);
+					if (source.Packed == nullptr && !mTexturePack.Read(*entry, source.Data))
+						return false;
+				}
+				else if (!source.File.Open(texture->Filename) || source.File.Size() == 0)
+				{
+					return false;
+				}
+
+				const std::uint8_t* data = source.Packed ? source.Packed : source.File.IsOpen() ? source.File.Data() : source.Data.data();
+				std::size_t size = source.Packed ? source.PackedSize : source.File.IsOpen() ? source.File.Size() : source.Data.size();
+
+				std::vector<std::uint8_t> generated;
+				if (GenerateMissingMips(data, size, generated))
+				{
+					source.File.Close();
+					source.Packed = nullptr;
+					source.Data = std::move(generated);
+					data = source.Data.data();
+					size = source.Data.size();
+				}
+
+				source.ContentHash = AssetCache::Hash(data, size);
+				source.ContentSize = size;
+				return true;
+			},
+			[this, texture](TextureSource& source, bool loaded)
+			{
+				HRESULT hr = E_FAIL;
+				if (loaded)
+				{
+					//이미 로드된 텍스처와 내용이 같으면 리소스를 만들지 않고 그 SRV를 같이 쓴다. (상주 관리도 원본 하나로)
+					Texture* owner = mTextureDedup.Acquire(texture, source.ContentHash, source.ContentSize);
+					if (owner != texture)
+					{
+						const int placeholderIndex = texture->DiffuseSrvHeapIndex;
+						SetTextureSrvHeapIndex(texture, owner->DiffuseSrvHeapIndex);
+						mSrvAllocator.Free(placeholderIndex, mCurrentFence);
+						return true;
+					}
+
+					if (source.Packed)
+						hr = mTextureStreamer->Add(texture, source.Packed, source.PackedSize);
+					else if (source.File.IsOpen())
+						hr = mTextureStreamer->Add(texture, std::move(source.File));
+					else
+						hr = mTextureStreamer->Add(texture, std::move(source.Data));
+				}
+
+				if (FAILED(hr))
+				{
+					mTextureDedup.Release(texture);
+					OutputDebugStringW((L"texture load failed : " + texture->Filename + L"\n").c_str());
+					return false;
+				}
+
+				//처음에는 밉 꼬리만 올린다. 화면에 보이면 UpdateTextureResidency()가 목표 밉을 낮춘다.
+				const DDS_TEXTURE_INFO* info = mTextureStreamer->FindInfo(texture);
+				std::vector<std::uint64_t> mipBytes(info->mipCount);
+				for (UINT mip = 0; mip < info->mipCount; mip++)
+					mipBytes[mip] = TextureStreamer::MipByteSize(*info, mip);
+
+				const TextureResidency::Id id = mTextureResidency->Register(info->width, info->height, std::move(mipBytes), TextureStreamer::MaxBaseMip(*info));
+				mTextureStreamer->SetTargetMip(texture, mTextureResidency->TargetMip(id));
+				mResidencyIds[texture] = id;
+				if (mResidencyTextures.size() <= id)
+					mResidencyTextures.resize(id + 1);
+				mResidencyTextures[id] = texture;
+
+				//첫 밉이 올라갈 때까지는 자리표시자 SRV를 그대로 쓴다. 링 슬롯이 없으면 계속 자리표시자.
+				const UINT ringBase = mSrvAllocator.Allocate(gNumFrameResources);
+				if (ringBase == DescriptorAllocator::InvalidIndex)
+				{
+					OutputDebugStringW((L"out of SRV slots : " + texture->Filename + L"\n").c_str());
+					return true;
+				}
+
+				SrvRing& ring = mStreamedSrvs[texture];
+				ring.Base = (int)ringBase;
+				ring.Placeholder = texture->DiffuseSrvHeapIndex;
+				return true;
+			});
+	}
+}
+
+void AppD3D::FinalizeAssets()
+{
+	mTextureStreamer->ReleaseCompleted(mFence->GetCompletedValue());
+
+	if (!mAssetLoader->HasCompleted() && !mTextureStreamer->IsStreaming())
+		return;
+
+	//이전 업로드 명령이 GPU에서 끝나야 할당자를 재사용할 수 있다. 기다리지 않고 다음 프레임에 다시 시도.
+	if (mFence->GetCompletedValue() < mUploadFence)
+		return;
+
+	ThrowIfFailed(mUploadCmdListAlloc->Reset());
+	ThrowIfFailed(mUploadCmdList->Reset(mUploadCmdListAlloc.Get(), nullptr));
+
+	mAssetLoader->Pump();
+
+	//로드가 모두 끝나면 서브시스템별 메모리 사용 보고를 한 번 찍는다.
+	if (!mLoadReportPrinted && mAssetLoader->PendingCount() == 0 && !mAssetLoader->HasCompleted())
+	{
+		OutputDebugStringA(mTextureDedup.Report().c_str());
+		OutputDebugStringA(mHeapAllocator->Report().c_str());
+		OutputDebugStringA(mGeometryPool->Report().c_str());
+		OutputDebugStringA(FrameArena::Report().c_str());
+		mLoadReportPrinted = true;
+	}
+
+	//아래에서 시그널할 펜스 값으로 스테이징 버퍼를 묶는다.
+	FrameVector<Texture*> changed;
+	mTextureStreamer->Update(mUploadCmdList.Get(), TextureStreamer::DefaultFrameBudget, mCurrentFence + 1, changed);
+	for (Texture* texture : changed)
+		UpdateStreamedTextureSrv(texture);
+
+	ThrowIfFailed(mUploadCmdList->Close());
+	ID3D12CommandList* cmdLists[] = { mUploadCmdList.Get() };
+	mCommandQueue->ExecuteCommandLists(_countof(cmdLists), cmdLists);
+
+	//같은 큐이므로 이후 프레임의 드로우는 업로드 뒤에 실행된다.
+	mUploadFence = ++mCurrentFence;
+	ThrowIfFailed(mCommandQueue->Signal(mFence.Get(), mUploadFence));
 }
 
 GeometryGenerator::MeshData AppD3D::LoadModelFile(const std::wstring& path)
 {
-	std::ifstream file(path);
-	if (!file)
+	//.obj는 블록 스트리밍 임포터(ObjImporter), 그 외는 skull.txt 형식. (ModelLoader 참고)
+	const bool isObj = std::filesystem::path(path).extension() == L".obj";
+
+	//파싱 결과는 소스 내용 해시로 캐시. 파서가 바뀌면 버전 문자열을 올린다.
+	AssetCache& cache = AssetCache::Default();
+	std::uint64_t key = 0;
+	const bool hasKey = cache.MakeKey(path, isObj ? "ObjImporter/1" : "ModelLoader/1", key);
+
+	GeometryGenerator::MeshData meshData;
+	std::vector<std::uint8_t> cached;
+	if (hasKey && cache.Load(key, cached) && ModelLoader::DeserializeMesh(cached.data(), cached.size(), meshData))
+		return meshData;
+
+	bool loaded = false;
+	if (isObj)
+	{
+		ObjModel model;
+		loaded = ObjImporter::Import(path, model);
+		meshData = std::move(model.Mesh);
+	}
+	else
+	{
+		loaded = ModelLoader::LoadTextModel(path, meshData);
+	}
+
+	if (!loaded)
 	{
 		std::wstring wfn = AnsiToWString(__FILE__);
 		throw DxException(1, path, wfn, __LINE__);
 	}
 
-	std::vector<std::string> lines;
-	std::string line;
-
-	while (std::getline(file, line))
+	if (hasKey)
 	{
-		lines.push_back(line);
+		ModelLoader::SerializeMesh(meshData, cached);
+		cache.Store(key, cached.data(), cached.size());
 	}
-	file.close();
 
-	std::string label;
-	int vertexCount=0;
-	int indexCount=0;
+	return meshData;
+}
 
-	std::istringstream iss(lines[0]);
-	iss >> label >> vertexCount;
-	iss.str(lines[1]); iss.clear();
-	iss >> label >> indexCount;
+bool AppD3D::GenerateMissingMips(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& outDds)
+{
+	DDS_TEXTURE_INFO info = {};
+	if (FAILED(ProbeDDSFromMemory(data, size, info)))
+		return false;
 
-	// ޽ 
-	GeometryGenerator::MeshData meshData;
+	//밉이 한 장뿐인 2D 텍스처만. (배열, 큐브, 볼륨은 그대로 올린다)
+	if (info.mipCount != 1 || info.dimension != D3D12_RESOURCE_DIMENSION_TEXTURE2D || info.arraySize != 1 ||
+		(info.width == 1 && info.height == 1) || !DDSWriter::IsSupported(info.format))
+		return false;
+
+	//RGBA로 디코딩되는 형식만. (BC4/BC5는 채널 수가 달라 제외)
+	BCFormat bcFormat = BCFormat::BC1;
+	const bool compressed = BCDecoder::FromDXGIFormat(info.format, bcFormat);
+	if (compressed && BCDecoder::PixelBytes(bcFormat) != 4)
+		return false;
+
+	//밉 체인은 소스 내용 해시로 캐시. 필터나 인코딩 방식이 바뀌면 버전 문자열을 올린다.
+	//낱개 파일과 묶음 파일 안의 이미지가 같은 키를 쓰도록 경로가 아니라 데이터를 해시한다.
+	AssetCache& cache = AssetCache::Default();
+	const std::uint64_t key = AssetCache::Combine(AssetCache::Hash(data, size), AssetCache::Hash("MipGenerator/1|kaiser|fast", AssetCache::Version));
+	if (cache.Load(key, outDds))
+		return true;
 
-	for (int i = 4; i < 4 + vertexCount; i++)
+	const DDS_SUBRESOURCE_LAYOUT& top = info.subresources[0];
+	const std::uint8_t* src = data + top.offset;
+
+	std::vector<std::uint8_t> rgba;
+	std::size_t rgbaPitch = top.rowPitch;
+	if (compressed)
 	{
-		iss.str(lines[i]); iss.clear();
-		float v1, v2, v3, n1, n2, n3;
-		iss >> v1 >> v2 >> v3 >> n1 >> n2 >> n3;
-
-		GeometryGenerator::Vertex v;
-		v.Position = { v1,v2,v3 };
-		v.Normal = { n1,n2,n3 };
-		meshData.Vertices.push_back(v);
+		rgbaPitch = std::size_t(info.width) * 4;
+		rgba.resize(rgbaPitch * info.height);
+		if (!BCDecoder::Decode(bcFormat, src, top.size, info.width, info.height, rgba.data(), rgbaPitch, top.rowPitch))
+			return false;
+		src = rgba.data();
 	}
-	for (int i = 31083; i < 31083 + indexCount; i++)
-	{
-		iss.str(lines[i]); iss.clear();
-		int i1, i2, i3;
-		iss >> i1 >> i2 >> i3;
 
-		meshData.Indices32.push_back(i1);
-		meshData.Indices32.push_back(i2);
-		meshData.Indices32.push_back(i3);
+	MipOptions options;
+	options.SRGB = info.format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB || info.format == DXGI_FORMAT_BC1_UNORM_SRGB ||
+		info.format == DXGI_FORMAT_BC2_UNORM_SRGB || info.format == DXGI_FORMAT_BC3_UNORM_SRGB || info.format == DXGI_FORMAT_BC7_UNORM_SRGB;
+
+	std::vector<MipLevel> chain;
+	if (!MipGenerator::Generate(src, info.width, info.height, rgbaPitch, options, chain))
+		return false;
+
+	//밉 0은 원본 그대로, 나머지는 원래 형식으로 다시 인코딩. (로드 시간이 중요하므로 Fast)
+	std::vector<std::vector<std::uint8_t>> levels(chain.size());
+	levels[0].assign(data + top.offset, data + top.offset + top.size);
+	for (std::size_t i = 1; i < chain.size(); i++)
+	{
+		const MipLevel& level = chain[i];
+		if (compressed)
+		{
+			levels[i].resize(BCEncoder::EncodedSize(bcFormat, level.Width, level.Height));
+			if (!BCEncoder::Encode(bcFormat, BCQuality::Fast, level.Pixels.data(), level.Width, level.Height, std::size_t(level.Width) * 4,
+				levels[i].data(), levels[i].size()))
+				return false;
+		}
+		else
+		{
+			levels[i] = level.Pixels;
+		}
 	}
 
-	return meshData;
+	if (!DDSWriter::Write(info.format, info.width, info.height, levels, outDds))
+		return false;
+
+	cache.Store(key, outDds.data(), outDds.size());
+	return true;
 }
 
 void AppD3D::OnMouseDown(WPARAM btnState, int x, int y)
 {
 	mLastMousePos = { x,y };
 
-	//콺 Ŀ â   콺 ޽   â .
+	//마우스 커서가 창 밖으로 나가도 마우스 메시지가 계속 이 창으로 들어옴.
 	SetCapture(mhMainWnd);
 }
 
@@ -1097,7 +1569,7 @@ void AppD3D::OnMouseMove(WPARAM btnState, int x, int y)
 		mTheta += dx;
 		mPhi += dy;
 
-		//LookAt    up Ϳ ü Ͱ        ȭ  .
+		//LookAt 행렬 생성 시 up 벡터와 시선 벡터가 평행해져서 직교 기저를 만들 수 없는 수학적 퇴화 현상 방지.
 		mPhi = MathHelper::Clamp(mPhi, 0.1f, MathHelper::Pi - 0.1f);
 	}
 
@@ -1113,18 +1585,20 @@ void AppD3D::OnMouseWheel(short zDelta, int x, int y)
 
 void AppD3D::OnKeyUp(WPARAM key)
 {
-	std::wstring s(1, static_cast<wchar_t>(key));
+	FrameWString s(L"UP : ");
+	s += static_cast<wchar_t>(key);
 	s += L" ";
-	OutputDebugStringW((std::wstring(L"UP : ") + s).c_str());
+	OutputDebugStringW(s.c_str());
 
 	isMoving = false;
 }
 
 void AppD3D::OnKeyDown(WPARAM key)
 {
-	std::wstring s(1, static_cast<wchar_t>(key));
+	FrameWString s(L"DOWN : ");
+	s += static_cast<wchar_t>(key);
 	s += L" ";
-	OutputDebugStringW((std::wstring(L"DOWN : ") + s).c_str());
+	OutputDebugStringW(s.c_str());
 
 	isMoving = true;
 	if (key == 'W') md = 1;
@@ -1142,7 +1616,7 @@ void AppD3D::OnKeyboardInput(const GameTimer& gt)
 
 	bool currKeyDown = (GetAsyncKeyState('1') & 0x8000) != 0;
 
-	// Ű " " 
+	// 키가 "눌린 순간"만 감지
 	if (currKeyDown && !prevKeyDown)
 		mIsWireframe = !mIsWireframe;
 
@@ -1177,29 +1651,30 @@ void AppD3D::UpdateCamera(const GameTimer& gt)
 	XMVECTOR target = XMVectorZero();
 	XMVECTOR up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
 
-	//¼ ǥ  .
+	//좌수 좌표계 행렬 생성.
 	XMMATRIX view = XMMatrixLookAtLH(pos, target, up);
 	XMStoreFloat4x4(&mView, view);
 }
 
 void AppD3D::UpdateObjectCBs(const GameTimer& gt)
 {
-	auto currObjectCB = mCurrFrameResource->ObjectCB.get();
-	for (auto& e : mAllRenderItems)
-	{
-		if (e->NumFramesDirty > 0)
+	//이 프레임 리소스에 아직 반영되지 않은 원소만 복사. (연속 구간은 한 번에)
+	UploadBuffer<ObjectConstants>* currObjectCB = mCurrFrameResource->ObjectCB.get();
+	mObjectConstants.Flush(mCurrFrameResourceIndex, [currObjectCB](std::size_t first, const ObjectConstants* data, std::size_t count)
 		{
-			XMMATRIX world = XMLoadFloat4x4(&e->World);
-			XMMATRIX texTransform = XMLoadFloat4x4(&e->TexTransform);
+			currObjectCB->CopyRange((UINT)first, data, (UINT)count);
+		});
+	mObjectCBAddress = currObjectCB->Resource()->GetGPUVirtualAddress();
+}
 
-			ObjectConstants objConstants;
-			XMStoreFloat4x4(&objConstants.World, XMMatrixTranspose(world));
-			XMStoreFloat4x4(&objConstants.TexTransform, XMMatrixTranspose(texTransform));
+void AppD3D::SetObjectConstants(const RenderItem& ri)
+{
+	XMMATRIX world = XMLoadFloat4x4(&ri.World);
+	XMMATRIX texTransform = XMLoadFloat4x4(&ri.TexTransform);
 
-			currObjectCB->CopyData(e->ObjCBIndex, objConstants);
-			e->NumFramesDirty--;
-		}
-	}
+	ObjectConstants& objConstants = mObjectConstants.Edit(ri.ObjCBIndex);
+	XMStoreFloat4x4(&objConstants.World, XMMatrixTranspose(world));
+	XMStoreFloat4x4(&objConstants.TexTransform, XMMatrixTranspose(texTransform));
 }
 
 void AppD3D::UpdateMainPassCB(const GameTimer& gt)
@@ -1276,13 +1751,14 @@ void AppD3D::UpdateMainPassCB(const GameTimer& gt)
 	//XMStoreFloat3(&mMainPassCB.Lights[1].Direction, lightDir);
 	//XMStoreFloat3(&mMainPassCB.Lights[2].Direction, lightDir);
 	
-	auto currPassCB = mCurrFrameResource->PassCB.get();
-	currPassCB->CopyData(0, mMainPassCB);
+	auto currPassCB = mCurrFrameResource->Upload.AllocateConstants<PassConstants>();
+	FrameUploadAllocator::ConstantsWriter<PassConstants>(currPassCB).Write(0, mMainPassCB);
+	mPassCBAddress = currPassCB.GpuAddress;
 }
 
 void AppD3D::UpdateWaves(const GameTimer& gt)
 {
-	//  .
+	//정점 버퍼 설정.
 	static float t_base = 0.0f;
 	if ((mTimer.TotalTime() - t_base) >= 0.25f)
 	{
@@ -1298,7 +1774,8 @@ void AppD3D::UpdateWaves(const GameTimer& gt)
 
 	mWaves->Update(gt.DeltaTime());
 
-	auto currWavesVB = mCurrFrameResource->WavesVB.get();
+	auto currWavesVB = mCurrFrameResource->Upload.Allocate(UINT64(mWaves->VertexCount()) * sizeof(Vertex), sizeof(Vertex));
+	auto waveVertices = FrameUploadAllocator::Writer<Vertex>(currWavesVB, sizeof(Vertex), mWaves->VertexCount());
 	for (int i = 0; i < mWaves->VertexCount(); i++)
 	{
 		Vertex v;
@@ -1308,39 +1785,40 @@ void AppD3D::UpdateWaves(const GameTimer& gt)
 		v.TexC.x = 0.5f + v.Pos.x / mWaves->Width();
 		v.TexC.y = 0.5f - v.Pos.z / mWaves->Depth();
 
-		currWavesVB->CopyData(i, v);
+		waveVertices.Write(i, v);
 	}
 
-	mWavesRenderItem->Geo->VertexBufferGPU = currWavesVB->Resource();
+	RenderItem* wavesRI = mRenderItems.Get(mWavesRenderItem);
+	wavesRI->Geo->VertexBufferGPU = currWavesVB.Resource;
+	wavesRI->Geo->VertexBufferOffset = currWavesVB.Offset;
 }
 
 void AppD3D::UpdateMaterialCBs(const GameTimer& gt)
 {
-	auto currMaterialCB = mCurrFrameResource->MaterialCB.get();
-	for (auto& e : mMaterials)
-	{
-		Material* mat = e.second.get();
-		if (mat->NumFramesDirty > 0)
+	UploadBuffer<MaterialConstants>* currMaterialCB = mCurrFrameResource->MaterialCB.get();
+	mMaterialConstants.Flush(mCurrFrameResourceIndex, [currMaterialCB](std::size_t first, const MaterialConstants* data, std::size_t count)
 		{
-			XMMATRIX matTransform = XMLoadFloat4x4(&mat->MatTransform);
+			currMaterialCB->CopyRange((UINT)first, data, (UINT)count);
+		});
+	mMaterialCBAddress = currMaterialCB->Resource()->GetGPUVirtualAddress();
+}
 
-			MaterialConstants matConstants;
-			matConstants.DiffuseAlbedo = mat->DiffuseAlbedo;
-			matConstants.FresnelR0 = mat->FresnelR0;
-			matConstants.Roughness = mat->Roughness;
-			XMStoreFloat4x4(&matConstants.MatTransform, XMMatrixTranspose(matTransform));
+void AppD3D::SetMaterialConstants(const Material& mat)
+{
+	XMMATRIX matTransform = XMLoadFloat4x4(&mat.MatTransform);
 
-			currMaterialCB->CopyData(mat->MatCBIndex, matConstants);
-			mat->NumFramesDirty--;
-		}
-	}
+	MaterialConstants& matConstants = mMaterialConstants.Edit(mat.MatCBIndex);
+	matConstants.DiffuseAlbedo = mat.DiffuseAlbedo;
+	matConstants.FresnelR0 = mat.FresnelR0;
+	matConstants.Roughness = mat.Roughness;
+	XMStoreFloat4x4(&matConstants.MatTransform, XMMatrixTranspose(matTransform));
 }
 
 void AppD3D::AnimateMaterials(const GameTimer& gt)
 {
-	auto waterMat = mMaterials["water0"].get(); 
+	auto waterMat = FindMaterial("water0"); 
 	
-	//ȯ x,y ̵ κ
+	//변환행렬의 x,y 이동 부분
 	float& tu = waterMat->MatTransform(3, 0);
 	float& tv = waterMat->MatTransform(3, 1);
 
@@ -1350,21 +1828,21 @@ void AppD3D::AnimateMaterials(const GameTimer& gt)
 	if (tu >= 1.0f) tu -= 1.0f;
 	if (tv >= 1.0f) tv -= 1.0f;
 
-	waterMat->NumFramesDirty = gNumFrameResources;
+	SetMaterialConstants(*waterMat);
 
 
-	//̾ ȸ ִϸ̼
-	auto swirlingMat = mMaterials["swirling"].get();
+	//파이어볼 회전 애니메이션
+	auto swirlingMat = FindMaterial("swirling");
 	XMMATRIX R = XMMatrixRotationZ(1.5f * gt.TotalTime());
 	XMMATRIX T0 = XMMatrixTranslation(-0.5f, -0.5f, 0.0f);
 	XMMATRIX T1 = XMMatrixTranslation(0.5f, 0.5f, 0.0f);
 	XMMATRIX M = T0 * R * T1;
 	XMStoreFloat4x4(&swirlingMat->MatTransform, M);
-	swirlingMat->NumFramesDirty = gNumFrameResources;
+	SetMaterialConstants(*swirlingMat);
 }
 
-//ۿ Ϲ   ÷ ʿϴ.
-// ̸  ΰ Ʈ ñ״ó   ֵ Ѵ.
+//앱에서는 일반적으로 몇 개의 샘플러만 필요하다.
+//따라서 미리 정의해 두고 루트 시그니처에서 사용할 수 있도록 유지한다.
 std::array<const CD3DX12_STATIC_SAMPLER_DESC, 7> AppD3D::GetStaticSamplers()
 {
 	const CD3DX12_STATIC_SAMPLER_DESC pointWrap(
@@ -7,6 +7,25 @@
 #include "RenderItem.h"
 #include "GeometryGenerator.h"
 #include "Waves.h"
+#include "ModelLoader.h"
+#include "MeshFile.h"
+#include "ObjImporter.h"
+#include "AssetLoader.h"
+#include "AssetCache.h"
+#include "TextureStreamer.h"
+#include "TextureResidency.h"
+#include "MipGenerator.h"
+#include "BCEncoder.h"
+#include "DDSWriter.h"
+#include "TexturePack.h"
+#include "TextureDedup.h"
+#include "GpuHeapAllocator.h"
+#include "DeferredReleaseQueue.h"
+#include "ConstantStore.h"
+#include "DescriptorAllocator.h"
+#include "GeometryPool.h"
+#include "FrameArena.h"
+#include "ObjectPool.h"
 
 /*
 	GPU 관련 메모리 (개념적 분류)
@@ -38,6 +57,9 @@
 */
 
 inline const int gNumFrameResources = 3;
+//객체/재질 데이터를 256바이트 cbuffer 슬롯 대신 빈틈없는 StructuredBuffer로 바인딩하고 드로우마다 인덱스만 넘긴다.
+//(ObjectConstants 128바이트, MaterialConstants 96바이트이므로 업로드 양이 절반 이하. false면 cbuffer 경로)
+inline constexpr bool gStructuredObjectData = true;
 
 class AppD3D : public InitAppD3D
 {
@@ -58,17 +80,24 @@ private:
 	void BuildRootsignature();
 	void BuildShadersAndInputLayout();
 	void BuildShapeGeometry();
+	void RequestSkullGeometry();
 	void BuildLandGeometry();
 	void BuildWavesGeometryBuffers();
 	void BuildPSO();
 	void BuildRenderItems();
 	void BuildFrameResources();
-	void BuildConstantsBufferView();
 	void BuildMaterials();
 	void DrawRenderItems(ID3D12GraphicsCommandList* cmdList, const std::vector<const RenderItem*>* allRenderItem);
 	void LoadTextures();
+	void CreateTextureSrv(ID3D12Resource* resource, int heapIndex, float minLod = 0.0f);
+	void SetTextureSrvHeapIndex(Texture* texture, int heapIndex);
+	void UpdateStreamedTextureSrv(Texture* texture);
+	void UpdateTextureResidency();
+	float TextureScreenPixels(const RenderItem& ri)const;
+	void FinalizeAssets();
 
 	GeometryGenerator::MeshData LoadModelFile(const std::wstring& path);
+	static bool GenerateMissingMips(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& outDds);
 
 	virtual void OnMouseDown(WPARAM btnState, int x, int y) override;
 	virtual void OnMouseUp(WPARAM btnState, int x, int y) override;
@@ -84,6 +113,15 @@ private:
 	void UpdateWaves(const GameTimer& gt);
 	void UpdateMaterialCBs(const GameTimer& gt);
 	void AnimateMaterials(const GameTimer& gt);
+	//CPU 사본에 쓰고 변경 표시. 각 프레임 리소스에는 그 프레임의 Update*CBs()에서 반영된다.
+	void SetObjectConstants(const RenderItem& ri);
+	void SetMaterialConstants(const Material& mat);
+
+	//풀에 만들고 이름으로 찾을 수 있게 등록. 없는 이름이면 Find*()는 nullptr.
+	Material* CreateMaterial(const std::string& name);
+	Texture* CreateTexture(const std::string& name);
+	Material* FindMaterial(const std::string& name);
+	Texture* FindTexture(const std::string& name);
 
 	inline float GetHillsHeight(float x, float z)const
 	{
@@ -111,23 +149,78 @@ private:
 	FrameResource* mCurrFrameResource = nullptr;
 	int mCurrFrameResourceIndex = 0;
 
+	//정점/인덱스 버퍼와 텍스처를 놓는 힙. (배치된 리소스보다 오래 살도록 지오메트리/텍스처보다 먼저 선언)
+	std::unique_ptr<GpuHeapAllocator> mHeapAllocator;
+	//GPU가 아직 쓰고 있을 수 있는 리소스. Update()에서 펜스가 지난 것부터 놓는다. (할당기보다 먼저 비워지도록 뒤에 선언)
+	DeferredReleaseQueue mReleaseQueue;
+	//정적 메시가 함께 쓰는 정점/인덱스 버퍼. (지오메트리는 이 버퍼를 참조만 한다)
+	std::unique_ptr<GeometryPool> mGeometryPool;
+
 	std::unordered_map<std::string, Microsoft::WRL::ComPtr<ID3DBlob>> mShaders;
 	std::unordered_map<std::string, std::unique_ptr<MeshGeometry>> mGeometries;
 	std::unordered_map<std::string, Microsoft::WRL::ComPtr<ID3D12PipelineState>> mPSOs;
-	std::unordered_map<std::string, std::unique_ptr<Material>> mMaterials;
-	std::unordered_map<std::string, std::unique_ptr<Texture>> mTextures;
-
-	std::vector<std::unique_ptr<RenderItem>> mAllRenderItems;
+	//머티리얼/텍스처는 풀에 모아 두고 이름은 핸들로만 찾는다. (스트리머/중복 제거가 Texture*를 들고 있으므로 주소가 바뀌지 않는 풀)
+	ObjectPool<Material> mMaterials;
+	ObjectPool<Texture> mTextures;
+	std::unordered_map<std::string, Handle<Material>> mMaterialNames;
+	std::unordered_map<std::string, Handle<Texture>> mTextureNames;
+
+	//워커에서 읽고 Update()에서 mUploadCmdList로 업로드 기록.
+	std::unique_ptr<AssetLoader> mAssetLoader;
+	Microsoft::WRL::ComPtr<ID3D12CommandAllocator> mUploadCmdListAlloc;
+	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> mUploadCmdList;
+	UINT64 mUploadFence = 0;
+	//처음 로드가 모두 끝났을 때 메모리 보고를 한 번 찍었는지.
+	bool mLoadReportPrinted = false;
+	//SRV 힙 슬롯. 로드가 끝난 텍스처의 SRV는 새 슬롯에 만들고(사용 중인 디스크립터를 덮어쓰지 않기 위해)
+	//쓰지 않게 된 슬롯은 펜스가 지나면 다시 나눠 준다.
+	DescriptorAllocator mSrvAllocator;
+	//시작 때 텍스처 슬롯 외에 런타임에 만들 텍스처 몫으로 남겨 두는 상주 슬롯, 프레임마다 쓰는 임시 슬롯.
+	static constexpr UINT SrvPersistentHeadroom = 256;
+	static constexpr UINT SrvTransientPerFrame = 64;
+
+	//텍스처 묶음 파일. 있으면 낱개 파일 대신 여기서 찾는다. (스트리머가 매핑을 가리키므로 스트리머보다 오래 산다)
+	TexturePack mTexturePack;
+	//작은 밉부터 프레임마다 나눠 올린다.
+	std::unique_ptr<TextureStreamer> mTextureStreamer;
+	//스트리밍 텍스처마다 gNumFrameResources개의 SRV 슬롯을 돌려 쓴다.
+	struct SrvRing
+	{
+		int Base = 0;
+		int Next = 0;
+		int Placeholder = -1;	//첫 밉이 올라가기 전까지 쓰던 슬롯. 링으로 옮기면 해제.
+	};
+	std::unordered_map<const Texture*, SrvRing> mStreamedSrvs;
+
+	//내용이 같은 텍스처는 먼저 로드된 텍스처(원본)의 리소스와 SRV를 같이 쓴다.
+	TextureDedup mTextureDedup;
+
+	//스트리밍 텍스처의 상주 밉을 예산 안에서 정한다. (화면 크기 우선, 오래 안 쓴 텍스처의 상세 밉부터 내린다)
+	static constexpr UINT64 TextureMemoryBudget = 64 * 1024 * 1024;
+	std::unique_ptr<TextureResidency> mTextureResidency;
+	std::unordered_map<const Texture*, TextureResidency::Id> mResidencyIds;
+	std::vector<Texture*> mResidencyTextures;	//Id -> 텍스처
+	std::uint64_t mResidencyFrame = 0;
+
+	ObjectPool<RenderItem> mRenderItems;
 	//Observer pointer 이므로 const강제.
 	//렌더 아이템을 유형별로 보관.
 	std::vector<const RenderItem*> mRenderItemLayer[(int)RenderLayer::Count];
 
 	//추후 동적 메시 일반화 수정 필요.
 	std::unique_ptr<Waves> mWaves;
-	RenderItem* mWavesRenderItem = nullptr;
+	Handle<RenderItem> mWavesRenderItem;
+	Handle<RenderItem> mSkullRenderItem;
 
 	UINT mPassCbvOffset = 0;
 	PassConstants mMainPassCB;
+	//ObjCBIndex, MatCBIndex 순서. 바뀐 원소만 프레임 리소스의 버퍼로 복사한다. (두 바인딩 경로가 같이 쓴다)
+	ConstantStore<ObjectConstants> mObjectConstants;
+	ConstantStore<MaterialConstants> mMaterialConstants;
+	//이번 프레임에 쓸 버퍼 시작 주소. (패스는 mCurrFrameResource->Upload에서 할당, 객체/재질은 gStructuredObjectData에 따라 빈틈없이 또는 256바이트 간격)
+	D3D12_GPU_VIRTUAL_ADDRESS mPassCBAddress = 0;
+	D3D12_GPU_VIRTUAL_ADDRESS mObjectCBAddress = 0;
+	D3D12_GPU_VIRTUAL_ADDRESS mMaterialCBAddress = 0;
 
 	Microsoft::WRL::ComPtr<ID3D12RootSignature> mRootSignature = nullptr;
 	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> mCbvHeap;
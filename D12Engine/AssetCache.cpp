@@ -0,0 +1,331 @@
+﻿#include "AssetCache.h"
+#include "MappedFile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+	constexpr std::uint32_t kEntryMagic = 0x43323144;	// "D12C"
+	constexpr std::uint32_t kIndexMagic = 0x49323144;	// "D12I"
+
+	struct EntryHeader
+	{
+		std::uint32_t Magic;
+		std::uint32_t Version;
+		std::uint64_t Key;
+		std::uint64_t Size;
+		std::uint64_t PayloadHash;
+	};
+
+	constexpr std::uint64_t P1 = 11400714785074694791ull;
+	constexpr std::uint64_t P2 = 14029467366897019727ull;
+	constexpr std::uint64_t P3 = 1609587929392839161ull;
+	constexpr std::uint64_t P4 = 9650029242287828579ull;
+	constexpr std::uint64_t P5 = 2870177450012600261ull;
+
+	inline std::uint64_t Rotl(std::uint64_t x, int r)
+	{
+		return (x << r) | (x >> (64 - r));
+	}
+
+	inline std::uint64_t Read64(const std::uint8_t* p)
+	{
+		std::uint64_t v;
+		std::memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	inline std::uint32_t Read32(const std::uint8_t* p)
+	{
+		std::uint32_t v;
+		std::memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	inline std::uint64_t Round(std::uint64_t acc, std::uint64_t input)
+	{
+		acc += input * P2;
+		acc = Rotl(acc, 31);
+		return acc * P1;
+	}
+
+	inline std::uint64_t MergeRound(std::uint64_t acc, std::uint64_t val)
+	{
+		acc ^= Round(0, val);
+		return acc * P1 + P4;
+	}
+
+	std::string PathKey(const std::filesystem::path& file)
+	{
+		std::error_code ec;
+		std::filesystem::path abs = std::filesystem::absolute(file, ec);
+		return (ec ? file : abs).lexically_normal().u8string();
+	}
+}
+
+AssetCache& AssetCache::Default()
+{
+	static AssetCache cache("Cache");
+	return cache;
+}
+
+AssetCache::AssetCache(std::filesystem::path directory)
+	: mDirectory(std::move(directory))
+{
+	std::error_code ec;
+	std::filesystem::create_directories(mDirectory, ec);
+	if (ec)
+		mEnabled = false;
+
+	LoadIndex();
+}
+
+AssetCache::~AssetCache()
+{
+	SaveIndex();
+}
+
+std::uint64_t AssetCache::Hash(const void* data, std::size_t size, std::uint64_t seed)
+{
+	const std::uint8_t* p = static_cast<const std::uint8_t*>(data);
+	const std::uint8_t* end = p + size;
+	std::uint64_t h;
+
+	if (size >= 32)
+	{
+		std::uint64_t v1 = seed + P1 + P2;
+		std::uint64_t v2 = seed + P2;
+		std::uint64_t v3 = seed;
+		std::uint64_t v4 = seed - P1;
+
+		const std::uint8_t* limit = end - 32;
+		do
+		{
+			v1 = Round(v1, Read64(p)); p += 8;
+			v2 = Round(v2, Read64(p)); p += 8;
+			v3 = Round(v3, Read64(p)); p += 8;
+			v4 = Round(v4, Read64(p)); p += 8;
+		} while (p <= limit);
+
+		h = Rotl(v1, 1) + Rotl(v2, 7) + Rotl(v3, 12) + Rotl(v4, 18);
+		h = MergeRound(h, v1);
+		h = MergeRound(h, v2);
+		h = MergeRound(h, v3);
+		h = MergeRound(h, v4);
+	}
+	else
+	{
+		h = seed + P5;
+	}
+
+	h += static_cast<std::uint64_t>(size);
+
+	while (p + 8 <= end)
+	{
+		h ^= Round(0, Read64(p));
+		h = Rotl(h, 27) * P1 + P4;
+		p += 8;
+	}
+	if (p + 4 <= end)
+	{
+		h ^= static_cast<std::uint64_t>(Read32(p)) * P1;
+		h = Rotl(h, 23) * P2 + P3;
+		p += 4;
+	}
+	while (p < end)
+	{
+		h ^= (*p) * P5;
+		h = Rotl(h, 11) * P1;
+		p++;
+	}
+
+	h ^= h >> 33;
+	h *= P2;
+	h ^= h >> 29;
+	h *= P3;
+	h ^= h >> 32;
+	return h;
+}
+
+std::uint64_t AssetCache::Combine(std::uint64_t a, std::uint64_t b)
+{
+	std::uint64_t v[2] = { a, b };
+	return Hash(v, sizeof(v));
+}
+
+bool AssetCache::HashFile(const std::filesystem::path& file, std::uint64_t& outHash)
+{
+	std::error_code ec;
+	const std::uint64_t size = std::filesystem::file_size(file, ec);
+	if (ec)
+		return false;
+	const std::int64_t writeTime = static_cast<std::int64_t>(std::filesystem::last_write_time(file, ec).time_since_epoch().count());
+	if (ec)
+		return false;
+
+	const std::string key = PathKey(file);
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		auto it = mSources.find(key);
+		if (it != mSources.end() && it->second.Size == size && it->second.WriteTime == writeTime)
+		{
+			outHash = it->second.Hash;
+			return true;
+		}
+	}
+
+	//바뀌었거나 처음 보는 파일만 읽어서 해시.
+	MappedFile mapped;
+	if (!mapped.Open(file))
+		return false;
+	outHash = Hash(mapped.Data(), mapped.Size());
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	mSources[key] = { size, writeTime, outHash };
+	mIndexDirty = true;
+	return true;
+}
+
+bool AssetCache::MakeKey(const std::filesystem::path& source, std::string_view params, std::uint64_t& outKey)
+{
+	std::uint64_t sourceHash = 0;
+	if (!HashFile(source, sourceHash))
+		return false;
+
+	outKey = Combine(sourceHash, Hash(params, Version));
+	return true;
+}
+
+std::filesystem::path AssetCache::EntryPath(std::uint64_t key)const
+{
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+	return mDirectory / name;
+}
+
+bool AssetCache::Load(std::uint64_t key, std::vector<std::uint8_t>& outData)const
+{
+	if (!mEnabled)
+		return false;
+
+	MappedFile mapped;
+	if (!mapped.Open(EntryPath(key)) || mapped.Size() < sizeof(EntryHeader))
+		return false;
+
+	EntryHeader header;
+	std::memcpy(&header, mapped.Data(), sizeof(header));
+	if (header.Magic != kEntryMagic || header.Version != Version || header.Key != key ||
+		header.Size != mapped.Size() - sizeof(EntryHeader))
+		return false;
+
+	const std::uint8_t* payload = mapped.Data() + sizeof(EntryHeader);
+	if (Hash(payload, static_cast<std::size_t>(header.Size)) != header.PayloadHash)
+		return false;
+
+	outData.assign(payload, payload + header.Size);
+	return true;
+}
+
+bool AssetCache::Store(std::uint64_t key, const void* data, std::size_t size)
+{
+	if (!mEnabled)
+		return false;
+
+	EntryHeader header = { kEntryMagic, Version, key, size, Hash(data, size) };
+
+	//다른 스레드/프로세스가 읽는 중일 수 있으므로 임시 파일에 쓰고 교체한다.
+	const std::filesystem::path path = EntryPath(key);
+	std::ostringstream suffix;
+	suffix << ".tmp" << std::this_thread::get_id();
+	std::filesystem::path tempPath = path;
+	tempPath += suffix.str();
+
+	{
+		std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+		if (!out)
+			return false;
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+		if (!out)
+			return false;
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tempPath, path, ec);
+	if (ec)
+	{
+		std::filesystem::remove(tempPath, ec);
+		return false;
+	}
+	return true;
+}
+
+void AssetCache::LoadIndex()
+{
+	std::ifstream in(mDirectory / "sources.idx", std::ios::binary);
+	if (!in)
+		return;
+
+	std::uint32_t magic = 0, version = 0, count = 0;
+	in.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+	in.read(reinterpret_cast<char*>(&version), sizeof(version));
+	in.read(reinterpret_cast<char*>(&count), sizeof(count));
+	if (!in || magic != kIndexMagic || version != Version)
+		return;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	for (std::uint32_t i = 0; i < count; i++)
+	{
+		std::uint32_t length = 0;
+		SourceEntry entry;
+		in.read(reinterpret_cast<char*>(&length), sizeof(length));
+		if (!in || length > 4096)
+			break;
+
+		std::string path(length, '\0');
+		in.read(path.data(), length);
+		in.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+		if (!in)
+			break;
+
+		mSources[std::move(path)] = entry;
+	}
+}
+
+void AssetCache::SaveIndex()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (!mEnabled || !mIndexDirty)
+		return;
+
+	const std::filesystem::path path = mDirectory / "sources.idx";
+	std::filesystem::path tempPath = path;
+	tempPath += ".tmp";
+
+	{
+		std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+		if (!out)
+			return;
+
+		const std::uint32_t header[3] = { kIndexMagic, Version, static_cast<std::uint32_t>(mSources.size()) };
+		out.write(reinterpret_cast<const char*>(header), sizeof(header));
+		for (const auto& [file, entry] : mSources)
+		{
+			const std::uint32_t length = static_cast<std::uint32_t>(file.size());
+			out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+			out.write(file.data(), length);
+			out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+		}
+		if (!out)
+			return;
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tempPath, path, ec);
+	if (!ec)
+		mIndexDirty = false;
+}
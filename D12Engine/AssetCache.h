@@ -0,0 +1,74 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*
+	파생 데이터 캐시. (파싱된 메시, 컴파일된 셰이더, 변환된 텍스처 등)
+
+	키 = 소스 파일 내용 해시(64비트) + 처리 파라미터 문자열 해시.
+	항목은 <캐시 폴더>/<키 16진수>.bin 한 파일. 헤더에 키/크기/본문 해시를 넣어 손상을 걸러낸다.
+
+	소스 해시는 파일 크기와 수정 시각을 함께 인덱스(sources.idx)에 저장해 두고,
+	둘 다 같으면 파일을 다시 읽지 않는다. 처리 방식이 바뀌면 파라미터 문자열에 버전을 올린다.
+	모든 함수는 스레드 안전. (워커 스레드의 로드 작업에서도 사용)
+*/
+class AssetCache
+{
+public:
+	static constexpr std::uint32_t Version = 1;
+
+	//실행 폴더 기준 "Cache" 폴더를 쓰는 기본 캐시.
+	static AssetCache& Default();
+
+	explicit AssetCache(std::filesystem::path directory);
+	AssetCache(const AssetCache& rhs) = delete;
+	AssetCache& operator=(const AssetCache& rhs) = delete;
+	~AssetCache();
+
+	//XXH64.
+	static std::uint64_t Hash(const void* data, std::size_t size, std::uint64_t seed = 0);
+	static std::uint64_t Hash(std::string_view text, std::uint64_t seed = 0) { return Hash(text.data(), text.size(), seed); }
+	static std::uint64_t Combine(std::uint64_t a, std::uint64_t b);
+
+	//파일 내용 해시. 크기와 수정 시각이 인덱스와 같으면 파일을 읽지 않는다. 파일이 없으면 false.
+	bool HashFile(const std::filesystem::path& file, std::uint64_t& outHash);
+
+	//소스 파일 해시와 처리 파라미터로 키 생성.
+	bool MakeKey(const std::filesystem::path& source, std::string_view params, std::uint64_t& outKey);
+
+	bool Load(std::uint64_t key, std::vector<std::uint8_t>& outData)const;
+	bool Store(std::uint64_t key, const void* data, std::size_t size);
+
+	//소스 인덱스를 디스크에 기록. 소멸자에서도 호출된다.
+	void SaveIndex();
+
+	void SetEnabled(bool enabled) { mEnabled = enabled; }
+	bool IsEnabled()const { return mEnabled; }
+	const std::filesystem::path& Directory()const { return mDirectory; }
+
+private:
+	struct SourceEntry
+	{
+		std::uint64_t Size = 0;
+		std::int64_t WriteTime = 0;
+		std::uint64_t Hash = 0;
+	};
+
+	void LoadIndex();
+	std::filesystem::path EntryPath(std::uint64_t key)const;
+
+private:
+	std::filesystem::path mDirectory;
+	bool mEnabled = true;
+
+	mutable std::mutex mMutex;
+	std::unordered_map<std::string, SourceEntry> mSources;	//절대 경로(UTF-8) -> 항목
+	bool mIndexDirty = false;
+};
@@ -0,0 +1,189 @@
+﻿#include "AssetLoader.h"
+
+#include <algorithm>
+
+AssetLoader::AssetLoader(unsigned workerCount)
+{
+	if (workerCount == 0)
+	{
+		//렌더 스레드 몫으로 하나 남긴다.
+		unsigned hw = std::thread::hardware_concurrency();
+		workerCount = hw > 1 ? hw - 1 : 1;
+	}
+
+	mWorkers.reserve(workerCount);
+	for (unsigned i = 0; i < workerCount; i++)
+		mWorkers.emplace_back(&AssetLoader::WorkerMain, this);
+}
+
+AssetLoader::~AssetLoader()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStop = true;
+	}
+	mWorkCv.notify_all();
+
+	for (auto& worker : mWorkers)
+		worker.join();
+}
+
+AssetHandle AssetLoader::Submit(LoadFn load, FinalizeFn finalize, AssetPriority priority)
+{
+	auto job = std::make_unique<Job>();
+	job->Priority = priority;
+	job->Load = std::move(load);
+	job->Finalize = std::move(finalize);
+
+	AssetHandle handle;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		job->Id = mNextId++;
+		job->Sequence = mNextSequence++;
+		handle.Id = job->Id;
+
+		mStates[job->Id] = AssetState::Queued;
+		mQueue.push(std::move(job));
+	}
+	mWorkCv.notify_one();
+
+	return handle;
+}
+
+bool AssetLoader::Cancel(AssetHandle handle)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	auto it = mStates.find(handle.Id);
+	if (it == mStates.end() || it->second != AssetState::Queued)
+		return false;
+
+	//큐에서 바로 빼지 않고 표시만 한다. 워커가 꺼낼 때 버린다.
+	it->second = AssetState::Cancelled;
+	mCancelledInQueue++;
+	return true;
+}
+
+AssetState AssetLoader::GetState(AssetHandle handle)const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	auto it = mStates.find(handle.Id);
+	if (it != mStates.end())
+		return it->second;
+
+	//발급한 핸들인데 표에 없으면 끝나서 정리된 요청.
+	return handle.IsValid() && handle.Id < mNextId ? AssetState::Finished : AssetState::Invalid;
+}
+
+bool AssetLoader::IsFinished(AssetHandle handle)const
+{
+	AssetState state = GetState(handle);
+	return state == AssetState::Cancelled || state == AssetState::Finished;
+}
+
+std::size_t AssetLoader::Pump(std::size_t maxCount)
+{
+	std::vector<std::unique_ptr<Job>> jobs;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mCompleted.empty())
+			return 0;
+
+		//급한 것부터. 같은 우선순위는 요청 순서.
+		std::sort(mCompleted.begin(), mCompleted.end(),
+			[](const std::unique_ptr<Job>& a, const std::unique_ptr<Job>& b)
+			{
+				if (a->Priority != b->Priority)
+					return a->Priority < b->Priority;
+				return a->Sequence < b->Sequence;
+			});
+
+		const std::size_t count = (std::min)(maxCount, mCompleted.size());
+		jobs.assign(std::make_move_iterator(mCompleted.begin()), std::make_move_iterator(mCompleted.begin() + count));
+		mCompleted.erase(mCompleted.begin(), mCompleted.begin() + count);
+	}
+
+	//Finalize는 잠금 없이 실행. (콜백 안에서 Submit 가능)
+	for (auto& job : jobs)
+	{
+		if (job->Finalize)
+			job->Finalize(job->Loaded);
+
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStates.erase(job->Id);
+	}
+
+	return jobs.size();
+}
+
+bool AssetLoader::HasCompleted()const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return !mCompleted.empty();
+}
+
+std::size_t AssetLoader::PendingCount()const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mQueue.size() - mCancelledInQueue + mLoadingCount + mCompleted.size();
+}
+
+void AssetLoader::WaitIdle()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mIdleCv.wait(lock, [this]() { return mQueue.empty() && mLoadingCount == 0; });
+}
+
+void AssetLoader::WorkerMain()
+{
+	while (true)
+	{
+		std::unique_ptr<Job> job;
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mWorkCv.wait(lock, [this]() { return mStop || !mQueue.empty(); });
+			if (mStop)
+				return;
+
+			//priority_queue::top()은 const라 이동하려면 const_cast가 필요하다.
+			job = std::move(const_cast<std::unique_ptr<Job>&>(mQueue.top()));
+			mQueue.pop();
+
+			AssetState& state = mStates[job->Id];
+			if (state == AssetState::Cancelled)
+			{
+				mStates.erase(job->Id);
+				mCancelledInQueue--;
+				if (mQueue.empty() && mLoadingCount == 0)
+					mIdleCv.notify_all();
+				continue;
+			}
+
+			state = AssetState::Loading;
+			mLoadingCount++;
+		}
+
+		bool loaded = false;
+		try
+		{
+			loaded = job->Load ? job->Load() : true;
+		}
+		catch (...)
+		{
+			//워커에서 던진 예외는 실패로 처리하고 렌더 스레드에서 Finalize(false)로 알린다.
+			loaded = false;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			job->Loaded = loaded;
+			mStates[job->Id] = AssetState::Loaded;
+			mCompleted.push_back(std::move(job));
+			mLoadingCount--;
+
+			if (mQueue.empty() && mLoadingCount == 0)
+				mIdleCv.notify_all();
+		}
+	}
+}
@@ -0,0 +1,140 @@
+﻿#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/*
+	비동기 에셋 로더.
+
+	Load    : 워커 스레드. 파일 읽기/디코딩/최적화 등 CPU 작업만 한다. (D3D 호출 금지)
+	Finalize: 렌더 스레드의 Pump()에서 호출. GPU 리소스 생성/업로드 기록 등 마무리.
+
+	요청은 우선순위(같으면 요청 순서)대로 워커가 가져간다.
+	완료 여부는 GetState()로 폴링하거나 Finalize 콜백으로 받는다.
+
+	상태는 진행 중인 요청만 들고 있다. Finalize를 마쳤거나 취소된 요청은 그 자리에서 지우고 Finished로 답한다.
+	성공/실패는 남기지 않는다. (결과는 Finalize 콜백에서 처리한다)
+	그래서 런타임 스트리밍으로 요청이 계속 들어와도 상태 표는 진행 중인 요청 수만큼만 커진다.
+*/
+
+enum class AssetPriority : std::uint8_t
+{
+	Critical = 0,	//첫 프레임에 필요
+	High,
+	Normal,
+	Low,			//배경 스트리밍
+};
+
+enum class AssetState : std::uint8_t
+{
+	Invalid,	//이 로더가 발급하지 않은 핸들
+	Queued,		//워커 대기 중
+	Loading,	//워커에서 Load 실행 중
+	Loaded,		//Load 끝. 렌더 스레드의 Finalize 대기
+	Cancelled,	//취소됨. 워커가 큐에서 버리면 Finished
+	Finished,	//Finalize까지 끝났거나 취소되어 정리된 요청
+};
+
+struct AssetHandle
+{
+	std::uint32_t Id = 0;
+
+	bool IsValid()const { return Id != 0; }
+	bool operator==(const AssetHandle& rhs)const { return Id == rhs.Id; }
+	bool operator!=(const AssetHandle& rhs)const { return Id != rhs.Id; }
+};
+
+class AssetLoader
+{
+public:
+	//워커 스레드에서 실행. 실패 시 false.
+	using LoadFn = std::function<bool()>;
+	//렌더 스레드에서 실행. loaded = Load 성공 여부. 반환값은 최종 성공 여부. (로더는 기록하지 않는다)
+	using FinalizeFn = std::function<bool(bool loaded)>;
+
+	//workerCount = 0 이면 (하드웨어 스레드 - 1), 최소 1.
+	explicit AssetLoader(unsigned workerCount = 0);
+	AssetLoader(const AssetLoader& rhs) = delete;
+	AssetLoader& operator=(const AssetLoader& rhs) = delete;
+	~AssetLoader();
+
+	AssetHandle Submit(LoadFn load, FinalizeFn finalize, AssetPriority priority = AssetPriority::Normal);
+
+	//Load 결과(T)를 워커에서 채우고 렌더 스레드에서 소비하는 형태.
+	template<typename T>
+	AssetHandle Submit(std::function<bool(T&)> load, std::function<bool(T&, bool)> finalize, AssetPriority priority = AssetPriority::Normal)
+	{
+		auto payload = std::make_shared<T>();
+		return Submit(
+			[payload, load = std::move(load)]() { return load(*payload); },
+			[payload, finalize = std::move(finalize)](bool loaded) { return finalize(*payload, loaded); },
+			priority);
+	}
+
+	//아직 워커가 가져가지 않은 요청만 취소 가능. 취소된 요청의 Finalize는 호출되지 않는다.
+	bool Cancel(AssetHandle handle);
+
+	AssetState GetState(AssetHandle handle)const;
+	//Cancelled/Finished. (Finalize가 더 불리지 않는다)
+	bool IsFinished(AssetHandle handle)const;
+
+	//렌더 스레드에서 매 프레임 호출. 완료된 요청의 Finalize를 우선순위 순으로 최대 maxCount개 실행.
+	std::size_t Pump(std::size_t maxCount = SIZE_MAX);
+
+	//Finalize 대기 중인 요청이 있는지.
+	bool HasCompleted()const;
+	//Queued + Loading + Loaded
+	std::size_t PendingCount()const;
+
+	//모든 요청이 Loaded 이상이 될 때까지 대기. (Finalize는 하지 않는다)
+	void WaitIdle();
+
+private:
+	struct Job
+	{
+		std::uint32_t Id = 0;
+		AssetPriority Priority = AssetPriority::Normal;
+		std::uint64_t Sequence = 0;
+		LoadFn Load;
+		FinalizeFn Finalize;
+		bool Loaded = false;
+	};
+
+	//priority_queue는 최대 힙이므로 "덜 급한" 쪽이 작다.
+	struct JobOrder
+	{
+		bool operator()(const std::unique_ptr<Job>& a, const std::unique_ptr<Job>& b)const
+		{
+			if (a->Priority != b->Priority)
+				return a->Priority > b->Priority;
+			return a->Sequence > b->Sequence;
+		}
+	};
+
+	void WorkerMain();
+
+private:
+	mutable std::mutex mMutex;
+	std::condition_variable mWorkCv;
+	std::condition_variable mIdleCv;
+
+	std::priority_queue<std::unique_ptr<Job>, std::vector<std::unique_ptr<Job>>, JobOrder> mQueue;
+	std::vector<std::unique_ptr<Job>> mCompleted;
+	std::unordered_map<std::uint32_t, AssetState> mStates;	//진행 중인 요청만
+
+	std::uint32_t mNextId = 1;
+	std::uint64_t mNextSequence = 0;
+	std::size_t mLoadingCount = 0;
+	std::size_t mCancelledInQueue = 0;
+	bool mStop = false;
+
+	std::vector<std::thread> mWorkers;
+};
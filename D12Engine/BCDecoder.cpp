@@ -0,0 +1,720 @@
+﻿#include "BCDecoder.h"
+#include "BC7Tables.h"
+
+#include <algorithm>
+#include <cstring>
+#if defined(_WIN32)
+#include <ppl.h> //Parallel Patterns Library
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define BC_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define BC_TARGET_SSSE3
+#define BC_TARGET_AVX2
+#else
+#define BC_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define BC_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace
+{
+	//한 작업 단위의 최소 블록 수. 너무 잘게 자르면 스케줄링 비용이 디코딩 비용보다 커진다.
+	constexpr std::size_t kMinChunkBlocks = 4096;
+
+	inline std::uint32_t Pack(std::uint32_t r, std::uint32_t g, std::uint32_t b, std::uint32_t a)
+	{
+		return r | (g << 8) | (b << 16) | (a << 24);
+	}
+
+	inline std::uint32_t Expand5(std::uint32_t v) { return (v << 3) | (v >> 2); }
+	inline std::uint32_t Expand6(std::uint32_t v) { return (v << 2) | (v >> 4); }
+
+	inline std::uint32_t Load32(const std::uint8_t* p)
+	{
+		std::uint32_t v;
+		std::memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	inline std::uint64_t Load64(const std::uint8_t* p)
+	{
+		std::uint64_t v;
+		std::memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	//----------------------------------------------------------------------------
+	// BC1~BC5 팔레트
+	//----------------------------------------------------------------------------
+
+	//BC2/BC3의 색 블록은 c0 <= c1 이어도 항상 4색 모드.
+	void ColorPalette(const std::uint8_t* block, bool forceFourColor, std::uint32_t palette[4])
+	{
+		const std::uint32_t c0 = block[0] | (block[1] << 8);
+		const std::uint32_t c1 = block[2] | (block[3] << 8);
+
+		const std::uint32_t r0 = Expand5(c0 >> 11), g0 = Expand6((c0 >> 5) & 0x3f), b0 = Expand5(c0 & 0x1f);
+		const std::uint32_t r1 = Expand5(c1 >> 11), g1 = Expand6((c1 >> 5) & 0x3f), b1 = Expand5(c1 & 0x1f);
+
+		palette[0] = Pack(r0, g0, b0, 255);
+		palette[1] = Pack(r1, g1, b1, 255);
+		if (c0 > c1 || forceFourColor)
+		{
+			palette[2] = Pack((2 * r0 + r1) / 3, (2 * g0 + g1) / 3, (2 * b0 + b1) / 3, 255);
+			palette[3] = Pack((r0 + 2 * r1) / 3, (g0 + 2 * g1) / 3, (b0 + 2 * b1) / 3, 255);
+		}
+		else
+		{
+			//3색 모드. 인덱스 3은 투명한 검정.
+			palette[2] = Pack((r0 + r1) / 2, (g0 + g1) / 2, (b0 + b1) / 2, 255);
+			palette[3] = 0;
+		}
+	}
+
+	//BC3 알파, BC4/BC5 채널 블록. (8바이트: 끝점 2개 + 3비트 인덱스 16개)
+	void AlphaPalette(const std::uint8_t* block, std::uint8_t palette[8])
+	{
+		const std::uint32_t a0 = block[0];
+		const std::uint32_t a1 = block[1];
+
+		palette[0] = static_cast<std::uint8_t>(a0);
+		palette[1] = static_cast<std::uint8_t>(a1);
+		if (a0 > a1)
+		{
+			for (std::uint32_t i = 1; i < 7; i++)
+				palette[i + 1] = static_cast<std::uint8_t>(((7 - i) * a0 + i * a1) / 7);
+		}
+		else
+		{
+			for (std::uint32_t i = 1; i < 5; i++)
+				palette[i + 1] = static_cast<std::uint8_t>(((5 - i) * a0 + i * a1) / 5);
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+	}
+
+	void AlphaIndices(const std::uint8_t* block, std::uint8_t indices[16])
+	{
+		const std::uint64_t bits = Load64(block) >> 16;
+		for (int i = 0; i < 16; i++)
+			indices[i] = static_cast<std::uint8_t>((bits >> (3 * i)) & 7);
+	}
+
+	//----------------------------------------------------------------------------
+	// 스칼라 경로 (기준 구현)
+	//----------------------------------------------------------------------------
+
+	void DecodeColorScalar(const std::uint8_t* block, bool forceFourColor, std::uint8_t* out, std::size_t pitch)
+	{
+		std::uint32_t palette[4];
+		ColorPalette(block, forceFourColor, palette);
+
+		const std::uint32_t indices = Load32(block + 4);
+		for (int y = 0; y < 4; y++)
+		{
+			std::uint32_t* row = reinterpret_cast<std::uint32_t*>(out + y * pitch);
+			for (int x = 0; x < 4; x++)
+			{
+				const std::uint32_t color = palette[(indices >> (2 * (y * 4 + x))) & 3];
+				std::memcpy(row + x, &color, sizeof(color));
+			}
+		}
+	}
+
+	//RGBA8의 알파 채널만 덮어쓴다.
+	void WriteAlphaScalar(const std::uint8_t alpha[16], std::uint8_t* out, std::size_t pitch)
+	{
+		for (int y = 0; y < 4; y++)
+		{
+			for (int x = 0; x < 4; x++)
+				out[y * pitch + x * 4 + 3] = alpha[y * 4 + x];
+		}
+	}
+
+	void DecodeAlphaScalar(const std::uint8_t* block, std::uint8_t alpha[16])
+	{
+		std::uint8_t palette[8];
+		std::uint8_t indices[16];
+		AlphaPalette(block, palette);
+		AlphaIndices(block, indices);
+
+		for (int i = 0; i < 16; i++)
+			alpha[i] = palette[indices[i]];
+	}
+
+	void DecodeBC1Scalar(const std::uint8_t* block, std::uint8_t* out, std::size_t pitch)
+	{
+		DecodeColorScalar(block, false, out, pitch);
+	}
+
+	void DecodeBC2Scalar(const std::uint8_t* block, std::uint8_t* out, std::size_t pitch)
+	{
+		DecodeColorScalar(block + 8, true, out, pitch);
+
+		std::uint8_t alpha[16];
+		for (int i = 0; i < 16; i++)
+		{
+			const std::uint32_t nibble = (block[i / 2] >> (4 * (i & 1))) & 0xf;
+			alpha[i] = static_cast<std::uint8_t>(nibble * 17);
+		}
+		WriteAlphaScalar(alpha, out, pitch);
+	}
+
+	void DecodeBC3Scalar(const std::uint8_t* block, std::uint8_t* out, std::size_t pitch)
+	{
+		DecodeColorScalar(block + 8, true, out, pitch);
+
+		std::uint8_t alpha[16];
+		DecodeAlphaScalar(block, alpha);
+		WriteAlphaScalar(alpha, out, pitch);
+	}
+
+	void DecodeBC4Scalar(const std::uint8_t* block, std::uint8_t* out, std::size_t pitch)
+	{
+		std::uint8_t red[16];
+		DecodeAlphaScalar(block, red);
+		for (int y = 0; y < 4; y++)
+			std::memcpy(out + y * pitch, red + y * 4, 4);
+	}
+
+	void DecodeBC5Scalar(const std::uint8_t* block, std::uint8_t* out, std::size_t pitch)
+	{
+		std::uint8_t red[16];
+		std::uint8_t green[16];
+		DecodeAlphaScalar(block, red);
+		DecodeAlphaScalar(block + 8, green);
+		for (int y = 0; y < 4; y++)
+		{
+			for (int x = 0; x < 4; x++)
+			{
+				out[y * pitch + x * 2 + 0] = red[y * 4 + x];
+				out[y * pitch + x * 2 + 1] = green[y * 4 + x];
+			}
+		}
+	}
+
+	//----------------------------------------------------------------------------
+	// BC7
+	//----------------------------------------------------------------------------
+
+	//128비트 블록을 LSB부터 읽는다.
+	struct Bc7BitReader
+	{
+		std::uint64_t Lo;
+		std::uint64_t Hi;
+		std::uint32_t Pos = 0;
+
+		std::uint32_t Read(std::uint32_t count)
+		{
+			std::uint64_t v;
+			if (Pos >= 64)
+				v = Hi >> (Pos - 64);
+			else if (Pos == 0)
+				v = Lo;
+			else
+				v = (Lo >> Pos) | (Hi << (64 - Pos));
+
+			Pos += count;
+			return static_cast<std::uint32_t>(v & ((1ull << count) - 1));
+		}
+	};
+
+	void DecodeBC7Scalar(const std::uint8_t* block, std::uint8_t* out, std::size_t pitch)
+	{
+		Bc7BitReader bits = { Load64(block), Load64(block + 8) };
+
+		//모드 = 첫 번째 1비트의 위치. 모드 비트가 없는 블록은 투명한 검정.
+		std::uint32_t modeIndex = 0;
+		while (modeIndex < 8 && !(block[0] & (1u << modeIndex)))
+			modeIndex++;
+		if (modeIndex == 8)
+		{
+			for (int y = 0; y < 4; y++)
+				std::memset(out + y * pitch, 0, 16);
+			return;
+		}
+
+		const BC7::Mode& mode = BC7::Modes[modeIndex];
+		bits.Read(modeIndex + 1);
+
+		const std::uint32_t partition = bits.Read(mode.PartitionBits);
+		const std::uint32_t rotation = bits.Read(mode.RotationBits);
+		const std::uint32_t indexSelection = bits.Read(mode.IndexSelectionBits);
+
+		//끝점: 채널마다 (서브셋0 e0, e1, 서브셋1 e0, e1, ...) 순서.
+		const std::uint32_t endpointCount = mode.Subsets * 2u;
+		std::uint32_t endpoints[6][4] = {};
+		for (std::uint32_t c = 0; c < 3; c++)
+		{
+			for (std::uint32_t e = 0; e < endpointCount; e++)
+				endpoints[e][c] = bits.Read(mode.ColorBits);
+		}
+		if (mode.AlphaBits)
+		{
+			for (std::uint32_t e = 0; e < endpointCount; e++)
+				endpoints[e][3] = bits.Read(mode.AlphaBits);
+		}
+
+		std::uint32_t colorBits = mode.ColorBits;
+		std::uint32_t alphaBits = mode.AlphaBits;
+		if (mode.EndpointPBits || mode.SharedPBits)
+		{
+			std::uint32_t pbits[6];
+			if (mode.EndpointPBits)
+			{
+				for (std::uint32_t e = 0; e < endpointCount; e++)
+					pbits[e] = bits.Read(1);
+			}
+			else
+			{
+				for (std::uint32_t s = 0; s < mode.Subsets; s++)
+					pbits[s * 2] = pbits[s * 2 + 1] = bits.Read(1);
+			}
+
+			for (std::uint32_t e = 0; e < endpointCount; e++)
+			{
+				for (std::uint32_t c = 0; c < 4; c++)
+					endpoints[e][c] = (endpoints[e][c] << 1) | pbits[e];
+			}
+			colorBits++;
+			if (alphaBits)
+				alphaBits++;
+		}
+
+		//상위 비트를 하위에 반복해서 8비트로 확장.
+		for (std::uint32_t e = 0; e < endpointCount; e++)
+		{
+			for (std::uint32_t c = 0; c < 3; c++)
+			{
+				const std::uint32_t v = endpoints[e][c] << (8 - colorBits);
+				endpoints[e][c] = v | (v >> colorBits);
+			}
+
+			if (alphaBits)
+			{
+				const std::uint32_t v = endpoints[e][3] << (8 - alphaBits);
+				endpoints[e][3] = v | (v >> alphaBits);
+			}
+			else
+			{
+				endpoints[e][3] = 255;
+			}
+		}
+
+		//픽셀별 서브셋과 고정 픽셀. (고정 픽셀의 인덱스는 최상위 비트 0이 생략되어 한 비트 짧다)
+		std::uint8_t subsets[16] = {};
+		std::uint32_t anchors[3] = { 0, 0, 0 };
+		if (mode.Subsets == 2)
+		{
+			for (int i = 0; i < 16; i++)
+				subsets[i] = static_cast<std::uint8_t>((BC7::Partition2[partition] >> i) & 1);
+			anchors[1] = BC7::Anchor2[partition];
+		}
+		else if (mode.Subsets == 3)
+		{
+			for (int i = 0; i < 16; i++)
+				subsets[i] = static_cast<std::uint8_t>((BC7::Partition3[partition] >> (2 * i)) & 3);
+			anchors[1] = BC7::Anchor3a[partition];
+			anchors[2] = BC7::Anchor3b[partition];
+		}
+
+		std::uint32_t indices[16];
+		for (std::uint32_t i = 0; i < 16; i++)
+		{
+			const bool anchor = i == anchors[subsets[i]];
+			indices[i] = bits.Read(mode.IndexBits - (anchor ? 1 : 0));
+		}
+
+		std::uint32_t indices2[16] = {};
+		if (mode.IndexBits2)
+		{
+			for (std::uint32_t i = 0; i < 16; i++)
+				indices2[i] = bits.Read(mode.IndexBits2 - (i == 0 ? 1 : 0));
+		}
+
+		//모드 4/5: 색과 알파가 서로 다른 인덱스 세트를 쓴다. (모드 4는 선택 비트로 교환)
+		const std::uint32_t* colorIndices = indices;
+		const std::uint32_t* alphaIndices = mode.IndexBits2 ? indices2 : indices;
+		std::uint32_t colorIndexBits = mode.IndexBits;
+		std::uint32_t alphaIndexBits = mode.IndexBits2 ? mode.IndexBits2 : mode.IndexBits;
+		if (indexSelection)
+		{
+			std::swap(colorIndices, alphaIndices);
+			std::swap(colorIndexBits, alphaIndexBits);
+		}
+
+		const std::uint8_t* colorWeights = BC7::Weights(colorIndexBits);
+		const std::uint8_t* alphaWeights = BC7::Weights(alphaIndexBits);
+
+		for (std::uint32_t i = 0; i < 16; i++)
+		{
+			const std::uint32_t* e0 = endpoints[subsets[i] * 2];
+			const std::uint32_t* e1 = endpoints[subsets[i] * 2 + 1];
+			const std::uint32_t cw = colorWeights[colorIndices[i]];
+			const std::uint32_t aw = alphaWeights[alphaIndices[i]];
+
+			std::uint32_t rgba[4] =
+			{
+				BC7::Interpolate(e0[0], e1[0], cw),
+				BC7::Interpolate(e0[1], e1[1], cw),
+				BC7::Interpolate(e0[2], e1[2], cw),
+				BC7::Interpolate(e0[3], e1[3], aw),
+			};
+
+			//회전: 알파와 한 채널을 교환.
+			if (rotation)
+				std::swap(rgba[3], rgba[rotation - 1]);
+
+			std::uint8_t* px = out + (i / 4) * pitch + (i % 4) * 4;
+			for (int c = 0; c < 4; c++)
+				px[c] = static_cast<std::uint8_t>(rgba[c]);
+		}
+	}
+
+	//----------------------------------------------------------------------------
+	// SIMD 경로. 팔레트는 스칼라와 같은 함수로 만들고 인덱스 -> 픽셀 확장만 셔플로 한다.
+	//----------------------------------------------------------------------------
+
+#if defined(BC_SIMD)
+	struct ShuffleTable
+	{
+		alignas(16) std::uint8_t Mask[256][16];
+	};
+
+	//색 인덱스 한 행(2비트 x 4) -> 팔레트(4바이트 x 4)에서 픽셀 4개를 뽑는 셔플 마스크.
+	constexpr ShuffleTable MakeColorShuffleTable()
+	{
+		ShuffleTable table = {};
+		for (int row = 0; row < 256; row++)
+		{
+			for (int x = 0; x < 4; x++)
+			{
+				const int index = (row >> (2 * x)) & 3;
+				for (int c = 0; c < 4; c++)
+					table.Mask[row][x * 4 + c] = static_cast<std::uint8_t>(index * 4 + c);
+			}
+		}
+		return table;
+	}
+
+	constexpr ShuffleTable kColorShuffle = MakeColorShuffleTable();
+
+	//알파 16개 중 y행의 4개를 RGBA의 A 자리로 옮기는 마스크.
+	alignas(16) constexpr std::uint8_t kAlphaSpread[4][16] =
+	{
+		{ 0x80, 0x80, 0x80,  0, 0x80, 0x80, 0x80,  1, 0x80, 0x80, 0x80,  2, 0x80, 0x80, 0x80,  3 },
+		{ 0x80, 0x80, 0x80,  4, 0x80, 0x80, 0x80,  5, 0x80, 0x80, 0x80,  6, 0x80, 0x80, 0x80,  7 },
+		{ 0x80, 0x80, 0x80,  8, 0x80, 0x80, 0x80,  9, 0x80, 0x80, 0x80, 10, 0x80, 0x80, 0x80, 11 },
+		{ 0x80, 0x80, 0x80, 12, 0x80, 0x80, 0x80, 13, 0x80, 0x80, 0x80, 14, 0x80, 0x80, 0x80, 15 },
+	};
+
+	//알파 팔레트(8) + 인덱스(16) -> 알파 16개.
+	BC_TARGET_SSSE3 __m128i LookupAlphaSsse3(const std::uint8_t* block)
+	{
+		alignas(16) std::uint8_t palette[16] = {};
+		alignas(16) std::uint8_t indices[16];
+		AlphaPalette(block, palette);
+		AlphaIndices(block, indices);
+
+		return _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(palette)),
+			_mm_load_si128(reinterpret_cast<const __m128i*>(indices)));
+	}
+
+	//BC2 4비트 알파 16개 -> 8비트. (n * 17 = n << 4 | n)
+	BC_TARGET_SSSE3 __m128i ExplicitAlphaSsse3(const std::uint8_t* block)
+	{
+		const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(block));
+		const __m128i nibbleMask = _mm_set1_epi8(0x0f);
+		const __m128i lo = _mm_and_si128(packed, nibbleMask);
+		const __m128i hi = _mm_and_si128(_mm_srli_epi16(packed, 4), nibbleMask);
+		const __m128i nibbles = _mm_unpacklo_epi8(lo, hi);
+		return _mm_or_si128(nibbles, _mm_slli_epi16(nibbles, 4));
+	}
+
+	BC_TARGET_SSSE3 void DecodeRgbaSsse3(const std::uint8_t* colorBlock, bool forceFourColor, const __m128i* alpha, std::uint8_t* out, std::size_t pitch)
+	{
+		alignas(16) std::uint32_t palette[4];
+		ColorPalette(colorBlock, forceFourColor, palette);
+
+		const __m128i colors = _mm_load_si128(reinterpret_cast<const __m128i*>(palette));
+		const __m128i rgbMask = _mm_set1_epi32(0x00ffffff);
+		const std::uint32_t indices = Load32(colorBlock + 4);
+
+		for (int y = 0; y < 4; y++)
+		{
+			const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(kColorShuffle.Mask[(indices >> (8 * y)) & 0xff]));
+			__m128i row = _mm_shuffle_epi8(colors, mask);
+			if (alpha)
+			{
+				const __m128i a = _mm_shuffle_epi8(*alpha, _mm_load_si128(reinterpret_cast<const __m128i*>(kAlphaSpread[y])));
+				row = _mm_or_si128(_mm_and_si128(row, rgbMask), a);
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + y * pitch), row);
+		}
+	}
+
+	//AVX2: 두 행을 한 번에 셔플. (128비트 레인마다 같은 팔레트)
+	BC_TARGET_AVX2 void DecodeRgbaAvx2(const std::uint8_t* colorBlock, bool forceFourColor, const __m128i* alpha, std::uint8_t* out, std::size_t pitch)
+	{
+		alignas(16) std::uint32_t palette[4];
+		ColorPalette(colorBlock, forceFourColor, palette);
+
+		const __m256i colors = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(palette)));
+		const __m256i rgbMask = _mm256_set1_epi32(0x00ffffff);
+		const __m256i alpha2 = alpha ? _mm256_broadcastsi128_si256(*alpha) : _mm256_setzero_si256();
+		const std::uint32_t indices = Load32(colorBlock + 4);
+
+		for (int y = 0; y < 4; y += 2)
+		{
+			const __m128i mask0 = _mm_load_si128(reinterpret_cast<const __m128i*>(kColorShuffle.Mask[(indices >> (8 * y)) & 0xff]));
+			const __m128i mask1 = _mm_load_si128(reinterpret_cast<const __m128i*>(kColorShuffle.Mask[(indices >> (8 * y + 8)) & 0xff]));
+			__m256i rows = _mm256_shuffle_epi8(colors, _mm256_inserti128_si256(_mm256_castsi128_si256(mask0), mask1, 1));
+			if (alpha)
+			{
+				const __m128i spread0 = _mm_load_si128(reinterpret_cast<const __m128i*>(kAlphaSpread[y]));
+				const __m128i spread1 = _mm_load_si128(reinterpret_cast<const __m128i*>(kAlphaSpread[y + 1]));
+				const __m256i a = _mm256_shuffle_epi8(alpha2, _mm256_inserti128_si256(_mm256_castsi128_si256(spread0), spread1, 1));
+				rows = _mm256_or_si256(_mm256_and_si256(rows, rgbMask), a);
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + y * pitch), _mm256_castsi256_si128(rows));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + (y + 1) * pitch), _mm256_extracti128_si256(rows, 1));
+		}
+	}
+
+	BC_TARGET_SSSE3 void DecodeBC2Ssse3(const std::uint8_t* block, std::uint8_t* out, std::size_t pitch, bool avx2)
+	{
+		const __m128i alpha = ExplicitAlphaSsse3(block);
+		if (avx2)
+			DecodeRgbaAvx2(block + 8, true, &alpha, out, pitch);
+		else
+			DecodeRgbaSsse3(block + 8, true, &alpha, out, pitch);
+	}
+
+	BC_TARGET_SSSE3 void DecodeBC3Ssse3(const std::uint8_t* block, std::uint8_t* out, std::size_t pitch, bool avx2)
+	{
+		const __m128i alpha = LookupAlphaSsse3(block);
+		if (avx2)
+			DecodeRgbaAvx2(block + 8, true, &alpha, out, pitch);
+		else
+			DecodeRgbaSsse3(block + 8, true, &alpha, out, pitch);
+	}
+
+	BC_TARGET_SSSE3 void DecodeBC4Ssse3(const std::uint8_t* block, std::uint8_t* out, std::size_t pitch)
+	{
+		alignas(16) std::uint8_t red[16];
+		_mm_store_si128(reinterpret_cast<__m128i*>(red), LookupAlphaSsse3(block));
+		for (int y = 0; y < 4; y++)
+			std::memcpy(out + y * pitch, red + y * 4, 4);
+	}
+
+	BC_TARGET_SSSE3 void DecodeBC5Ssse3(const std::uint8_t* block, std::uint8_t* out, std::size_t pitch)
+	{
+		const __m128i red = LookupAlphaSsse3(block);
+		const __m128i green = LookupAlphaSsse3(block + 8);
+		const __m128i rows01 = _mm_unpacklo_epi8(red, green);
+		const __m128i rows23 = _mm_unpackhi_epi8(red, green);
+
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out), rows01);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out + pitch), _mm_srli_si128(rows01, 8));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out + 2 * pitch), rows23);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out + 3 * pitch), _mm_srli_si128(rows23, 8));
+	}
+
+	int DetectSimdLevel()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		const int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		const bool ssse3 = (info[2] & (1 << 9)) != 0;
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const bool avx = (info[2] & (1 << 28)) != 0;
+
+		bool avx2 = false;
+		if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+		{
+			__cpuidex(info, 7, 0);
+			avx2 = (info[1] & (1 << 5)) != 0;
+		}
+#else
+		__builtin_cpu_init();
+		const bool ssse3 = __builtin_cpu_supports("ssse3");
+		const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+		return avx2 ? 2 : ssse3 ? 1 : 0;
+	}
+#endif
+
+	void DecodeBlockScalar(BCFormat format, const std::uint8_t* block, std::uint8_t* out, std::size_t pitch)
+	{
+		switch (format)
+		{
+		case BCFormat::BC1: DecodeBC1Scalar(block, out, pitch); break;
+		case BCFormat::BC2: DecodeBC2Scalar(block, out, pitch); break;
+		case BCFormat::BC3: DecodeBC3Scalar(block, out, pitch); break;
+		case BCFormat::BC4: DecodeBC4Scalar(block, out, pitch); break;
+		case BCFormat::BC5: DecodeBC5Scalar(block, out, pitch); break;
+		case BCFormat::BC7: DecodeBC7Scalar(block, out, pitch); break;
+		}
+	}
+
+	void DecodeBlockLevel(int level, BCFormat format, const std::uint8_t* block, std::uint8_t* out, std::size_t pitch)
+	{
+#if defined(BC_SIMD)
+		if (level > 0)
+		{
+			const bool avx2 = level >= 2;
+			switch (format)
+			{
+			case BCFormat::BC1:
+				if (avx2)
+					DecodeRgbaAvx2(block, false, nullptr, out, pitch);
+				else
+					DecodeRgbaSsse3(block, false, nullptr, out, pitch);
+				return;
+			case BCFormat::BC2: DecodeBC2Ssse3(block, out, pitch, avx2); return;
+			case BCFormat::BC3: DecodeBC3Ssse3(block, out, pitch, avx2); return;
+			case BCFormat::BC4: DecodeBC4Ssse3(block, out, pitch); return;
+			case BCFormat::BC5: DecodeBC5Ssse3(block, out, pitch); return;
+			case BCFormat::BC7: break;
+			}
+		}
+#endif
+		DecodeBlockScalar(format, block, out, pitch);
+	}
+}
+
+#if defined(_WIN32)
+bool BCDecoder::FromDXGIFormat(DXGI_FORMAT format, BCFormat& outFormat)
+{
+	switch (format)
+	{
+	case DXGI_FORMAT_BC1_TYPELESS:
+	case DXGI_FORMAT_BC1_UNORM:
+	case DXGI_FORMAT_BC1_UNORM_SRGB:
+		outFormat = BCFormat::BC1;
+		return true;
+	case DXGI_FORMAT_BC2_TYPELESS:
+	case DXGI_FORMAT_BC2_UNORM:
+	case DXGI_FORMAT_BC2_UNORM_SRGB:
+		outFormat = BCFormat::BC2;
+		return true;
+	case DXGI_FORMAT_BC3_TYPELESS:
+	case DXGI_FORMAT_BC3_UNORM:
+	case DXGI_FORMAT_BC3_UNORM_SRGB:
+		outFormat = BCFormat::BC3;
+		return true;
+	case DXGI_FORMAT_BC4_TYPELESS:
+	case DXGI_FORMAT_BC4_UNORM:
+		outFormat = BCFormat::BC4;
+		return true;
+	case DXGI_FORMAT_BC5_TYPELESS:
+	case DXGI_FORMAT_BC5_UNORM:
+		outFormat = BCFormat::BC5;
+		return true;
+	case DXGI_FORMAT_BC7_TYPELESS:
+	case DXGI_FORMAT_BC7_UNORM:
+	case DXGI_FORMAT_BC7_UNORM_SRGB:
+		outFormat = BCFormat::BC7;
+		return true;
+	default:
+		return false;
+	}
+}
+#endif
+
+void BCDecoder::DecodeBlock(BCFormat format, const std::uint8_t* block, std::uint8_t* out, std::size_t outRowPitch)
+{
+	DecodeBlockLevel(SimdLevel(), format, block, out, outRowPitch);
+}
+
+void BCDecoder::DecodeBlockAtLevel(int simdLevel, BCFormat format, const std::uint8_t* block, std::uint8_t* out, std::size_t outRowPitch)
+{
+	DecodeBlockLevel((std::min)(simdLevel, SimdLevel()), format, block, out, outRowPitch);
+}
+
+void BCDecoder::DecodeBlockReference(BCFormat format, const std::uint8_t* block, std::uint8_t* out, std::size_t outRowPitch)
+{
+	DecodeBlockScalar(format, block, out, outRowPitch);
+}
+
+bool BCDecoder::Decode(BCFormat format, const void* src, std::size_t srcSize, std::uint32_t width, std::uint32_t height,
+	void* dst, std::size_t dstRowPitch, std::size_t srcRowPitch)
+{
+	if (!src || !dst || width == 0 || height == 0)
+		return false;
+
+	const std::size_t blockBytes = BlockBytes(format);
+	const std::size_t pixelBytes = PixelBytes(format);
+	const std::size_t blocksWide = (width + 3) / 4;
+	const std::size_t blocksHigh = (height + 3) / 4;
+
+	if (srcRowPitch == 0)
+		srcRowPitch = blocksWide * blockBytes;
+	if (srcRowPitch < blocksWide * blockBytes || srcRowPitch * (blocksHigh - 1) + blocksWide * blockBytes > srcSize)
+		return false;
+	if (dstRowPitch < width * pixelBytes)
+		return false;
+
+	const int level = SimdLevel();
+	const std::uint8_t* srcBytes = static_cast<const std::uint8_t*>(src);
+	std::uint8_t* dstBytes = static_cast<std::uint8_t*>(dst);
+
+	const std::size_t rowsPerChunk = (std::max)(std::size_t(1), kMinChunkBlocks / blocksWide);
+	const std::size_t chunkCount = (blocksHigh + rowsPerChunk - 1) / rowsPerChunk;
+
+	auto decodeChunk = [&](std::size_t chunk)
+		{
+			const std::size_t rowEnd = (std::min)(blocksHigh, (chunk + 1) * rowsPerChunk);
+			for (std::size_t by = chunk * rowsPerChunk; by < rowEnd; by++)
+			{
+				const std::uint8_t* block = srcBytes + by * srcRowPitch;
+				const std::size_t y = by * 4;
+				const std::size_t rows = (std::min)(std::size_t(4), height - y);
+
+				for (std::size_t bx = 0; bx < blocksWide; bx++, block += blockBytes)
+				{
+					const std::size_t x = bx * 4;
+					const std::size_t cols = (std::min)(std::size_t(4), width - x);
+					std::uint8_t* out = dstBytes + y * dstRowPitch + x * pixelBytes;
+
+					if (rows == 4 && cols == 4)
+					{
+						DecodeBlockLevel(level, format, block, out, dstRowPitch);
+						continue;
+					}
+
+					//가장자리 블록은 임시로 풀어서 이미지 안쪽만 복사.
+					std::uint8_t temp[64];
+					DecodeBlockLevel(level, format, block, temp, 4 * pixelBytes);
+					for (std::size_t r = 0; r < rows; r++)
+						std::memcpy(out + r * dstRowPitch, temp + r * 4 * pixelBytes, cols * pixelBytes);
+				}
+			}
+		};
+
+#if defined(_WIN32)
+	concurrency::parallel_for(std::size_t(0), chunkCount, decodeChunk);
+#else
+	for (std::size_t chunk = 0; chunk < chunkCount; chunk++)
+		decodeChunk(chunk);
+#endif
+
+	return true;
+}
+
+int BCDecoder::SimdLevel()
+{
+#if defined(BC_SIMD)
+	static const int level = DetectSimdLevel();
+	return level;
+#else
+	return 0;
+#endif
+}
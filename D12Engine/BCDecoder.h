@@ -0,0 +1,69 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_WIN32)
+#include <dxgiformat.h>
+#endif
+
+enum class BCFormat : std::uint8_t
+{
+	BC1,	//RGB + 1비트 알파 -> RGBA8
+	BC2,	//RGB + 4비트 명시 알파 -> RGBA8
+	BC3,	//RGB + 보간 알파 -> RGBA8
+	BC4,	//R -> R8
+	BC5,	//RG -> RG8
+	BC7,	//RGBA -> RGBA8
+};
+
+/*
+	블록 압축(BC) 텍스처 CPU 디코더. (피킹, 텍스처 기반 높이 값, 소프트웨어 폴백, 이미지 비교 등)
+
+	- UNORM 기준. _SRGB 형식도 같은 비트를 그대로 돌려준다. (감마 변환 없음)
+	- 팔레트 계산은 스칼라, 인덱스 -> 픽셀 확장은 SSSE3/AVX2 셔플. (실행 시 CPU 검사)
+	  BC7은 모드/파티션 분기가 많아 스칼라로만 디코딩한다.
+	- 이미지 디코딩은 블록 행 단위로 나눠 PPL로 병렬 처리. (Windows 밖에서는 순차)
+	- SIMD 경로는 DecodeBlockReference(스칼라)와 비트 단위로 같은 결과를 낸다.
+	  보간 공식은 BC1 (2a+b)/3, (a+b)/2 / BC3·4·5 알파 (6a+b)/7, (4a+b)/5 / BC7 (64-w)a+wb+32 >> 6. (모두 정수, 내림)
+	- 기준 디코딩은 Pillow(BcnDecode.c)와 같다. Tests/BCDecoderTests.cpp의 기준 블록이 그 출력이고 두 경로를 모두 비교한다.
+	  DirectXTex는 BC1~5 팔레트를 float로 보간한 뒤 반올림하므로 중간색이 1씩 다를 수 있다. (BC7은 규격의 정수 공식이라 같다)
+	- 모드 비트가 없는 BC7 블록은 D3D 규격대로 투명한 검정(0)으로 디코딩. (Pillow는 불투명한 검정)
+*/
+class BCDecoder
+{
+public:
+	static constexpr std::size_t BlockBytes(BCFormat format)
+	{
+		return (format == BCFormat::BC1 || format == BCFormat::BC4) ? 8 : 16;
+	}
+
+	//디코딩된 픽셀 하나의 바이트 수.
+	static constexpr std::size_t PixelBytes(BCFormat format)
+	{
+		return format == BCFormat::BC4 ? 1 : format == BCFormat::BC5 ? 2 : 4;
+	}
+
+#if defined(_WIN32)
+	//BC1~BC5, BC7의 UNORM/UNORM_SRGB/TYPELESS. 그 외(SNORM, BC6H 등)는 false.
+	static bool FromDXGIFormat(DXGI_FORMAT format, BCFormat& outFormat);
+#endif
+
+	//블록 하나 -> 4x4 픽셀. out의 행 간격은 outRowPitch 바이트.
+	static void DecodeBlock(BCFormat format, const std::uint8_t* block, std::uint8_t* out, std::size_t outRowPitch);
+	//simdLevel 경로로 (SimdLevel()보다 높으면 SimdLevel()). 경로별 검증용.
+	static void DecodeBlockAtLevel(int simdLevel, BCFormat format, const std::uint8_t* block, std::uint8_t* out, std::size_t outRowPitch);
+	//SIMD를 쓰지 않는 기준 구현.
+	static void DecodeBlockReference(BCFormat format, const std::uint8_t* block, std::uint8_t* out, std::size_t outRowPitch);
+
+	/*
+		width x height 이미지 전체 디코딩.
+		srcRowPitch: 블록 한 행의 바이트 수. 0이면 빈틈없이 붙어 있다고 본다.
+		가장자리의 4x4가 안 되는 블록은 이미지 범위만 기록. src가 모자라면 false.
+	*/
+	static bool Decode(BCFormat format, const void* src, std::size_t srcSize, std::uint32_t width, std::uint32_t height,
+		void* dst, std::size_t dstRowPitch, std::size_t srcRowPitch = 0);
+
+	//이 CPU에서 쓰는 경로. (0 = 스칼라, 1 = SSSE3, 2 = AVX2)
+	static int SimdLevel();
+};
@@ -0,0 +1,1054 @@
+﻿#include "BCEncoder.h"
+#include "BC7Tables.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <ppl.h> //Parallel Patterns Library
+
+namespace
+{
+	//한 작업 단위의 최소 블록 수. 인코딩은 블록당 비용이 커서 디코더보다 잘게 나눈다.
+	constexpr std::size_t kMinChunkBlocks = 256;
+
+	//블록 하나의 픽셀. (RGBA, 0~255)
+	using BlockPixels = int[16][4];
+
+	inline float Clamp255(float v)
+	{
+		return (std::min)(255.0f, (std::max)(0.0f, v));
+	}
+
+	//----------------------------------------------------------------------------
+	// 공용: 주축, 최소제곱 끝점
+	//----------------------------------------------------------------------------
+
+	//count개 점(channels 차원)의 평균과 주축(길이 1). 모든 점이 같으면 axis = 0.
+	void PrincipalAxis(const float (*points)[4], int count, int channels, float mean[4], float axis[4])
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			mean[c] = 0.0f;
+			axis[c] = 0.0f;
+		}
+		if (count == 0)
+			return;
+
+		for (int i = 0; i < count; i++)
+		{
+			for (int c = 0; c < channels; c++)
+				mean[c] += points[i][c];
+		}
+		for (int c = 0; c < channels; c++)
+			mean[c] /= count;
+
+		float cov[4][4] = {};
+		for (int i = 0; i < count; i++)
+		{
+			float d[4];
+			for (int c = 0; c < channels; c++)
+				d[c] = points[i][c] - mean[c];
+			for (int a = 0; a < channels; a++)
+			{
+				for (int b = a; b < channels; b++)
+					cov[a][b] += d[a] * d[b];
+			}
+		}
+		for (int a = 0; a < channels; a++)
+		{
+			for (int b = 0; b < a; b++)
+				cov[a][b] = cov[b][a];
+		}
+
+		//거듭제곱법. 시작 벡터는 분산이 가장 큰 채널의 공분산 행.
+		int largest = 0;
+		for (int c = 1; c < channels; c++)
+		{
+			if (cov[c][c] > cov[largest][largest])
+				largest = c;
+		}
+		if (cov[largest][largest] <= 0.0f)
+			return;
+
+		float v[4] = {};
+		for (int c = 0; c < channels; c++)
+			v[c] = cov[largest][c];
+
+		for (int iter = 0; iter < 8; iter++)
+		{
+			float w[4] = {};
+			float norm = 0.0f;
+			for (int a = 0; a < channels; a++)
+			{
+				for (int b = 0; b < channels; b++)
+					w[a] += cov[a][b] * v[b];
+				norm = (std::max)(norm, std::fabs(w[a]));
+			}
+			if (norm <= 0.0f)
+				break;
+			for (int c = 0; c < channels; c++)
+				v[c] = w[c] / norm;
+		}
+
+		float length = 0.0f;
+		for (int c = 0; c < channels; c++)
+			length += v[c] * v[c];
+		length = std::sqrt(length);
+		if (length <= 0.0f)
+			return;
+		for (int c = 0; c < channels; c++)
+			axis[c] = v[c] / length;
+	}
+
+	//주축 위 투영의 양 끝을 끝점으로.
+	void AxisEndpoints(const float (*points)[4], int count, int channels, float ends[2][4])
+	{
+		float mean[4], axis[4];
+		PrincipalAxis(points, count, channels, mean, axis);
+
+		float tMin = 0.0f, tMax = 0.0f;
+		for (int i = 0; i < count; i++)
+		{
+			float t = 0.0f;
+			for (int c = 0; c < channels; c++)
+				t += (points[i][c] - mean[c]) * axis[c];
+			tMin = (std::min)(tMin, t);
+			tMax = (std::max)(tMax, t);
+		}
+
+		for (int c = 0; c < 4; c++)
+		{
+			ends[0][c] = Clamp255(mean[c] + tMin * axis[c]);
+			ends[1][c] = Clamp255(mean[c] + tMax * axis[c]);
+		}
+	}
+
+	//주축에서 벗어난 정도. (분산 합 - 주축 방향 분산) 파티션 후보를 고를 때 쓴다.
+	float LineResidual(const float (*points)[4], int count, int channels)
+	{
+		float mean[4], axis[4];
+		PrincipalAxis(points, count, channels, mean, axis);
+
+		float residual = 0.0f;
+		for (int i = 0; i < count; i++)
+		{
+			float t = 0.0f, lengthSq = 0.0f;
+			for (int c = 0; c < channels; c++)
+			{
+				const float d = points[i][c] - mean[c];
+				t += d * axis[c];
+				lengthSq += d * d;
+			}
+			residual += lengthSq - t * t;
+		}
+		return residual;
+	}
+
+	//점마다 보간 가중치(0~1)를 고정하고 두 끝점을 최소제곱으로 푼다. 가중치가 모두 같으면 false.
+	bool SolveEndpoints(const float (*points)[4], const float* weights, int count, int channels, float ends[2][4])
+	{
+		float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+		float ax[4] = {}, bx[4] = {};
+		for (int i = 0; i < count; i++)
+		{
+			const float b = weights[i];
+			const float a = 1.0f - b;
+			aa += a * a;
+			ab += a * b;
+			bb += b * b;
+			for (int c = 0; c < channels; c++)
+			{
+				ax[c] += a * points[i][c];
+				bx[c] += b * points[i][c];
+			}
+		}
+
+		const float det = aa * bb - ab * ab;
+		if (std::fabs(det) < 1e-6f)
+			return false;
+
+		for (int c = 0; c < channels; c++)
+		{
+			ends[0][c] = Clamp255((bb * ax[c] - ab * bx[c]) / det);
+			ends[1][c] = Clamp255((aa * bx[c] - ab * ax[c]) / det);
+		}
+		return true;
+	}
+
+	//----------------------------------------------------------------------------
+	// BC1 색 블록 (BC2/BC3 색 부분 포함)
+	//----------------------------------------------------------------------------
+
+	struct ColorResult
+	{
+		std::uint16_t C0 = 0;
+		std::uint16_t C1 = 0;
+		std::uint32_t Indices = 0;
+		bool FourColor = true;
+		std::uint32_t Error = UINT_MAX;
+	};
+
+	inline std::uint16_t Pack565(const int q[3])
+	{
+		return static_cast<std::uint16_t>((q[0] << 11) | (q[1] << 5) | q[2]);
+	}
+
+	inline void Unpack565(std::uint16_t c, int q[3])
+	{
+		q[0] = c >> 11;
+		q[1] = (c >> 5) & 0x3f;
+		q[2] = c & 0x1f;
+	}
+
+	//BCDecoder와 같은 팔레트.
+	void ColorPalette(std::uint16_t c0, std::uint16_t c1, bool fourColor, int palette[4][3])
+	{
+		int q0[3], q1[3];
+		Unpack565(c0, q0);
+		Unpack565(c1, q1);
+
+		const int e0[3] = { (q0[0] << 3) | (q0[0] >> 2), (q0[1] << 2) | (q0[1] >> 4), (q0[2] << 3) | (q0[2] >> 2) };
+		const int e1[3] = { (q1[0] << 3) | (q1[0] >> 2), (q1[1] << 2) | (q1[1] >> 4), (q1[2] << 3) | (q1[2] >> 2) };
+
+		for (int c = 0; c < 3; c++)
+		{
+			palette[0][c] = e0[c];
+			palette[1][c] = e1[c];
+			if (fourColor)
+			{
+				palette[2][c] = (2 * e0[c] + e1[c]) / 3;
+				palette[3][c] = (e0[c] + 2 * e1[c]) / 3;
+			}
+			else
+			{
+				palette[2][c] = (e0[c] + e1[c]) / 2;
+				palette[3][c] = 0;
+			}
+		}
+	}
+
+	/*
+		끝점 두 개로 블록을 평가.
+		forceFourColor(BC2/BC3)가 아니면 원하는 모드에 맞게 끝점 순서를 바꾼다. (c0 > c1 = 4색)
+		transparent[i] 픽셀은 인덱스 3. (3색 모드일 때만 넘어온다)
+	*/
+	void EvaluateColor(const BlockPixels& px, const bool* transparent, int q0[3], int q1[3], bool wantFourColor, bool forceFourColor, ColorResult& best)
+	{
+		ColorResult result;
+		result.C0 = Pack565(q0);
+		result.C1 = Pack565(q1);
+		if (forceFourColor)
+		{
+			result.FourColor = true;
+		}
+		else
+		{
+			if (wantFourColor ? result.C0 < result.C1 : result.C0 > result.C1)
+				std::swap(result.C0, result.C1);
+			result.FourColor = result.C0 > result.C1;
+		}
+
+		int palette[4][3];
+		ColorPalette(result.C0, result.C1, result.FourColor, palette);
+
+		const int choices = result.FourColor ? 4 : 3;
+		result.Error = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			int index = 3;
+			if (!transparent || !transparent[i])
+			{
+				int bestError = INT_MAX;
+				for (int k = 0; k < choices; k++)
+				{
+					const int dr = palette[k][0] - px[i][0];
+					const int dg = palette[k][1] - px[i][1];
+					const int db = palette[k][2] - px[i][2];
+					const int error = dr * dr + dg * dg + db * db;
+					if (error < bestError)
+					{
+						bestError = error;
+						index = k;
+					}
+				}
+				result.Error += bestError;
+				if (result.Error >= best.Error)
+					return;
+			}
+			result.Indices |= std::uint32_t(index) << (2 * i);
+		}
+
+		best = result;
+	}
+
+	void QuantizeColor(const float color[4], int q[3])
+	{
+		q[0] = static_cast<int>(color[0] * 31.0f / 255.0f + 0.5f);
+		q[1] = static_cast<int>(color[1] * 63.0f / 255.0f + 0.5f);
+		q[2] = static_cast<int>(color[2] * 31.0f / 255.0f + 0.5f);
+	}
+
+	void EncodeColorMode(const BlockPixels& px, const bool* transparent, bool fourColor, bool forceFourColor, BCQuality quality, ColorResult& best)
+	{
+		float points[16][4];
+		int pointPixel[16];
+		int count = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			if (transparent && transparent[i])
+				continue;
+			for (int c = 0; c < 4; c++)
+				points[count][c] = static_cast<float>(px[i][c]);
+			pointPixel[count++] = i;
+		}
+
+		//모두 투명: 3색 모드 + 인덱스 3.
+		if (count == 0)
+		{
+			int zero[3] = { 0, 0, 0 };
+			EvaluateColor(px, transparent, zero, zero, false, false, best);
+			return;
+		}
+
+		float ends[2][4];
+		AxisEndpoints(points, count, 3, ends);
+
+		int q0[3], q1[3];
+		QuantizeColor(ends[1], q0);
+		QuantizeColor(ends[0], q1);
+		EvaluateColor(px, transparent, q0, q1, fourColor, forceFourColor, best);
+
+		//인덱스를 고정하고 끝점 보정.
+		const int iterations = quality == BCQuality::Fast ? 0 : quality == BCQuality::Normal ? 2 : 4;
+		for (int iter = 0; iter < iterations && best.Error > 0; iter++)
+		{
+			const float fourWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+			const float threeWeights[4] = { 0.0f, 1.0f, 0.5f, 0.0f };
+			const float* weightTable = best.FourColor ? fourWeights : threeWeights;
+
+			float weights[16];
+			for (int i = 0; i < count; i++)
+				weights[i] = weightTable[(best.Indices >> (2 * pointPixel[i])) & 3];
+
+			if (!SolveEndpoints(points, weights, count, 3, ends))
+				break;
+
+			const std::uint32_t previous = best.Error;
+			QuantizeColor(ends[0], q0);
+			QuantizeColor(ends[1], q1);
+			EvaluateColor(px, transparent, q0, q1, best.FourColor, forceFourColor, best);
+			if (best.Error >= previous)
+				break;
+		}
+
+		if (quality != BCQuality::High)
+			return;
+
+		//끝점 성분을 하나씩 +-1 해 보며 나아지는 동안 반복.
+		const int maxQ[3] = { 31, 63, 31 };
+		for (int pass = 0; pass < 8 && best.Error > 0; pass++)
+		{
+			bool improved = false;
+			for (int e = 0; e < 2; e++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					for (int d = -1; d <= 1; d += 2)
+					{
+						Unpack565(best.C0, q0);
+						Unpack565(best.C1, q1);
+						int* q = e == 0 ? q0 : q1;
+						q[c] += d;
+						if (q[c] < 0 || q[c] > maxQ[c])
+							continue;
+
+						const std::uint32_t previous = best.Error;
+						EvaluateColor(px, transparent, q0, q1, best.FourColor, forceFourColor, best);
+						improved |= best.Error < previous;
+					}
+				}
+			}
+			if (!improved)
+				break;
+		}
+	}
+
+	void EncodeColorBlock(const BlockPixels& px, bool forceFourColor, BCQuality quality, std::uint8_t* out)
+	{
+		//BC1: 알파 < 128 은 투명 픽셀로 보고 3색 모드만 쓴다.
+		bool transparent[16] = {};
+		bool hasTransparent = false;
+		if (!forceFourColor)
+		{
+			for (int i = 0; i < 16; i++)
+			{
+				transparent[i] = px[i][3] < 128;
+				hasTransparent |= transparent[i];
+			}
+		}
+
+		ColorResult best;
+		if (hasTransparent)
+		{
+			EncodeColorMode(px, transparent, false, false, quality, best);
+		}
+		else
+		{
+			EncodeColorMode(px, nullptr, true, forceFourColor, quality, best);
+			if (quality == BCQuality::High && !forceFourColor && best.Error > 0)
+			{
+				ColorResult threeColor;
+				EncodeColorMode(px, nullptr, false, false, quality, threeColor);
+				if (threeColor.Error < best.Error)
+					best = threeColor;
+			}
+		}
+
+		out[0] = static_cast<std::uint8_t>(best.C0);
+		out[1] = static_cast<std::uint8_t>(best.C0 >> 8);
+		out[2] = static_cast<std::uint8_t>(best.C1);
+		out[3] = static_cast<std::uint8_t>(best.C1 >> 8);
+		std::memcpy(out + 4, &best.Indices, 4);
+	}
+
+	//----------------------------------------------------------------------------
+	// BC4 채널 블록 (BC3 알파, BC5 포함)
+	//----------------------------------------------------------------------------
+
+	struct ChannelResult
+	{
+		int A0 = 0;
+		int A1 = 0;
+		std::uint8_t Indices[16] = {};
+		std::uint32_t Error = UINT_MAX;
+	};
+
+	//a0 > a1 이면 8값 보간, 아니면 6값 보간 + 0/255.
+	void EvaluateChannel(const int values[16], int a0, int a1, ChannelResult& best)
+	{
+		int palette[8];
+		palette[0] = a0;
+		palette[1] = a1;
+		if (a0 > a1)
+		{
+			for (int i = 1; i < 7; i++)
+				palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+		}
+		else
+		{
+			for (int i = 1; i < 5; i++)
+				palette[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		ChannelResult result;
+		result.A0 = a0;
+		result.A1 = a1;
+		result.Error = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			int bestError = INT_MAX;
+			for (int k = 0; k < 8; k++)
+			{
+				const int d = palette[k] - values[i];
+				if (d * d < bestError)
+				{
+					bestError = d * d;
+					result.Indices[i] = static_cast<std::uint8_t>(k);
+				}
+			}
+			result.Error += bestError;
+			if (result.Error >= best.Error)
+				return;
+		}
+
+		best = result;
+	}
+
+	//(a0, a1)을 +-1씩 움직여 보며 나아지는 동안 반복. 모드(a0 > a1 여부)는 유지.
+	void RefineChannel(const int values[16], ChannelResult& best)
+	{
+		const bool eightValues = best.A0 > best.A1;
+		for (int pass = 0; pass < 16 && best.Error > 0; pass++)
+		{
+			bool improved = false;
+			for (int e = 0; e < 2; e++)
+			{
+				for (int d = -1; d <= 1; d += 2)
+				{
+					int a0 = best.A0 + (e == 0 ? d : 0);
+					int a1 = best.A1 + (e == 1 ? d : 0);
+					if (a0 < 0 || a0 > 255 || a1 < 0 || a1 > 255 || (a0 > a1) != eightValues)
+						continue;
+
+					const std::uint32_t previous = best.Error;
+					EvaluateChannel(values, a0, a1, best);
+					improved |= best.Error < previous;
+				}
+			}
+			if (!improved)
+				break;
+		}
+	}
+
+	void EncodeChannelBlock(const int values[16], BCQuality quality, std::uint8_t* out)
+	{
+		int minValue = 255, maxValue = 0;
+		int minInner = 255, maxInner = 0;	//0, 255를 뺀 범위 (6값 모드용)
+		for (int i = 0; i < 16; i++)
+		{
+			minValue = (std::min)(minValue, values[i]);
+			maxValue = (std::max)(maxValue, values[i]);
+			if (values[i] != 0 && values[i] != 255)
+			{
+				minInner = (std::min)(minInner, values[i]);
+				maxInner = (std::max)(maxInner, values[i]);
+			}
+		}
+
+		ChannelResult best;
+		EvaluateChannel(values, maxValue, minValue, best);
+		if (quality == BCQuality::High)
+			RefineChannel(values, best);
+
+		if (quality != BCQuality::Fast && best.Error > 0)
+		{
+			ChannelResult sixValues;
+			if (minInner > maxInner)
+				minInner = maxInner = 0;
+			EvaluateChannel(values, minInner, maxInner, sixValues);
+			if (quality == BCQuality::High)
+				RefineChannel(values, sixValues);
+			if (sixValues.Error < best.Error)
+				best = sixValues;
+		}
+
+		out[0] = static_cast<std::uint8_t>(best.A0);
+		out[1] = static_cast<std::uint8_t>(best.A1);
+
+		std::uint64_t bits = 0;
+		for (int i = 0; i < 16; i++)
+			bits |= std::uint64_t(best.Indices[i]) << (3 * i);
+		for (int i = 0; i < 6; i++)
+			out[2 + i] = static_cast<std::uint8_t>(bits >> (8 * i));
+	}
+
+	//----------------------------------------------------------------------------
+	// BC7
+	//----------------------------------------------------------------------------
+
+	enum class PBitMode { None, Endpoint, Shared };
+
+	struct Bc7SubsetParams
+	{
+		int Channels;
+		int Bits[4];		//채널별 끝점 비트 (P비트 제외)
+		PBitMode PBits;
+		int IndexBits;
+		int Iterations;
+	};
+
+	struct Bc7SubsetResult
+	{
+		int Q[2][4] = {};	//양자화된 끝점
+		int P[2] = {};		//P비트
+		std::uint8_t Indices[16] = {};
+		std::uint32_t Error = UINT_MAX;
+	};
+
+	//블록 하나의 모든 필드. Bc7Pack()이 비트로 옮긴다.
+	struct Bc7Block
+	{
+		int Mode = 6;
+		int Partition = 0;
+		int Q[3][2][4] = {};
+		int P[3][2] = {};
+		std::uint8_t Indices[16] = {};
+		std::uint8_t Indices2[16] = {};	//모드 5의 알파 인덱스
+		std::uint32_t Error = UINT_MAX;
+	};
+
+	inline int ExpandBits(int x, int bits)
+	{
+		const int v = x << (8 - bits);
+		return v | (v >> bits);
+	}
+
+	//v에 가장 가까운 bits 비트 값. pbit >= 0 이면 (q << 1 | pbit)를 bits + 1 비트로 확장한 값 기준.
+	int QuantizeChannel(float v, int bits, int pbit)
+	{
+		const int totalBits = bits + (pbit >= 0 ? 1 : 0);
+		const int maxQ = (1 << bits) - 1;
+		const float scaled = v * ((1 << totalBits) - 1) / 255.0f;
+		const int guess = pbit >= 0 ? static_cast<int>((scaled - pbit) * 0.5f + 0.5f) : static_cast<int>(scaled + 0.5f);
+
+		int best = 0;
+		float bestError = 1e30f;
+		for (int q = (std::max)(0, guess - 1); q <= (std::min)(maxQ, guess + 1); q++)
+		{
+			const int x = pbit >= 0 ? (q << 1) | pbit : q;
+			const float error = std::fabs(ExpandBits(x, totalBits) - v);
+			if (error < bestError)
+			{
+				bestError = error;
+				best = q;
+			}
+		}
+		return best;
+	}
+
+	void EvaluateBc7Subset(const int (*values)[4], int count, const Bc7SubsetParams& params, Bc7SubsetResult& result, std::uint32_t bestError)
+	{
+		const bool hasPBit = params.PBits != PBitMode::None;
+		int ends[2][4];
+		for (int e = 0; e < 2; e++)
+		{
+			for (int c = 0; c < params.Channels; c++)
+			{
+				const int bits = params.Bits[c] + (hasPBit ? 1 : 0);
+				const int x = hasPBit ? (result.Q[e][c] << 1) | result.P[e] : result.Q[e][c];
+				ends[e][c] = ExpandBits(x, bits);
+			}
+		}
+
+		const int levels = 1 << params.IndexBits;
+		const std::uint8_t* weights = BC7::Weights(params.IndexBits);
+		int palette[16][4];
+		for (int k = 0; k < levels; k++)
+		{
+			for (int c = 0; c < params.Channels; c++)
+				palette[k][c] = static_cast<int>(BC7::Interpolate(ends[0][c], ends[1][c], weights[k]));
+		}
+
+		result.Error = 0;
+		for (int i = 0; i < count; i++)
+		{
+			int best = INT_MAX;
+			for (int k = 0; k < levels; k++)
+			{
+				int error = 0;
+				for (int c = 0; c < params.Channels; c++)
+				{
+					const int d = palette[k][c] - values[i][c];
+					error += d * d;
+				}
+				if (error < best)
+				{
+					best = error;
+					result.Indices[i] = static_cast<std::uint8_t>(k);
+				}
+			}
+			result.Error += best;
+			if (result.Error >= bestError)
+				return;
+		}
+	}
+
+	//서브셋 하나: 주축 끝점 -> (P비트 조합별) 양자화 -> 인덱스 고정 최소제곱 보정 반복.
+	void EncodeBc7Subset(const int (*values)[4], int count, const Bc7SubsetParams& params, Bc7SubsetResult& best)
+	{
+		float points[16][4];
+		for (int i = 0; i < count; i++)
+		{
+			for (int c = 0; c < 4; c++)
+				points[i][c] = static_cast<float>(values[i][c]);
+		}
+
+		static constexpr int kNoPBit[1][2] = { { -1, -1 } };
+		static constexpr int kEndpointPBits[4][2] = { { 0, 0 }, { 0, 1 }, { 1, 0 }, { 1, 1 } };
+		static constexpr int kSharedPBits[2][2] = { { 0, 0 }, { 1, 1 } };
+
+		const int (*combos)[2] = params.PBits == PBitMode::Endpoint ? kEndpointPBits : params.PBits == PBitMode::Shared ? kSharedPBits : kNoPBit;
+		const int comboCount = params.PBits == PBitMode::Endpoint ? 4 : params.PBits == PBitMode::Shared ? 2 : 1;
+
+		auto tryEndpoints = [&](const float ends[2][4])
+		{
+			for (int k = 0; k < comboCount; k++)
+			{
+				Bc7SubsetResult result;
+				for (int e = 0; e < 2; e++)
+				{
+					result.P[e] = (std::max)(0, combos[k][e]);
+					for (int c = 0; c < params.Channels; c++)
+						result.Q[e][c] = QuantizeChannel(ends[e][c], params.Bits[c], combos[k][e]);
+				}
+
+				EvaluateBc7Subset(values, count, params, result, best.Error);
+				if (result.Error < best.Error)
+					best = result;
+			}
+		};
+
+		float ends[2][4];
+		AxisEndpoints(points, count, params.Channels, ends);
+		tryEndpoints(ends);
+
+		const std::uint8_t* weightTable = BC7::Weights(params.IndexBits);
+		for (int iter = 0; iter < params.Iterations && best.Error > 0; iter++)
+		{
+			float weights[16];
+			for (int i = 0; i < count; i++)
+				weights[i] = weightTable[best.Indices[i]] / 64.0f;
+
+			if (!SolveEndpoints(points, weights, count, params.Channels, ends))
+				break;
+
+			const std::uint32_t previous = best.Error;
+			tryEndpoints(ends);
+			if (best.Error >= previous)
+				break;
+		}
+	}
+
+	//모든 채널이 한 인덱스를 쓰는 모드. (1, 3, 6, 7)
+	void EncodeBc7Shared(const BlockPixels& px, int modeIndex, int partition, int channels, int iterations, Bc7Block& best)
+	{
+		const BC7::Mode& mode = BC7::Modes[modeIndex];
+
+		Bc7SubsetParams params = {};
+		params.Channels = channels;
+		params.Bits[0] = params.Bits[1] = params.Bits[2] = mode.ColorBits;
+		params.Bits[3] = mode.AlphaBits;
+		params.PBits = mode.EndpointPBits ? PBitMode::Endpoint : mode.SharedPBits ? PBitMode::Shared : PBitMode::None;
+		params.IndexBits = mode.IndexBits;
+		params.Iterations = iterations;
+
+		Bc7Block block;
+		block.Mode = modeIndex;
+		block.Partition = partition;
+		block.Error = 0;
+		for (int s = 0; s < mode.Subsets; s++)
+		{
+			int values[16][4];
+			int pixels[16];
+			int count = 0;
+			for (int i = 0; i < 16; i++)
+			{
+				if (BC7::Subset(mode.Subsets, partition, i) != std::uint32_t(s))
+					continue;
+				std::memcpy(values[count], px[i], sizeof(values[count]));
+				pixels[count++] = i;
+			}
+
+			Bc7SubsetResult result;
+			EncodeBc7Subset(values, count, params, result);
+
+			std::memcpy(block.Q[s], result.Q, sizeof(result.Q));
+			std::memcpy(block.P[s], result.P, sizeof(result.P));
+			for (int i = 0; i < count; i++)
+				block.Indices[pixels[i]] = result.Indices[i];
+
+			block.Error += result.Error;
+			if (block.Error >= best.Error)
+				return;
+		}
+
+		best = block;
+	}
+
+	//모드 5: 색(7비트, 인덱스 2비트)과 알파(8비트, 인덱스 2비트)를 따로. 회전은 쓰지 않는다.
+	void EncodeBc7Mode5(const BlockPixels& px, int iterations, Bc7Block& best)
+	{
+		const Bc7SubsetParams colorParams = { 3, { 7, 7, 7, 0 }, PBitMode::None, 2, iterations };
+		const Bc7SubsetParams alphaParams = { 1, { 8, 0, 0, 0 }, PBitMode::None, 2, iterations };
+
+		int alphaValues[16][4] = {};
+		for (int i = 0; i < 16; i++)
+			alphaValues[i][0] = px[i][3];
+
+		Bc7SubsetResult color, alpha;
+		EncodeBc7Subset(px, 16, colorParams, color);
+		EncodeBc7Subset(alphaValues, 16, alphaParams, alpha);
+
+		Bc7Block block;
+		block.Mode = 5;
+		block.Error = color.Error + alpha.Error;
+		if (block.Error >= best.Error)
+			return;
+
+		for (int e = 0; e < 2; e++)
+		{
+			for (int c = 0; c < 3; c++)
+				block.Q[0][e][c] = color.Q[e][c];
+			block.Q[0][e][3] = alpha.Q[e][0];
+		}
+		std::memcpy(block.Indices, color.Indices, sizeof(block.Indices));
+		std::memcpy(block.Indices2, alpha.Indices, sizeof(block.Indices2));
+
+		best = block;
+	}
+
+	//128비트 블록에 LSB부터 쓴다.
+	struct Bc7BitWriter
+	{
+		std::uint8_t* Out;
+		std::uint32_t Pos = 0;
+
+		void Write(std::uint32_t value, std::uint32_t count)
+		{
+			for (std::uint32_t i = 0; i < count; i++, Pos++)
+				Out[Pos >> 3] |= static_cast<std::uint8_t>(((value >> i) & 1) << (Pos & 7));
+		}
+	};
+
+	void Bc7Pack(Bc7Block& block, std::uint8_t out[16])
+	{
+		const BC7::Mode& mode = BC7::Modes[block.Mode];
+		const std::uint32_t indexBits = mode.IndexBits;
+		const std::uint32_t indexBits2 = mode.IndexBits2;
+
+		//고정 픽셀 인덱스의 최상위 비트가 1이면 끝점을 바꾸고 인덱스를 뒤집는다. (비트 하나 절약)
+		const int sharedChannels = indexBits2 ? 3 : 4;
+		for (std::uint32_t s = 0; s < mode.Subsets; s++)
+		{
+			const std::uint32_t anchor = BC7::Anchor(mode.Subsets, block.Partition, s);
+			if (!(block.Indices[anchor] >> (indexBits - 1)))
+				continue;
+
+			for (int c = 0; c < sharedChannels; c++)
+				std::swap(block.Q[s][0][c], block.Q[s][1][c]);
+			std::swap(block.P[s][0], block.P[s][1]);
+			for (std::uint32_t i = 0; i < 16; i++)
+			{
+				if (BC7::Subset(mode.Subsets, block.Partition, i) == s)
+					block.Indices[i] = static_cast<std::uint8_t>((1u << indexBits) - 1 - block.Indices[i]);
+			}
+		}
+		if (indexBits2 && (block.Indices2[0] >> (indexBits2 - 1)))
+		{
+			std::swap(block.Q[0][0][3], block.Q[0][1][3]);
+			for (std::uint32_t i = 0; i < 16; i++)
+				block.Indices2[i] = static_cast<std::uint8_t>((1u << indexBits2) - 1 - block.Indices2[i]);
+		}
+
+		std::memset(out, 0, 16);
+		Bc7BitWriter writer = { out };
+		writer.Write(1u << block.Mode, block.Mode + 1);
+		writer.Write(block.Partition, mode.PartitionBits);
+		writer.Write(0, mode.RotationBits);
+		writer.Write(0, mode.IndexSelectionBits);
+
+		for (int c = 0; c < 3; c++)
+		{
+			for (std::uint32_t s = 0; s < mode.Subsets; s++)
+			{
+				writer.Write(block.Q[s][0][c], mode.ColorBits);
+				writer.Write(block.Q[s][1][c], mode.ColorBits);
+			}
+		}
+		if (mode.AlphaBits)
+		{
+			for (std::uint32_t s = 0; s < mode.Subsets; s++)
+			{
+				writer.Write(block.Q[s][0][3], mode.AlphaBits);
+				writer.Write(block.Q[s][1][3], mode.AlphaBits);
+			}
+		}
+
+		for (std::uint32_t s = 0; s < mode.Subsets; s++)
+		{
+			if (mode.EndpointPBits)
+			{
+				writer.Write(block.P[s][0], 1);
+				writer.Write(block.P[s][1], 1);
+			}
+			else if (mode.SharedPBits)
+			{
+				writer.Write(block.P[s][0], 1);
+			}
+		}
+
+		for (std::uint32_t i = 0; i < 16; i++)
+		{
+			const std::uint32_t s = BC7::Subset(mode.Subsets, block.Partition, i);
+			const bool anchor = i == BC7::Anchor(mode.Subsets, block.Partition, s);
+			writer.Write(block.Indices[i], indexBits - (anchor ? 1 : 0));
+		}
+		if (indexBits2)
+		{
+			for (std::uint32_t i = 0; i < 16; i++)
+				writer.Write(block.Indices2[i], indexBits2 - (i == 0 ? 1 : 0));
+		}
+	}
+
+	//2서브셋 파티션 중 각 서브셋이 직선에 가장 잘 맞는 count개.
+	int SelectBc7Partitions(const BlockPixels& px, int channels, int count, int outPartitions[64])
+	{
+		float points[16][4];
+		for (int i = 0; i < 16; i++)
+		{
+			for (int c = 0; c < 4; c++)
+				points[i][c] = static_cast<float>(px[i][c]);
+		}
+
+		std::pair<float, int> scores[64];
+		for (int p = 0; p < 64; p++)
+		{
+			float subsetPoints[2][16][4];
+			int subsetCount[2] = {};
+			for (int i = 0; i < 16; i++)
+			{
+				const std::uint32_t s = BC7::Subset(2, p, i);
+				std::memcpy(subsetPoints[s][subsetCount[s]++], points[i], sizeof(points[i]));
+			}
+			scores[p] = { LineResidual(subsetPoints[0], subsetCount[0], channels) + LineResidual(subsetPoints[1], subsetCount[1], channels), p };
+		}
+
+		std::partial_sort(scores, scores + count, scores + 64);
+		for (int i = 0; i < count; i++)
+			outPartitions[i] = scores[i].second;
+		return count;
+	}
+
+	void EncodeBC7Block(const BlockPixels& px, BCQuality quality, std::uint8_t* out)
+	{
+		bool opaque = true;
+		for (int i = 0; i < 16; i++)
+			opaque &= px[i][3] == 255;
+
+		const int iterations = quality == BCQuality::Fast ? 0 : quality == BCQuality::Normal ? 1 : 3;
+
+		Bc7Block best;
+		EncodeBc7Shared(px, 6, 0, 4, iterations, best);
+
+		if (quality != BCQuality::Fast && best.Error > 0)
+		{
+			if (!opaque)
+				EncodeBc7Mode5(px, iterations, best);
+
+			//2서브셋 모드는 주축 잔차가 작은 파티션 몇 개만 실제로 인코딩해 본다.
+			const int channels = opaque ? 3 : 4;
+			int partitions[64];
+			const int partitionCount = SelectBc7Partitions(px, channels, quality == BCQuality::High ? 16 : 4, partitions);
+			for (int k = 0; k < partitionCount && best.Error > 0; k++)
+			{
+				if (opaque)
+				{
+					EncodeBc7Shared(px, 1, partitions[k], channels, iterations, best);
+					EncodeBc7Shared(px, 3, partitions[k], channels, iterations, best);
+				}
+				else
+				{
+					EncodeBc7Shared(px, 7, partitions[k], channels, iterations, best);
+				}
+			}
+		}
+
+		Bc7Pack(best, out);
+	}
+
+	//----------------------------------------------------------------------------
+
+	void EncodeBlockPixels(BCFormat format, BCQuality quality, const BlockPixels& px, std::uint8_t* out)
+	{
+		switch (format)
+		{
+		case BCFormat::BC1:
+			EncodeColorBlock(px, false, quality, out);
+			break;
+		case BCFormat::BC2:
+		{
+			//4비트 명시 알파. (반올림)
+			for (int i = 0; i < 8; i++)
+			{
+				const int lo = (px[2 * i][3] * 15 + 127) / 255;
+				const int hi = (px[2 * i + 1][3] * 15 + 127) / 255;
+				out[i] = static_cast<std::uint8_t>(lo | (hi << 4));
+			}
+			EncodeColorBlock(px, true, quality, out + 8);
+			break;
+		}
+		case BCFormat::BC3:
+		{
+			int alpha[16];
+			for (int i = 0; i < 16; i++)
+				alpha[i] = px[i][3];
+			EncodeChannelBlock(alpha, quality, out);
+			EncodeColorBlock(px, true, quality, out + 8);
+			break;
+		}
+		case BCFormat::BC4:
+		case BCFormat::BC5:
+		{
+			const int channels = format == BCFormat::BC4 ? 1 : 2;
+			for (int c = 0; c < channels; c++)
+			{
+				int values[16];
+				for (int i = 0; i < 16; i++)
+					values[i] = px[i][c];
+				EncodeChannelBlock(values, quality, out + 8 * c);
+			}
+			break;
+		}
+		case BCFormat::BC7:
+			EncodeBC7Block(px, quality, out);
+			break;
+		}
+	}
+}
+
+void BCEncoder::EncodeBlock(BCFormat format, BCQuality quality, const std::uint8_t* rgba, std::size_t rowPitch, std::uint8_t* outBlock)
+{
+	BlockPixels px;
+	for (int y = 0; y < 4; y++)
+	{
+		for (int x = 0; x < 4; x++)
+		{
+			for (int c = 0; c < 4; c++)
+				px[y * 4 + x][c] = rgba[y * rowPitch + x * 4 + c];
+		}
+	}
+	EncodeBlockPixels(format, quality, px, outBlock);
+}
+
+bool BCEncoder::Encode(BCFormat format, BCQuality quality, const void* rgba, std::uint32_t width, std::uint32_t height, std::size_t srcRowPitch,
+	void* dst, std::size_t dstSize, std::size_t dstRowPitch)
+{
+	if (!rgba || !dst || width == 0 || height == 0 || srcRowPitch < std::size_t(width) * 4)
+		return false;
+
+	const std::size_t blockBytes = BCDecoder::BlockBytes(format);
+	const std::size_t blocksWide = (width + 3) / 4;
+	const std::size_t blocksHigh = (height + 3) / 4;
+
+	if (dstRowPitch == 0)
+		dstRowPitch = blocksWide * blockBytes;
+	if (dstRowPitch < blocksWide * blockBytes || dstRowPitch * (blocksHigh - 1) + blocksWide * blockBytes > dstSize)
+		return false;
+
+	const std::uint8_t* srcBytes = static_cast<const std::uint8_t*>(rgba);
+	std::uint8_t* dstBytes = static_cast<std::uint8_t*>(dst);
+
+	const std::size_t rowsPerChunk = (std::max)(std::size_t(1), kMinChunkBlocks / blocksWide);
+	const std::size_t chunkCount = (blocksHigh + rowsPerChunk - 1) / rowsPerChunk;
+
+	concurrency::parallel_for(std::size_t(0), chunkCount, [&](std::size_t chunk)
+		{
+			const std::size_t rowEnd = (std::min)(blocksHigh, (chunk + 1) * rowsPerChunk);
+			for (std::size_t by = chunk * rowsPerChunk; by < rowEnd; by++)
+			{
+				std::uint8_t* out = dstBytes + by * dstRowPitch;
+				for (std::size_t bx = 0; bx < blocksWide; bx++, out += blockBytes)
+				{
+					//가장자리는 이미지 끝 픽셀 반복.
+					BlockPixels px;
+					for (std::size_t y = 0; y < 4; y++)
+					{
+						const std::size_t sy = (std::min)(by * 4 + y, std::size_t(height) - 1);
+						for (std::size_t x = 0; x < 4; x++)
+						{
+							const std::size_t sx = (std::min)(bx * 4 + x, std::size_t(width) - 1);
+							const std::uint8_t* p = srcBytes + sy * srcRowPitch + sx * 4;
+							for (int c = 0; c < 4; c++)
+								px[y * 4 + x][c] = p[c];
+						}
+					}
+					EncodeBlockPixels(format, quality, px, out);
+				}
+			}
+		});
+
+	return true;
+}
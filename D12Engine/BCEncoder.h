@@ -0,0 +1,41 @@
+﻿#pragma once
+
+#include "BCDecoder.h"
+
+enum class BCQuality : std::uint8_t
+{
+	Fast,	//주축 끝점만. BC7은 모드 6만.
+	Normal,	//최소제곱 끝점 보정 + BC7 2서브셋 모드 (파티션 후보 4개)
+	High,	//보정 반복 + BC1 3색/BC4 6값 모드 비교, 끝점 미세 탐색 + BC7 파티션 후보 16개
+};
+
+/*
+	RGBA8 -> BC 블록 인코더. (오프라인 텍스처 변환용, Tools/TextureConverter)
+
+	- 입력은 항상 RGBA8. BC4는 R, BC5는 RG만 사용.
+	- BC1은 알파 < 128 인 픽셀이 있으면 3색 모드로 인코딩. (인덱스 3 = 투명)
+	- BC7은 모드 6(1서브셋 RGBA)을 기본으로, Normal 이상에서 불투명 블록은 모드 1/3,
+	  알파가 있는 블록은 모드 5/7도 시도해서 오차가 가장 작은 것을 고른다. (3서브셋 모드 0/2, 모드 4는 쓰지 않음)
+	- 오차는 BCDecoder와 같은 정수 보간으로 계산한다. (실제 디코딩 결과 기준)
+	- 이미지 인코딩은 블록 행 묶음 단위로 PPL 병렬 처리.
+*/
+class BCEncoder
+{
+public:
+	//4x4 RGBA8 (행 간격 rowPitch 바이트) -> 블록 하나. (BCDecoder::BlockBytes 바이트)
+	static void EncodeBlock(BCFormat format, BCQuality quality, const std::uint8_t* rgba, std::size_t rowPitch, std::uint8_t* outBlock);
+
+	/*
+		width x height RGBA8 이미지 전체 인코딩.
+		dstRowPitch: 블록 한 행의 바이트 수. 0이면 빈틈없이 붙여 쓴다.
+		4의 배수가 아닌 가장자리 블록은 이미지 끝 픽셀을 반복해서 채운다. dst가 모자라면 false.
+	*/
+	static bool Encode(BCFormat format, BCQuality quality, const void* rgba, std::uint32_t width, std::uint32_t height, std::size_t srcRowPitch,
+		void* dst, std::size_t dstSize, std::size_t dstRowPitch = 0);
+
+	//빈틈없이 붙여 쓸 때의 바이트 수.
+	static std::size_t EncodedSize(BCFormat format, std::uint32_t width, std::uint32_t height)
+	{
+		return std::size_t((width + 3) / 4) * ((height + 3) / 4) * BCDecoder::BlockBytes(format);
+	}
+};
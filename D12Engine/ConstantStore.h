@@ -0,0 +1,135 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*
+	상수 데이터의 CPU 사본 + 프레임 리소스별 변경 비트셋.
+
+	Set()/Edit()  : 사본을 고치고 모든 프레임 리소스에 변경 비트를 세운다.
+	Flush(frame)  : 그 프레임 리소스의 비트셋을 64비트 워드 단위로 훑어 세워진 비트만 찾는다.
+	                연속으로 바뀐 원소는 묶어서 copyRange(first, data, count)를 한 번 부르고 비트를 지운다.
+	비용은 원소 수가 아니라 바뀐 원소 수(와 비트셋 워드 수)에 비례한다. GPU 버퍼는 모르므로 어디서나 테스트 가능.
+*/
+template<typename T>
+class ConstantStore
+{
+public:
+	ConstantStore() = default;
+	ConstantStore(std::size_t count, std::size_t frameCount) { Reset(count, frameCount); }
+
+	//사본을 기본값으로 채우고 모든 원소를 변경 상태로. (count가 0이어도 된다)
+	void Reset(std::size_t count, std::size_t frameCount)
+	{
+		mShadow.assign(count, T());
+		mWordCount = (count + 63) / 64;
+		mFrameCount = frameCount;
+		mDirty.assign(mWordCount * frameCount, 0);
+		MarkAllDirty();
+	}
+
+	std::size_t Count()const { return mShadow.size(); }
+	const T& Get(std::size_t index)const { return mShadow[index]; }
+
+	void Set(std::size_t index, const T& value)
+	{
+		mShadow[index] = value;
+		MarkDirty(index);
+	}
+
+	//고칠 원소의 참조. 부르기만 해도 변경으로 본다.
+	T& Edit(std::size_t index)
+	{
+		MarkDirty(index);
+		return mShadow[index];
+	}
+
+	void MarkDirty(std::size_t index)
+	{
+		const std::uint64_t bit = 1ull << (index & 63);
+		for (std::size_t frame = 0; frame < mFrameCount; frame++)
+			mDirty[frame * mWordCount + index / 64] |= bit;
+	}
+
+	void MarkAllDirty()
+	{
+		for (std::size_t frame = 0; frame < mFrameCount; frame++)
+		{
+			std::uint64_t* words = mDirty.data() + frame * mWordCount;
+			std::fill(words, words + mWordCount, ~0ull);
+			//마지막 워드의 범위 밖 비트는 비워 둔다.
+			if (mShadow.size() & 63)
+				words[mWordCount - 1] = (1ull << (mShadow.size() & 63)) - 1;
+		}
+	}
+
+	//copyRange(std::size_t first, const T* data, std::size_t count). 복사한 원소 수를 반환.
+	template<typename CopyRangeFn>
+	std::size_t Flush(std::size_t frame, CopyRangeFn&& copyRange)
+	{
+		std::uint64_t* words = mDirty.data() + frame * mWordCount;
+		std::size_t copied = 0;
+
+		std::size_t w = 0;
+		while (w < mWordCount)
+		{
+			if (words[w] == 0)
+			{
+				w++;
+				continue;
+			}
+
+			//연속된 변경 구간 [first, last)를 찾는다. 워드 경계를 넘어 이어질 수 있다.
+			const std::size_t first = w * 64 + CountTrailingZeros(words[w]);
+			std::size_t lastWord = w;
+			std::uint64_t clean = ~words[w] & (~0ull << (first & 63));
+			while (clean == 0 && ++lastWord < mWordCount)
+				clean = ~words[lastWord];
+			const std::size_t last = lastWord < mWordCount ? lastWord * 64 + CountTrailingZeros(clean) : mWordCount * 64;
+
+			copyRange(first, &mShadow[first], last - first);
+			copied += last - first;
+
+			//[first, last) 비트 지우기.
+			for (std::size_t i = first / 64; i * 64 < last; i++)
+			{
+				const std::size_t begin = (std::max)(first, i * 64) - i * 64;
+				const std::size_t end = (std::min)(last, i * 64 + 64) - i * 64;
+				const std::uint64_t mask = (end == 64 ? ~0ull : (1ull << end) - 1) & ~((1ull << begin) - 1);
+				words[i] &= ~mask;
+			}
+			w = last / 64;
+		}
+		return copied;
+	}
+
+	//frame 프레임 리소스에 아직 반영되지 않은 원소가 있는가.
+	bool IsDirty(std::size_t frame)const
+	{
+		const std::uint64_t* words = mDirty.data() + frame * mWordCount;
+		return std::any_of(words, words + mWordCount, [](std::uint64_t word) { return word != 0; });
+	}
+
+private:
+	static std::uint32_t CountTrailingZeros(std::uint64_t v)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward64(&index, v);
+		return index;
+#else
+		return static_cast<std::uint32_t>(__builtin_ctzll(v));
+#endif
+	}
+
+private:
+	std::vector<T> mShadow;
+	std::vector<std::uint64_t> mDirty;	//프레임 리소스마다 mWordCount개
+	std::size_t mWordCount = 0;
+	std::size_t mFrameCount = 0;
+};
@@ -24,6 +24,11 @@
 #include <wrl.h>
 
 #include "DDSTextureLoader.h" 
+#include "AssetCache.h"
+#include "MappedFile.h"
+#include <fstream>
+#include <string>
+#include <vector>
 
 using namespace Microsoft::WRL;
 
@@ -124,12 +129,6 @@ struct DDS_HEADER_DXT10
 namespace
 {
 
-struct handle_closer { void operator()(HANDLE h) { if (h) CloseHandle(h); } };
-
-typedef public std::unique_ptr<void, handle_closer> ScopedHandle;
-
-inline HANDLE safe_handle( HANDLE h ) { return (h == INVALID_HANDLE_VALUE) ? 0 : h; }
-
 template<UINT TNameLength>
 inline void SetDebugObjectName(_In_ ID3D11DeviceChild* resource, _In_ const char (&name)[TNameLength])
 {
@@ -145,9 +144,9 @@ inline void SetDebugObjectName(_In_ ID3D11DeviceChild* resource, _In_ const char
 
 //--------------------------------------------------------------------------------------
 static HRESULT LoadTextureDataFromFile( _In_z_ const wchar_t* fileName,
-                                        std::unique_ptr<uint8_t[]>& ddsData,
-                                        DDS_HEADER** header,
-                                        uint8_t** bitData,
+                                        MappedFile& ddsFile,
+                                        const DDS_HEADER** header,
+                                        const uint8_t** bitData,
                                         size_t* bitSize
                                       )
 {
@@ -156,86 +155,39 @@ static HRESULT LoadTextureDataFromFile( _In_z_ const wchar_t* fileName,
         return E_POINTER;
     }
 
-    // open the file
-#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
-    ScopedHandle hFile( safe_handle( CreateFile2( fileName,
-                                                  GENERIC_READ,
-                                                  FILE_SHARE_READ,
-                                                  OPEN_EXISTING,
-                                                  nullptr ) ) );
-#else
-    ScopedHandle hFile( safe_handle( CreateFileW( fileName,
-                                                  GENERIC_READ,
-                                                  FILE_SHARE_READ,
-                                                  nullptr,
-                                                  OPEN_EXISTING,
-                                                  FILE_ATTRIBUTE_NORMAL,
-                                                  nullptr ) ) );
-#endif
-
-    if ( !hFile )
+    // Map the file read-only instead of copying it into a heap buffer. The header is parsed
+    // in place and the subresource pointers built by FillInitData point straight into the
+    // mapping, so only the pages the upload actually touches are read from disk.
+    if (!ddsFile.Open( fileName ))
     {
-        return HRESULT_FROM_WIN32( GetLastError() );
+        DWORD error = GetLastError();
+        return error ? HRESULT_FROM_WIN32( error ) : E_FAIL;
     }
 
-    // Get the file size
-    LARGE_INTEGER FileSize = { 0 };
-
-#if (_WIN32_WINNT >= _WIN32_WINNT_VISTA)
-    FILE_STANDARD_INFO fileInfo;
-    if ( !GetFileInformationByHandleEx( hFile.get(), FileStandardInfo, &fileInfo, sizeof(fileInfo) ) )
-    {
-        return HRESULT_FROM_WIN32( GetLastError() );
-    }
-    FileSize = fileInfo.EndOfFile;
-#else
-    GetFileSizeEx( hFile.get(), &FileSize );
-#endif
+    const size_t fileSize = ddsFile.Size();
 
-    // File is too big for 32-bit allocation, so reject read
-    if (FileSize.HighPart > 0)
+    // File is too big for 32-bit subresource pitches, so reject it
+    if (fileSize > UINT32_MAX)
     {
         return E_FAIL;
     }
 
     // Need at least enough data to fill the header and magic number to be a valid DDS
-    if (FileSize.LowPart < ( sizeof(DDS_HEADER) + sizeof(uint32_t) ) )
+    if (fileSize < ( sizeof(DDS_HEADER) + sizeof(uint32_t) ) )
     {
         return E_FAIL;
     }
 
-    // create enough space for the file data
-    ddsData.reset( new (std::nothrow) uint8_t[ FileSize.LowPart ] );
-    if (!ddsData)
-    {
-        return E_OUTOFMEMORY;
-    }
-
-    // read the data in
-    DWORD BytesRead = 0;
-    if (!ReadFile( hFile.get(),
-                   ddsData.get(),
-                   FileSize.LowPart,
-                   &BytesRead,
-                   nullptr
-                 ))
-    {
-        return HRESULT_FROM_WIN32( GetLastError() );
-    }
-
-    if (BytesRead < FileSize.LowPart)
-    {
-        return E_FAIL;
-    }
+    const uint8_t* ddsData = ddsFile.Data();
 
     // DDS files always start with the same magic number ("DDS ")
-    uint32_t dwMagicNumber = *( const uint32_t* )( ddsData.get() );
+    uint32_t dwMagicNumber = *( const uint32_t* )( ddsData );
     if (dwMagicNumber != DDS_MAGIC)
     {
         return E_FAIL;
     }
 
-    auto hdr = reinterpret_cast<DDS_HEADER*>( ddsData.get() + sizeof( uint32_t ) );
+    auto hdr = reinterpret_cast<const DDS_HEADER*>( ddsData + sizeof( uint32_t ) );
 
     // Verify header to validate DDS file
     if (hdr->size != sizeof(DDS_HEADER) ||
@@ -250,7 +202,7 @@ static HRESULT LoadTextureDataFromFile( _In_z_ const wchar_t* fileName,
         (MAKEFOURCC( 'D', 'X', '1', '0' ) == hdr->ddspf.fourCC))
     {
         // Must be long enough for both headers and magic value
-        if (FileSize.LowPart < ( sizeof(DDS_HEADER) + sizeof(uint32_t) + sizeof(DDS_HEADER_DXT10) ) )
+        if (fileSize < ( sizeof(DDS_HEADER) + sizeof(uint32_t) + sizeof(DDS_HEADER_DXT10) ) )
         {
             return E_FAIL;
         }
@@ -262,8 +214,8 @@ static HRESULT LoadTextureDataFromFile( _In_z_ const wchar_t* fileName,
     *header = hdr;
     ptrdiff_t offset = sizeof( uint32_t ) + sizeof( DDS_HEADER )
                        + (bDXT10Header ? sizeof( DDS_HEADER_DXT10 ) : 0);
-    *bitData = ddsData.get() + offset;
-    *bitSize = FileSize.LowPart - offset;
+    *bitData = ddsData + offset;
+    *bitSize = fileSize - offset;
 
     return S_OK;
 }
@@ -1690,7 +1642,8 @@ static HRESULT CreateTextureFromDDS12(
 	_In_ size_t maxsize,
 	_In_ bool forceSRGB,
 	ComPtr<ID3D12Resource>& texture,
-	ComPtr<ID3D12Resource>& textureUploadHeap)
+	ComPtr<ID3D12Resource>& textureUploadHeap,
+	_Out_opt_ std::vector<uint8_t>* trimmedDDS = nullptr)
 {
 	HRESULT hr = S_OK;
 
@@ -1882,6 +1835,40 @@ static HRESULT CreateTextureFromDDS12(
 			textureUploadHeap);
 	}
 
+	// When maxsize dropped top mips, hand back a standalone DDS holding only the kept
+	// subresources so the caller can cache it instead of re-reading the full file.
+	if (SUCCEEDED(hr) && trimmedDDS && skipMip > 0)
+	{
+		const size_t keptMips = mipCount - skipMip;
+		const bool dxt10 = (header->ddspf.flags & DDS_FOURCC) && (MAKEFOURCC('D', 'X', '1', '0') == header->ddspf.fourCC);
+		const size_t headerSize = sizeof(uint32_t) + sizeof(DDS_HEADER) + (dxt10 ? sizeof(DDS_HEADER_DXT10) : 0);
+
+		size_t dataSize = 0;
+		for (size_t k = 0; k < keptMips * arraySize; ++k)
+			dataSize += initData[k].SlicePitch * std::max<size_t>(1, tdepth >> (k % keptMips));
+
+		trimmedDDS->resize(headerSize + dataSize);
+		uint8_t* dst = trimmedDDS->data();
+
+		const uint32_t magic = DDS_MAGIC;
+		memcpy(dst, &magic, sizeof(uint32_t));
+		memcpy(dst + sizeof(uint32_t), header, headerSize - sizeof(uint32_t));
+
+		auto newHeader = reinterpret_cast<DDS_HEADER*>(dst + sizeof(uint32_t));
+		newHeader->width = static_cast<uint32_t>(twidth);
+		newHeader->height = static_cast<uint32_t>(theight);
+		newHeader->depth = (header->flags & DDS_HEADER_FLAGS_VOLUME) ? static_cast<uint32_t>(tdepth) : header->depth;
+		newHeader->mipMapCount = static_cast<uint32_t>(keptMips);
+
+		dst += headerSize;
+		for (size_t k = 0; k < keptMips * arraySize; ++k)
+		{
+			const size_t bytes = initData[k].SlicePitch * std::max<size_t>(1, tdepth >> (k % keptMips));
+			memcpy(dst, initData[k].pData, bytes);
+			dst += bytes;
+		}
+	}
+
 	return hr;
 }
 
@@ -2172,19 +2159,44 @@ HRESULT DirectX::CreateDDSTextureFromFile12(_In_ ID3D12Device* device,
 		return E_INVALIDARG;
 	}
 
-	DDS_HEADER* header = nullptr;
-	uint8_t* bitData = nullptr;
+	// The only derived data here is the mip chain trimmed to maxsize; look it up in the asset cache
+	// so the full-resolution file is not read again on the next run.
+	AssetCache& cache = AssetCache::Default();
+	uint64_t cacheKey = 0;
+	const bool useCache = maxsize != 0 &&
+		cache.MakeKey(szFileName, "dds-trim/1/maxsize=" + std::to_string(maxsize), cacheKey);
+
+	if (useCache)
+	{
+		std::vector<uint8_t> cached;
+		if (cache.Load(cacheKey, cached) &&
+			SUCCEEDED(CreateDDSTextureFromMemory12(device, cmdList, cached.data(), cached.size(),
+				texture, textureUploadHeap, 0, alphaMode)))
+		{
+			return S_OK;
+		}
+	}
+
+	const DDS_HEADER* header = nullptr;
+	const uint8_t* bitData = nullptr;
 	size_t bitSize = 0;
 
-	std::unique_ptr<uint8_t[]> ddsData;
-	HRESULT hr = LoadTextureDataFromFile(szFileName, ddsData, &header, &bitData, &bitSize);
+	MappedFile ddsFile;
+	HRESULT hr = LoadTextureDataFromFile(szFileName, ddsFile, &header, &bitData, &bitSize);
 	if (FAILED(hr))
 	{
 		return hr;
 	}
 
+	std::vector<uint8_t> trimmed;
 	hr = CreateTextureFromDDS12(device, cmdList, header,
-		bitData, bitSize, maxsize, false, texture, textureUploadHeap);
+		bitData, bitSize, maxsize, false, texture, textureUploadHeap,
+		useCache ? &trimmed : nullptr);
+
+	if (SUCCEEDED(hr) && !trimmed.empty())
+	{
+		cache.Store(cacheKey, trimmed.data(), trimmed.size());
+	}
 
 	if (SUCCEEDED(hr))
 	{
@@ -2304,13 +2316,13 @@ HRESULT DirectX::CreateDDSTextureFromFileEx( ID3D11Device* d3dDevice,
         return E_INVALIDARG;
     }
 
-    DDS_HEADER* header = nullptr;
-    uint8_t* bitData = nullptr;
+    const DDS_HEADER* header = nullptr;
+    const uint8_t* bitData = nullptr;
     size_t bitSize = 0;
 
-    std::unique_ptr<uint8_t[]> ddsData;
+    MappedFile ddsFile;
     HRESULT hr = LoadTextureDataFromFile( fileName,
-                                          ddsData,
+                                          ddsFile,
                                           &header,
                                           &bitData,
                                           &bitSize
@@ -2377,3 +2389,220 @@ HRESULT DirectX::CreateDDSTextureFromFileEx( ID3D11Device* d3dDevice,
 
     return hr;
 }
+
+
+//--------------------------------------------------------------------------------------
+// Header-only probe
+//--------------------------------------------------------------------------------------
+static HRESULT ProbeDDSHeader( _In_reads_bytes_(headerSize) const uint8_t* headerData,
+                               _In_ size_t headerSize,
+                               _In_ uint64_t fileSize,
+                               _Out_ DDS_TEXTURE_INFO& info )
+{
+    info = {};
+
+    if (headerSize < sizeof(uint32_t) + sizeof(DDS_HEADER))
+    {
+        return E_FAIL;
+    }
+
+    if (*reinterpret_cast<const uint32_t*>(headerData) != DDS_MAGIC)
+    {
+        return E_FAIL;
+    }
+
+    auto header = reinterpret_cast<const DDS_HEADER*>(headerData + sizeof(uint32_t));
+    if (header->size != sizeof(DDS_HEADER) ||
+        header->ddspf.size != sizeof(DDS_PIXELFORMAT))
+    {
+        return E_FAIL;
+    }
+
+    const bool dxt10 = (header->ddspf.flags & DDS_FOURCC) &&
+                       (MAKEFOURCC('D', 'X', '1', '0') == header->ddspf.fourCC);
+    if (dxt10 && headerSize < sizeof(uint32_t) + sizeof(DDS_HEADER) + sizeof(DDS_HEADER_DXT10))
+    {
+        return E_FAIL;
+    }
+
+    // Same interpretation of the header as CreateTextureFromDDS12
+    uint32_t width = header->width;
+    uint32_t height = header->height;
+    uint32_t depth = header->depth;
+    uint32_t mipCount = (std::max)(header->mipMapCount, 1u);
+    uint32_t arraySize = 1;
+    bool isCubeMap = false;
+    DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+    D3D12_RESOURCE_DIMENSION resDim = D3D12_RESOURCE_DIMENSION_UNKNOWN;
+
+    if (dxt10)
+    {
+        auto d3d10ext = reinterpret_cast<const DDS_HEADER_DXT10*>((const char*)header + sizeof(DDS_HEADER));
+
+        arraySize = d3d10ext->arraySize;
+        if (arraySize == 0)
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+
+        format = d3d10ext->dxgiFormat;
+        if (BitsPerPixel(format) == 0)
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+        switch (d3d10ext->resourceDimension)
+        {
+        case D3D11_RESOURCE_DIMENSION_TEXTURE1D:
+            height = depth = 1;
+            resDim = D3D12_RESOURCE_DIMENSION_TEXTURE1D;
+            break;
+
+        case D3D11_RESOURCE_DIMENSION_TEXTURE2D:
+            if (d3d10ext->miscFlag & D3D11_RESOURCE_MISC_TEXTURECUBE)
+            {
+                arraySize *= 6;
+                isCubeMap = true;
+            }
+            depth = 1;
+            resDim = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+            break;
+
+        case D3D11_RESOURCE_DIMENSION_TEXTURE3D:
+            if (!(header->flags & DDS_HEADER_FLAGS_VOLUME) || arraySize > 1)
+                return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+            resDim = D3D12_RESOURCE_DIMENSION_TEXTURE3D;
+            break;
+
+        default:
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        }
+    }
+    else
+    {
+        format = GetDXGIFormat(header->ddspf);
+        if (format == DXGI_FORMAT_UNKNOWN)
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+        if (header->flags & DDS_HEADER_FLAGS_VOLUME)
+        {
+            resDim = D3D12_RESOURCE_DIMENSION_TEXTURE3D;
+        }
+        else
+        {
+            if (header->caps2 & DDS_CUBEMAP)
+            {
+                if ((header->caps2 & DDS_CUBEMAP_ALLFACES) != DDS_CUBEMAP_ALLFACES)
+                    return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+                arraySize = 6;
+                isCubeMap = true;
+            }
+            depth = 1;
+            resDim = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+        }
+    }
+
+    if (mipCount > D3D12_REQ_MIP_LEVELS || width == 0 || height == 0 || depth == 0)
+    {
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    info.dimension = resDim;
+    info.format = format;
+    info.width = width;
+    info.height = height;
+    info.depth = depth;
+    info.mipCount = mipCount;
+    info.arraySize = arraySize;
+    info.isCubeMap = isCubeMap;
+    info.alphaMode = GetAlphaMode(header);
+    info.headerSize = sizeof(uint32_t) + sizeof(DDS_HEADER) + (dxt10 ? sizeof(DDS_HEADER_DXT10) : 0);
+    info.fileSize = fileSize;
+    info.subresources.resize(size_t(mipCount) * arraySize);
+
+    // Same walk as FillInitData12: every array slice holds its full mip chain in turn
+    uint64_t offset = info.headerSize;
+    size_t index = 0;
+    for (uint32_t j = 0; j < arraySize; ++j)
+    {
+        uint32_t w = width;
+        uint32_t h = height;
+        uint32_t d = depth;
+        for (uint32_t i = 0; i < mipCount; ++i)
+        {
+            size_t numBytes = 0;
+            size_t rowBytes = 0;
+            size_t numRows = 0;
+            GetSurfaceInfo(w, h, format, &numBytes, &rowBytes, &numRows);
+
+            DDS_SUBRESOURCE_LAYOUT& layout = info.subresources[index++];
+            layout.offset = offset;
+            layout.size = uint64_t(numBytes) * d;
+            layout.rowPitch = static_cast<uint32_t>(rowBytes);
+            layout.slicePitch = static_cast<uint32_t>(numBytes);
+            layout.numRows = static_cast<uint32_t>(numRows);
+            layout.width = w;
+            layout.height = h;
+            layout.depth = d;
+
+            offset += layout.size;
+
+            w = (std::max)(w >> 1, 1u);
+            h = (std::max)(h >> 1, 1u);
+            d = (std::max)(d >> 1, 1u);
+        }
+    }
+
+    info.dataSize = offset - info.headerSize;
+    if (offset > fileSize)
+    {
+        return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+    }
+
+    return S_OK;
+}
+
+//--------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::ProbeDDS( const wchar_t* szFileName,
+                           DDS_TEXTURE_INFO& info )
+{
+    info = {};
+
+    if (!szFileName)
+    {
+        return E_INVALIDARG;
+    }
+
+    std::ifstream file(szFileName, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+    }
+
+    const uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+
+    // magic + DDS_HEADER + DDS_HEADER_DXT10 = 148 bytes; the DX10 part is simply absent for legacy files
+    uint8_t headerData[sizeof(uint32_t) + sizeof(DDS_HEADER) + sizeof(DDS_HEADER_DXT10)];
+    const size_t headerSize = static_cast<size_t>((std::min)<uint64_t>(fileSize, sizeof(headerData)));
+
+    file.seekg(0, std::ios::beg);
+    if (!file.read(reinterpret_cast<char*>(headerData), headerSize))
+    {
+        return E_FAIL;
+    }
+
+    return ProbeDDSHeader(headerData, headerSize, fileSize, info);
+}
+
+//--------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::ProbeDDSFromMemory( const uint8_t* ddsData,
+                                     size_t ddsDataSize,
+                                     DDS_TEXTURE_INFO& info )
+{
+    info = {};
+
+    if (!ddsData)
+    {
+        return E_INVALIDARG;
+    }
+
+    return ProbeDDSHeader(ddsData, ddsDataSize, ddsDataSize, info);
+}
@@ -32,6 +32,8 @@
 
 #pragma warning(pop)
 
+#include <vector>
+
 #if defined(_MSC_VER) && (_MSC_VER<1610) && !defined(_In_reads_)
 #define _In_reads_(exp)
 #define _Out_writes_(exp)
@@ -55,6 +57,51 @@ namespace DirectX
         DDS_ALPHA_MODE_CUSTOM        = 4,
     };
 
+    // Placement of one subresource inside a DDS file
+    struct DDS_SUBRESOURCE_LAYOUT
+    {
+        uint64_t offset;        // from the start of the file
+        uint64_t size;          // slicePitch * depth
+        uint32_t rowPitch;
+        uint32_t slicePitch;    // bytes per 2D slice
+        uint32_t numRows;       // rows of blocks for BC formats
+        uint32_t width;
+        uint32_t height;
+        uint32_t depth;
+    };
+
+    // Metadata of a DDS file, filled in from its header alone
+    struct DDS_TEXTURE_INFO
+    {
+        D3D12_RESOURCE_DIMENSION dimension;
+        DXGI_FORMAT format;
+        uint32_t width;
+        uint32_t height;
+        uint32_t depth;
+        uint32_t mipCount;
+        uint32_t arraySize;     // includes the 6 faces of each cube
+        bool isCubeMap;
+        DDS_ALPHA_MODE alphaMode;
+        uint64_t headerSize;    // magic + DDS_HEADER (+ DDS_HEADER_DXT10)
+        uint64_t dataSize;      // sum of all subresource sizes
+        uint64_t fileSize;
+
+        // Indexed like D3D12CalcSubresource(mip, arraySlice, 0, mipCount, arraySize)
+        std::vector<DDS_SUBRESOURCE_LAYOUT> subresources;
+    };
+
+    // Reads only the header of a DDS file (148 bytes at most) and computes the subresource
+    // layout without touching the pixel data. Fails if the file is too short for that layout.
+    HRESULT ProbeDDS( _In_z_ const wchar_t* szFileName,
+                      _Out_ DDS_TEXTURE_INFO& info
+                    );
+
+    // Same as ProbeDDS for a DDS already in memory. ddsDataSize is the size of the whole file.
+    HRESULT ProbeDDSFromMemory( _In_reads_bytes_(ddsDataSize) const uint8_t* ddsData,
+                                _In_ size_t ddsDataSize,
+                                _Out_ DDS_TEXTURE_INFO& info
+                              );
+
     // Standard version
     HRESULT CreateDDSTextureFromMemory( _In_ ID3D11Device* d3dDevice,
                                         _In_reads_bytes_(ddsDataSize) const uint8_t* ddsData,
@@ -0,0 +1,210 @@
+﻿#include "DDSWriter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+	//DDS 헤더. (DDSTextureLoader.cpp의 정의와 같은 배치)
+	struct DdsPixelFormat
+	{
+		std::uint32_t Size;
+		std::uint32_t Flags;
+		std::uint32_t FourCC;
+		std::uint32_t RGBBitCount;
+		std::uint32_t RBitMask;
+		std::uint32_t GBitMask;
+		std::uint32_t BBitMask;
+		std::uint32_t ABitMask;
+	};
+
+	struct DdsHeader
+	{
+		std::uint32_t Size;
+		std::uint32_t Flags;
+		std::uint32_t Height;
+		std::uint32_t Width;
+		std::uint32_t PitchOrLinearSize;
+		std::uint32_t Depth;
+		std::uint32_t MipMapCount;
+		std::uint32_t Reserved1[11];
+		DdsPixelFormat PixelFormat;
+		std::uint32_t Caps;
+		std::uint32_t Caps2;
+		std::uint32_t Caps3;
+		std::uint32_t Caps4;
+		std::uint32_t Reserved2;
+	};
+
+	struct DdsHeaderDxt10
+	{
+		std::uint32_t DxgiFormat;
+		std::uint32_t ResourceDimension;
+		std::uint32_t MiscFlag;
+		std::uint32_t ArraySize;
+		std::uint32_t MiscFlags2;
+	};
+
+	static_assert(sizeof(DdsHeader) == 124, "DDS header size mismatch");
+	static_assert(sizeof(DdsHeaderDxt10) == 20, "DDS DX10 header size mismatch");
+
+	constexpr std::uint32_t MakeFourCC(char a, char b, char c, char d)
+	{
+		return std::uint32_t(std::uint8_t(a)) | (std::uint32_t(std::uint8_t(b)) << 8) |
+			(std::uint32_t(std::uint8_t(c)) << 16) | (std::uint32_t(std::uint8_t(d)) << 24);
+	}
+
+	constexpr std::uint32_t DDS_MAGIC = MakeFourCC('D', 'D', 'S', ' ');
+	constexpr std::uint32_t DDS_FOURCC = 0x00000004;
+	constexpr std::uint32_t DDS_RGBA = 0x00000041;	//DDPF_RGB | DDPF_ALPHAPIXELS
+	constexpr std::uint32_t DDSD_CAPS = 0x00000001;
+	constexpr std::uint32_t DDSD_HEIGHT = 0x00000002;
+	constexpr std::uint32_t DDSD_WIDTH = 0x00000004;
+	constexpr std::uint32_t DDSD_PITCH = 0x00000008;
+	constexpr std::uint32_t DDSD_PIXELFORMAT = 0x00001000;
+	constexpr std::uint32_t DDSD_MIPMAPCOUNT = 0x00020000;
+	constexpr std::uint32_t DDSD_LINEARSIZE = 0x00080000;
+	constexpr std::uint32_t DDSCAPS_COMPLEX = 0x00000008;
+	constexpr std::uint32_t DDSCAPS_TEXTURE = 0x00001000;
+	constexpr std::uint32_t DDSCAPS_MIPMAP = 0x00400000;
+	constexpr std::uint32_t DDS_DIMENSION_TEXTURE2D = 3;
+
+	//블록 하나의 바이트 수. (BC가 아니면 0)
+	std::size_t BlockBytes(DXGI_FORMAT format)
+	{
+		switch (format)
+		{
+		case DXGI_FORMAT_BC1_UNORM:
+		case DXGI_FORMAT_BC1_UNORM_SRGB:
+		case DXGI_FORMAT_BC4_UNORM:
+			return 8;
+		case DXGI_FORMAT_BC2_UNORM:
+		case DXGI_FORMAT_BC2_UNORM_SRGB:
+		case DXGI_FORMAT_BC3_UNORM:
+		case DXGI_FORMAT_BC3_UNORM_SRGB:
+		case DXGI_FORMAT_BC5_UNORM:
+		case DXGI_FORMAT_BC7_UNORM:
+		case DXGI_FORMAT_BC7_UNORM_SRGB:
+			return 16;
+		default:
+			return 0;
+		}
+	}
+
+	//레거시 헤더로 표현할 수 있는 FourCC. (0이면 DX10 헤더 또는 RGB 마스크)
+	std::uint32_t LegacyFourCC(DXGI_FORMAT format)
+	{
+		switch (format)
+		{
+		case DXGI_FORMAT_BC1_UNORM: return MakeFourCC('D', 'X', 'T', '1');
+		case DXGI_FORMAT_BC2_UNORM: return MakeFourCC('D', 'X', 'T', '3');
+		case DXGI_FORMAT_BC3_UNORM: return MakeFourCC('D', 'X', 'T', '5');
+		case DXGI_FORMAT_BC4_UNORM: return MakeFourCC('A', 'T', 'I', '1');
+		case DXGI_FORMAT_BC5_UNORM: return MakeFourCC('A', 'T', 'I', '2');
+		default: return 0;
+		}
+	}
+}
+
+bool DDSWriter::IsSupported(DXGI_FORMAT format)
+{
+	return BlockBytes(format) != 0 || format == DXGI_FORMAT_R8G8B8A8_UNORM || format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+}
+
+std::size_t DDSWriter::LevelSize(DXGI_FORMAT format, std::uint32_t width, std::uint32_t height)
+{
+	if (const std::size_t blockBytes = BlockBytes(format))
+		return std::size_t((width + 3) / 4) * ((height + 3) / 4) * blockBytes;
+	if (IsSupported(format))
+		return std::size_t(width) * height * 4;
+	return 0;
+}
+
+bool DDSWriter::Write(DXGI_FORMAT format, std::uint32_t width, std::uint32_t height,
+	const std::vector<std::vector<std::uint8_t>>& mips, std::vector<std::uint8_t>& outData)
+{
+	if (!IsSupported(format) || mips.empty() || width == 0 || height == 0)
+		return false;
+
+	//레벨 크기 검사.
+	std::size_t dataSize = 0;
+	for (std::size_t i = 0; i < mips.size(); i++)
+	{
+		const std::uint32_t w = (std::max)(1u, width >> i);
+		const std::uint32_t h = (std::max)(1u, height >> i);
+		if (mips[i].size() != LevelSize(format, w, h))
+			return false;
+		dataSize += mips[i].size();
+	}
+
+	const bool compressed = BlockBytes(format) != 0;
+	const std::uint32_t fourCC = LegacyFourCC(format);
+	const bool legacyRgba = format == DXGI_FORMAT_R8G8B8A8_UNORM;
+	const bool dx10 = !fourCC && !legacyRgba;
+	const std::uint32_t mipCount = static_cast<std::uint32_t>(mips.size());
+
+	DdsHeader header = {};
+	header.Size = sizeof(DdsHeader);
+	header.Flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT |
+		(compressed ? DDSD_LINEARSIZE : DDSD_PITCH) | (mipCount > 1 ? DDSD_MIPMAPCOUNT : 0);
+	header.Height = height;
+	header.Width = width;
+	header.PitchOrLinearSize = static_cast<std::uint32_t>(compressed ? mips[0].size() : std::size_t(width) * 4);
+	header.MipMapCount = mipCount;
+	header.PixelFormat.Size = sizeof(DdsPixelFormat);
+	if (legacyRgba)
+	{
+		header.PixelFormat.Flags = DDS_RGBA;
+		header.PixelFormat.RGBBitCount = 32;
+		header.PixelFormat.RBitMask = 0x000000FF;
+		header.PixelFormat.GBitMask = 0x0000FF00;
+		header.PixelFormat.BBitMask = 0x00FF0000;
+		header.PixelFormat.ABitMask = 0xFF000000;
+	}
+	else
+	{
+		header.PixelFormat.Flags = DDS_FOURCC;
+		header.PixelFormat.FourCC = fourCC ? fourCC : MakeFourCC('D', 'X', '1', '0');
+	}
+	header.Caps = DDSCAPS_TEXTURE | (mipCount > 1 ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0);
+
+	const std::size_t headerSize = sizeof(DDS_MAGIC) + sizeof(DdsHeader) + (dx10 ? sizeof(DdsHeaderDxt10) : 0);
+	outData.resize(headerSize + dataSize);
+
+	std::uint8_t* dst = outData.data();
+	std::memcpy(dst, &DDS_MAGIC, sizeof(DDS_MAGIC));
+	dst += sizeof(DDS_MAGIC);
+	std::memcpy(dst, &header, sizeof(header));
+	dst += sizeof(header);
+	if (dx10)
+	{
+		DdsHeaderDxt10 ext = {};
+		ext.DxgiFormat = format;
+		ext.ResourceDimension = DDS_DIMENSION_TEXTURE2D;
+		ext.ArraySize = 1;
+		std::memcpy(dst, &ext, sizeof(ext));
+		dst += sizeof(ext);
+	}
+
+	for (const auto& mip : mips)
+	{
+		std::memcpy(dst, mip.data(), mip.size());
+		dst += mip.size();
+	}
+	return true;
+}
+
+bool DDSWriter::Save(const std::filesystem::path& path, DXGI_FORMAT format, std::uint32_t width, std::uint32_t height,
+	const std::vector<std::vector<std::uint8_t>>& mips)
+{
+	std::vector<std::uint8_t> data;
+	if (!Write(format, width, height, mips, data))
+		return false;
+
+	std::ofstream fout(path, std::ios::binary);
+	if (!fout)
+		return false;
+	fout.write(reinterpret_cast<const char*>(data.data()), data.size());
+	return static_cast<bool>(fout);
+}
@@ -0,0 +1,32 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include <dxgiformat.h>
+
+/*
+	밉 체인 -> DDS 파일 이미지. (TextureConverter 출력, 로드 시 만든 밉 체인 캐시)
+
+	- 2D 텍스처 하나(배열/큐브 아님)만 쓴다. mips[0]이 가장 큰 레벨, 각 레벨은 빈틈없이 붙인 데이터.
+	- BC1~BC5 UNORM, R8G8B8A8_UNORM은 레거시 헤더(FourCC/RGB 마스크), 그 외(BC7, _SRGB)는 DX10 확장 헤더.
+	- 결과는 CreateDDSTextureFromFile12 / ProbeDDS가 그대로 읽는다.
+*/
+class DDSWriter
+{
+public:
+	//지원하는 형식: BC1~BC5, BC7의 UNORM(_SRGB), R8G8B8A8_UNORM(_SRGB).
+	static bool IsSupported(DXGI_FORMAT format);
+
+	//레벨 하나의 바이트 수. (지원하지 않는 형식은 0)
+	static std::size_t LevelSize(DXGI_FORMAT format, std::uint32_t width, std::uint32_t height);
+
+	//형식이 지원되지 않거나 레벨 크기가 맞지 않으면 false.
+	static bool Write(DXGI_FORMAT format, std::uint32_t width, std::uint32_t height,
+		const std::vector<std::vector<std::uint8_t>>& mips, std::vector<std::uint8_t>& outData);
+
+	static bool Save(const std::filesystem::path& path, DXGI_FORMAT format, std::uint32_t width, std::uint32_t height,
+		const std::vector<std::vector<std::uint8_t>>& mips);
+};
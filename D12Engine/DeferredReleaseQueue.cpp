@@ -0,0 +1,24 @@
+﻿#include "DeferredReleaseQueue.h"
+
+void DeferredReleaseQueue::Enqueue(Microsoft::WRL::ComPtr<IUnknown>&& resource, UINT64 fenceValue)
+{
+	if (resource == nullptr)
+		return;
+
+	//더 늦은 펜스 값이 이미 있으면 그 앞에 끼워 넣는다. (업로드 명령 리스트와 프레임 명령 리스트가 섞이는 경우)
+	auto it = mPending.end();
+	while (it != mPending.begin() && std::prev(it)->Fence > fenceValue)
+		--it;
+	mPending.insert(it, { std::move(resource), fenceValue });
+}
+
+std::size_t DeferredReleaseQueue::ReleaseCompleted(UINT64 completedFence)
+{
+	std::size_t count = 0;
+	while (!mPending.empty() && mPending.front().Fence <= completedFence)
+	{
+		mPending.pop_front();
+		count++;
+	}
+	return count;
+}
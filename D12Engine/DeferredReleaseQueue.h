@@ -0,0 +1,43 @@
+﻿#pragma once
+
+#include "d3dUtil.h"
+#include <deque>
+
+/*
+	펜스 기반 지연 해제 큐. (스테이징 버퍼, 다시 만들기 전의 텍스처 등 GPU가 아직 읽을 수 있는 리소스)
+
+	Enqueue()         : 리소스의 참조를 넘겨받아, 그 리소스를 쓰는 명령의 펜스 값과 묶어 둔다.
+	ReleaseCompleted(): GPU가 끝낸 펜스 값까지의 리소스를 놓는다. 프레임마다 한 번 호출.
+
+	큐는 펜스 값 순으로 유지한다. 보통 펜스 값이 커지는 순서로 들어오므로 뒤에 붙고, 앞에서부터 꺼낸다.
+	GpuHeapAllocator 힙에 있는 리소스는 직접 넣지 말고 할당기의 Free()로 넘긴다. (구간도 같은 펜스로 돌려준다)
+*/
+class DeferredReleaseQueue
+{
+public:
+	DeferredReleaseQueue() = default;
+	DeferredReleaseQueue(const DeferredReleaseQueue& rhs) = delete;
+	DeferredReleaseQueue& operator=(const DeferredReleaseQueue& rhs) = delete;
+
+	//resource는 비워진다. nullptr이면 무시.
+	void Enqueue(Microsoft::WRL::ComPtr<IUnknown>&& resource, UINT64 fenceValue);
+	template<typename T>
+	void Enqueue(Microsoft::WRL::ComPtr<T>& resource, UINT64 fenceValue)
+	{
+		Enqueue(Microsoft::WRL::ComPtr<IUnknown>(std::move(resource)), fenceValue);
+	}
+
+	//놓은 리소스 수를 반환.
+	std::size_t ReleaseCompleted(UINT64 completedFence);
+
+	std::size_t PendingCount()const { return mPending.size(); }
+
+private:
+	struct Pending
+	{
+		Microsoft::WRL::ComPtr<IUnknown> Resource;
+		UINT64 Fence = 0;
+	};
+
+	std::deque<Pending> mPending;
+};
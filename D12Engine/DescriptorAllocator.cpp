@@ -0,0 +1,134 @@
+﻿#include "DescriptorAllocator.h"
+
+#include <algorithm>
+
+void DescriptorAllocator::Reset(std::uint32_t persistentCount, std::uint32_t transientPerFrame, std::uint32_t frameCount)
+{
+	mPersistentCount = persistentCount;
+	mTransientPerFrame = transientPerFrame;
+	mFrameCount = frameCount;
+
+	mFreeRanges.clear();
+	if (persistentCount > 0)
+		mFreeRanges[0] = persistentCount;
+	mAllocations.clear();
+	mPendingFrees.clear();
+	mPersistentUsed = 0;
+
+	mFrame = 0;
+	mTransientUsed = 0;
+	mTransientPeak = 0;
+}
+
+std::uint32_t DescriptorAllocator::Allocate(std::uint32_t count)
+{
+	if (count == 0)
+		return InvalidIndex;
+
+	//first-fit. 낮은 인덱스부터 채워 힙 앞쪽에 모인다.
+	for (auto it = mFreeRanges.begin(); it != mFreeRanges.end(); ++it)
+	{
+		if (it->second < count)
+			continue;
+
+		const std::uint32_t index = it->first;
+		const std::uint32_t rest = it->second - count;
+		mFreeRanges.erase(it);
+		if (rest > 0)
+			mFreeRanges[index + count] = rest;
+
+		mAllocations[index] = { count, false };
+		mPersistentUsed += count;
+		return index;
+	}
+	return InvalidIndex;
+}
+
+void DescriptorAllocator::Free(std::uint32_t index, std::uint64_t fenceValue)
+{
+	//해제 대기 중인 인덱스를 또 놓으면 먼저 건 펜스보다 일찍 돌아가 다른 주인에게 넘어갈 수 있다.
+	const auto allocation = mAllocations.find(index);
+	if (allocation == mAllocations.end() || allocation->second.Pending)
+		return;
+
+	const std::uint32_t count = allocation->second.Count;
+	if (fenceValue == 0)
+	{
+		mAllocations.erase(allocation);
+		Release(index, count);
+		return;
+	}
+	allocation->second.Pending = true;
+	mPendingFrees.push_back({ index, count, fenceValue });
+}
+
+void DescriptorAllocator::ReleaseCompleted(std::uint64_t completedFence)
+{
+	auto done = std::stable_partition(mPendingFrees.begin(), mPendingFrees.end(),
+		[completedFence](const PendingFree& pending) { return pending.Fence > completedFence; });
+
+	for (auto it = done; it != mPendingFrees.end(); ++it)
+	{
+		mAllocations.erase(it->Index);
+		Release(it->Index, it->Count);
+	}
+	mPendingFrees.erase(done, mPendingFrees.end());
+}
+
+void DescriptorAllocator::Release(std::uint32_t index, std::uint32_t count)
+{
+	mPersistentUsed -= count;
+
+	//뒤쪽 빈 구간과 합친다.
+	auto next = mFreeRanges.lower_bound(index);
+	if (next != mFreeRanges.end() && next->first == index + count)
+	{
+		count += next->second;
+		next = mFreeRanges.erase(next);
+	}
+
+	//앞쪽 빈 구간과 합친다.
+	if (next != mFreeRanges.begin())
+	{
+		auto prev = std::prev(next);
+		if (prev->first + prev->second == index)
+		{
+			prev->second += count;
+			return;
+		}
+	}
+	mFreeRanges[index] = count;
+}
+
+void DescriptorAllocator::BeginFrame(std::uint32_t frame)
+{
+	mFrame = frame % (std::max)(mFrameCount, 1u);
+	mTransientUsed = 0;
+}
+
+std::uint32_t DescriptorAllocator::AllocateTransient(std::uint32_t count)
+{
+	if (count == 0 || mTransientUsed + count > mTransientPerFrame)
+		return InvalidIndex;
+
+	const std::uint32_t index = mPersistentCount + mFrame * mTransientPerFrame + mTransientUsed;
+	mTransientUsed += count;
+	mTransientPeak = (std::max)(mTransientPeak, mTransientUsed);
+	return index;
+}
+
+DescriptorAllocator::Stats DescriptorAllocator::GetStats()const
+{
+	Stats stats;
+	stats.PersistentUsed = mPersistentUsed;
+	for (const PendingFree& pending : mPendingFrees)
+		stats.PersistentPending += pending.Count;
+	for (const auto& [index, count] : mFreeRanges)
+	{
+		stats.FreeRangeCount++;
+		stats.LargestFreeRange = (std::max)(stats.LargestFreeRange, count);
+	}
+	stats.TransientUsed = mTransientUsed;
+	stats.TransientPeak = mTransientPeak;
+	return stats;
+}
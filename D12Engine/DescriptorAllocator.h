@@ -0,0 +1,86 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+/*
+	디스크립터 힙 인덱스 할당. (힙 자체는 모름, GPU 없이 테스트 가능)
+
+	[0, persistentCount)           : 상주 영역. 연속 구간 first-fit, 해제하면 이웃 빈 구간과 합친다.
+	                                 인덱스는 해제할 때까지 바뀌지 않으므로 셰이더에서 바인드리스 인덱스로 써도 된다.
+	[persistentCount, 끝)          : 프레임 리소스마다 같은 크기의 선형 영역. 한 프레임 동안만 쓰는 디스크립터.
+	                                 BeginFrame(frame)에서 그 프레임 영역을 한 번에 비운다.
+
+	상주 디스크립터는 앞서 제출한 프레임이 아직 읽고 있을 수 있으므로 Free(index, fenceValue)로 펜스에 묶고,
+	ReleaseCompleted()에서 펜스가 지난 것만 빈 목록으로 돌린다.
+	펜스를 기다리는 인덱스에 Free()를 다시 부르면 무시한다. (먼저 건 펜스가 지나야 돌아온다)
+*/
+class DescriptorAllocator
+{
+public:
+	static constexpr std::uint32_t InvalidIndex = ~0u;
+
+	struct Stats
+	{
+		std::uint32_t PersistentUsed = 0;
+		std::uint32_t PersistentPending = 0;	//펜스를 기다리는 해제
+		std::uint32_t LargestFreeRange = 0;
+		std::uint32_t FreeRangeCount = 0;
+		std::uint32_t TransientUsed = 0;		//현재 프레임 영역
+		std::uint32_t TransientPeak = 0;
+	};
+
+	DescriptorAllocator() = default;
+	DescriptorAllocator(std::uint32_t persistentCount, std::uint32_t transientPerFrame, std::uint32_t frameCount)
+	{
+		Reset(persistentCount, transientPerFrame, frameCount);
+	}
+
+	void Reset(std::uint32_t persistentCount, std::uint32_t transientPerFrame, std::uint32_t frameCount);
+
+	//힙에 필요한 디스크립터 수.
+	std::uint32_t Capacity()const { return mPersistentCount + mTransientPerFrame * mFrameCount; }
+
+	//count개 연속 구간의 첫 인덱스. 공간이 없으면 InvalidIndex.
+	std::uint32_t Allocate(std::uint32_t count = 1);
+	//Allocate()가 준 인덱스. fenceValue가 지나면 다시 쓸 수 있다. (0이면 바로, 이미 해제 대기 중이면 무시)
+	void Free(std::uint32_t index, std::uint64_t fenceValue = 0);
+	void ReleaseCompleted(std::uint64_t completedFence);
+
+	//frame 영역을 비우고 이후 AllocateTransient()는 그 영역에서 준다. (그 프레임의 펜스가 지난 뒤에 호출)
+	void BeginFrame(std::uint32_t frame);
+	std::uint32_t AllocateTransient(std::uint32_t count = 1);
+
+	Stats GetStats()const;
+
+private:
+	void Release(std::uint32_t index, std::uint32_t count);
+
+private:
+	std::uint32_t mPersistentCount = 0;
+	std::uint32_t mTransientPerFrame = 0;
+	std::uint32_t mFrameCount = 0;
+
+	std::map<std::uint32_t, std::uint32_t> mFreeRanges;				//시작 -> 개수 (시작 순)
+	struct Allocation
+	{
+		std::uint32_t Count = 0;
+		bool Pending = false;	//Free(index, fence)로 펜스를 기다리는 중
+	};
+	std::unordered_map<std::uint32_t, Allocation> mAllocations;	//시작 -> 할당
+	std::uint32_t mPersistentUsed = 0;
+
+	struct PendingFree
+	{
+		std::uint32_t Index = 0;
+		std::uint32_t Count = 0;
+		std::uint64_t Fence = 0;
+	};
+	std::vector<PendingFree> mPendingFrees;
+
+	std::uint32_t mFrame = 0;
+	std::uint32_t mTransientUsed = 0;
+	std::uint32_t mTransientPeak = 0;
+};
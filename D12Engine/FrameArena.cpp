@@ -0,0 +1,189 @@
+﻿#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+namespace
+{
+	//ThreadLocal() 아레나 목록. (Report용)
+	struct ArenaRegistry
+	{
+		std::mutex Mutex;
+		std::vector<FrameArena*> Arenas;
+	};
+
+	ArenaRegistry& Registry()
+	{
+		static ArenaRegistry registry;
+		return registry;
+	}
+}
+
+FrameArena::~FrameArena()
+{
+	if (!mRegistered)
+		return;
+
+	ArenaRegistry& registry = Registry();
+	std::lock_guard<std::mutex> lock(registry.Mutex);
+	registry.Arenas.erase(std::remove(registry.Arenas.begin(), registry.Arenas.end(), this), registry.Arenas.end());
+}
+
+void* FrameArena::Allocate(std::size_t size, std::size_t alignment)
+{
+	while (true)
+	{
+		if (mBlock < mBlocks.size())
+		{
+			Block& block = mBlocks[mBlock];
+			const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.Data.get());
+			const std::size_t aligned = static_cast<std::size_t>(((base + mOffset + alignment - 1) & ~std::uintptr_t(alignment - 1)) - base);
+			if (aligned + size <= block.Size)
+			{
+				mOffset = aligned + size;
+				mHighWater = (std::max)(mHighWater, mUsedBefore + mOffset);
+				return block.Data.get() + aligned;
+			}
+
+			//남은 자리는 버리고 다음 블록으로.
+			mUsedBefore += block.Size;
+			mBlock++;
+			mOffset = 0;
+			continue;
+		}
+
+		Block block;
+		block.Size = (std::max)(mBlockSize, size + alignment);
+		block.Data.reset(new std::uint8_t[block.Size]);
+		mBlocks.push_back(std::move(block));
+		mBlockAllocations++;
+		Publish();
+	}
+}
+
+void FrameArena::Poison(std::size_t block, std::size_t offset)
+{
+#if FRAME_ARENA_POISON
+	for (std::size_t i = block; i <= mBlock && i < mBlocks.size(); i++)
+	{
+		const std::size_t begin = i == block ? offset : 0;
+		const std::size_t end = i == mBlock ? mOffset : mBlocks[i].Size;
+		if (end > begin)
+			std::memset(mBlocks[i].Data.get() + begin, 0xDD, end - begin);
+	}
+#else
+	(void)block;
+	(void)offset;
+#endif
+}
+
+void FrameArena::Rewind(const Marker& marker)
+{
+	Poison(marker.Block, marker.Offset);
+
+	mBlock = marker.Block;
+	mOffset = marker.Offset;
+	mUsedBefore = marker.UsedBefore;
+	Publish();
+}
+
+void FrameArena::Reset()
+{
+	//끝난 프레임의 사용량과 최고 사용량을 내보내고 비운다.
+	Publish();
+	Poison(0, 0);
+
+	//여러 블록에 걸쳐 썼으면 다음 프레임부터는 한 블록에 들어가도록 합친다.
+	if (mBlocks.size() > 1)
+	{
+		std::size_t total = 0;
+		for (const Block& block : mBlocks)
+			total += block.Size;
+
+		mBlocks.clear();
+		Block block;
+		block.Size = total;
+		block.Data.reset(new std::uint8_t[block.Size]);
+		mBlocks.push_back(std::move(block));
+		mBlockAllocations++;
+	}
+
+	mBlock = 0;
+	mOffset = 0;
+	mUsedBefore = 0;
+	mHighWater = 0;
+	mResetCount++;
+}
+
+FrameArena::Stats FrameArena::GetStats()const
+{
+	Stats stats;
+	stats.UsedBytes = mUsedBefore + mOffset;
+	for (const Block& block : mBlocks)
+		stats.CapacityBytes += block.Size;
+	stats.HighWaterBytes = mHighWater;
+	stats.BlockCount = mBlocks.size();
+	stats.BlockAllocations = mBlockAllocations;
+	stats.ResetCount = mResetCount;
+	return stats;
+}
+
+FrameArena::Stats FrameArena::PublishedStats()const
+{
+	Stats stats;
+	stats.UsedBytes = mPublished.UsedBytes.load(std::memory_order_relaxed);
+	stats.CapacityBytes = mPublished.CapacityBytes.load(std::memory_order_relaxed);
+	stats.HighWaterBytes = mPublished.HighWaterBytes.load(std::memory_order_relaxed);
+	stats.BlockCount = mPublished.BlockCount.load(std::memory_order_relaxed);
+	stats.BlockAllocations = mPublished.BlockAllocations.load(std::memory_order_relaxed);
+	stats.ResetCount = mPublished.ResetCount.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void FrameArena::Publish()
+{
+	//값마다 따로 쓰므로 읽는 쪽에서 항목끼리 한 순간의 값이 아닐 수 있다. (보고용이라 괜찮다)
+	const Stats stats = GetStats();
+	mPublished.UsedBytes.store(stats.UsedBytes, std::memory_order_relaxed);
+	mPublished.CapacityBytes.store(stats.CapacityBytes, std::memory_order_relaxed);
+	mPublished.HighWaterBytes.store(stats.HighWaterBytes, std::memory_order_relaxed);
+	mPublished.BlockCount.store(stats.BlockCount, std::memory_order_relaxed);
+	mPublished.BlockAllocations.store(stats.BlockAllocations, std::memory_order_relaxed);
+	mPublished.ResetCount.store(stats.ResetCount, std::memory_order_relaxed);
+}
+
+FrameArena& FrameArena::ThreadLocal()
+{
+	//스레드 아레나가 목록보다 먼저 사라지도록 목록을 먼저 만든다.
+	ArenaRegistry& registry = Registry();
+
+	thread_local FrameArena arena;
+	if (!arena.mRegistered)
+	{
+		std::lock_guard<std::mutex> lock(registry.Mutex);
+		registry.Arenas.push_back(&arena);
+		arena.mRegistered = true;
+	}
+	return arena;
+}
+
+std::string FrameArena::Report()
+{
+	ArenaRegistry& registry = Registry();
+	std::lock_guard<std::mutex> lock(registry.Mutex);
+
+	//다른 스레드의 아레나는 그 스레드가 쓰는 중일 수 있으므로 내보낸 값만 읽는다.
+	std::string report;
+	char line[256];
+	for (std::size_t i = 0; i < registry.Arenas.size(); i++)
+	{
+		const Stats stats = registry.Arenas[i]->PublishedStats();
+		std::snprintf(line, sizeof(line), "frame arena %zu: %zu/%zu bytes used (high water %zu), %zu blocks, %llu block allocations over %llu resets\n",
+			i, stats.UsedBytes, stats.CapacityBytes, stats.HighWaterBytes, stats.BlockCount,
+			static_cast<unsigned long long>(stats.BlockAllocations), static_cast<unsigned long long>(stats.ResetCount));
+		report += line;
+	}
+	return report;
+}
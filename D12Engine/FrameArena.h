@@ -0,0 +1,162 @@
+﻿#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//디버그 빌드에서는 되감은 메모리를 0xDD로 채워 프레임이 지난 포인터를 쓰면 바로 드러나게 한다. (끄려면 0으로 정의)
+#if !defined(FRAME_ARENA_POISON)
+#if defined(DEBUG) || defined(_DEBUG)
+#define FRAME_ARENA_POISON 1
+#else
+#define FRAME_ARENA_POISON 0
+#endif
+#endif
+
+/*
+	프레임 단위 임시 CPU 메모리. (포인터만 앞으로 미는 bump 할당)
+
+	- 스레드마다 하나(ThreadLocal()). 잠금 없이 할당하고, 다른 스레드의 아레나는 건드리지 않는다.
+	- Reset(): 프레임 경계에서 한 번에 비운다. 해제는 따로 없다. (FrameAllocator::deallocate는 아무것도 안 한다)
+	  한 프레임에 블록 여러 개가 필요했으면 다음 Reset()에서 합친 크기의 블록 하나로 바꾼다.
+	  그 뒤로는 같은 양을 쓰는 프레임에서 힙 할당이 없다.
+	- Marker/Rewind(), FrameArenaScope: 프레임 안에서 잠깐 쓰는 스크래치를 범위를 벗어날 때 되감는다. (중첩 가능)
+	- 통계: 현재 사용량, 최고 사용량(high-water mark), 블록 수, 블록을 새로 잡은 횟수
+	  GetStats()는 아레나를 쓰는 스레드에서만 부른다. 다른 스레드에는 Reset()/Rewind()/블록 할당 때
+	  원자 변수로 내보낸 값만 보인다. (PublishedStats(), Report())
+
+	아레나에서 받은 메모리는 Reset()(또는 되감기) 뒤에 쓰면 안 된다. 프레임을 넘겨 들고 있을 데이터는 일반 컨테이너에.
+	FrameVector 등은 만든 스레드에서만 쓴다.
+*/
+class FrameArena
+{
+public:
+	static constexpr std::size_t DefaultBlockSize = 256 * 1024;
+
+	struct Marker
+	{
+		std::size_t Block = 0;
+		std::size_t Offset = 0;
+		std::size_t UsedBefore = 0;
+	};
+
+	struct Stats
+	{
+		std::size_t UsedBytes = 0;			//정렬 여백 포함
+		std::size_t CapacityBytes = 0;
+		std::size_t HighWaterBytes = 0;		//지난 Reset() 이후 가장 많이 쓴 양
+		std::size_t BlockCount = 0;
+		std::uint64_t BlockAllocations = 0;	//블록을 새로 잡은 횟수. 정상 상태에서는 늘지 않아야 한다.
+		std::uint64_t ResetCount = 0;
+	};
+
+	explicit FrameArena(std::size_t blockSize = DefaultBlockSize) : mBlockSize(blockSize) {}
+	~FrameArena();
+	FrameArena(const FrameArena& rhs) = delete;
+	FrameArena& operator=(const FrameArena& rhs) = delete;
+
+	//alignment는 2의 거듭제곱. 블록에 자리가 없으면 다음 블록으로 (없으면 새로 잡는다)
+	void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+	template<typename T>
+	T* Allocate(std::size_t count) { return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T))); }
+
+	Marker GetMarker()const { return { mBlock, mOffset, mUsedBefore }; }
+	//marker 이후 할당을 모두 되돌린다.
+	void Rewind(const Marker& marker);
+	void Reset();
+
+	//아레나를 쓰는 스레드에서만.
+	Stats GetStats()const;
+	//마지막으로 내보낸 통계. 아무 스레드에서나 읽을 수 있다. Reset() 직후에는 끝난 프레임의 값.
+	Stats PublishedStats()const;
+
+	//이 스레드의 아레나. 처음 부를 때 만들고 스레드가 끝날 때 사라진다.
+	static FrameArena& ThreadLocal();
+	//살아 있는 스레드 아레나들이 내보낸 통계 한 줄씩.
+	static std::string Report();
+
+private:
+	struct Block
+	{
+		std::unique_ptr<std::uint8_t[]> Data;
+		std::size_t Size = 0;
+	};
+
+	void Poison(std::size_t block, std::size_t offset);
+	void Publish();
+
+private:
+	std::size_t mBlockSize = 0;
+	std::vector<Block> mBlocks;
+	std::size_t mBlock = 0;			//지금 할당 중인 블록
+	std::size_t mOffset = 0;		//그 블록 안의 위치
+	std::size_t mUsedBefore = 0;	//앞 블록들의 크기 합 (넘어간 블록은 다 쓴 것으로 본다)
+
+	std::size_t mHighWater = 0;
+	std::uint64_t mBlockAllocations = 0;
+	std::uint64_t mResetCount = 0;
+	bool mRegistered = false;
+
+	//Report()용. 쓰는 쪽은 아레나의 스레드 하나.
+	struct Published
+	{
+		std::atomic<std::size_t> UsedBytes{ 0 };
+		std::atomic<std::size_t> CapacityBytes{ 0 };
+		std::atomic<std::size_t> HighWaterBytes{ 0 };
+		std::atomic<std::size_t> BlockCount{ 0 };
+		std::atomic<std::uint64_t> BlockAllocations{ 0 };
+		std::atomic<std::uint64_t> ResetCount{ 0 };
+	};
+	Published mPublished;
+};
+
+//범위를 벗어나면 만들 때의 위치로 되감는다.
+class FrameArenaScope
+{
+public:
+	explicit FrameArenaScope(FrameArena& arena = FrameArena::ThreadLocal()) : mArena(arena), mMarker(arena.GetMarker()) {}
+	~FrameArenaScope() { mArena.Rewind(mMarker); }
+	FrameArenaScope(const FrameArenaScope& rhs) = delete;
+	FrameArenaScope& operator=(const FrameArenaScope& rhs) = delete;
+
+private:
+	FrameArena& mArena;
+	FrameArena::Marker mMarker;
+};
+
+//STL 컨테이너용 할당자. 기본 생성하면 이 스레드의 아레나를 쓴다.
+template<typename T>
+class FrameAllocator
+{
+public:
+	using value_type = T;
+
+	FrameAllocator() : mArena(&FrameArena::ThreadLocal()) {}
+	explicit FrameAllocator(FrameArena& arena) : mArena(&arena) {}
+	template<typename U>
+	FrameAllocator(const FrameAllocator<U>& rhs) : mArena(rhs.Arena()) {}
+
+	T* allocate(std::size_t count) { return mArena->Allocate<T>(count); }
+	void deallocate(T*, std::size_t) {}
+
+	FrameArena* Arena()const { return mArena; }
+
+	template<typename U>
+	bool operator==(const FrameAllocator<U>& rhs)const { return mArena == rhs.Arena(); }
+	template<typename U>
+	bool operator!=(const FrameAllocator<U>& rhs)const { return mArena != rhs.Arena(); }
+
+private:
+	FrameArena* mArena;
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+template<typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>>
+using FrameUnorderedMap = std::unordered_map<K, V, Hash, Eq, FrameAllocator<std::pair<const K, V>>>;
+using FrameWString = std::basic_string<wchar_t, std::char_traits<wchar_t>, FrameAllocator<wchar_t>>;
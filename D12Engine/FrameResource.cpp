@@ -1,13 +1,11 @@
 #include "FrameResource.h"
 
-FrameResource::FrameResource(ID3D12Device* device, UINT passCount, UINT objectCount, UINT waveVertCount, UINT materialCount)
+FrameResource::FrameResource(ID3D12Device* device, UINT objectCount, UINT materialCount, bool packedObjectData) : Upload(device)
 {
 	ThrowIfFailed(device->CreateCommandAllocator(
 		D3D12_COMMAND_LIST_TYPE_DIRECT,
 		IID_PPV_ARGS(CmdListAlloc.GetAddressOf())));
 
-	PassCB = std::make_unique<UploadBuffer<PassConstants>>(device, passCount, true);
-	ObjectCB = std::make_unique<UploadBuffer<ObjectConstants>>(device, objectCount, true);
-	WavesVB = std::make_unique<UploadBuffer<Vertex>>(device, waveVertCount, false);
-	MaterialCB = std::make_unique<UploadBuffer<MaterialConstants>>(device, materialCount, true);
+	ObjectCB = std::make_unique<UploadBuffer<ObjectConstants>>(device, objectCount, !packedObjectData);
+	MaterialCB = std::make_unique<UploadBuffer<MaterialConstants>>(device, materialCount, !packedObjectData);
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "d3dUtil.h"
 #include "MathHelper.h"
+#include "FrameUploadAllocator.h"
 #include "UploadBuffer.h"
 
 struct ObjectConstants
@@ -29,9 +30,9 @@ struct PassConstants
 
 	DirectX::XMFLOAT4 AmbientLight = { 0.0f, 0.0f, 0.0f, 1.0f };
 
-	// ε [0, NUM_DIR_LIGHTS) ⱤԴϴ.
-	// ε[NUM_DIR_LIGHTS, NUM_DIR_LIGHTS + NUM_POINT_LIGHTS) Դϴ.
-	// ε[NUM_DIR_LIGHTS + NUM_POINT_LIGHTS, NUM_DIR_LIGHTS + NUM_POINT_LIGHT + NUM_SPOT_LIGHTS) ƮƮ̸, ü ִ MaxLights    ֽϴ.
+	// 인덱스 [0, NUM_DIR_LIGHTS)는 방향광입니다.
+	// 인덱스[NUM_DIR_LIGHTS, NUM_DIR_LIGHTS + NUM_POINT_LIGHTS)는 점광원입니다.
+	// 인덱스[NUM_DIR_LIGHTS + NUM_POINT_LIGHTS, NUM_DIR_LIGHTS + NUM_POINT_LIGHT + NUM_SPOT_LIGHTS)는 스포트라이트이며, 객체당 최대 MaxLights 개수까지 사용할 수 있습니다.
 	Light Lights[MaxLights];
 };
 
@@ -43,26 +44,27 @@ struct Vertex
 	//DirectX::XMFLOAT4 Color;
 };
 
-//CPU  ӿ    ϴ  ʿ ҽ .
+//CPU가 한 프레임에 대한 명령 목록을 구성하는 데 필요한 리소스 묶음.
 struct FrameResource
 {
 public:
-	FrameResource(ID3D12Device* device, UINT passCount, UINT objectCount, UINT waveVertCount, UINT materialCount);
+	//packedObjectData: 객체/재질 데이터를 256바이트 간격 대신 빈틈없이. (StructuredBuffer로 바인딩)
+	FrameResource(ID3D12Device* device, UINT objectCount, UINT materialCount, bool packedObjectData);
 	FrameResource(const FrameResource& rhs) = delete;
 	FrameResource& operator=(const FrameResource& rhs) = delete;
 	~FrameResource() {};
 
-	//GPU  Ϸ  Alloc ϸ ȵǹǷ Ӹ Alloc .
+	//GPU가 명령을 완료할 때까지 Alloc을 수정하면 안되므로 프레임마다 Alloc 존재.
 	Microsoft::WRL::ComPtr<ID3D12CommandAllocator> CmdListAlloc;
 
-	//cbuffer  Ӹ .
-	std::unique_ptr<UploadBuffer<PassConstants>> PassCB = nullptr;
+	//패스 cbuffer와 파도 정점처럼 매 프레임 새로 쓰는 데이터.
+	//매 프레임 필요한 만큼 잘라 쓰고, Fence가 지나면 Reset()으로 한 번에 돌려준다.
+	FrameUploadAllocator Upload;
+
+	//가끔 바뀌는 객체/재질 cbuffer는 프레임마다 유지하고 바뀐 원소만 다시 쓴다. (AppD3D의 ConstantStore)
 	std::unique_ptr<UploadBuffer<ObjectConstants>> ObjectCB = nullptr;
 	std::unique_ptr<UploadBuffer<MaterialConstants>> MaterialCB = nullptr;
 
-	// ġ Ӹ ޶Ƿ Ӹ .
-	std::unique_ptr<UploadBuffer<Vertex>> WavesVB = nullptr;
-
-	//ش  ҽ GPU    Ȯ
+	//해당 프레임 리소스가 GPU에서 여전히 사용 중인지 확인
 	UINT64 Fence = 0;
 };
\ No newline at end of file
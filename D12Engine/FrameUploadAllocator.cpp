@@ -0,0 +1,63 @@
+﻿#include "FrameUploadAllocator.h"
+
+FrameUploadAllocator::~FrameUploadAllocator()
+{
+	ReleasePages();
+}
+
+void FrameUploadAllocator::ReleasePages()
+{
+	for (Page& page : mPages)
+	{
+		if (page.Resource != nullptr)
+		{
+			page.Guard->Detach();
+			page.Resource->Unmap(0, nullptr);
+		}
+	}
+	mPages.clear();
+}
+
+FrameUploadAllocator::Allocation FrameUploadAllocator::Allocate(UINT64 size, UINT64 alignment)
+{
+	const LinearAllocator::Allocation range = mAllocator.Allocate(size, alignment);
+
+	//새 페이지면 버퍼를 만든다. (페이지는 앞에서부터 차례로 열린다)
+	while (mPages.size() <= range.Page)
+	{
+		Page page;
+		page.Size = mAllocator.PageSize(mPages.size());
+		CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
+		CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(page.Size);
+		ThrowIfFailed(mDevice->CreateCommittedResource(
+			&heapProps,
+			D3D12_HEAP_FLAG_NONE,
+			&bufferDesc,
+			D3D12_RESOURCE_STATE_GENERIC_READ,
+			nullptr,
+			IID_PPV_ARGS(page.Resource.GetAddressOf())));
+
+		//GPU는 읽기만 하므로 계속 매핑해 둔다.
+		CD3DX12_RANGE readRange(0, 0);
+		ThrowIfFailed(page.Resource->Map(0, &readRange, reinterpret_cast<void**>(&page.MappedData)));
+		page.Guard = std::make_unique<UploadReadGuard>();
+		page.Guard->Attach(page.MappedData, page.Size);
+		mPages.push_back(std::move(page));
+	}
+
+	const Page& page = mPages[range.Page];
+	Allocation allocation;
+	allocation.Resource = page.Resource.Get();
+	allocation.Offset = range.Offset;
+	allocation.CpuData = page.MappedData + range.Offset;
+	allocation.GpuAddress = page.Resource->GetGPUVirtualAddress() + range.Offset;
+	allocation.Guard = page.Guard.get();
+	return allocation;
+}
+
+void FrameUploadAllocator::Reset()
+{
+	//페이지 구성이 바뀌었으면 지금 버퍼들은 이 프레임 이후로 쓰이지 않는다. (펜스가 지났으므로 바로 해제)
+	if (mAllocator.Reset())
+		ReleasePages();
+}
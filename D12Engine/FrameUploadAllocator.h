@@ -0,0 +1,79 @@
+﻿#pragma once
+
+#include "d3dUtil.h"
+#include "LinearAllocator.h"
+#include "WriteCombined.h"
+
+/*
+	프레임마다 하나씩 두는 업로드 힙 선형 할당기. (상수 버퍼, 동적 정점 버퍼)
+
+	할당 정책은 LinearAllocator. 페이지마다 업로드 버퍼를 하나씩 만들어 계속 매핑해 둔다.
+	한 프레임 동안 필요한 만큼 잘라 쓰고, 그 프레임의 펜스가 지나면 Reset()으로 한 번에 돌려준다.
+	여러 페이지를 쓴 프레임이 있으면 Reset()에서 버퍼를 해제하고 다음 할당 때 합친 크기로 다시 만든다.
+	CpuData는 write-combined 메모리다. 읽지 말고 Writer()/ConstantsWriter()로 쓴다. (UPLOAD_READ_GUARD를 켜면 그 밖의 접근이 접근 위반)
+*/
+class FrameUploadAllocator
+{
+public:
+	struct Allocation
+	{
+		ID3D12Resource* Resource = nullptr;
+		UINT64 Offset = 0;		//Resource 안의 위치
+		BYTE* CpuData = nullptr;
+		D3D12_GPU_VIRTUAL_ADDRESS GpuAddress = 0;
+		UploadReadGuard* Guard = nullptr;	//CpuData가 든 페이지의 읽기 검사
+	};
+
+	explicit FrameUploadAllocator(ID3D12Device* device, UINT64 pageSize = LinearAllocator::DefaultPageSize) :
+		mDevice(device), mAllocator(pageSize) {}
+	FrameUploadAllocator(const FrameUploadAllocator& rhs) = delete;
+	FrameUploadAllocator& operator=(const FrameUploadAllocator& rhs) = delete;
+	~FrameUploadAllocator();
+
+	//alignment는 2의 거듭제곱. 기본값은 상수 버퍼 정렬(256).
+	Allocation Allocate(UINT64 size, UINT64 alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+
+	//상수 버퍼 count개. 각 원소는 256바이트 배수 간격. (d3dUtil::CalcConstantBufferByteSize)
+	template<typename T>
+	Allocation AllocateConstants(UINT count = 1)
+	{
+		return Allocate(UINT64(d3dUtil::CalcConstantBufferByteSize(sizeof(T))) * count);
+	}
+
+	//AllocateConstants<T>(count)로 받은 구간의 쓰기 도구.
+	template<typename T>
+	static UploadWriter<T> ConstantsWriter(const Allocation& allocation, UINT count = 1)
+	{
+		return UploadWriter<T>(allocation.CpuData, d3dUtil::CalcConstantBufferByteSize(sizeof(T)), count, allocation.Guard);
+	}
+
+	//Allocate()로 받은 구간에 T를 stride 간격으로 count개 쓰는 도구.
+	template<typename T>
+	static UploadWriter<T> Writer(const Allocation& allocation, std::size_t stride, std::size_t count)
+	{
+		return UploadWriter<T>(allocation.CpuData, stride, count, allocation.Guard);
+	}
+
+	//GPU가 이 프레임의 명령을 끝낸 뒤에 호출.
+	void Reset();
+
+	UINT64 UsedBytes()const { return mAllocator.UsedBytes(); }
+	UINT64 PeakBytes()const { return mAllocator.PeakBytes(); }
+
+private:
+	struct Page
+	{
+		Microsoft::WRL::ComPtr<ID3D12Resource> Resource;
+		BYTE* MappedData = nullptr;
+		UINT64 Size = 0;
+		//Allocation이 주소를 들고 있으므로 mPages가 커져도 옮기지 않는다.
+		std::unique_ptr<UploadReadGuard> Guard;
+	};
+
+	void ReleasePages();
+
+private:
+	ID3D12Device* mDevice = nullptr;
+	LinearAllocator mAllocator;
+	std::vector<Page> mPages;
+};
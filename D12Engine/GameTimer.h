@@ -9,7 +9,7 @@ class GameTimer
 public:
 	GameTimer() { Reset(); }
 
-	//ø̼    ü ð()
+	//애플리케이션 시작 이후 경과된 전체 시간(초)
 	float TotalTime()const
 	{
 		auto elapsed = mStopped
@@ -19,7 +19,7 @@ public:
 		return std::chrono::duration<float>(elapsed).count();
 	}
 
-	//    ð()
+	//이전 프레임 이후 경과된 시간(초)
 	float DeltaTime()const { return static_cast<float>(mDeltaTime); }
 
 	void Reset()
@@ -57,7 +57,7 @@ public:
 		}
 	}
 
-	//  ȣ
+	//매 프레임 호출
 	void Tick()
 	{
 		if (mStopped)
@@ -70,8 +70,8 @@ public:
 		mDeltaTime = std::chrono::duration<double>(mCurrTime - mPrevTime).count();
 		mPrevTime = mCurrTime;
 
-		//DXSDK CDXUTTimer  μ   ȯǰų ٸ μ ȯ 
-		//mDeltaTime    ֽϴ. QPC ߻  ̳ chrono ߻ ʴ  ϴ.
+		//DXSDK의 CDXUTTimer에 따르면 프로세서가 절전 모드로 전환되거나 다른 프로세서로 전환될 경우
+		//mDeltaTime이 음수가 될 수 있습니다. QPC에서는 발생 가능한 현상이나 chrono에서는 발생하지 않는 것 같습니다.
 		if(mDeltaTime < 0.0)
 			mDeltaTime = 0.0;
 	}
@@ -83,7 +83,7 @@ private:
 	clock::time_point mPrevTime;
 	clock::time_point mCurrTime;
 	clock::time_point mStopTime;
-	clock::duration mPausedDuration; //nano 
+	clock::duration mPausedDuration; //nano초 단위
 
 	bool mStopped;
 };
\ No newline at end of file
@@ -73,8 +73,8 @@ GeometryGenerator::MeshData GeometryGenerator::CreateSphere(float radius, uint32
 {
 	MeshData meshData;
 
-	//ֻ  Ͽ   Ʒ ̵ϸ鼭  
-	//簢 ؽó    ؽó ʿ  Ҵ   Ƿ ؽó ǥ ְ ߻  ִ.
+	//최상위 극점에서 시작하여 스택을 따라 아래로 이동하면서 정점을 계산
+	//직사각형 텍스처를 구에 매핑할 때 텍스처 맵에서 극점에 할당할 고유한 지점이 없으므로 텍스처 좌표 왜곡이 발생할 수 있다.
 	Vertex topVertex(0.0f, +radius, 0.0f, 0.0f, +1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f);
 	Vertex bottomVertex(0.0f, -radius, 0.0f, 0.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f);
 
@@ -83,8 +83,8 @@ GeometryGenerator::MeshData GeometryGenerator::CreateSphere(float radius, uint32
 	float phiStep	= XM_PI / stackCount;
 	float thetaStep = 2.0f * XM_PI / sliceCount;
 
-	//stack ring  vertex
-	for (uint32 i = 1; i <= stackCount - 1; i++) //top/bottom  ϴ 1 ~ (stackCount-1)
+	//stack ring 마다 vertex계산
+	for (uint32 i = 1; i <= stackCount - 1; i++) //top/bottom 정점을 제외하니 1 ~ (stackCount-1)
 	{
 		float phi = i * phiStep;
 
@@ -115,7 +115,7 @@ GeometryGenerator::MeshData GeometryGenerator::CreateSphere(float radius, uint32
 	}
 	meshData.Vertices.push_back(bottomVertex);
 
-	//ֻ  ε .
+	//최상단 스택 인덱스 계산.
 	for (uint32 i = 1; i <= sliceCount; i++)
 	{
 		meshData.Indices32.push_back(0);
@@ -123,10 +123,10 @@ GeometryGenerator::MeshData GeometryGenerator::CreateSphere(float radius, uint32
 		meshData.Indices32.push_back(i);
 	}
 
-	//0 ε(ֻ ) ϰ 1   ε .
+	//0번 인덱스(최상위 극점)을 제외하고 1번부터 링 마다 인덱스 계산.
 	uint32 baseIndex = 1;
-	// ۰   ġ ٸ .
-	// ؽó ǥ ٸ .
+	// 시작과 끝점은 같은 위치지만 다른 정점.
+	// 텍스처 좌표가 다르기 때문.
 	uint32 ringVertexCount = sliceCount + 1; 
 
 	for (uint32 i = 0; i < stackCount - 2; i++)
@@ -143,7 +143,7 @@ GeometryGenerator::MeshData GeometryGenerator::CreateSphere(float radius, uint32
 		}
 	}
 
-	//ϴ  ε .
+	//최하단 스택 인덱스 계산.
 	uint32 southPoleIndex = (uint32)meshData.Vertices.size() - 1;
 	baseIndex = southPoleIndex - ringVertexCount;
 
@@ -163,7 +163,7 @@ GeometryGenerator::MeshData GeometryGenerator::CreateGeosphere(float radius, uin
 
 	numSubdivisions = std::min<uint32>(numSubdivisions, 6u);
 
-	// ̽ʸü ׼̼Ͽ  ٻ ǥմϴ.
+	// 정이십면체를 테셀레이션하여 구를 근사적으로 표현합니다.
 	const float X = 0.525731f;
 	const float Z = 0.850651f;
 
@@ -222,7 +222,7 @@ GeometryGenerator::MeshData GeometryGenerator::CreateGeosphere(float radius, uin
 	return meshData;
 }
 
-//, źƮ  ʿ.
+//노멀, 탄젠트 공부 필요.
 GeometryGenerator::MeshData GeometryGenerator::CreateCylinder(float bottomRadius, float topRadius, float height, uint32 sliceCount, uint32 stackCount)
 {
 	MeshData meshData;
@@ -231,7 +231,7 @@ GeometryGenerator::MeshData GeometryGenerator::CreateCylinder(float bottomRadius
 	float radiusStep = (topRadius - bottomRadius) / stackCount;
 	uint32 ringCount = stackCount + 1;
 
-	//Ʒ  .
+	//아래부터 위로 계산.
 	for (uint32 i = 0; i < ringCount; i++)
 	{
 		float y = -0.5f * height + i * stackHeight;
@@ -248,10 +248,10 @@ GeometryGenerator::MeshData GeometryGenerator::CreateCylinder(float bottomRadius
 			vertex.Position = XMFLOAT3(r * c, y, r * s);
 			vertex.TexC.x = (float)j / sliceCount;
 			vertex.TexC.y = 1.0f - (float)i / stackCount;
-			//    Űȭ  ֽϴ. ⼭ v Ű v ؽó ǥ   ϵ ξ,
-			// źƮ(bitangent) v ؽó ǥ    մϴ.
-			//   r0 Ʒ (bottom radius), r1  (top radius)Դϴ.
-			//   y(v) = h - h v,   v  [0,1].
+			// 원기둥은 다음과 같이 매개변수화할 수 있습니다. 여기서 v 매개변수는 v 텍스처 좌표와 같은 방향으로 증가하도록 두어,
+			// 비탄젠트(bitangent)가 v 텍스처 좌표와 같은 방향을 갖도록 합니다.
+			//   r0는 아래쪽 반지름(bottom radius), r1은 위쪽 반지름(top radius)입니다.
+			//   y(v) = h - h v,   v ∈ [0,1].
 			//   r(v) = r1 + (r0 - r1) v
 			//
 			//   x(t, v) = r(v) * cos(t)
@@ -266,7 +266,7 @@ GeometryGenerator::MeshData GeometryGenerator::CreateCylinder(float bottomRadius
 			//  dy/dv = -h
 			//  dz/dv = (r0 - r1) * sin(t)
 			//
-			//  ʹ  Դϴ.
+			// 이 벡터는 단위 길이입니다.
 			vertex.TangentU = XMFLOAT3(-s, 0.0f, c);
 
 			float dr = bottomRadius - topRadius;
@@ -281,11 +281,11 @@ GeometryGenerator::MeshData GeometryGenerator::CreateCylinder(float bottomRadius
 		}
 	}
 
-	//۰   ġ ٸ .
-	//ؽó ǥ ٸ .
+	//시작과 끝점은 같은 위치지만 다른 정점.
+	//텍스처 좌표가 다르기 때문.
 	uint32 ringVertexCount = sliceCount + 1;
 
-	//ε 
+	//인덱스 계산
 	for (uint32 i = 0; i < stackCount; i++)
 	{
 		for (uint32 j = 0; j < sliceCount; j++)
@@ -491,7 +491,7 @@ void GeometryGenerator::BuildCylinderTopCap(float bottomRadius, float topRadius,
 	float y = 0.5f * height;
 	float dTheta = 2.0f * XM_PI / sliceCount;
 
-	for (uint32 i = 0; i <= sliceCount; i++) //۰   ġ ٸ .
+	for (uint32 i = 0; i <= sliceCount; i++) //시작과 끝점은 같은 위치지만 다른 정점.
 	{
 		float x = topRadius * cosf(i * dTheta);
 		float z = topRadius * sinf(i * dTheta);
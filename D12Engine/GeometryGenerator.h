@@ -4,7 +4,7 @@
 #include <DirectXMath.h>
 #include <cstdint>
 
-//TangentU/TexC/Normal   .
+//TangentU/TexC/Normal 은 추후 공부.
 class GeometryGenerator
 {
 public:
@@ -60,24 +60,24 @@ public:
 		std::vector<uint16> mIndices16;
 	};
 
-	// ũ  ߽ ϴ ڸ .
+	//지정된 크기로 원점을 중심으로 하는 상자를 생성.
 	MeshData CreateBox(float width, float height, float depth, uint32 numSubdivisions);
 
-	//   ߽ ϴ  .
-	//slices  stacks Ű ׼̼  .
-	//ﰢ  ó  .
+	//지정된 반지름으로 원점을 중심으로 하는 구를 생성.
+	//slices 및 stacks 매개변수는 테셀레이션 정도를 제어.
+	//삼각형이 극점 근처에 정점 과밀.
 	MeshData CreateSphere(float radius, uint32 sliceCount, uint32 stackCount);
 
-	//ﰢ յ.
-	//̰ ׼̼ .
+	//삼각형이 균등분포.
+	//깊이가 테셀레이션 제어.
 	MeshData CreateGeosphere(float radius, uint32 numSubdivisions);
 
-	//y࿡ ϰ  ߽ ϴ  .
+	//y축에 평행하고 원점을 중심으로 하는 원기둥을 생성.
 	MeshData CreateCylinder(float bottomRadius, float topRadius, float height, uint32 sliceCount, uint32 stackCount);
 
 	MeshData CreateGrid(float width, float depth, uint32 m, uint32 n);
 
-	//ȭ鿡  ĵ 簢  մϴ. ̴ ó  ȭ ȿ 
+	//화면에 맞춰 정렬된 사각형 영역을 생성합니다. 이는 후처리 및 화면 효과에 유용
 	MeshData CreateQuad(float x, float y, float w, float h, float depth);
 
 private:
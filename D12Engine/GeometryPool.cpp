@@ -0,0 +1,189 @@
+﻿#include "GeometryPool.h"
+#include "DeferredReleaseQueue.h"
+#include "GpuHeapAllocator.h"
+#include "WriteCombined.h"
+
+#include <cstdio>
+
+using Microsoft::WRL::ComPtr;
+
+GeometryPool::GeometryPool(ID3D12Device* device, GpuHeapAllocator* heapAllocator, UINT vertexStride, UINT64 vertexCapacity, UINT64 indexCapacity) :
+	mDevice(device), mHeapAllocator(heapAllocator), mVertexStride(vertexStride),
+	mVertexRanges(vertexCapacity, 1), mIndexRanges(indexCapacity, 1)
+{
+	mVertexBuffer = CreateBuffer(D3D12_HEAP_TYPE_DEFAULT, vertexCapacity * vertexStride, D3D12_RESOURCE_STATE_COMMON);
+	mIndexBuffer = CreateBuffer(D3D12_HEAP_TYPE_DEFAULT, indexCapacity * sizeof(std::uint32_t), D3D12_RESOURCE_STATE_COMMON);
+}
+
+ComPtr<ID3D12Resource> GeometryPool::CreateBuffer(D3D12_HEAP_TYPE heapType, UINT64 byteSize, D3D12_RESOURCE_STATES initialState)
+{
+	CD3DX12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(byteSize);
+	if (mHeapAllocator != nullptr)
+		return mHeapAllocator->CreateResource(heapType, desc, initialState);
+
+	ComPtr<ID3D12Resource> resource;
+	CD3DX12_HEAP_PROPERTIES heapProps(heapType);
+	ThrowIfFailed(mDevice->CreateCommittedResource(
+		&heapProps,
+		D3D12_HEAP_FLAG_NONE,
+		&desc,
+		initialState,
+		nullptr,
+		IID_PPV_ARGS(resource.GetAddressOf())));
+	return resource;
+}
+
+bool GeometryPool::Add(ID3D12GraphicsCommandList* cmdList, DeferredReleaseQueue& releaseQueue, UINT64 uploadFence,
+	const void* vertices, UINT vertexCount, const std::uint32_t* indices, UINT indexCount, Range& outRange)
+{
+	if (vertexCount == 0 || indexCount == 0)
+		return false;
+
+	const std::uint64_t baseVertex = mVertexRanges.Allocate(vertexCount, 1);
+	if (baseVertex == TlsfAllocator::InvalidOffset)
+	{
+		OutputDebugStringW(L"geometry pool: out of vertex space\n");
+		return false;
+	}
+	const std::uint64_t startIndex = mIndexRanges.Allocate(indexCount, 1);
+	if (startIndex == TlsfAllocator::InvalidOffset)
+	{
+		mVertexRanges.Free(baseVertex);
+		OutputDebugStringW(L"geometry pool: out of index space\n");
+		return false;
+	}
+
+	//정점과 인덱스를 스테이징 하나에 이어 붙인다. (인덱스 쪽은 4바이트 정렬)
+	const UINT64 vbByteSize = UINT64(vertexCount) * mVertexStride;
+	const UINT64 ibOffset = (vbByteSize + 3) & ~UINT64(3);
+	const UINT64 ibByteSize = UINT64(indexCount) * sizeof(std::uint32_t);
+
+	ComPtr<ID3D12Resource> staging = CreateBuffer(D3D12_HEAP_TYPE_UPLOAD, ibOffset + ibByteSize, D3D12_RESOURCE_STATE_GENERIC_READ);
+
+	std::uint8_t* mapped = nullptr;
+	CD3DX12_RANGE readRange(0, 0);
+	ThrowIfFailed(staging->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+	WriteCombined::Copy(mapped, vertices, vbByteSize);
+	WriteCombined::Copy(mapped + ibOffset, indices, ibByteSize);
+	WriteCombined::Flush();
+	staging->Unmap(0, nullptr);
+
+	D3D12_RESOURCE_BARRIER barriers[2] =
+	{
+		CD3DX12_RESOURCE_BARRIER::Transition(mVertexBuffer.Get(), mState, D3D12_RESOURCE_STATE_COPY_DEST),
+		CD3DX12_RESOURCE_BARRIER::Transition(mIndexBuffer.Get(), mState, D3D12_RESOURCE_STATE_COPY_DEST),
+	};
+	cmdList->ResourceBarrier(_countof(barriers), barriers);
+
+	cmdList->CopyBufferRegion(mVertexBuffer.Get(), baseVertex * mVertexStride, staging.Get(), 0, vbByteSize);
+	cmdList->CopyBufferRegion(mIndexBuffer.Get(), startIndex * sizeof(std::uint32_t), staging.Get(), ibOffset, ibByteSize);
+
+	mState = D3D12_RESOURCE_STATE_GENERIC_READ;
+	for (D3D12_RESOURCE_BARRIER& barrier : barriers)
+	{
+		barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
+		barrier.Transition.StateAfter = mState;
+	}
+	cmdList->ResourceBarrier(_countof(barriers), barriers);
+
+	if (mHeapAllocator != nullptr)
+		mHeapAllocator->Free(staging, uploadFence);
+	else
+		releaseQueue.Enqueue(staging, uploadFence);
+
+	outRange.BaseVertex = static_cast<UINT>(baseVertex);
+	outRange.VertexCount = vertexCount;
+	outRange.StartIndex = static_cast<UINT>(startIndex);
+	outRange.IndexCount = indexCount;
+	return true;
+}
+
+bool GeometryPool::Add(ID3D12GraphicsCommandList* cmdList, DeferredReleaseQueue& releaseQueue, UINT64 uploadFence,
+	const void* vertices, UINT vertexCount, const std::uint16_t* indices, UINT indexCount, Range& outRange)
+{
+	std::vector<std::uint32_t> indices32(indices, indices + indexCount);
+	return Add(cmdList, releaseQueue, uploadFence, vertices, vertexCount, indices32.data(), indexCount, outRange);
+}
+
+void GeometryPool::Free(const Range& range, UINT64 fenceValue)
+{
+	if (fenceValue == 0)
+	{
+		mVertexRanges.Free(range.BaseVertex);
+		mIndexRanges.Free(range.StartIndex);
+		return;
+	}
+
+	mPendingFrees.push_back({ range, fenceValue });
+}
+
+void GeometryPool::ReleaseCompleted(UINT64 completedFence)
+{
+	std::size_t kept = 0;
+	for (std::size_t i = 0; i < mPendingFrees.size(); i++)
+	{
+		if (mPendingFrees[i].Fence <= completedFence)
+		{
+			mVertexRanges.Free(mPendingFrees[i].Mesh.BaseVertex);
+			mIndexRanges.Free(mPendingFrees[i].Mesh.StartIndex);
+		}
+		else
+		{
+			mPendingFrees[kept++] = mPendingFrees[i];
+		}
+	}
+	mPendingFrees.resize(kept);
+}
+
+void GeometryPool::Bind(MeshGeometry& geo)const
+{
+	geo.VertexBufferGPU = mVertexBuffer;
+	geo.IndexBufferGPU = mIndexBuffer;
+	geo.VertexByteStride = mVertexStride;
+	geo.VertexBufferByteSize = static_cast<UINT>(mVertexRanges.Size() * mVertexStride);
+	geo.VertexBufferOffset = 0;
+	geo.IndexFormat = DXGI_FORMAT_R32_UINT;
+	geo.IndexBufferByteSize = static_cast<UINT>(mIndexRanges.Size() * sizeof(std::uint32_t));
+}
+
+D3D12_VERTEX_BUFFER_VIEW GeometryPool::VertexBufferView()const
+{
+	D3D12_VERTEX_BUFFER_VIEW vbv;
+	vbv.BufferLocation = mVertexBuffer->GetGPUVirtualAddress();
+	vbv.StrideInBytes = mVertexStride;
+	vbv.SizeInBytes = static_cast<UINT>(mVertexRanges.Size() * mVertexStride);
+
+	return vbv;
+}
+
+D3D12_INDEX_BUFFER_VIEW GeometryPool::IndexBufferView()const
+{
+	D3D12_INDEX_BUFFER_VIEW ibv;
+	ibv.BufferLocation = mIndexBuffer->GetGPUVirtualAddress();
+	ibv.Format = DXGI_FORMAT_R32_UINT;
+	ibv.SizeInBytes = static_cast<UINT>(mIndexRanges.Size() * sizeof(std::uint32_t));
+
+	return ibv;
+}
+
+GeometryPool::Stats GeometryPool::GetStats()const
+{
+	Stats stats;
+	stats.Vertices = mVertexRanges.GetStats();
+	stats.Indices = mIndexRanges.GetStats();
+	stats.MeshCount = stats.Vertices.AllocationCount;
+	stats.PendingFrees = static_cast<UINT>(mPendingFrees.size());
+	return stats;
+}
+
+std::string GeometryPool::Report()const
+{
+	const Stats stats = GetStats();
+
+	char line[256];
+	std::snprintf(line, sizeof(line), "geometry pool: %u meshes (%u pending free), vertices %llu/%llu (fragmentation %.2f), indices %llu/%llu (fragmentation %.2f)\n",
+		stats.MeshCount, stats.PendingFrees,
+		static_cast<unsigned long long>(stats.Vertices.UsedBytes), static_cast<unsigned long long>(stats.Vertices.Size), stats.Vertices.Fragmentation(),
+		static_cast<unsigned long long>(stats.Indices.UsedBytes), static_cast<unsigned long long>(stats.Indices.Size), stats.Indices.Fragmentation());
+	return line;
+}
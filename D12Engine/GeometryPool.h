@@ -0,0 +1,92 @@
+﻿#pragma once
+
+#include "d3dUtil.h"
+#include "TlsfAllocator.h"
+
+class DeferredReleaseQueue;
+class GpuHeapAllocator;
+
+/*
+	정적 메시가 함께 쓰는 큰 정점 버퍼 하나와 인덱스 버퍼 하나.
+
+	- 메시마다 정점 구간과 인덱스 구간을 TlsfAllocator로 잘라 준다. 오프셋과 크기는 바이트가 아니라 정점/인덱스 단위.
+	  메시의 서브메시는 (BaseVertexLocation + Range::BaseVertex, StartIndexLocation + Range::StartIndex)로 그린다.
+	- 인덱스는 모두 32비트로 저장한다. (버퍼 하나에 포맷 하나, 16비트 인덱스는 Add()에서 넓힌다)
+	- 풀에 든 메시는 같은 정점/인덱스 버퍼 뷰를 쓰므로 메시가 바뀌어도 IASetVertexBuffers/IASetIndexBuffer를 다시 하지 않는다.
+	  (나중에 ExecuteIndirect로 여러 드로우를 묶을 때도 버퍼는 하나)
+	- Add()는 스테이징 버퍼에 복사하고 구간 복사 명령을 기록한다. 스테이징은 업로드 펜스로 놓는다. (힙에 있으면 GpuHeapAllocator::Free)
+	- 앞서 제출한 프레임이 아직 그 구간을 읽고 있을 수 있으므로 Free(range, fenceValue)는 ReleaseCompleted()에서 돌려준다.
+	- 동적 정점(Waves)은 프레임 업로드 할당기에서 따로 잘라 쓴다.
+*/
+class GeometryPool
+{
+public:
+	static constexpr UINT64 DefaultVertexCapacity = 512 * 1024;
+	static constexpr UINT64 DefaultIndexCapacity = 2 * 1024 * 1024;
+
+	//풀 안에서 메시 하나가 차지하는 구간.
+	struct Range
+	{
+		UINT BaseVertex = 0;
+		UINT VertexCount = 0;
+		UINT StartIndex = 0;
+		UINT IndexCount = 0;
+	};
+
+	struct Stats
+	{
+		TlsfAllocator::Stats Vertices;	//정점 단위
+		TlsfAllocator::Stats Indices;	//인덱스 단위
+		UINT MeshCount = 0;
+		UINT PendingFrees = 0;			//펜스를 기다리는 해제
+	};
+
+	//heapAllocator가 nullptr이면 커밋 리소스로 만든다.
+	GeometryPool(ID3D12Device* device, GpuHeapAllocator* heapAllocator, UINT vertexStride,
+		UINT64 vertexCapacity = DefaultVertexCapacity, UINT64 indexCapacity = DefaultIndexCapacity);
+	GeometryPool(const GeometryPool& rhs) = delete;
+	GeometryPool& operator=(const GeometryPool& rhs) = delete;
+
+	//vertices는 vertexStride 간격. 복사 명령을 cmdList에 기록하고, 스테이징은 uploadFence가 지나면 놓는다.
+	//정점이나 인덱스 자리가 없으면 false. (아무것도 기록하지 않는다)
+	bool Add(ID3D12GraphicsCommandList* cmdList, DeferredReleaseQueue& releaseQueue, UINT64 uploadFence,
+		const void* vertices, UINT vertexCount, const std::uint32_t* indices, UINT indexCount, Range& outRange);
+	bool Add(ID3D12GraphicsCommandList* cmdList, DeferredReleaseQueue& releaseQueue, UINT64 uploadFence,
+		const void* vertices, UINT vertexCount, const std::uint16_t* indices, UINT indexCount, Range& outRange);
+
+	//Add()가 준 구간. fenceValue가 지나면 다시 쓸 수 있다. (0이면 바로)
+	void Free(const Range& range, UINT64 fenceValue = 0);
+	void ReleaseCompleted(UINT64 completedFence);
+
+	//geo가 풀 버퍼를 가리키게 한다. (정점/인덱스 버퍼, 뷰 크기, 32비트 인덱스)
+	void Bind(MeshGeometry& geo)const;
+
+	D3D12_VERTEX_BUFFER_VIEW VertexBufferView()const;
+	D3D12_INDEX_BUFFER_VIEW IndexBufferView()const;
+
+	Stats GetStats()const;
+	std::string Report()const;
+
+private:
+	Microsoft::WRL::ComPtr<ID3D12Resource> CreateBuffer(D3D12_HEAP_TYPE heapType, UINT64 byteSize, D3D12_RESOURCE_STATES initialState);
+
+private:
+	ID3D12Device* mDevice = nullptr;
+	GpuHeapAllocator* mHeapAllocator = nullptr;
+	UINT mVertexStride = 0;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> mVertexBuffer;
+	Microsoft::WRL::ComPtr<ID3D12Resource> mIndexBuffer;
+	//두 버퍼는 항상 같이 전환한다. 처음 복사 전에는 COMMON, 이후 복사가 끝나면 GENERIC_READ.
+	D3D12_RESOURCE_STATES mState = D3D12_RESOURCE_STATE_COMMON;
+
+	TlsfAllocator mVertexRanges;
+	TlsfAllocator mIndexRanges;
+
+	struct PendingFree
+	{
+		Range Mesh;
+		UINT64 Fence = 0;
+	};
+	std::vector<PendingFree> mPendingFrees;
+};
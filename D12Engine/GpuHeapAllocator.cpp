@@ -0,0 +1,222 @@
+﻿#include "GpuHeapAllocator.h"
+#include "DeferredReleaseQueue.h"
+
+#include <cstdio>
+
+using Microsoft::WRL::ComPtr;
+
+UINT64 GpuHeapAllocator::Granularity(HeapClass heapClass)
+{
+	return heapClass == HeapClass::Texture ? D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT : D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+}
+
+GpuHeapAllocator::Heap& GpuHeapAllocator::NewHeap(HeapClass heapClass)
+{
+	D3D12_HEAP_DESC desc = {};
+	desc.SizeInBytes = mBlockSize;
+	desc.Properties = CD3DX12_HEAP_PROPERTIES(heapClass == HeapClass::Upload ? D3D12_HEAP_TYPE_UPLOAD : D3D12_HEAP_TYPE_DEFAULT);
+	desc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+	desc.Flags = heapClass == HeapClass::Texture ? D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES : D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+
+	Heap heap;
+	ThrowIfFailed(mDevice->CreateHeap(&desc, IID_PPV_ARGS(heap.Resource.GetAddressOf())));
+	heap.Allocator = std::make_unique<TlsfAllocator>(mBlockSize, Granularity(heapClass));
+
+	auto& heaps = mHeaps[static_cast<std::size_t>(heapClass)];
+	heaps.push_back(std::move(heap));
+	return heaps.back();
+}
+
+GpuHeapAllocator::Heap* GpuHeapAllocator::FindHeap(HeapClass heapClass, const ID3D12Heap* heap)
+{
+	for (Heap& candidate : mHeaps[static_cast<std::size_t>(heapClass)])
+	{
+		if (candidate.Resource.Get() == heap)
+			return &candidate;
+	}
+	return nullptr;
+}
+
+ComPtr<ID3D12Resource> GpuHeapAllocator::CreateResource(D3D12_HEAP_TYPE heapType, const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES initialState)
+{
+	const bool isBuffer = desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER;
+	const HeapClass heapClass = heapType == D3D12_HEAP_TYPE_UPLOAD ? HeapClass::Upload : isBuffer ? HeapClass::Buffer : HeapClass::Texture;
+
+	//작은 텍스처는 4KB 정렬을 먼저 시도. 드라이버가 거절하면(Alignment가 다르게 나오면) 64KB.
+	D3D12_RESOURCE_DESC placedDesc = desc;
+	D3D12_RESOURCE_ALLOCATION_INFO info = {};
+	bool smallAlignment = false;
+	if (heapClass == HeapClass::Texture && desc.SampleDesc.Count <= 1)
+	{
+		placedDesc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+		info = mDevice->GetResourceAllocationInfo(0, 1, &placedDesc);
+		smallAlignment = info.Alignment == D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+		if (!smallAlignment)
+			placedDesc.Alignment = 0;
+	}
+	if (!smallAlignment)
+		info = mDevice->GetResourceAllocationInfo(0, 1, &placedDesc);
+
+	Placement placement;
+	placement.Class = heapClass;
+	placement.Size = info.SizeInBytes;
+
+	//블록보다 크면 커밋 리소스.
+	if (info.SizeInBytes > mBlockSize)
+	{
+		CD3DX12_HEAP_PROPERTIES heapProps(heapType);
+		ThrowIfFailed(mDevice->CreateCommittedResource(
+			&heapProps,
+			D3D12_HEAP_FLAG_NONE,
+			&desc,
+			initialState,
+			nullptr,
+			IID_PPV_ARGS(placement.Resource.GetAddressOf())));
+
+		mPlacements[placement.Resource.Get()] = placement;
+		return placement.Resource;
+	}
+
+	Heap* target = nullptr;
+	UINT64 offset = TlsfAllocator::InvalidOffset;
+	for (Heap& heap : mHeaps[static_cast<std::size_t>(heapClass)])
+	{
+		offset = heap.Allocator->Allocate(info.SizeInBytes, info.Alignment);
+		if (offset != TlsfAllocator::InvalidOffset)
+		{
+			target = &heap;
+			break;
+		}
+	}
+	if (target == nullptr)
+	{
+		target = &NewHeap(heapClass);
+		offset = target->Allocator->Allocate(info.SizeInBytes, info.Alignment);
+	}
+
+	const HRESULT hr = mDevice->CreatePlacedResource(
+		target->Resource.Get(),
+		offset,
+		&placedDesc,
+		initialState,
+		nullptr,
+		IID_PPV_ARGS(placement.Resource.GetAddressOf()));
+	if (FAILED(hr))
+	{
+		target->Allocator->Free(offset);
+		ThrowIfFailed(hr);
+	}
+
+	placement.Heap = target->Resource.Get();
+	placement.Offset = offset;
+	mPlacements[placement.Resource.Get()] = placement;
+	return placement.Resource;
+}
+
+void GpuHeapAllocator::Free(ComPtr<ID3D12Resource>& resource, UINT64 fenceValue)
+{
+	if (resource == nullptr)
+		return;
+
+	const auto it = mPlacements.find(resource.Get());
+	if (it == mPlacements.end())
+	{
+		mReleaseQueue.Enqueue(resource, fenceValue);
+		return;
+	}
+
+	Placement placement = std::move(it->second);
+	mPlacements.erase(it);
+	resource = nullptr;
+	if (placement.Heap != nullptr)
+		mPendingFrees.push_back({ placement.Class, placement.Heap, placement.Offset, fenceValue });
+
+	//기다릴 펜스가 없으면 리소스를 여기서 놓은 뒤에 구간을 돌려준다. (큐를 거치면 리소스가 힙보다 오래 남는다)
+	if (fenceValue == 0)
+	{
+		placement.Resource = nullptr;
+		ReleaseCompleted(0);
+		return;
+	}
+
+	//리소스 객체는 큐가 펜스까지 들고 있다. 구간은 같은 펜스로 보류.
+	mReleaseQueue.Enqueue(placement.Resource, fenceValue);
+}
+
+void GpuHeapAllocator::ReleaseCompleted(UINT64 completedFence)
+{
+	std::size_t kept = 0;
+	for (std::size_t i = 0; i < mPendingFrees.size(); i++)
+	{
+		const PendingFree& pending = mPendingFrees[i];
+		if (pending.Fence <= completedFence)
+			FindHeap(pending.Class, pending.Heap)->Allocator->Free(pending.Offset);
+		else
+			mPendingFrees[kept++] = pending;
+	}
+	mPendingFrees.resize(kept);
+
+	//비게 된 추가 블록 해제. (첫 블록은 다음 할당을 위해 남긴다)
+	for (auto& heaps : mHeaps)
+	{
+		if (heaps.size() <= 1)
+			continue;
+
+		heaps.erase(std::remove_if(heaps.begin() + 1, heaps.end(),
+			[](const Heap& heap) { return heap.Allocator->IsEmpty(); }), heaps.end());
+	}
+}
+
+GpuHeapAllocator::ClassStats GpuHeapAllocator::GetStats(HeapClass heapClass)const
+{
+	ClassStats stats;
+	float weightedFragmentation = 0.0f;
+	UINT64 freeBytes = 0;
+	for (const Heap& heap : mHeaps[static_cast<std::size_t>(heapClass)])
+	{
+		const TlsfAllocator::Stats heapStats = heap.Allocator->GetStats();
+		stats.HeapCount++;
+		stats.HeapBytes += heapStats.Size;
+		stats.UsedBytes += heapStats.UsedBytes;
+		stats.AllocationCount += heapStats.AllocationCount;
+		stats.FreeBlockCount += heapStats.FreeBlockCount;
+		stats.LargestFreeBlock = (std::max)(stats.LargestFreeBlock, heapStats.LargestFreeBlock);
+		weightedFragmentation += heapStats.Fragmentation() * float(heapStats.FreeBytes);
+		freeBytes += heapStats.FreeBytes;
+	}
+	stats.Fragmentation = freeBytes ? weightedFragmentation / float(freeBytes) : 0.0f;
+
+	for (const auto& [resource, placement] : mPlacements)
+	{
+		if (placement.Class == heapClass && placement.Heap == nullptr)
+		{
+			stats.CommittedCount++;
+			stats.CommittedBytes += placement.Size;
+		}
+	}
+	for (const PendingFree& pending : mPendingFrees)
+	{
+		if (pending.Class == heapClass)
+			stats.PendingFrees++;
+	}
+	return stats;
+}
+
+std::string GpuHeapAllocator::Report()const
+{
+	static const char* const names[] = { "buffer", "texture", "upload" };
+
+	std::string report;
+	char line[256];
+	for (std::size_t i = 0; i < static_cast<std::size_t>(HeapClass::Count); i++)
+	{
+		const ClassStats stats = GetStats(static_cast<HeapClass>(i));
+		std::snprintf(line, sizeof(line), "gpu heap %s: %u heaps, %llu/%llu bytes used by %u resources (%u pending free), %u free blocks (largest %llu, fragmentation %.2f), %u committed (%llu bytes)\n",
+			names[i], stats.HeapCount,
+			static_cast<unsigned long long>(stats.UsedBytes), static_cast<unsigned long long>(stats.HeapBytes), stats.AllocationCount, stats.PendingFrees,
+			stats.FreeBlockCount, static_cast<unsigned long long>(stats.LargestFreeBlock), stats.Fragmentation,
+			stats.CommittedCount, static_cast<unsigned long long>(stats.CommittedBytes));
+		report += line;
+	}
+	return report;
+}
@@ -0,0 +1,109 @@
+﻿#pragma once
+
+#include "d3dUtil.h"
+#include "TlsfAllocator.h"
+
+class DeferredReleaseQueue;
+
+/*
+	큰 ID3D12Heap 블록을 잡아 두고 그 안에 리소스를 배치(placed)하는 할당기.
+
+	- 리소스 종류별로 힙을 나눈다. (Tier 1 하드웨어는 버퍼와 텍스처를 한 힙에 둘 수 없다)
+	    Buffer  : DEFAULT 힙, 버퍼 전용, 64KB 정렬 (정점/인덱스 버퍼)
+	    Texture : DEFAULT 힙, RT/DS가 아닌 텍스처 전용. 작은 텍스처는 4KB 정렬, 나머지는 64KB 정렬
+	    Upload  : UPLOAD 힙, 버퍼 전용, 64KB 정렬 (CreateDefaultBuffer의 스테이징)
+	- 힙 안의 구간은 TlsfAllocator가 관리한다. 기존 힙에 자리가 없으면 블록을 하나 더 만든다.
+	  블록보다 큰 리소스는 커밋 리소스로 만든다.
+	- 다 쓴 리소스는 Free(resource, fenceValue)로 돌려준다. 리소스는 DeferredReleaseQueue에 같은 펜스로 넘기고,
+	  구간은 ReleaseCompleted()에서 펜스가 지난 것만 TLSF로 돌린다. (리소스를 하나씩 검사하지 않는다)
+	  Free() 없이 놓은 리소스는 할당기가 참조를 들고 있으므로 할당기가 사라질 때까지 구간이 돌아오지 않는다.
+	- 비게 된 추가 블록은 ReleaseCompleted()에서 해제한다. 종류마다 첫 블록은 남겨 둔다.
+	- 통계: 종류별 블록 수/크기, 사용 바이트, 빈 블록 수, 단편화 비율 (조각 모음 판단용)
+*/
+class GpuHeapAllocator
+{
+public:
+	enum class HeapClass : std::uint8_t
+	{
+		Buffer,
+		Texture,
+		Upload,
+		Count
+	};
+
+	struct ClassStats
+	{
+		UINT HeapCount = 0;
+		UINT64 HeapBytes = 0;
+		UINT64 UsedBytes = 0;
+		UINT AllocationCount = 0;
+		UINT FreeBlockCount = 0;
+		UINT64 LargestFreeBlock = 0;
+		float Fragmentation = 0.0f;		//힙별 TlsfAllocator::Stats::Fragmentation의 바이트 가중 평균
+		UINT CommittedCount = 0;		//블록보다 커서 커밋 리소스로 만든 것
+		UINT64 CommittedBytes = 0;
+		UINT PendingFrees = 0;			//펜스를 기다리는 해제
+	};
+
+	static constexpr UINT64 DefaultBlockSize = 32 * 1024 * 1024;
+
+	//releaseQueue는 할당기보다 오래 살아야 한다.
+	GpuHeapAllocator(ID3D12Device* device, DeferredReleaseQueue& releaseQueue, UINT64 blockSize = DefaultBlockSize) :
+		mDevice(device), mReleaseQueue(releaseQueue), mBlockSize(blockSize) {}
+	GpuHeapAllocator(const GpuHeapAllocator& rhs) = delete;
+	GpuHeapAllocator& operator=(const GpuHeapAllocator& rhs) = delete;
+
+	//heapType은 DEFAULT 또는 UPLOAD. 렌더 타깃/깊이 스텐실 텍스처는 지원하지 않는다.
+	Microsoft::WRL::ComPtr<ID3D12Resource> CreateResource(
+		D3D12_HEAP_TYPE heapType,
+		const D3D12_RESOURCE_DESC& desc,
+		D3D12_RESOURCE_STATES initialState);
+
+	//CreateResource()가 준 리소스. resource는 비워진다. fenceValue가 지나면 구간을 다시 쓴다. (0이면 바로)
+	//이 할당기가 만들지 않은 리소스는 releaseQueue로만 넘긴다. Free() 뒤에는 다른 곳에 남은 참조로도 쓰지 않는다.
+	void Free(Microsoft::WRL::ComPtr<ID3D12Resource>& resource, UINT64 fenceValue);
+	//펜스가 지난 구간을 돌려주고 비게 된 추가 블록을 해제한다. 프레임마다 한 번.
+	//releaseQueue.ReleaseCompleted()를 같은 completedFence로 먼저 불러야 한다. (그 구간의 리소스가 먼저 놓이도록)
+	void ReleaseCompleted(UINT64 completedFence);
+
+	ClassStats GetStats(HeapClass heapClass)const;
+	std::string Report()const;
+
+private:
+	struct Heap
+	{
+		Microsoft::WRL::ComPtr<ID3D12Heap> Resource;
+		std::unique_ptr<TlsfAllocator> Allocator;
+	};
+
+	struct Placement
+	{
+		Microsoft::WRL::ComPtr<ID3D12Resource> Resource;
+		HeapClass Class = HeapClass::Buffer;
+		ID3D12Heap* Heap = nullptr;		//nullptr이면 커밋 리소스
+		UINT64 Offset = 0;
+		UINT64 Size = 0;
+	};
+
+	struct PendingFree
+	{
+		HeapClass Class = HeapClass::Buffer;
+		ID3D12Heap* Heap = nullptr;
+		UINT64 Offset = 0;
+		UINT64 Fence = 0;
+	};
+
+	//Texture 힙은 작은 텍스처 정렬(4KB)로 나눈다. 나머지는 64KB.
+	static UINT64 Granularity(HeapClass heapClass);
+	Heap& NewHeap(HeapClass heapClass);
+	Heap* FindHeap(HeapClass heapClass, const ID3D12Heap* heap);
+
+private:
+	ID3D12Device* mDevice = nullptr;
+	DeferredReleaseQueue& mReleaseQueue;
+	UINT64 mBlockSize = 0;
+
+	std::vector<Heap> mHeaps[static_cast<std::size_t>(HeapClass::Count)];
+	std::unordered_map<ID3D12Resource*, Placement> mPlacements;
+	std::vector<PendingFree> mPendingFrees;
+};
@@ -1,7 +1,7 @@
 #pragma once
 
-//  忡 C Runtime c/c++  Ҵ  ϰ .
-// α׷   ޸   .
+// 디버그 빌드에서만 C Runtime에 c/c++ 힙 할당을 추적 가능하게 만듦.
+// 프로그램 종료 시 메모리 누수 보고서를 출력함.
 #if defined(DEBUG) || defined(_DEBUG)
 #define _CRTDBG_MAP_ALLOC
 #include <crtdbg.h>
@@ -10,12 +10,12 @@
 #include "d3dUtil.h"
 #include "GameTimer.h"
 
-//Ŀ ؼ ϰ, Ģ .h δ  ߺ ũ ִ.
-// cpp .
+//링커가 병합해서 무시하겠지만, 원칙상으로 .h에 두는 것은 중복 링크위험이 있다.
+//추후 cpp로 이전.
 #pragma comment (lib, "d3dcompiler.lib")
 #pragma comment (lib, "d3d12.lib")
 #pragma comment (lib, "dxgi.lib")
-#pragma comment (lib, "dxguid.lib")	//  ڵ忣  ʼ ߰ ־ . d3dx12.h ȭǾ.
+#pragma comment (lib, "dxguid.lib")	// 예제 코드엔 없지만 필수적으로 추가 해주어야 함. d3dx12.h가 변화되었음.
 
 struct WinHandle
 {
@@ -77,10 +77,10 @@ protected:
 
 	D3D12_CPU_DESCRIPTOR_HANDLE CurrentBackBufferView()const
 	{
-		// RTV  SwapChainBufferCount  RTV  ġǾ ִ.
-		//   CPU ڵ 
-		// (  ε  RTV ũ ũ) ŭ  
-		//  ۿ ϴ RTV CPU ũ ڵ ȯѴ.
+		// RTV 힙에는 SwapChainBufferCount 개의 RTV가 연속으로 배치되어 있다.
+		// 힙의 시작 CPU 핸들을 기준으로
+		// (현재 백버퍼 인덱스 × RTV 디스크립터 크기) 만큼 오프셋을 적용해
+		// 현재 백버퍼에 대응하는 RTV CPU 디스크립터 핸들을 반환한다.
 		return CD3DX12_CPU_DESCRIPTOR_HANDLE(mRtvHeap->GetCPUDescriptorHandleForHeapStart(),
 			mCurrBackBuffer, mRtvDescriptorSize);
 	}
@@ -102,8 +102,8 @@ protected:
 	bool mResizing = false;
 	GameTimer mTimer;
 
-	bool m4xMsaaState = false; //4x MSAA Ȱȭ 
-	UINT m4xMsaaQuality = 0; //Ǵ 4x MSAA ǰ 
+	bool m4xMsaaState = false; //4x MSAA 활성화 여부
+	UINT m4xMsaaQuality = 0; //지원되는 4x MSAA 품질 수준
 
 	Microsoft::WRL::ComPtr<IDXGIFactory4> mdxgiFactory;
 	Microsoft::WRL::ComPtr<ID3D12Device> md3dDevice;
@@ -0,0 +1,62 @@
+﻿#include "LinearAllocator.h"
+
+#include <algorithm>
+
+namespace
+{
+	inline std::uint64_t AlignUp(std::uint64_t v, std::uint64_t alignment)
+	{
+		return (v + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+LinearAllocator::LinearAllocator(std::uint64_t pageSize) : mPageSize(pageSize)
+{
+	mPages.push_back(mPageSize);
+}
+
+LinearAllocator::Allocation LinearAllocator::Allocate(std::uint64_t size, std::uint64_t alignment)
+{
+	std::uint64_t offset = AlignUp(mHead, alignment);
+	if (offset + size > mPages[mCurrentPage])
+	{
+		//남은 페이지 중 들어가는 것이 없으면 새로 연다. 현재 페이지의 남은 공간은 버린다.
+		mUsed += mPages[mCurrentPage] - mHead;
+		mCurrentPage++;
+		while (mCurrentPage < mPages.size() && size > mPages[mCurrentPage])
+		{
+			mUsed += mPages[mCurrentPage];
+			mCurrentPage++;
+		}
+		if (mCurrentPage == mPages.size())
+			mPages.push_back(AlignUp((std::max)(mPageSize, size), mPageSize));
+
+		mHead = 0;
+		offset = 0;
+	}
+
+	Allocation allocation;
+	allocation.Page = mCurrentPage;
+	allocation.Offset = offset;
+
+	mUsed += offset + size - mHead;
+	mHead = offset + size;
+	mPeak = (std::max)(mPeak, mUsed);
+	return allocation;
+}
+
+bool LinearAllocator::Reset()
+{
+	//여러 페이지를 썼으면 다음 프레임에는 가장 많이 쓴 만큼 들어가는 한 페이지로.
+	bool changed = false;
+	if (mPages.size() > 1)
+	{
+		mPages.assign(1, AlignUp((std::max)(mPeak, mPageSize), mPageSize));
+		changed = true;
+	}
+
+	mCurrentPage = 0;
+	mHead = 0;
+	mUsed = 0;
+	return changed;
+}
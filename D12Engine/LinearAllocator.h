@@ -0,0 +1,49 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+	페이지 단위 선형(bump) 할당 정책. 실제 메모리는 모른다. (GPU 쪽은 FrameUploadAllocator)
+
+	Allocate() : 현재 페이지의 머리에서 정렬된 구간을 잘라 준다. 모자라면 새 페이지를 연다. (항상 성공)
+	             새 페이지 크기는 PageSize와 요청 크기 중 큰 값. 정렬은 페이지 시작 기준.
+	Reset()    : 모든 할당을 한 번에 돌려준다. (프레임 펜스가 지난 뒤)
+	             여러 페이지를 썼으면 다음부터는 그만큼 들어가는 페이지 하나로 합친다.
+	             페이지 구성이 바뀌면 true. (쓰는 쪽이 페이지 메모리를 다시 만든다)
+
+	고정된 최대 개수가 없고, 몇 프레임이 지나면 한 프레임 사용량이 페이지 하나에 들어간다.
+*/
+class LinearAllocator
+{
+public:
+	static constexpr std::uint64_t DefaultPageSize = 64 * 1024;
+
+	struct Allocation
+	{
+		std::uint32_t Page = 0;
+		std::uint64_t Offset = 0;	//페이지 시작 기준
+	};
+
+	explicit LinearAllocator(std::uint64_t pageSize = DefaultPageSize);
+
+	//alignment는 2의 거듭제곱. size가 0이어도 정렬된 위치를 준다.
+	Allocation Allocate(std::uint64_t size, std::uint64_t alignment);
+	bool Reset();
+
+	std::size_t PageCount()const { return mPages.size(); }
+	std::uint64_t PageSize(std::size_t page)const { return mPages[page]; }
+	//지난 Reset() 이후 정렬 여백을 포함해 쓴 바이트 수.
+	std::uint64_t UsedBytes()const { return mUsed; }
+	//지금까지 한 번에 가장 많이 쓴 바이트 수.
+	std::uint64_t PeakBytes()const { return mPeak; }
+
+private:
+	std::uint64_t mPageSize = DefaultPageSize;
+	std::vector<std::uint64_t> mPages;	//페이지 크기
+	std::uint32_t mCurrentPage = 0;
+	std::uint64_t mHead = 0;
+	std::uint64_t mUsed = 0;
+	std::uint64_t mPeak = 0;
+};
@@ -0,0 +1,150 @@
+﻿#include "MappedFile.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept
+{
+	MoveFrom(rhs);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept
+{
+	if (this != &rhs)
+	{
+		Close();
+		MoveFrom(rhs);
+	}
+	return *this;
+}
+
+void MappedFile::MoveFrom(MappedFile& rhs) noexcept
+{
+#if defined(_WIN32)
+	mFile = rhs.mFile;			rhs.mFile = nullptr;
+	mMapping = rhs.mMapping;	rhs.mMapping = nullptr;
+#else
+	mFd = rhs.mFd;				rhs.mFd = -1;
+#endif
+	mData = rhs.mData;			rhs.mData = nullptr;
+	mSize = rhs.mSize;			rhs.mSize = 0;
+	mIsOpen = rhs.mIsOpen;		rhs.mIsOpen = false;
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::Open(const std::filesystem::path& path)
+{
+	Close();
+
+	//순차 접근 힌트를 주면 OS의 read-ahead가 커진다.
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize = {};
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	mFile = file;
+	mSize = static_cast<std::size_t>(fileSize.QuadPart);
+	mIsOpen = true;
+
+	//크기 0인 파일은 매핑을 만들 수 없다.
+	if (mSize == 0)
+		return true;
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr)
+	{
+		Close();
+		return false;
+	}
+	mMapping = mapping;
+
+	mData = static_cast<const std::uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (mData == nullptr)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (mData)
+		UnmapViewOfFile(mData);
+	if (mMapping)
+		CloseHandle(mMapping);
+	if (mFile)
+		CloseHandle(mFile);
+
+	mData = nullptr;
+	mMapping = nullptr;
+	mFile = nullptr;
+	mSize = 0;
+	mIsOpen = false;
+}
+
+#else
+
+bool MappedFile::Open(const std::filesystem::path& path)
+{
+	Close();
+
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st = {};
+	if (::fstat(fd, &st) != 0)
+	{
+		::close(fd);
+		return false;
+	}
+
+	mFd = fd;
+	mSize = static_cast<std::size_t>(st.st_size);
+	mIsOpen = true;
+
+	if (mSize == 0)
+		return true;
+
+	void* p = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (p == MAP_FAILED)
+	{
+		Close();
+		return false;
+	}
+	::madvise(p, mSize, MADV_SEQUENTIAL);
+
+	mData = static_cast<const std::uint8_t*>(p);
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (mData)
+		::munmap(const_cast<std::uint8_t*>(mData), mSize);
+	if (mFd >= 0)
+		::close(mFd);
+
+	mData = nullptr;
+	mFd = -1;
+	mSize = 0;
+	mIsOpen = false;
+}
+
+#endif
@@ -0,0 +1,48 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+/*
+	읽기 전용 메모리 매핑 파일.
+	파일 전체를 한 번에 주소 공간에 올리고, 실제 페이지는 접근할 때 OS가 읽어 온다.
+	힙 복사본이 없으므로 파서/로더가 매핑된 포인터를 그대로 사용할 수 있다.
+	Win32는 CreateFileMapping, 그 외 플랫폼은 POSIX mmap을 사용.
+*/
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	explicit MappedFile(const std::filesystem::path& path) { Open(path); }
+	MappedFile(const MappedFile& rhs) = delete;
+	MappedFile& operator=(const MappedFile& rhs) = delete;
+	MappedFile(MappedFile&& rhs) noexcept;
+	MappedFile& operator=(MappedFile&& rhs) noexcept;
+	~MappedFile() { Close(); }
+
+	//실패 시 false. 크기가 0인 파일은 열리지만 Data()가 nullptr.
+	bool Open(const std::filesystem::path& path);
+	void Close();
+
+	bool IsOpen()const { return mIsOpen; }
+	const std::uint8_t* Data()const { return mData; }
+	std::size_t Size()const { return mSize; }
+
+	const char* Begin()const { return reinterpret_cast<const char*>(mData); }
+	const char* End()const { return reinterpret_cast<const char*>(mData) + mSize; }
+
+private:
+	void MoveFrom(MappedFile& rhs) noexcept;
+
+private:
+#if defined(_WIN32)
+	void* mFile = nullptr;		//HANDLE
+	void* mMapping = nullptr;	//HANDLE
+#else
+	int mFd = -1;
+#endif
+	const std::uint8_t* mData = nullptr;
+	std::size_t mSize = 0;
+	bool mIsOpen = false;
+};
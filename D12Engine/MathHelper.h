@@ -57,8 +57,8 @@ public:
 		return I;
 	}
 
-	// ǥ ->  ǥ
-	// phi : ذ / theta :  , ع +X / Y-up 
+	//구면 좌표 -> 직교 좌표
+	// phi : 극각 / theta : 수평 방위각, 기준방향 +X축 / Y-up 축
 	static DirectX::XMVECTOR SphericalToCatesian(float radius, float theta, float phi)
 	{
 		return DirectX::XMVectorSet(
@@ -68,7 +68,7 @@ public:
 			1.0f);
 	}
 
-	//  ...
+	// 공부 예정...
 	static DirectX::XMMATRIX InverseTranspose(DirectX::CXMMATRIX M)
 	{
 		// Inverse-transpose is just applied to normals.  So zero out 
@@ -81,7 +81,7 @@ public:
 		return DirectX::XMMatrixTranspose(DirectX::XMMatrixInverse(&det, A));
 	}
 
-	//+X  . [0, 2*PI)
+	//+X축 기준 각도. [0, 2*PI)
 	static float AngleFromXY(float x, float y);
 	static DirectX::XMVECTOR RandUnitVec3();
 	static DirectX::XMVECTOR RandHemisphereUnitVec3(DirectX::XMVECTOR n);
@@ -0,0 +1,330 @@
+﻿#include "MeshFile.h"
+#include "AssetCache.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+	inline std::uint64_t AlignUp(std::uint64_t v, std::uint64_t alignment)
+	{
+		return (v + alignment - 1) & ~(alignment - 1);
+	}
+
+	//[offset, offset + size)가 파일 안에 있는지. 오버플로 포함.
+	inline bool InRange(std::uint64_t offset, std::uint64_t size, std::uint64_t fileSize)
+	{
+		return offset <= fileSize && size <= fileSize - offset;
+	}
+
+	void Grow(DirectX::XMFLOAT3& mn, DirectX::XMFLOAT3& mx, const DirectX::XMFLOAT3& p)
+	{
+		mn.x = (std::min)(mn.x, p.x); mn.y = (std::min)(mn.y, p.y); mn.z = (std::min)(mn.z, p.z);
+		mx.x = (std::max)(mx.x, p.x); mx.y = (std::max)(mx.y, p.y); mx.z = (std::max)(mx.z, p.z);
+	}
+
+	void ToCenterExtents(const DirectX::XMFLOAT3& mn, const DirectX::XMFLOAT3& mx, float center[3], float extents[3])
+	{
+		center[0] = 0.5f * (mn.x + mx.x);
+		center[1] = 0.5f * (mn.y + mx.y);
+		center[2] = 0.5f * (mn.z + mx.z);
+		extents[0] = 0.5f * (mx.x - mn.x);
+		extents[1] = 0.5f * (mx.y - mn.y);
+		extents[2] = 0.5f * (mx.z - mn.z);
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// MeshFile (읽기)
+//--------------------------------------------------------------------------------------
+
+bool MeshFile::Open(const std::filesystem::path& path)
+{
+	Close();
+
+	if (!mFile.Open(path) || mFile.Size() < sizeof(MeshFileHeader))
+	{
+		mFile.Close();
+		return false;
+	}
+
+	mHeader = At<MeshFileHeader>(0);
+	if (!Validate())
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+bool MeshFile::SourceHash(const std::vector<std::filesystem::path>& sources, std::uint64_t& outHash)
+{
+	AssetCache& cache = AssetCache::Default();
+
+	outHash = 0;
+	for (std::size_t i = 0; i < sources.size(); i++)
+	{
+		std::uint64_t hash = 0;
+		if (!cache.HashFile(sources[i], hash))
+			return false;
+		outHash = i == 0 ? hash : AssetCache::Combine(outHash, hash);
+	}
+	return !sources.empty();
+}
+
+void MeshFile::Close()
+{
+	mHeader = nullptr;
+	mFile.Close();
+}
+
+bool MeshFile::Validate()const
+{
+	const MeshFileHeader& h = *mHeader;
+	const std::uint64_t fileSize = mFile.Size();
+
+	if (h.Magic != Magic || h.Version != Version || h.HeaderSize != sizeof(MeshFileHeader))
+		return false;
+	if (h.FileSize != fileSize)
+		return false;
+	if (h.VertexStride != sizeof(MeshFileVertex) || h.VertexLayout != MESHFILE_LAYOUT_POS_NORMAL_TEX)
+		return false;
+	if (h.IndexStride != 2 && h.IndexStride != 4)
+		return false;
+
+	//곱셈 오버플로 방지를 위해 개수 상한을 먼저 확인.
+	if (h.VertexCount > fileSize / h.VertexStride || h.IndexCount > fileSize / h.IndexStride)
+		return false;
+
+	if (h.VertexDataOffset % SectionAlignment != 0 || h.IndexDataOffset % SectionAlignment != 0)
+		return false;
+	if (!InRange(h.VertexDataOffset, h.VertexCount * h.VertexStride, fileSize) ||
+		!InRange(h.IndexDataOffset, h.IndexCount * h.IndexStride, fileSize) ||
+		!InRange(h.SubmeshTableOffset, std::uint64_t(h.SubmeshCount) * sizeof(MeshFileSubmesh), fileSize) ||
+		!InRange(h.LodTableOffset, std::uint64_t(h.LodCount) * sizeof(MeshFileLod), fileSize) ||
+		!InRange(h.StringTableOffset, h.StringTableSize, fileSize))
+		return false;
+	if (h.SubmeshTableOffset % alignof(MeshFileSubmesh) != 0 || h.LodTableOffset % alignof(MeshFileLod) != 0)
+		return false;
+
+	//서브메시/LOD가 가리키는 범위 검사. 이후에는 드로우 인자를 그대로 믿어도 된다.
+	auto checkRange = [&h](std::uint32_t indexCount, std::uint32_t startIndex)
+		{
+			return std::uint64_t(startIndex) + indexCount <= h.IndexCount;
+		};
+
+	for (const MeshFileSubmesh& sm : Submeshes())
+	{
+		if (!checkRange(sm.IndexCount, sm.StartIndexLocation))
+			return false;
+		if (std::uint64_t(sm.NameOffset) + sm.NameLength >= h.StringTableSize)
+			return false;
+		if (std::uint64_t(sm.FirstLod) + sm.LodCount > h.LodCount)
+			return false;
+
+		for (const MeshFileLod& lod : Lods(sm))
+		{
+			if (!checkRange(lod.IndexCount, lod.StartIndexLocation))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+MeshFileSpan<MeshFileVertex> MeshFile::Vertices()const
+{
+	return { At<MeshFileVertex>(mHeader->VertexDataOffset), static_cast<std::size_t>(mHeader->VertexCount) };
+}
+
+const void* MeshFile::IndexData()const
+{
+	return mFile.Data() + mHeader->IndexDataOffset;
+}
+
+std::uint64_t MeshFile::IndexDataByteSize()const
+{
+	return mHeader->IndexCount * mHeader->IndexStride;
+}
+
+MeshFileSpan<MeshFileSubmesh> MeshFile::Submeshes()const
+{
+	return { At<MeshFileSubmesh>(mHeader->SubmeshTableOffset), mHeader->SubmeshCount };
+}
+
+MeshFileSpan<MeshFileLod> MeshFile::Lods(const MeshFileSubmesh& submesh)const
+{
+	return { At<MeshFileLod>(mHeader->LodTableOffset) + submesh.FirstLod, submesh.LodCount };
+}
+
+std::string_view MeshFile::SubmeshName(const MeshFileSubmesh& submesh)const
+{
+	return { At<char>(mHeader->StringTableOffset + submesh.NameOffset), submesh.NameLength };
+}
+
+const MeshFileSubmesh* MeshFile::FindSubmesh(std::string_view name)const
+{
+	for (const MeshFileSubmesh& sm : Submeshes())
+	{
+		if (SubmeshName(sm) == name)
+			return &sm;
+	}
+	return nullptr;
+}
+
+//--------------------------------------------------------------------------------------
+// MeshFileSource (쓰기)
+//--------------------------------------------------------------------------------------
+
+namespace
+{
+	//메시를 src 끝에 붙이고 (BaseVertexLocation, StartIndexLocation, IndexCount)를 돌려준다.
+	void AppendMesh(MeshFileSource& src, const GeometryGenerator::MeshData& mesh,
+		std::int32_t& baseVertex, std::uint32_t& startIndex, std::uint32_t& indexCount,
+		DirectX::XMFLOAT3& bmin, DirectX::XMFLOAT3& bmax)
+	{
+		baseVertex = static_cast<std::int32_t>(src.Vertices.size());
+		startIndex = static_cast<std::uint32_t>(src.Indices.size());
+		indexCount = static_cast<std::uint32_t>(mesh.Indices32.size());
+
+		bmin = { FLT_MAX, FLT_MAX, FLT_MAX };
+		bmax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+		src.Vertices.reserve(src.Vertices.size() + mesh.Vertices.size());
+		for (const auto& v : mesh.Vertices)
+		{
+			src.Vertices.push_back({ v.Position, v.Normal, v.TexC });
+			Grow(bmin, bmax, v.Position);
+		}
+		if (mesh.Vertices.empty())
+			bmin = bmax = { 0.0f, 0.0f, 0.0f };
+
+		src.Indices.insert(src.Indices.end(), mesh.Indices32.begin(), mesh.Indices32.end());
+	}
+}
+
+std::size_t MeshFileSource::AddSubmesh(const std::string& name, const GeometryGenerator::MeshData& mesh)
+{
+	Submesh sm;
+	sm.Name = name;
+	AppendMesh(*this, mesh, sm.BaseVertexLocation, sm.StartIndexLocation, sm.IndexCount, sm.BoundsMin, sm.BoundsMax);
+
+	Submeshes.push_back(std::move(sm));
+	return Submeshes.size() - 1;
+}
+
+void MeshFileSource::AddLod(std::size_t submeshIndex, const GeometryGenerator::MeshData& mesh, float screenSize)
+{
+	Lod lod;
+	lod.ScreenSize = screenSize;
+
+	DirectX::XMFLOAT3 bmin, bmax;
+	AppendMesh(*this, mesh, lod.BaseVertexLocation, lod.StartIndexLocation, lod.IndexCount, bmin, bmax);
+
+	Submeshes[submeshIndex].Lods.push_back(lod);
+}
+
+bool MeshFileSource::Write(const std::filesystem::path& path)const
+{
+	std::uint32_t maxIndex = 0;
+	for (std::uint32_t i : Indices)
+		maxIndex = (std::max)(maxIndex, i);
+	const std::uint32_t indexStride = (maxIndex <= 0xffff) ? 2 : 4;
+
+	//문자열 테이블 / LOD 테이블 구성.
+	std::string strings;
+	std::vector<MeshFileSubmesh> submeshTable;
+	std::vector<MeshFileLod> lodTable;
+
+	DirectX::XMFLOAT3 bmin = { FLT_MAX, FLT_MAX, FLT_MAX };
+	DirectX::XMFLOAT3 bmax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	for (const Submesh& sm : Submeshes)
+	{
+		MeshFileSubmesh e = {};
+		e.NameOffset = static_cast<std::uint32_t>(strings.size());
+		e.NameLength = static_cast<std::uint32_t>(sm.Name.size());
+		e.IndexCount = sm.IndexCount;
+		e.StartIndexLocation = sm.StartIndexLocation;
+		e.BaseVertexLocation = sm.BaseVertexLocation;
+		e.FirstLod = static_cast<std::uint32_t>(lodTable.size());
+		e.LodCount = static_cast<std::uint32_t>(sm.Lods.size());
+		ToCenterExtents(sm.BoundsMin, sm.BoundsMax, e.BoundsCenter, e.BoundsExtents);
+		submeshTable.push_back(e);
+
+		strings += sm.Name;
+		strings.push_back('\0');
+
+		for (const Lod& lod : sm.Lods)
+			lodTable.push_back({ lod.IndexCount, lod.StartIndexLocation, lod.BaseVertexLocation, lod.ScreenSize });
+
+		Grow(bmin, bmax, sm.BoundsMin);
+		Grow(bmin, bmax, sm.BoundsMax);
+	}
+	if (Submeshes.empty())
+		bmin = bmax = { 0.0f, 0.0f, 0.0f };
+
+	MeshFileHeader h = {};
+	h.Magic = MeshFile::Magic;
+	h.Version = MeshFile::Version;
+	h.HeaderSize = sizeof(MeshFileHeader);
+	h.VertexStride = sizeof(MeshFileVertex);
+	h.VertexLayout = MESHFILE_LAYOUT_POS_NORMAL_TEX;
+	h.VertexCount = Vertices.size();
+	h.IndexStride = indexStride;
+	h.IndexCount = Indices.size();
+	h.SubmeshCount = static_cast<std::uint32_t>(submeshTable.size());
+	h.LodCount = static_cast<std::uint32_t>(lodTable.size());
+	h.StringTableSize = static_cast<std::uint32_t>(strings.size());
+	ToCenterExtents(bmin, bmax, h.BoundsCenter, h.BoundsExtents);
+	h.SourceHash = SourceHash;
+
+	//레이아웃 배치.
+	std::uint64_t offset = sizeof(MeshFileHeader);
+	h.SubmeshTableOffset = offset;
+	offset += submeshTable.size() * sizeof(MeshFileSubmesh);
+	h.LodTableOffset = offset;
+	offset += lodTable.size() * sizeof(MeshFileLod);
+	h.StringTableOffset = offset;
+	offset += strings.size();
+	h.VertexDataOffset = AlignUp(offset, MeshFile::SectionAlignment);
+	offset = h.VertexDataOffset + Vertices.size() * sizeof(MeshFileVertex);
+	h.IndexDataOffset = AlignUp(offset, MeshFile::SectionAlignment);
+	offset = h.IndexDataOffset + Indices.size() * indexStride;
+	h.FileSize = offset;
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (!out)
+		return false;
+
+	auto padTo = [&out](std::uint64_t target)
+		{
+			static const char zeros[MeshFile::SectionAlignment] = {};
+			std::uint64_t pos = static_cast<std::uint64_t>(out.tellp());
+			out.write(zeros, static_cast<std::streamsize>(target - pos));
+		};
+
+	out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+	out.write(reinterpret_cast<const char*>(submeshTable.data()), submeshTable.size() * sizeof(MeshFileSubmesh));
+	out.write(reinterpret_cast<const char*>(lodTable.data()), lodTable.size() * sizeof(MeshFileLod));
+	out.write(strings.data(), strings.size());
+
+	padTo(h.VertexDataOffset);
+	out.write(reinterpret_cast<const char*>(Vertices.data()), Vertices.size() * sizeof(MeshFileVertex));
+
+	padTo(h.IndexDataOffset);
+	if (indexStride == 2)
+	{
+		std::vector<std::uint16_t> indices16(Indices.begin(), Indices.end());
+		out.write(reinterpret_cast<const char*>(indices16.data()), indices16.size() * sizeof(std::uint16_t));
+	}
+	else
+	{
+		out.write(reinterpret_cast<const char*>(Indices.data()), Indices.size() * sizeof(std::uint32_t));
+	}
+
+	return out.good();
+}
@@ -0,0 +1,208 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <DirectXMath.h>
+
+#include "GeometryGenerator.h"
+#include "MappedFile.h"
+
+/*
+	.d12mesh 바이너리 메시 컨테이너 (리틀 엔디언, 버전 관리).
+
+	[MeshFileHeader]
+	[MeshFileSubmesh x SubmeshCount]
+	[MeshFileLod     x LodCount]
+	[문자열 테이블 (서브메시 이름, '\0' 종료)]
+	(64바이트 정렬) [정점 스트림]  MeshFileVertex x VertexCount  (= 엔진 Vertex 레이아웃)
+	(64바이트 정렬) [인덱스 스트림] uint16 또는 uint32 x IndexCount
+
+	모든 오프셋은 파일 시작 기준. 정점/인덱스 구간은 GPU 버퍼 내용 그대로이므로
+	매핑한 포인터를 파싱이나 복사 없이 업로드 경로(CreateDefaultBuffer)에 넘길 수 있다.
+
+	변환 결과물이므로 저장소에 넣지 않는다. (Tools/MeshConverter로 만든다)
+	헤더의 SourceHash는 변환에 쓴 입력 파일들의 내용 해시. 읽는 쪽은 원본의 현재 해시와
+	비교해서 다르면 파일을 버리고 원본을 쓴다. (MeshFile::SourceHash())
+*/
+
+//정점 레이아웃. 엔진 Vertex(Pos, Normal, TexC)와 같아야 한다.
+struct MeshFileVertex
+{
+	DirectX::XMFLOAT3 Pos;
+	DirectX::XMFLOAT3 Normal;
+	DirectX::XMFLOAT2 TexC;
+};
+
+enum MeshFileVertexLayout : std::uint32_t
+{
+	MESHFILE_LAYOUT_POS_NORMAL_TEX = 1,
+};
+
+struct MeshFileHeader
+{
+	std::uint32_t Magic;
+	std::uint32_t Version;
+	std::uint32_t HeaderSize;
+	std::uint32_t Flags;
+	std::uint64_t FileSize;
+
+	std::uint32_t VertexStride;
+	std::uint32_t VertexLayout;
+	std::uint64_t VertexCount;
+	std::uint64_t VertexDataOffset;
+
+	std::uint32_t IndexStride;		//2 또는 4
+	std::uint32_t Reserved0;
+	std::uint64_t IndexCount;
+	std::uint64_t IndexDataOffset;
+
+	std::uint32_t SubmeshCount;
+	std::uint32_t LodCount;
+	std::uint64_t SubmeshTableOffset;
+	std::uint64_t LodTableOffset;
+	std::uint64_t StringTableOffset;
+	std::uint32_t StringTableSize;
+	std::uint32_t Reserved1;
+
+	//전체 메시의 AABB.
+	float BoundsCenter[3];
+	float BoundsExtents[3];
+
+	std::uint64_t SourceHash;		//입력 파일 내용 해시. 0이면 모름
+};
+
+//SubmeshGeometry와 같은 의미. 자체 값은 LOD0.
+struct MeshFileSubmesh
+{
+	std::uint32_t NameOffset;		//문자열 테이블 내 오프셋
+	std::uint32_t NameLength;
+	std::uint32_t IndexCount;
+	std::uint32_t StartIndexLocation;
+	std::int32_t BaseVertexLocation;
+	std::uint32_t FirstLod;			//LOD 테이블 내 시작 (LOD1부터)
+	std::uint32_t LodCount;
+	std::uint32_t Reserved;
+	float BoundsCenter[3];
+	float BoundsExtents[3];
+	std::uint32_t Reserved2[2];
+};
+
+//추가 LOD. ScreenSize 이하로 작아지면 이 LOD를 사용.
+struct MeshFileLod
+{
+	std::uint32_t IndexCount;
+	std::uint32_t StartIndexLocation;
+	std::int32_t BaseVertexLocation;
+	float ScreenSize;
+};
+
+static_assert(sizeof(MeshFileVertex) == 32, "MeshFileVertex layout");
+static_assert(sizeof(MeshFileHeader) == 144, "MeshFileHeader layout");
+static_assert(sizeof(MeshFileSubmesh) == 64, "MeshFileSubmesh layout");
+static_assert(sizeof(MeshFileLod) == 16, "MeshFileLod layout");
+
+//매핑 메모리를 가리키는 읽기 전용 구간. MeshFile이 살아있는 동안만 유효.
+template<typename T>
+struct MeshFileSpan
+{
+	const T* Data = nullptr;
+	std::size_t Count = 0;
+
+	const T* begin()const { return Data; }
+	const T* end()const { return Data + Count; }
+	std::size_t size()const { return Count; }
+	bool empty()const { return Count == 0; }
+	const T& operator[](std::size_t i)const { return Data[i]; }
+	std::size_t ByteSize()const { return Count * sizeof(T); }
+};
+
+/*
+	.d12mesh 읽기. 파일을 매핑하고 헤더/테이블 범위만 검증한다.
+	반환되는 모든 구간은 매핑을 직접 가리킨다. (복사/파싱 없음)
+*/
+class MeshFile
+{
+public:
+	static constexpr std::uint32_t Magic = 0x4D323144; // "D12M"
+	static constexpr std::uint32_t Version = 2;
+	static constexpr std::uint64_t SectionAlignment = 64;
+
+	MeshFile() = default;
+	MeshFile(const MeshFile& rhs) = delete;
+	MeshFile& operator=(const MeshFile& rhs) = delete;
+
+	bool Open(const std::filesystem::path& path);
+	void Close();
+	bool IsOpen()const { return mHeader != nullptr; }
+
+	const MeshFileHeader& Header()const { return *mHeader; }
+
+	//정점 스트림. 엔진 Vertex 배열로 그대로 업로드 가능.
+	MeshFileSpan<MeshFileVertex> Vertices()const;
+	//인덱스 스트림의 원시 바이트. 형식은 Header().IndexStride.
+	const void* IndexData()const;
+	std::uint64_t IndexDataByteSize()const;
+
+	MeshFileSpan<MeshFileSubmesh> Submeshes()const;
+	MeshFileSpan<MeshFileLod> Lods(const MeshFileSubmesh& submesh)const;
+	std::string_view SubmeshName(const MeshFileSubmesh& submesh)const;
+	const MeshFileSubmesh* FindSubmesh(std::string_view name)const;
+
+	//입력 파일들의 AssetCache::HashFile() 값. 여러 개면 입력 순서대로 AssetCache::Combine()한다.
+	static bool SourceHash(const std::vector<std::filesystem::path>& sources, std::uint64_t& outHash);
+
+private:
+	bool Validate()const;
+
+	template<typename T>
+	const T* At(std::uint64_t offset)const
+	{
+		return reinterpret_cast<const T*>(mFile.Data() + offset);
+	}
+
+private:
+	MappedFile mFile;
+	const MeshFileHeader* mHeader = nullptr;
+};
+
+/*
+	.d12mesh 쓰기용 원본 데이터. (오프라인 변환기에서 사용)
+*/
+struct MeshFileSource
+{
+	struct Lod
+	{
+		std::uint32_t IndexCount = 0;
+		std::uint32_t StartIndexLocation = 0;
+		std::int32_t BaseVertexLocation = 0;
+		float ScreenSize = 0.0f;
+	};
+
+	struct Submesh
+	{
+		std::string Name;
+		std::uint32_t IndexCount = 0;
+		std::uint32_t StartIndexLocation = 0;
+		std::int32_t BaseVertexLocation = 0;
+		DirectX::XMFLOAT3 BoundsMin = { 0.0f, 0.0f, 0.0f };
+		DirectX::XMFLOAT3 BoundsMax = { 0.0f, 0.0f, 0.0f };
+		std::vector<Lod> Lods;
+	};
+
+	std::vector<MeshFileVertex> Vertices;
+	std::vector<std::uint32_t> Indices;	//서브메시 로컬 인덱스 (BaseVertexLocation 기준)
+	std::vector<Submesh> Submeshes;
+	std::uint64_t SourceHash = 0;		//MeshFile::SourceHash()
+
+	//메시를 정점/인덱스 끝에 붙이고 서브메시로 등록. 반환값은 서브메시 번호.
+	std::size_t AddSubmesh(const std::string& name, const GeometryGenerator::MeshData& mesh);
+	//기존 서브메시에 LOD를 추가.
+	void AddLod(std::size_t submeshIndex, const GeometryGenerator::MeshData& mesh, float screenSize);
+
+	//인덱스 최대값이 0xffff 이하이면 16비트로 저장.
+	bool Write(const std::filesystem::path& path)const;
+};
@@ -0,0 +1,367 @@
+﻿#include "MipGenerator.h"
+
+#include <DirectXMath.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <ppl.h> //Parallel Patterns Library
+
+using namespace DirectX;
+
+namespace
+{
+	//한 작업 단위의 최소 픽셀 수.
+	constexpr std::size_t kMinChunkPixels = 16384;
+
+	//선형, 알파 가중(premultiplied) RGBA.
+	struct FloatImage
+	{
+		std::uint32_t Width = 0;
+		std::uint32_t Height = 0;
+		std::vector<XMFLOAT4A> Pixels;
+	};
+
+	//rows 개의 행을 행 묶음 단위로 병렬 처리.
+	template<typename Fn>
+	void ParallelRows(std::uint32_t rows, std::uint32_t rowPixels, Fn&& fn)
+	{
+		const std::size_t rowsPerChunk = (std::max)(std::size_t(1), kMinChunkPixels / (std::max)(1u, rowPixels));
+		const std::size_t chunkCount = (rows + rowsPerChunk - 1) / rowsPerChunk;
+
+		concurrency::parallel_for(std::size_t(0), chunkCount, [&](std::size_t chunk)
+			{
+				const std::size_t rowEnd = (std::min)(std::size_t(rows), (chunk + 1) * rowsPerChunk);
+				for (std::size_t y = chunk * rowsPerChunk; y < rowEnd; y++)
+					fn(static_cast<std::uint32_t>(y));
+			});
+	}
+
+	//----------------------------------------------------------------------------
+	// 필터 커널
+	//----------------------------------------------------------------------------
+
+	float Sinc(float x)
+	{
+		if (std::fabs(x) < 1e-5f)
+			return 1.0f;
+		x *= XM_PI;
+		return std::sin(x) / x;
+	}
+
+	//0차 변형 베셀 함수. (급수 전개)
+	float BesselI0(float x)
+	{
+		float sum = 1.0f;
+		float term = 1.0f;
+		for (int k = 1; k < 32; k++)
+		{
+			const float t = x / (2.0f * k);
+			term *= t * t;
+			sum += term;
+			if (term < sum * 1e-8f)
+				break;
+		}
+		return sum;
+	}
+
+	float FilterRadius(MipFilter filter)
+	{
+		return filter == MipFilter::Box ? 0.5f : 3.0f;
+	}
+
+	//x: 목적 픽셀 단위 거리.
+	float FilterWeight(MipFilter filter, float x)
+	{
+		x = std::fabs(x);
+		switch (filter)
+		{
+		case MipFilter::Box:
+			return x <= 0.5f ? 1.0f : 0.0f;
+		case MipFilter::Kaiser:
+		{
+			constexpr float width = 3.0f;
+			constexpr float alpha = 4.0f;
+			if (x >= width)
+				return 0.0f;
+			const float t = x / width;
+			return Sinc(x) * BesselI0(alpha * std::sqrt(1.0f - t * t)) / BesselI0(alpha);
+		}
+		case MipFilter::Lanczos:
+			return x >= 3.0f ? 0.0f : Sinc(x) * Sinc(x / 3.0f);
+		}
+		return 0.0f;
+	}
+
+	//목적 픽셀마다 원본 픽셀 [First, First + Count)의 가중치. (합 = 1)
+	struct Kernel
+	{
+		std::vector<std::uint32_t> First;
+		std::vector<std::uint32_t> Count;
+		std::vector<float> Weights;	//목적 픽셀 i의 가중치는 i * Stride부터
+		std::uint32_t Stride = 0;
+	};
+
+	Kernel BuildKernel(MipFilter filter, std::uint32_t srcSize, std::uint32_t dstSize)
+	{
+		const float scale = float(srcSize) / float(dstSize);
+		const float support = FilterRadius(filter) * scale;
+
+		Kernel kernel;
+		kernel.Stride = static_cast<std::uint32_t>(std::ceil(support * 2.0f)) + 2;
+		kernel.First.resize(dstSize);
+		kernel.Count.resize(dstSize);
+		kernel.Weights.assign(std::size_t(dstSize) * kernel.Stride, 0.0f);
+
+		for (std::uint32_t i = 0; i < dstSize; i++)
+		{
+			const float center = (i + 0.5f) * scale;
+			const int lo = static_cast<int>(std::floor(center - support));
+			const int hi = static_cast<int>(std::ceil(center + support));
+
+			//범위를 벗어난 탭은 가장자리 픽셀에 더한다.
+			const int first = (std::max)(lo, 0);
+			const int last = (std::min)(hi, int(srcSize) - 1);
+			float* weights = kernel.Weights.data() + std::size_t(i) * kernel.Stride;
+
+			float sum = 0.0f;
+			for (int j = lo; j <= hi; j++)
+			{
+				const float w = FilterWeight(filter, (j + 0.5f - center) / scale);
+				const int clamped = (std::min)((std::max)(j, 0), int(srcSize) - 1);
+				weights[clamped - first] += w;
+				sum += w;
+			}
+			for (int k = 0; k <= last - first; k++)
+				weights[k] /= sum;
+
+			kernel.First[i] = static_cast<std::uint32_t>(first);
+			kernel.Count[i] = static_cast<std::uint32_t>(last - first + 1);
+		}
+		return kernel;
+	}
+
+	//분리형 리샘플링: 가로(src -> temp) 후 세로(temp -> dst).
+	FloatImage Resample(const FloatImage& src, std::uint32_t width, std::uint32_t height, MipFilter filter)
+	{
+		const Kernel kx = BuildKernel(filter, src.Width, width);
+		const Kernel ky = BuildKernel(filter, src.Height, height);
+
+		std::vector<XMFLOAT4A> temp(std::size_t(width) * src.Height);
+		ParallelRows(src.Height, width, [&](std::uint32_t y)
+			{
+				const XMFLOAT4A* srcRow = src.Pixels.data() + std::size_t(y) * src.Width;
+				XMFLOAT4A* dstRow = temp.data() + std::size_t(y) * width;
+				for (std::uint32_t x = 0; x < width; x++)
+				{
+					const XMFLOAT4A* taps = srcRow + kx.First[x];
+					const float* weights = kx.Weights.data() + std::size_t(x) * kx.Stride;
+
+					XMVECTOR sum = XMVectorZero();
+					for (std::uint32_t k = 0; k < kx.Count[x]; k++)
+						sum = XMVectorMultiplyAdd(XMVectorReplicate(weights[k]), XMLoadFloat4A(&taps[k]), sum);
+					XMStoreFloat4A(&dstRow[x], sum);
+				}
+			});
+
+		FloatImage dst;
+		dst.Width = width;
+		dst.Height = height;
+		dst.Pixels.resize(std::size_t(width) * height);
+		ParallelRows(height, width, [&](std::uint32_t y)
+			{
+				XMFLOAT4A* dstRow = dst.Pixels.data() + std::size_t(y) * width;
+				std::memset(dstRow, 0, sizeof(XMFLOAT4A) * width);
+
+				//행 단위로 누적. (세로 방향 메모리 접근을 피한다)
+				const float* weights = ky.Weights.data() + std::size_t(y) * ky.Stride;
+				for (std::uint32_t k = 0; k < ky.Count[y]; k++)
+				{
+					const XMVECTOR w = XMVectorReplicate(weights[k]);
+					const XMFLOAT4A* srcRow = temp.data() + std::size_t(ky.First[y] + k) * width;
+					for (std::uint32_t x = 0; x < width; x++)
+						XMStoreFloat4A(&dstRow[x], XMVectorMultiplyAdd(w, XMLoadFloat4A(&srcRow[x]), XMLoadFloat4A(&dstRow[x])));
+				}
+			});
+
+		return dst;
+	}
+
+	//----------------------------------------------------------------------------
+	// 8비트 <-> float
+	//----------------------------------------------------------------------------
+
+	struct SrgbTables
+	{
+		float ToLinear[256];
+		//선형 값이 Threshold[v]보다 크면 sRGB 8비트 값은 v보다 크다. (sRGB 공간에서 반올림)
+		float Threshold[255];
+	};
+
+	float SrgbToLinear(float v)
+	{
+		return v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+	}
+
+	const SrgbTables& GetSrgbTables()
+	{
+		static const SrgbTables tables = []()
+		{
+			SrgbTables t;
+			for (int v = 0; v < 256; v++)
+				t.ToLinear[v] = SrgbToLinear(v / 255.0f);
+			for (int v = 0; v < 255; v++)
+				t.Threshold[v] = SrgbToLinear((v + 0.5f) / 255.0f);
+			return t;
+		}();
+		return tables;
+	}
+
+	inline std::uint8_t EncodeLinear(float v)
+	{
+		return static_cast<std::uint8_t>((std::min)(1.0f, (std::max)(0.0f, v)) * 255.0f + 0.5f);
+	}
+
+	inline std::uint8_t EncodeSrgb(const SrgbTables& tables, float v)
+	{
+		return static_cast<std::uint8_t>(std::upper_bound(tables.Threshold, tables.Threshold + 255, v) - tables.Threshold);
+	}
+
+	FloatImage ToFloat(const std::uint8_t* rgba, std::uint32_t width, std::uint32_t height, std::size_t rowPitch, bool srgb)
+	{
+		const SrgbTables& tables = GetSrgbTables();
+
+		FloatImage image;
+		image.Width = width;
+		image.Height = height;
+		image.Pixels.resize(std::size_t(width) * height);
+		ParallelRows(height, width, [&](std::uint32_t y)
+			{
+				const std::uint8_t* src = rgba + y * rowPitch;
+				XMFLOAT4A* dst = image.Pixels.data() + std::size_t(y) * width;
+				for (std::uint32_t x = 0; x < width; x++, src += 4)
+				{
+					const float a = src[3] / 255.0f;
+					const float r = srgb ? tables.ToLinear[src[0]] : src[0] / 255.0f;
+					const float g = srgb ? tables.ToLinear[src[1]] : src[1] / 255.0f;
+					const float b = srgb ? tables.ToLinear[src[2]] : src[2] / 255.0f;
+					dst[x] = XMFLOAT4A(r * a, g * a, b * a, a);
+				}
+			});
+		return image;
+	}
+
+	inline std::uint8_t QuantizeAlpha(float a, float scale)
+	{
+		return EncodeLinear(a * scale);
+	}
+
+	//기준값을 넘는 알파 비율.
+	float AlphaCoverage(const FloatImage& image, float ref, float scale)
+	{
+		const std::uint8_t threshold = static_cast<std::uint8_t>((std::min)(255.0f, ref * 255.0f));
+		std::size_t passed = 0;
+		for (const XMFLOAT4A& p : image.Pixels)
+			passed += QuantizeAlpha(p.w, scale) > threshold;
+		return float(passed) / float(image.Pixels.size());
+	}
+
+	//알파 스케일 이분 탐색. 스케일이 커질수록 비율이 늘어나므로 목표 이상이 되는 가장 작은 값.
+	float FindCoverageScale(const FloatImage& image, float ref, float targetCoverage)
+	{
+		if (targetCoverage <= 0.0f || targetCoverage >= 1.0f)
+			return 1.0f;
+
+		float lo = 0.0f;
+		float hi = 4.0f;
+		for (int iter = 0; iter < 16; iter++)
+		{
+			const float mid = 0.5f * (lo + hi);
+			if (AlphaCoverage(image, ref, mid) >= targetCoverage)
+				hi = mid;
+			else
+				lo = mid;
+		}
+		return hi;
+	}
+
+	void ToLevel(const FloatImage& image, bool srgb, float alphaScale, MipLevel& level)
+	{
+		const SrgbTables& tables = GetSrgbTables();
+
+		level.Width = image.Width;
+		level.Height = image.Height;
+		level.Pixels.resize(std::size_t(image.Width) * image.Height * 4);
+		ParallelRows(image.Height, image.Width, [&](std::uint32_t y)
+			{
+				const XMFLOAT4A* src = image.Pixels.data() + std::size_t(y) * image.Width;
+				std::uint8_t* dst = level.Pixels.data() + std::size_t(y) * image.Width * 4;
+				for (std::uint32_t x = 0; x < image.Width; x++, dst += 4)
+				{
+					//알파 가중을 푼다. 완전히 투명하면 색은 0.
+					const float a = (std::min)(1.0f, (std::max)(0.0f, src[x].w));
+					const float inv = a > (1.0f / 1024.0f) ? 1.0f / a : 0.0f;
+					const float rgb[3] = { src[x].x * inv, src[x].y * inv, src[x].z * inv };
+
+					for (int c = 0; c < 3; c++)
+						dst[c] = srgb ? EncodeSrgb(tables, rgb[c]) : EncodeLinear(rgb[c]);
+					dst[3] = QuantizeAlpha(a, alphaScale);
+				}
+			});
+	}
+}
+
+std::uint32_t MipGenerator::CountLevels(std::uint32_t width, std::uint32_t height)
+{
+	std::uint32_t levels = 1;
+	while (width > 1 || height > 1)
+	{
+		width = (std::max)(1u, width / 2);
+		height = (std::max)(1u, height / 2);
+		levels++;
+	}
+	return levels;
+}
+
+bool MipGenerator::Generate(const void* rgba, std::uint32_t width, std::uint32_t height, std::size_t rowPitch,
+	const MipOptions& options, std::vector<MipLevel>& outLevels)
+{
+	outLevels.clear();
+	if (!rgba || width == 0 || height == 0 || rowPitch < std::size_t(width) * 4)
+		return false;
+
+	std::uint32_t levelCount = CountLevels(width, height);
+	if (options.MaxLevels != 0)
+		levelCount = (std::min)(levelCount, options.MaxLevels);
+	outLevels.resize(levelCount);
+
+	//밉 0은 입력 그대로.
+	const std::uint8_t* src = static_cast<const std::uint8_t*>(rgba);
+	MipLevel& base = outLevels[0];
+	base.Width = width;
+	base.Height = height;
+	base.Pixels.resize(std::size_t(width) * height * 4);
+	for (std::uint32_t y = 0; y < height; y++)
+		std::memcpy(base.Pixels.data() + std::size_t(y) * width * 4, src + y * rowPitch, std::size_t(width) * 4);
+
+	if (levelCount == 1)
+		return true;
+
+	FloatImage current = ToFloat(src, width, height, rowPitch, options.SRGB);
+
+	const bool preserveCoverage = options.AlphaCoverageRef > 0.0f;
+	const float targetCoverage = preserveCoverage ? AlphaCoverage(current, options.AlphaCoverageRef, 1.0f) : 0.0f;
+
+	//다음 레벨은 항상 스케일하지 않은 이전 레벨에서 만든다. (알파 스케일은 출력에만 적용)
+	for (std::uint32_t level = 1; level < levelCount; level++)
+	{
+		FloatImage next = Resample(current,
+			(std::max)(1u, current.Width / 2),
+			(std::max)(1u, current.Height / 2),
+			options.Filter);
+
+		const float alphaScale = preserveCoverage ? FindCoverageScale(next, options.AlphaCoverageRef, targetCoverage) : 1.0f;
+		ToLevel(next, options.SRGB, alphaScale, outLevels[level]);
+		current = std::move(next);
+	}
+	return true;
+}
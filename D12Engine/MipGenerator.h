@@ -0,0 +1,49 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class MipFilter : std::uint8_t
+{
+	Box,		//2x2 평균. 가장 빠르지만 흐리고 고주파가 남는다.
+	Kaiser,		//Kaiser 창 sinc (반경 3, alpha 4). 기본값.
+	Lanczos,	//Lanczos3. 가장 선명하지만 경계에 링잉이 생길 수 있다.
+};
+
+struct MipOptions
+{
+	MipFilter Filter = MipFilter::Kaiser;
+	//RGB가 sRGB 인코딩. 선형으로 바꿔 필터링하고 다시 인코딩한다. (알파는 항상 선형)
+	bool SRGB = false;
+	//0보다 크면 알파 테스트 기준값. 각 밉의 알파를 스케일해 기준값을 넘는 비율을 밉 0과 같게 맞춘다.
+	float AlphaCoverageRef = 0.0f;
+	//만들 최대 레벨 수. (밉 0 포함, 0 = 1x1까지)
+	std::uint32_t MaxLevels = 0;
+};
+
+struct MipLevel
+{
+	std::uint32_t Width = 0;
+	std::uint32_t Height = 0;
+	std::vector<std::uint8_t> Pixels;	//RGBA8, 빈틈없이
+};
+
+/*
+	CPU 밉 체인 생성. (TextureConverter 오프라인 변환, 밉 없는 DDS의 로드 시 보완)
+
+	- 이전 레벨에서 다음 레벨을 분리형(가로 -> 세로) 필터로 만든다. 크기가 홀수여도 비율대로 리샘플링.
+	- 필터링은 float 선형 공간 + 알파 가중(premultiplied). 투명 픽셀의 색이 번지지 않는다.
+	- 행 묶음 단위로 PPL 병렬, 픽셀(RGBA)은 XMVECTOR 하나로 곱셈-덧셈.
+	- 경계는 가장자리 픽셀 반복(clamp).
+*/
+class MipGenerator
+{
+public:
+	//1x1까지의 레벨 수.
+	static std::uint32_t CountLevels(std::uint32_t width, std::uint32_t height);
+
+	//outLevels[0]은 입력 복사본. 입력이 비었으면 false.
+	static bool Generate(const void* rgba, std::uint32_t width, std::uint32_t height, std::size_t rowPitch,
+		const MipOptions& options, std::vector<MipLevel>& outLevels);
+};
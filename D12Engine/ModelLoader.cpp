@@ -0,0 +1,295 @@
+﻿#include "ModelLoader.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <ppl.h> //Parallel Patterns Library
+
+using Vertex = GeometryGenerator::Vertex;
+
+namespace
+{
+	//한 작업 단위의 최소 크기. 너무 잘게 자르면 스케줄링 비용이 파싱 비용보다 커진다.
+	constexpr std::size_t kMinChunkBytes = 64 * 1024;
+
+	inline bool IsSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	}
+
+	inline const char* SkipSpace(const char* p, const char* end)
+	{
+		while (p < end && IsSpace(*p))
+			p++;
+		return p;
+	}
+
+	//[p, end)에서 label을 찾아 바로 뒤 위치를 반환. 없으면 nullptr.
+	const char* FindLabel(const char* p, const char* end, std::string_view label)
+	{
+		const char* it = std::search(p, end, label.begin(), label.end());
+		return it == end ? nullptr : it + label.size();
+	}
+
+	//"Label: 123" 형태의 정수 값.
+	bool ReadCount(const char*& p, const char* end, std::string_view label, std::size_t& outCount)
+	{
+		p = FindLabel(p, end, label);
+		if (!p)
+			return false;
+
+		p = SkipSpace(p, end);
+		if (p < end && *p == ':')
+			p = SkipSpace(p + 1, end);
+
+		auto result = std::from_chars(p, end, outCount);
+		if (result.ec != std::errc())
+			return false;
+
+		p = result.ptr;
+		return true;
+	}
+
+	//label 뒤의 { ... } 본문 구간. 본문에는 중괄호가 없으므로 처음 만나는 '}'가 끝.
+	bool FindSection(const char*& p, const char* end, std::string_view label, const char*& outBegin, const char*& outEnd)
+	{
+		p = FindLabel(p, end, label);
+		if (!p)
+			return false;
+
+		auto open = static_cast<const char*>(std::memchr(p, '{', end - p));
+		if (!open)
+			return false;
+
+		auto close = static_cast<const char*>(std::memchr(open + 1, '}', end - (open + 1)));
+		if (!close)
+			return false;
+
+		outBegin = open + 1;
+		outEnd = close;
+		p = close + 1;
+		return true;
+	}
+
+	//구간을 줄 경계 기준으로 대략 같은 크기의 조각으로 나눈다.
+	std::vector<const char*> SplitAtLines(const char* begin, const char* end)
+	{
+		const std::size_t bytes = static_cast<std::size_t>(end - begin);
+		const std::size_t workers = (std::max)(1u, std::thread::hardware_concurrency());
+		const std::size_t chunkCount = std::clamp<std::size_t>(bytes / kMinChunkBytes, 1, workers * 4);
+
+		std::vector<const char*> bounds;
+		bounds.reserve(chunkCount + 1);
+		bounds.push_back(begin);
+		for (std::size_t i = 1; i < chunkCount; i++)
+		{
+			const char* p = begin + bytes * i / chunkCount;
+			p = (std::max)(p, bounds.back());
+
+			auto nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+			p = nl ? nl + 1 : end;
+			if (p > bounds.back() && p < end)
+				bounds.push_back(p);
+		}
+		bounds.push_back(end);
+
+		return bounds;
+	}
+
+	//비어있지 않은 줄(=레코드) 수.
+	std::size_t CountRecords(const char* p, const char* end)
+	{
+		std::size_t count = 0;
+		while (true)
+		{
+			p = SkipSpace(p, end);
+			if (p >= end)
+				break;
+
+			count++;
+			auto nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+			if (!nl)
+				break;
+			p = nl + 1;
+		}
+		return count;
+	}
+
+	template<typename T>
+	inline bool ReadNumber(const char*& p, const char* end, T& out)
+	{
+		p = SkipSpace(p, end);
+		auto result = std::from_chars(p, end, out);
+		if (result.ec != std::errc())
+			return false;
+		p = result.ptr;
+		return true;
+	}
+
+	//줄 단위 레코드 구간을 조각으로 나눠, 조각마다 시작 레코드 번호를 구한 뒤 병렬 파싱.
+	//parseRecord(p, end, recordIndex)는 한 레코드를 읽고 p를 전진시킨다.
+	template<typename ParseFn>
+	bool ParseRecordsParallel(const char* begin, const char* end, std::size_t expectedCount, ParseFn parseRecord)
+	{
+		auto bounds = SplitAtLines(begin, end);
+		const std::size_t chunkCount = bounds.size() - 1;
+
+		//1단계: 조각별 레코드 수 -> 전역 시작 번호.
+		std::vector<std::size_t> offsets(chunkCount + 1, 0);
+		concurrency::parallel_for(std::size_t(0), chunkCount, [&](std::size_t i)
+			{
+				offsets[i + 1] = CountRecords(bounds[i], bounds[i + 1]);
+			});
+		for (std::size_t i = 0; i < chunkCount; i++)
+			offsets[i + 1] += offsets[i];
+
+		if (offsets[chunkCount] != expectedCount)
+			return false;
+
+		//2단계: 미리 잡아둔 출력 위치에 바로 기록.
+		std::atomic<bool> failed = false;
+		concurrency::parallel_for(std::size_t(0), chunkCount, [&](std::size_t i)
+			{
+				const char* p = bounds[i];
+				const char* chunkEnd = bounds[i + 1];
+				for (std::size_t r = offsets[i]; r < offsets[i + 1]; r++)
+				{
+					if (!parseRecord(p, chunkEnd, r))
+					{
+						failed.store(true, std::memory_order_relaxed);
+						return;
+					}
+				}
+			});
+
+		return !failed.load();
+	}
+}
+
+bool ModelLoader::LoadTextModel(const std::filesystem::path& path, GeometryGenerator::MeshData& outMesh)
+{
+	MappedFile file;
+	if (!file.Open(path) || file.Size() == 0)
+		return false;
+
+	return ParseTextModel(file.Begin(), file.End(), outMesh);
+}
+
+bool ModelLoader::ParseTextModel(const char* begin, const char* end, GeometryGenerator::MeshData& outMesh)
+{
+	const char* p = begin;
+
+	std::size_t vertexCount = 0;
+	std::size_t triangleCount = 0;
+	if (!ReadCount(p, end, "VertexCount", vertexCount) ||
+		!ReadCount(p, end, "TriangleCount", triangleCount))
+		return false;
+
+	const char* vb = nullptr;
+	const char* ve = nullptr;
+	const char* ib = nullptr;
+	const char* ie = nullptr;
+	if (!FindSection(p, end, "VertexList", vb, ve) ||
+		!FindSection(p, end, "TriangleList", ib, ie))
+		return false;
+
+	GeometryGenerator::MeshData mesh;
+	mesh.Vertices.resize(vertexCount);
+	mesh.Indices32.resize(triangleCount * 3);
+
+	Vertex* vertices = mesh.Vertices.data();
+	bool ok = ParseRecordsParallel(vb, ve, vertexCount,
+		[vertices](const char*& p, const char* end, std::size_t i)
+		{
+			float f[6];
+			for (float& x : f)
+			{
+				if (!ReadNumber(p, end, x))
+					return false;
+			}
+
+			Vertex& v = vertices[i];
+			v.Position = { f[0], f[1], f[2] };
+			v.Normal = { f[3], f[4], f[5] };
+			v.TangentU = { 0.0f, 0.0f, 0.0f };
+			v.TexC = { 0.0f, 0.0f };
+			return true;
+		});
+
+	GeometryGenerator::uint32* indices = mesh.Indices32.data();
+	const std::size_t maxIndex = vertexCount;
+	ok = ok && ParseRecordsParallel(ib, ie, triangleCount,
+		[indices, maxIndex](const char*& p, const char* end, std::size_t i)
+		{
+			GeometryGenerator::uint32* tri = indices + i * 3;
+			for (int k = 0; k < 3; k++)
+			{
+				if (!ReadNumber(p, end, tri[k]) || tri[k] >= maxIndex)
+					return false;
+			}
+			return true;
+		});
+
+	if (!ok)
+		return false;
+
+	outMesh = std::move(mesh);
+	return true;
+}
+
+void ModelLoader::SerializeMesh(const GeometryGenerator::MeshData& mesh, std::vector<std::uint8_t>& outData)
+{
+	const std::uint64_t counts[2] = { mesh.Vertices.size(), mesh.Indices32.size() };
+	const std::size_t vbByteSize = mesh.Vertices.size() * sizeof(Vertex);
+	const std::size_t ibByteSize = mesh.Indices32.size() * sizeof(GeometryGenerator::uint32);
+
+	outData.resize(sizeof(counts) + vbByteSize + ibByteSize);
+	std::uint8_t* p = outData.data();
+	std::memcpy(p, counts, sizeof(counts));
+	p += sizeof(counts);
+	if (vbByteSize > 0)
+		std::memcpy(p, mesh.Vertices.data(), vbByteSize);
+	p += vbByteSize;
+	if (ibByteSize > 0)
+		std::memcpy(p, mesh.Indices32.data(), ibByteSize);
+}
+
+bool ModelLoader::DeserializeMesh(const std::uint8_t* data, std::size_t size, GeometryGenerator::MeshData& outMesh)
+{
+	std::uint64_t counts[2];
+	if (size < sizeof(counts))
+		return false;
+	std::memcpy(counts, data, sizeof(counts));
+
+	//개수와 실제 크기가 맞지 않으면 깨진 항목.
+	const std::uint64_t payload = size - sizeof(counts);
+	if (counts[0] > payload / sizeof(Vertex) || counts[1] > payload / sizeof(GeometryGenerator::uint32) ||
+		counts[0] * sizeof(Vertex) + counts[1] * sizeof(GeometryGenerator::uint32) != payload)
+		return false;
+
+	GeometryGenerator::MeshData mesh;
+	mesh.Vertices.resize(static_cast<std::size_t>(counts[0]));
+	mesh.Indices32.resize(static_cast<std::size_t>(counts[1]));
+
+	const std::uint8_t* p = data + sizeof(counts);
+	const std::size_t vbByteSize = mesh.Vertices.size() * sizeof(Vertex);
+	if (vbByteSize > 0)
+		std::memcpy(mesh.Vertices.data(), p, vbByteSize);
+	p += vbByteSize;
+	if (!mesh.Indices32.empty())
+		std::memcpy(mesh.Indices32.data(), p, mesh.Indices32.size() * sizeof(GeometryGenerator::uint32));
+
+	for (GeometryGenerator::uint32 index : mesh.Indices32)
+	{
+		if (index >= mesh.Vertices.size())
+			return false;
+	}
+
+	outMesh = std::move(mesh);
+	return true;
+}
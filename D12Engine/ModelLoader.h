@@ -0,0 +1,39 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+#include "GeometryGenerator.h"
+
+/*
+	텍스트 모델(skull.txt 형식) 로더.
+
+		VertexCount: N
+		TriangleCount: M
+		VertexList (pos, normal)
+		{
+			px py pz nx ny nz		(N줄)
+		}
+		TriangleList
+		{
+			i0 i1 i2				(M줄)
+		}
+
+	파일을 메모리 매핑한 뒤 한 번만 훑는다.
+	- 구간은 줄 번호가 아니라 레이블("VertexCount", "TriangleList", "{", "}")로 찾는다.
+	- 선언된 개수로 출력 벡터를 미리 잡는다.
+	- 각 구간을 줄 경계로 잘라 std::from_chars로 병렬 파싱.
+*/
+class ModelLoader
+{
+public:
+	//실패(파일 없음, 형식 오류, 선언 개수 불일치) 시 false.
+	static bool LoadTextModel(const std::filesystem::path& path, GeometryGenerator::MeshData& outMesh);
+
+	//이미 메모리에 있는 텍스트를 파싱. [begin, end)
+	static bool ParseTextModel(const char* begin, const char* end, GeometryGenerator::MeshData& outMesh);
+
+	//파생 데이터 캐시(AssetCache)용 바이너리 직렬화. [정점 수][인덱스 수][Vertex 배열][uint32 인덱스 배열]
+	static void SerializeMesh(const GeometryGenerator::MeshData& mesh, std::vector<std::uint8_t>& outData);
+	static bool DeserializeMesh(const std::uint8_t* data, std::size_t size, GeometryGenerator::MeshData& outMesh);
+};
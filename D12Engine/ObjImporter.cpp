@@ -0,0 +1,495 @@
+﻿#include "ObjImporter.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+
+using Vertex = GeometryGenerator::Vertex;
+
+namespace
+{
+	//고정 크기 버퍼 하나로 파일을 블록 단위로 읽어 줄을 돌려준다.
+	//줄이 블록 경계에 걸리면 남은 조각을 버퍼 앞으로 당긴 뒤 이어서 읽는다.
+	class BlockLineReader
+	{
+	public:
+		explicit BlockLineReader(std::size_t blockSize) : mBuffer(blockSize) {}
+
+		bool Open(const std::filesystem::path& path)
+		{
+			//ifstream 자체 버퍼는 끄고 블록 버퍼로 직접 읽는다.
+			mStream.rdbuf()->pubsetbuf(nullptr, 0);
+			mStream.open(path, std::ios::binary);
+			return mStream.is_open();
+		}
+
+		//[outBegin, outEnd)에 줄 내용('\n' 제외). 더 이상 줄이 없거나 줄이 너무 길면 false.
+		bool NextLine(const char*& outBegin, const char*& outEnd)
+		{
+			char* data = mBuffer.data();
+			while (true)
+			{
+				auto nl = static_cast<const char*>(std::memchr(data + mPos, '\n', mEnd - mPos));
+				if (nl)
+				{
+					outBegin = data + mPos;
+					outEnd = nl;
+					mPos = static_cast<std::size_t>(nl - data) + 1;
+					return true;
+				}
+
+				if (mEof)
+				{
+					if (mPos == mEnd)
+						return false;
+					outBegin = data + mPos;
+					outEnd = data + mEnd;
+					mPos = mEnd;
+					return true;
+				}
+
+				const std::size_t remain = mEnd - mPos;
+				if (remain == mBuffer.size())
+				{
+					mOverflow = true;
+					return false;
+				}
+
+				std::memmove(data, data + mPos, remain);
+				mPos = 0;
+				mEnd = remain;
+
+				mStream.read(data + mEnd, static_cast<std::streamsize>(mBuffer.size() - mEnd));
+				const std::size_t got = static_cast<std::size_t>(mStream.gcount());
+				mEnd += got;
+				mBytesRead += got;
+				if (!mStream)
+					mEof = true;
+			}
+		}
+
+		bool Overflowed()const { return mOverflow; }
+		std::uint64_t BytesRead()const { return mBytesRead; }
+
+	private:
+		std::ifstream mStream;
+		std::vector<char> mBuffer;
+		std::size_t mPos = 0;
+		std::size_t mEnd = 0;
+		std::uint64_t mBytesRead = 0;
+		bool mEof = false;
+		bool mOverflow = false;
+	};
+
+	inline const char* SkipSpace(const char* p, const char* end)
+	{
+		while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+			p++;
+		return p;
+	}
+
+	inline const char* SkipToken(const char* p, const char* end)
+	{
+		while (p < end && *p != ' ' && *p != '\t' && *p != '\r')
+			p++;
+		return p;
+	}
+
+	//줄 앞의 키워드. 공백 전까지.
+	inline std::string_view ReadKeyword(const char*& p, const char* end)
+	{
+		p = SkipSpace(p, end);
+		const char* begin = p;
+		p = SkipToken(p, end);
+		return std::string_view(begin, static_cast<std::size_t>(p - begin));
+	}
+
+	//줄 끝의 공백을 제외한 나머지 전체. (이름, 경로용)
+	inline std::string_view ReadRest(const char* p, const char* end)
+	{
+		p = SkipSpace(p, end);
+		while (end > p && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r'))
+			end--;
+		return std::string_view(p, static_cast<std::size_t>(end - p));
+	}
+
+	template<typename T>
+	inline bool ReadNumber(const char*& p, const char* end, T& out)
+	{
+		p = SkipSpace(p, end);
+		auto result = std::from_chars(p, end, out);
+		if (result.ec != std::errc())
+			return false;
+		p = result.ptr;
+		return true;
+	}
+
+	//읽지 못한 성분은 기본값 유지. (vt의 w, Kd 생략 등)
+	template<std::size_t N>
+	inline int ReadFloats(const char* p, const char* end, float (&out)[N])
+	{
+		int count = 0;
+		while (count < static_cast<int>(N) && ReadNumber(p, end, out[count]))
+			count++;
+		return count;
+	}
+
+	//OBJ 인덱스(1부터, 음수는 끝에서부터)를 0부터 시작하는 인덱스로. 범위 밖이면 -1.
+	inline std::int32_t ResolveIndex(std::int64_t i, std::size_t count)
+	{
+		std::int64_t r = (i > 0) ? i - 1 : static_cast<std::int64_t>(count) + i;
+		return (r >= 0 && r < static_cast<std::int64_t>(count)) ? static_cast<std::int32_t>(r) : -1;
+	}
+
+	//(위치, UV, 노멀) 인덱스 조합 -> 출력 정점 번호. 선형 탐사 오픈 어드레싱.
+	//노드 할당이 없어서 수백만 정점에서도 슬롯당 16바이트만 쓴다.
+	class CornerMap
+	{
+	public:
+		CornerMap() { mSlots.resize(1024); }
+
+		//없으면 newIndex로 추가하고 inserted = true.
+		std::uint32_t FindOrAdd(std::int32_t v, std::int32_t t, std::int32_t n, std::uint32_t newIndex, bool& inserted)
+		{
+			if ((mCount + 1) * 4 > mSlots.size() * 3)
+				Grow();
+
+			const std::size_t mask = mSlots.size() - 1;
+			std::size_t i = Hash(v, t, n) & mask;
+			while (true)
+			{
+				Slot& s = mSlots[i];
+				if (s.Index == EmptySlot)
+				{
+					s = { v, t, n, newIndex };
+					mCount++;
+					inserted = true;
+					return newIndex;
+				}
+				if (s.V == v && s.T == t && s.N == n)
+				{
+					inserted = false;
+					return s.Index;
+				}
+				i = (i + 1) & mask;
+			}
+		}
+
+	private:
+		static constexpr std::uint32_t EmptySlot = 0xffffffff;
+
+		struct Slot
+		{
+			std::int32_t V = -1;
+			std::int32_t T = -1;
+			std::int32_t N = -1;
+			std::uint32_t Index = EmptySlot;
+		};
+
+		static std::size_t Hash(std::int32_t v, std::int32_t t, std::int32_t n)
+		{
+			std::uint32_t h = static_cast<std::uint32_t>(v) * 0x9E3779B1u;
+			h ^= static_cast<std::uint32_t>(t) * 0x85EBCA77u;
+			h ^= static_cast<std::uint32_t>(n) * 0xC2B2AE3Du;
+			h ^= h >> 16;
+			h *= 0x7FEB352Du;
+			h ^= h >> 15;
+			return h;
+		}
+
+		void Grow()
+		{
+			std::vector<Slot> old(mSlots.size() * 2);
+			old.swap(mSlots);
+
+			const std::size_t mask = mSlots.size() - 1;
+			for (const Slot& s : old)
+			{
+				if (s.Index == EmptySlot)
+					continue;
+				std::size_t i = Hash(s.V, s.T, s.N) & mask;
+				while (mSlots[i].Index != EmptySlot)
+					i = (i + 1) & mask;
+				mSlots[i] = s;
+			}
+		}
+
+	private:
+		std::vector<Slot> mSlots;
+		std::size_t mCount = 0;
+	};
+
+	//Blinn-Phong 지수 -> 거칠기. (Ns = 2/r^2 - 2)
+	inline float ShininessToRoughness(float ns)
+	{
+		return std::clamp(std::sqrt(2.0f / ((std::max)(ns, 0.0f) + 2.0f)), 0.0f, 1.0f);
+	}
+
+	//노멀이 없는 정점에 면적 가중 면 노멀의 평균을 넣는다.
+	void GenerateMissingNormals(GeometryGenerator::MeshData& mesh, const std::vector<bool>& missing)
+	{
+		using namespace DirectX;
+
+		std::vector<XMFLOAT3> accum(mesh.Vertices.size(), XMFLOAT3(0.0f, 0.0f, 0.0f));
+		for (std::size_t i = 0; i + 2 < mesh.Indices32.size(); i += 3)
+		{
+			const std::uint32_t i0 = mesh.Indices32[i], i1 = mesh.Indices32[i + 1], i2 = mesh.Indices32[i + 2];
+			XMVECTOR p0 = XMLoadFloat3(&mesh.Vertices[i0].Position);
+			XMVECTOR p1 = XMLoadFloat3(&mesh.Vertices[i1].Position);
+			XMVECTOR p2 = XMLoadFloat3(&mesh.Vertices[i2].Position);
+			XMVECTOR faceNormal = XMVector3Cross(p1 - p0, p2 - p0);
+
+			for (std::uint32_t idx : { i0, i1, i2 })
+			{
+				if (missing[idx])
+					XMStoreFloat3(&accum[idx], XMLoadFloat3(&accum[idx]) + faceNormal);
+			}
+		}
+
+		for (std::size_t i = 0; i < mesh.Vertices.size(); i++)
+		{
+			if (missing[i])
+				XMStoreFloat3(&mesh.Vertices[i].Normal, XMVector3Normalize(XMLoadFloat3(&accum[i])));
+		}
+	}
+}
+
+bool ObjImporter::ImportMaterials(const std::filesystem::path& path, std::vector<ObjMaterial>& outMaterials)
+{
+	BlockLineReader reader(BlockSize);
+	if (!reader.Open(path))
+		return false;
+
+	const std::filesystem::path dir = path.parent_path();
+	ObjMaterial* current = nullptr;
+
+	const char* line;
+	const char* end;
+	while (reader.NextLine(line, end))
+	{
+		const char* p = line;
+		std::string_view key = ReadKeyword(p, end);
+		if (key.empty() || key[0] == '#')
+			continue;
+
+		if (key == "newmtl")
+		{
+			outMaterials.emplace_back();
+			current = &outMaterials.back();
+			current->Name = std::string(ReadRest(p, end));
+			continue;
+		}
+		if (!current)
+			continue;
+
+		if (key == "Kd")
+		{
+			float kd[3] = { 1.0f, 1.0f, 1.0f };
+			ReadFloats(p, end, kd);
+			current->DiffuseAlbedo = { kd[0], kd[1], kd[2], current->DiffuseAlbedo.w };
+		}
+		else if (key == "Ks")
+		{
+			float ks[3] = { 0.01f, 0.01f, 0.01f };
+			ReadFloats(p, end, ks);
+			current->FresnelR0 = { ks[0], ks[1], ks[2] };
+		}
+		else if (key == "Ns")
+		{
+			float ns[1] = { 0.0f };
+			if (ReadFloats(p, end, ns) == 1)
+				current->Roughness = ShininessToRoughness(ns[0]);
+		}
+		else if (key == "d" || key == "Tr")
+		{
+			float d[1] = { 1.0f };
+			if (ReadFloats(p, end, d) == 1)
+				current->DiffuseAlbedo.w = (key == "d") ? d[0] : 1.0f - d[0];
+		}
+		else if (key == "map_Kd")
+		{
+			//옵션(-s, -o 등)은 무시하고 마지막 토큰을 파일 이름으로 본다.
+			std::string_view rest = ReadRest(p, end);
+			std::size_t lastSpace = rest.find_last_of(" \t");
+			if (!rest.empty() && rest[0] == '-' && lastSpace != std::string_view::npos)
+				rest = rest.substr(lastSpace + 1);
+			current->DiffuseMap = dir / std::filesystem::u8path(rest.begin(), rest.end());
+		}
+	}
+
+	return !reader.Overflowed();
+}
+
+bool ObjImporter::Import(const std::filesystem::path& path, ObjModel& outModel, ObjImportStats* outStats)
+{
+	BlockLineReader reader(BlockSize);
+	if (!reader.Open(path))
+		return false;
+
+	outModel = ObjModel();
+	GeometryGenerator::MeshData& mesh = outModel.Mesh;
+
+	ObjImportStats stats;
+	std::vector<DirectX::XMFLOAT3> positions;
+	std::vector<DirectX::XMFLOAT3> normals;
+	std::vector<DirectX::XMFLOAT2> texcoords;
+	std::vector<bool> missingNormal;
+	bool anyMissingNormal = false;
+
+	CornerMap corners;
+	std::vector<std::uint32_t> polygon;
+
+	outModel.Subsets.push_back(ObjSubset());
+
+	const std::filesystem::path dir = path.parent_path();
+
+	const char* line;
+	const char* end;
+	while (reader.NextLine(line, end))
+	{
+		stats.LineCount++;
+
+		const char* p = line;
+		std::string_view key = ReadKeyword(p, end);
+		if (key.empty() || key[0] == '#')
+			continue;
+
+		if (key == "v")
+		{
+			float v[3] = { 0.0f, 0.0f, 0.0f };
+			ReadFloats(p, end, v);
+			positions.emplace_back(v[0], v[1], v[2]);
+		}
+		else if (key == "vn")
+		{
+			float n[3] = { 0.0f, 0.0f, 0.0f };
+			ReadFloats(p, end, n);
+			normals.emplace_back(n[0], n[1], n[2]);
+		}
+		else if (key == "vt")
+		{
+			float t[2] = { 0.0f, 0.0f };
+			ReadFloats(p, end, t);
+			texcoords.emplace_back(t[0], 1.0f - t[1]);	//OBJ는 좌하단 원점.
+		}
+		else if (key == "f")
+		{
+			polygon.clear();
+			while (true)
+			{
+				p = SkipSpace(p, end);
+				if (p >= end)
+					break;
+
+				//v, v/t, v//n, v/t/n
+				std::int64_t vi = 0, ti = 0, ni = 0;
+				if (!ReadNumber(p, end, vi))
+					return false;
+				if (p < end && *p == '/')
+				{
+					p++;
+					if (p < end && *p != '/')
+						ReadNumber(p, end, ti);
+					if (p < end && *p == '/')
+					{
+						p++;
+						ReadNumber(p, end, ni);
+					}
+				}
+
+				const std::int32_t v = ResolveIndex(vi, positions.size());
+				const std::int32_t t = ti != 0 ? ResolveIndex(ti, texcoords.size()) : -1;
+				const std::int32_t n = ni != 0 ? ResolveIndex(ni, normals.size()) : -1;
+				if (v < 0 || (ti != 0 && t < 0) || (ni != 0 && n < 0))
+					return false;
+
+				bool inserted = false;
+				const std::uint32_t index = corners.FindOrAdd(v, t, n, static_cast<std::uint32_t>(mesh.Vertices.size()), inserted);
+				if (inserted)
+				{
+					Vertex vertex(
+						positions[v],
+						n >= 0 ? normals[n] : DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f),
+						DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f),
+						t >= 0 ? texcoords[t] : DirectX::XMFLOAT2(0.0f, 0.0f));
+					mesh.Vertices.push_back(vertex);
+
+					missingNormal.push_back(n < 0);
+					anyMissingNormal |= (n < 0);
+				}
+
+				polygon.push_back(index);
+				stats.CornerCount++;
+				p = SkipToken(p, end);
+			}
+
+			if (polygon.size() < 3)
+				continue;
+
+			//볼록 다각형 가정. 삼각형 팬으로 분할.
+			for (std::size_t i = 2; i < polygon.size(); i++)
+			{
+				mesh.Indices32.push_back(polygon[0]);
+				mesh.Indices32.push_back(polygon[i - 1]);
+				mesh.Indices32.push_back(polygon[i]);
+			}
+			stats.FaceCount++;
+			stats.TriangleCount += polygon.size() - 2;
+		}
+		else if (key == "usemtl")
+		{
+			std::string_view name = ReadRest(p, end);
+			int materialIndex = -1;
+			for (std::size_t i = 0; i < outModel.Materials.size(); i++)
+			{
+				if (outModel.Materials[i].Name == name)
+				{
+					materialIndex = static_cast<int>(i);
+					break;
+				}
+			}
+
+			//현재 구간을 닫고 새 구간 시작. 비어있으면 재질만 바꾼다.
+			ObjSubset& current = outModel.Subsets.back();
+			current.IndexCount = static_cast<std::uint32_t>(mesh.Indices32.size()) - current.StartIndexLocation;
+			if (current.IndexCount == 0)
+			{
+				current.MaterialIndex = materialIndex;
+			}
+			else
+			{
+				ObjSubset next;
+				next.MaterialIndex = materialIndex;
+				next.StartIndexLocation = static_cast<std::uint32_t>(mesh.Indices32.size());
+				outModel.Subsets.push_back(next);
+			}
+		}
+		else if (key == "mtllib")
+		{
+			std::string_view name = ReadRest(p, end);
+			ImportMaterials(dir / std::filesystem::u8path(name.begin(), name.end()), outModel.Materials);
+		}
+		//o, g, s 등은 무시.
+	}
+
+	if (reader.Overflowed())
+		return false;
+
+	ObjSubset& last = outModel.Subsets.back();
+	last.IndexCount = static_cast<std::uint32_t>(mesh.Indices32.size()) - last.StartIndexLocation;
+	if (last.IndexCount == 0)
+		outModel.Subsets.pop_back();
+
+	if (anyMissingNormal)
+		GenerateMissingNormals(mesh, missingNormal);
+
+	stats.BytesRead = reader.BytesRead();
+	stats.UniqueVertexCount = mesh.Vertices.size();
+	if (outStats)
+		*outStats = stats;
+
+	return !mesh.Indices32.empty();
+}
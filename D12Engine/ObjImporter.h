@@ -0,0 +1,69 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <DirectXMath.h>
+
+#include "GeometryGenerator.h"
+
+/*
+	OBJ(+MTL) 임포터.
+
+	파일 전체를 읽지 않고 고정 크기 블록(BlockSize) 단위로 스트리밍하며,
+	줄 단위 토크나이저로 v/vt/vn/f/usemtl/mtllib만 해석한다.
+	f의 (위치, UV, 노멀) 인덱스 조합은 오픈 어드레싱 해시로 중복 제거해 엔진 정점 하나가 된다.
+
+	메모리 사용량 = 블록 버퍼 + 속성 배열(v/vt/vn) + 출력 메시 + 해시 테이블.
+	텍스트 원본은 블록 하나 분량만 메모리에 있다.
+*/
+
+//MTL 재질. 엔진 Material의 상수 버퍼 값으로 바로 옮길 수 있게 변환해 둔다.
+struct ObjMaterial
+{
+	std::string Name;
+	DirectX::XMFLOAT4 DiffuseAlbedo = { 1.0f, 1.0f, 1.0f, 1.0f };	//Kd, d
+	DirectX::XMFLOAT3 FresnelR0 = { 0.01f, 0.01f, 0.01f };			//Ks
+	float Roughness = 0.25f;										//Ns에서 변환
+	std::filesystem::path DiffuseMap;								//map_Kd (OBJ 폴더 기준 경로)
+};
+
+//같은 재질을 쓰는 연속된 삼각형 구간. (usemtl 단위)
+struct ObjSubset
+{
+	int MaterialIndex = -1;		//ObjModel::Materials 인덱스, 없으면 -1
+	std::uint32_t StartIndexLocation = 0;
+	std::uint32_t IndexCount = 0;
+};
+
+struct ObjModel
+{
+	GeometryGenerator::MeshData Mesh;
+	std::vector<ObjMaterial> Materials;
+	std::vector<ObjSubset> Subsets;
+};
+
+struct ObjImportStats
+{
+	std::uint64_t BytesRead = 0;
+	std::uint64_t LineCount = 0;
+	std::uint64_t FaceCount = 0;			//원본 다각형 수
+	std::uint64_t TriangleCount = 0;
+	std::uint64_t UniqueVertexCount = 0;	//중복 제거 후 정점 수
+	std::uint64_t CornerCount = 0;			//중복 제거 전 (v/vt/vn) 참조 수
+};
+
+class ObjImporter
+{
+public:
+	static constexpr std::size_t BlockSize = 1 << 20;	//읽기 블록 크기. 한 줄은 이보다 짧아야 한다.
+
+	//실패(파일 없음, 잘못된 인덱스, 블록보다 긴 줄) 시 false.
+	//mtllib가 없거나 읽지 못하면 재질 없이 메시만 채운다.
+	static bool Import(const std::filesystem::path& path, ObjModel& outModel, ObjImportStats* outStats = nullptr);
+
+	//MTL 파일만 읽는다. 결과는 outMaterials 뒤에 추가.
+	static bool ImportMaterials(const std::filesystem::path& path, std::vector<ObjMaterial>& outMaterials);
+};
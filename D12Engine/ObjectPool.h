@@ -0,0 +1,172 @@
+﻿#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/*
+	32비트 세대(generation) 핸들. 하위 20비트는 풀의 슬롯 번호, 상위 12비트는 그 슬롯의 세대.
+
+	슬롯을 지우면 세대가 올라가므로 지운 뒤에 남은 핸들은 ObjectPool::Get()에서 nullptr이 된다.
+	세대는 1부터 돌고 0은 쓰지 않으므로 기본 생성한 핸들(값 0)은 항상 무효.
+	같은 슬롯이 4095번 재사용되면 세대가 한 바퀴 돈다. (그만큼 오래 들고 있던 핸들은 검출 못 할 수 있다)
+*/
+template<typename T>
+class Handle
+{
+public:
+	static constexpr std::uint32_t IndexBits = 20;
+	static constexpr std::uint32_t MaxIndex = (1u << IndexBits) - 1;
+	static constexpr std::uint32_t MaxGeneration = (1u << (32 - IndexBits)) - 1;
+
+	Handle() = default;
+	Handle(std::uint32_t index, std::uint32_t generation) : mValue((generation << IndexBits) | index) {}
+
+	std::uint32_t Index()const { return mValue & MaxIndex; }
+	std::uint32_t Generation()const { return mValue >> IndexBits; }
+	std::uint32_t Value()const { return mValue; }
+	bool IsValid()const { return mValue != 0; }
+
+	bool operator==(const Handle& rhs)const { return mValue == rhs.mValue; }
+	bool operator!=(const Handle& rhs)const { return mValue != rhs.mValue; }
+
+private:
+	std::uint32_t mValue = 0;
+};
+
+/*
+	타입별 객체 풀. 객체를 ChunkSize개씩 연속된 청크에 만든다.
+
+	- Create()/Destroy(): O(1). 빈 슬롯은 스택으로 재사용하고, 모두 차 있으면 청크를 하나 더 잡는다.
+	- 청크는 옮기지 않으므로 객체 주소는 Destroy()할 때까지 그대로다. (다른 시스템이 T*를 들고 있어도 된다)
+	- 살아 있는 슬롯 번호를 빈틈없는 배열(dense)로 따로 둔다. ForEach()는 빈 슬롯을 훑지 않고 이 배열만 돈다.
+	  Destroy()는 마지막 원소를 그 자리로 옮겨 배열을 빈틈없이 유지한다. (순회 순서는 바뀔 수 있다)
+	- Get(handle): 세대가 맞지 않으면 nullptr. 오래된 핸들을 그 자리에서 잡아낸다.
+*/
+template<typename T, std::size_t ChunkSize = 64>
+class ObjectPool
+{
+public:
+	using HandleType = Handle<T>;
+
+	ObjectPool() = default;
+	~ObjectPool() { Clear(); }
+	ObjectPool(const ObjectPool& rhs) = delete;
+	ObjectPool& operator=(const ObjectPool& rhs) = delete;
+
+	template<typename... Args>
+	HandleType Create(Args&&... args)
+	{
+		std::uint32_t index;
+		if (!mFreeSlots.empty())
+		{
+			index = mFreeSlots.back();
+			mFreeSlots.pop_back();
+		}
+		else
+		{
+			index = static_cast<std::uint32_t>(mSlots.size());
+			assert(index <= HandleType::MaxIndex);
+			if (index % ChunkSize == 0)
+				mChunks.push_back(std::make_unique<Chunk>());
+			mSlots.push_back({ 1, NotAlive });
+		}
+
+		new (Address(index)) T(std::forward<Args>(args)...);
+
+		Slot& slot = mSlots[index];
+		slot.DenseIndex = static_cast<std::uint32_t>(mDense.size());
+		mDense.push_back(index);
+		return HandleType(index, slot.Generation);
+	}
+
+	//이미 지운 핸들이면 아무것도 안 한다.
+	void Destroy(HandleType handle)
+	{
+		if (!IsAlive(handle))
+			return;
+
+		const std::uint32_t index = handle.Index();
+		Address(index)->~T();
+
+		Slot& slot = mSlots[index];
+		const std::uint32_t last = mDense.back();
+		mDense[slot.DenseIndex] = last;
+		mSlots[last].DenseIndex = slot.DenseIndex;
+		mDense.pop_back();
+
+		slot.DenseIndex = NotAlive;
+		slot.Generation = slot.Generation == HandleType::MaxGeneration ? 1 : slot.Generation + 1;
+		mFreeSlots.push_back(index);
+	}
+
+	bool IsAlive(HandleType handle)const
+	{
+		const std::uint32_t index = handle.Index();
+		return handle.IsValid() && index < mSlots.size() &&
+			mSlots[index].DenseIndex != NotAlive && mSlots[index].Generation == handle.Generation();
+	}
+
+	//지웠거나 무효인 핸들이면 nullptr.
+	T* Get(HandleType handle) { return IsAlive(handle) ? Address(handle.Index()) : nullptr; }
+	const T* Get(HandleType handle)const { return IsAlive(handle) ? Address(handle.Index()) : nullptr; }
+
+	//살아 있는 객체 수. [0, Size()) 순서 번호로 At()/HandleAt()을 쓸 수 있다. (Destroy() 후에는 바뀐다)
+	std::size_t Size()const { return mDense.size(); }
+	bool Empty()const { return mDense.empty(); }
+	T& At(std::size_t denseIndex) { return *Address(mDense[denseIndex]); }
+	const T& At(std::size_t denseIndex)const { return *Address(mDense[denseIndex]); }
+	HandleType HandleAt(std::size_t denseIndex)const
+	{
+		const std::uint32_t index = mDense[denseIndex];
+		return HandleType(index, mSlots[index].Generation);
+	}
+
+	template<typename Fn>
+	void ForEach(Fn&& fn)
+	{
+		for (std::uint32_t index : mDense)
+			fn(*Address(index));
+	}
+	template<typename Fn>
+	void ForEach(Fn&& fn)const
+	{
+		for (std::uint32_t index : mDense)
+			fn(*Address(index));
+	}
+
+	void Clear()
+	{
+		while (!mDense.empty())
+			Destroy(HandleAt(mDense.size() - 1));
+	}
+
+private:
+	static constexpr std::uint32_t NotAlive = ~0u;
+
+	struct Slot
+	{
+		std::uint32_t Generation = 1;
+		std::uint32_t DenseIndex = NotAlive;	//NotAlive이면 빈 슬롯
+	};
+
+	struct Chunk
+	{
+		alignas(T) unsigned char Storage[sizeof(T) * ChunkSize];
+	};
+
+	T* Address(std::uint32_t index)const
+	{
+		return std::launder(reinterpret_cast<T*>(mChunks[index / ChunkSize]->Storage + sizeof(T) * (index % ChunkSize)));
+	}
+
+private:
+	std::vector<std::unique_ptr<Chunk>> mChunks;
+	std::vector<Slot> mSlots;
+	std::vector<std::uint32_t> mFreeSlots;
+	std::vector<std::uint32_t> mDense;
+};
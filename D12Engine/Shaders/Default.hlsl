@@ -17,6 +17,43 @@ Texture2D gDiffuseMap2 : register(t1);
 
 SamplerState gsamLinear : register(s0);
 
+#ifdef STRUCTURED_OBJECT_DATA
+
+// 객체/재질 데이터를 빈틈없이 채운 StructuredBuffer. (cbuffer 256바이트 슬롯 대신)
+// CPU의 ObjectConstants/MaterialConstants와 같은 배치.
+struct ObjectData
+{
+    float4x4 World;
+    float4x4 TexTransform;
+};
+
+struct MaterialData
+{
+    float4 DiffuseAlbedo;
+    float3 FresnelR0;
+    float Roughness;
+    float4x4 MatTransform;
+};
+
+StructuredBuffer<ObjectData> gObjectData : register(t0, space1);
+StructuredBuffer<MaterialData> gMaterialData : register(t1, space1);
+
+// 드로우마다 루트 상수로 넘기는 인덱스.
+cbuffer cbDrawIds : register(b0)
+{
+    uint gObjectIndex;
+    uint gMaterialIndex;
+};
+
+#define gWorld (gObjectData[gObjectIndex].World)
+#define gTexTransform (gObjectData[gObjectIndex].TexTransform)
+#define gDiffuseAlbedo (gMaterialData[gMaterialIndex].DiffuseAlbedo)
+#define gFresnelR0 (gMaterialData[gMaterialIndex].FresnelR0)
+#define gRoughness (gMaterialData[gMaterialIndex].Roughness)
+#define gMatTransform (gMaterialData[gMaterialIndex].MatTransform)
+
+#else
+
 cbuffer cbPerObject : register(b0)
 {
     float4x4 gWorld; //16DWARD
@@ -31,6 +68,8 @@ cbuffer cbMaterial : register(b1)
     float4x4 gMatTransform;
 };
 
+#endif
+
 cbuffer cbPass : register(b2)
 {
     float4x4 gView;
@@ -49,9 +88,9 @@ cbuffer cbPass : register(b2)
     float gDeltaTime;
     float4 gAmbientLight;
     
-    // ε [0, NUM_DIR_LIGHTS) ⱤԴϴ.
-	// ε[NUM_DIR_LIGHTS, NUM_DIR_LIGHTS + NUM_POINT_LIGHTS) Դϴ.
-	// ε[NUM_DIR_LIGHTS + NUM_POINT_LIGHTS, NUM_DIR_LIGHTS + NUM_POINT_LIGHT + NUM_SPOT_LIGHTS) ƮƮ̸, ü ִ MaxLights    ֽϴ.
+    // 인덱스 [0, NUM_DIR_LIGHTS)는 방향광입니다.
+	// 인덱스[NUM_DIR_LIGHTS, NUM_DIR_LIGHTS + NUM_POINT_LIGHTS)는 점광원입니다.
+	// 인덱스[NUM_DIR_LIGHTS + NUM_POINT_LIGHTS, NUM_DIR_LIGHTS + NUM_POINT_LIGHT + NUM_SPOT_LIGHTS)는 스포트라이트이며, 객체당 최대 MaxLights 개수까지 사용할 수 있습니다.
     Light gLights[MaxLights];
 };
 
@@ -77,10 +116,10 @@ VertexOut VS(VertexIn vin)
     float4 posW = mul(float4(vin.PosL, 1.0f), gWorld);
     vout.PosW = posW.xyz;
     
-    //  ϸ . ƴ϶   ġ  ؾ Ѵ.
+    // 비균일 스케일링을 가정. 아니라면 월드 행렬의 역전치 행렬을 사용해야 한다.
     vout.NormalW = mul(vin.NormalL, (float3x3) gWorld);
     
-    // homogeneous clip  ȯ.
+    // homogeneous clip 공간으로 변환.
     vout.PosH = mul(posW, gViewProj);
     
     float4 texC = mul(float4(vin.TexC, 0.f, 1.f), gTexTransform);
@@ -93,10 +132,10 @@ float4 PS(VertexOut pin) : SV_Target
 {
     float4 diffuseAlbedo = gDiffuseMap.Sample(gsamLinear, pin.TexC) * gDiffuseAlbedo;
     
-    //  ʹ ̰ 1 ƴ  Ƿ.
+    //보간된 법선 벡터는 길이가 1이 아닐 수 있으므로.
     pin.NormalW = normalize(pin.NormalW);
 
-    // ī޶ ϴ .
+    //광원에서 카메라로 향하는 벡터.
     float3 toEyeW = normalize(gEyePosW - pin.PosW);
     float4 ambient = gAmbientLight * diffuseAlbedo;
     const float shininess = 1.0f - gRoughness;
@@ -108,7 +147,7 @@ float4 PS(VertexOut pin) : SV_Target
 
     float4 litColor = ambient + directLight;
 
-    //Ϲ   ǻ Ƽ   Ѵ.
+    //일반적으로 알파 값은 디퓨즈 머티리얼의 알파 값을 사용한다.
     litColor.a = diffuseAlbedo.a;
     
     return litColor;
@@ -121,7 +160,7 @@ float4 PS_multiTexture(VertexOut pin) : SV_Target
     float4 diffuseAlbedo = diffuseAlbedo1 * diffuseAlbedo2.r;
     
     pin.NormalW = normalize(pin.NormalW);
-    // ī޶ ϴ .
+    //광원에서 카메라로 향하는 벡터.
     float3 toEyeW = normalize(gEyePosW - pin.PosW);
     float4 ambient = gAmbientLight * diffuseAlbedo;
     const float shininess = 1.0f - gRoughness;
@@ -43,9 +43,9 @@ cbuffer cbPass : register(b2)
     float gDeltaTime;
     float4 gAmbientLight;
     
-    // ε [0, NUM_DIR_LIGHTS) ⱤԴϴ.
-	// ε[NUM_DIR_LIGHTS, NUM_DIR_LIGHTS + NUM_POINT_LIGHTS) Դϴ.
-	// ε[NUM_DIR_LIGHTS + NUM_POINT_LIGHTS, NUM_DIR_LIGHTS + NUM_POINT_LIGHT + NUM_SPOT_LIGHTS) ƮƮ̸, ü ִ MaxLights    ֽϴ.
+    // 인덱스 [0, NUM_DIR_LIGHTS)는 방향광입니다.
+	// 인덱스[NUM_DIR_LIGHTS, NUM_DIR_LIGHTS + NUM_POINT_LIGHTS)는 점광원입니다.
+	// 인덱스[NUM_DIR_LIGHTS + NUM_POINT_LIGHTS, NUM_DIR_LIGHTS + NUM_POINT_LIGHT + NUM_SPOT_LIGHTS)는 스포트라이트이며, 객체당 최대 MaxLights 개수까지 사용할 수 있습니다.
     Light gLights[MaxLights];
 };
 
@@ -69,10 +69,10 @@ VertexOut VS(VertexIn vin)
     float4 posW = mul(float4(vin.PosL, 1.0f), gWorld);
     vout.PosW = posW.xyz;
     
-    //  ϸ . ƴ϶   ġ  ؾ Ѵ.
+    // 비균일 스케일링을 가정. 아니라면 월드 행렬의 역전치 행렬을 사용해야 한다.
     vout.NormalW = mul(vin.NormalL, (float3x3) gWorld);
     
-    // homogeneous clip  ȯ.
+    // homogeneous clip 공간으로 변환.
     vout.PosH = mul(posW, gViewProj);
     
     return vout;
@@ -80,10 +80,10 @@ VertexOut VS(VertexIn vin)
 
 float4 PS(VertexOut pin) : SV_Target
 {
-    //  ʹ ̰ 1 ƴ  Ƿ.
+    //보간된 법선 벡터는 길이가 1이 아닐 수 있으므로.
     pin.NormalW = normalize(pin.NormalW);
 
-    // ī޶ ϴ .
+    //광원에서 카메라로 향하는 벡터.
     float3 toEyeW = normalize(gEyePosW - pin.PosW);
     float4 ambient = gAmbientLight * gDiffuseAlbedo;
     const float shininess = 1.0f - gRoughness;
@@ -95,7 +95,7 @@ float4 PS(VertexOut pin) : SV_Target
 
     float4 litColor = ambient + directLight;
 
-    //Ϲ   ǻ Ƽ   Ѵ.
+    //일반적으로 알파 값은 디퓨즈 머티리얼의 알파 값을 사용한다.
     litColor.a = gDiffuseAlbedo.a;
     
     return litColor;
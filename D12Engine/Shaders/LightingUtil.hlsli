@@ -49,12 +49,12 @@ float QuantizeKs(float ks)
 
 float CalcAttenuation(float d, float falloffStart, float falloffEnd)
 {
-    // 
+    //선형 감쇠
     return saturate((falloffEnd - d) / (falloffEnd - falloffStart));
 }
 
-// Schlick  ݻ  ٻġ մϴ(233 "ǽð  3" ).
-// R0 = ( (n-1)/(n+1) )^2, ⼭ n Դϴ.
+// Schlick은 프레넬 반사율에 대한 근사치를 제시합니다(233페이지 "실시간 렌더링 3판" 참조).
+// R0 = ( (n-1)/(n+1) )^2, 여기서 n은 굴절률입니다.
 float3 SchlickFresnel(float3 R0, float3 normal, float3 lightVec)
 {
     float cosIncidentAngle = saturate(dot(normal, lightVec));
@@ -75,8 +75,8 @@ float3 BlinnPhong(float3 lightStrength, float3 lightVec, float3 normal, float3 t
     
     float3 specAlbedo = fresnelFactor * roughnessFactor;
 
-    //Blinn-Phong 𵨿 specAlbedo 1 Ŭ  ִ.
-    //LDR  ϰ Ƿ  ణ Ѵ.
+    //Blinn-Phong 모델에서는 specAlbedo가 1보다 클 수 있다.
+    //LDR 렌더링을 수행하고 있으므로 범위를 약간 축소한다.
     specAlbedo = specAlbedo / (specAlbedo + 1.0f);
     
     return (mat.DiffuseAlbedo.rgb + specAlbedo) * lightStrength;
@@ -93,20 +93,20 @@ float3 BlinnPhongToon(float3 lightStrength, float3 lightVec, float3 normal, floa
     float3 halfVec = normalize(toEye + lightVec);
     float ndoth = saturate(dot(halfVec, normal));
 
-    float ks = pow(max(ndoth, 0), m); // ŧ  ٽ
-    float ks_q = QuantizeKs(ks); // ̻ȭ
+    float ks = pow(max(ndoth, 0), m); // 스펙큘러 강도의 핵심
+    float ks_q = QuantizeKs(ks); // 이산화
 
     float roughnessFactor = (m + 8.0f) * pow(max(dot(halfVec, normal), 0.0f), m) / 8.0f;
-    // fresnel() + (ʿϸ) ȭ  
+    // fresnel(색) + (필요하면) 정규화 계수는 취향
     float3 fresnelFactor = SchlickFresnel(mat.FresnelR0, halfVec, lightVec);
 
-    // ks_q spec ݿ
+    // ks_q를 spec에 반영
     float3 specAlbedo = roughnessFactor * fresnelFactor * ks_q;
 
-    // LDR clamp  
+    // LDR clamp는 유지 가능
     specAlbedo = specAlbedo / (specAlbedo + 1.0f);
 
-    // diffuse kd_q ݿ
+    // diffuse는 kd_q를 반영
     float3 diffuse = mat.DiffuseAlbedo.rgb * kd_q;
     
     return (diffuse + specAlbedo) * lightStrength;
@@ -114,10 +114,10 @@ float3 BlinnPhongToon(float3 lightStrength, float3 lightVec, float3 normal, floa
 
 float3 ComputeDirectionalLight(Light L, Material mat, float3 normal, float3 toEye)
 {
-    // ʹ  ϴ  ݴ .
+    //광 벡터는 빛이 진행하는 방향과 반대 방향.
     float3 lightVec = -L.Direction;
     
-    //Ʈ ڻ Ģ    .
+    //람베르트 코사인 법칙에 따라 빛 강도 계산.
     float ndotl = max(dot(lightVec, normal), 0.0f);
     float3 lightStrength = L.Strength * ndotl;
     
@@ -132,13 +132,13 @@ float3 ComputePointLight(Light L, Material mat, float3 pos, float3 normal, float
     if(d > L.FalloffEnd)
         return 0;
     
-    lightVec /= d; //ȭ
+    lightVec /= d; //정규화
     
-    //Ʈ ڻ Ģ    .
+    //람베르트 코사인 법칙에 따라 빛 강도 계산.
     float ndotl = max(dot(lightVec, normal), 0.0f);
     float3 lightStrength = L.Strength * ndotl;
     
-    //Ÿ    .
+    //거리에 따른 빛 감쇠 계산.
     float att = CalcAttenuation(d, L.FalloffStart, L.FalloffEnd);
     lightStrength *= att;
     
@@ -153,17 +153,17 @@ float3 ComputeSpotLight(Light L, Material mat, float3 pos, float3 normal, float3
     if(d > L.FalloffEnd)
         return 0;
     
-    lightVec /= d; //ȭ
+    lightVec /= d; //정규화
     
-    //Ʈ ڻ Ģ    .
+    //람베르트 코사인 법칙에 따라 빛 강도 계산.
     float ndotl = max(dot(lightVec, normal), 0.0f);
     float3 lightStrength = L.Strength * ndotl;
     
-    //Ÿ    .
+    //거리에 따른 빛 감쇠 계산.
     float att = CalcAttenuation(d, L.FalloffStart, L.FalloffEnd);
     lightStrength *= att;
     
-    //ƮƮ ,  ƮƮ ߽ɿ ־  .
+    //스포트라이트의 경우, 빛이 스포트라이트의 중심에서 멀어질수록 빛이 약해진다.
     float spotFactor = pow(max(dot(-lightVec, L.Direction), 0.0f), L.SpotPower);
     lightStrength *= spotFactor;    
     
@@ -0,0 +1,102 @@
+﻿#include "TextureDedup.h"
+#include "d3dUtil.h"
+
+#include <algorithm>
+#include <cstdio>
+
+Texture* TextureDedup::Acquire(Texture* texture, std::uint64_t contentHash, std::uint64_t size)
+{
+	if (texture == nullptr)
+		return nullptr;
+
+	if (Texture* owner = Owner(texture))
+		return owner;
+
+	const Key key = { contentHash, size };
+	Shared& shared = mShared[key];
+	mKeys[texture] = key;
+	shared.Users.push_back(texture);
+
+	if (shared.Owner == nullptr)
+	{
+		shared.Owner = texture;
+		mStats.UniqueCount++;
+		mStats.UniqueBytes += size;
+	}
+	else
+	{
+		mStats.SharedCount++;
+		mStats.SavedBytes += size;
+	}
+	return shared.Owner;
+}
+
+bool TextureDedup::Release(Texture* texture)
+{
+	const auto keyIt = mKeys.find(texture);
+	if (keyIt == mKeys.end())
+		return false;
+
+	const Key key = keyIt->second;
+	mKeys.erase(keyIt);
+
+	const auto it = mShared.find(key);
+	Shared& shared = it->second;
+	shared.Users.erase(std::find(shared.Users.begin(), shared.Users.end(), texture));
+
+	if (shared.Users.empty())
+	{
+		mShared.erase(it);
+		mStats.UniqueCount--;
+		mStats.UniqueBytes -= key.Size;
+		return true;
+	}
+
+	if (shared.Owner == texture)
+		shared.Owner = shared.Users.front();
+
+	mStats.SharedCount--;
+	mStats.SavedBytes -= key.Size;
+	return false;
+}
+
+Texture* TextureDedup::Owner(const Texture* texture)const
+{
+	const auto keyIt = mKeys.find(texture);
+	if (keyIt == mKeys.end())
+		return nullptr;
+	return mShared.at(keyIt->second).Owner;
+}
+
+std::uint32_t TextureDedup::RefCount(const Texture* texture)const
+{
+	const auto keyIt = mKeys.find(texture);
+	if (keyIt == mKeys.end())
+		return 0;
+	return static_cast<std::uint32_t>(mShared.at(keyIt->second).Users.size());
+}
+
+std::string TextureDedup::Report()const
+{
+	char line[256];
+	std::snprintf(line, sizeof(line), "texture dedup: %zu unique, %zu shared, %llu bytes loaded, %llu bytes saved\n",
+		mStats.UniqueCount, mStats.SharedCount,
+		static_cast<unsigned long long>(mStats.UniqueBytes), static_cast<unsigned long long>(mStats.SavedBytes));
+	std::string report = line;
+
+	for (const auto& [key, shared] : mShared)
+	{
+		if (shared.Users.size() < 2)
+			continue;
+
+		report += "  " + shared.Owner->Name + " <-";
+		for (const Texture* user : shared.Users)
+		{
+			if (user != shared.Owner)
+				report += " " + user->Name;
+		}
+		std::snprintf(line, sizeof(line), " (%llu bytes each)\n", static_cast<unsigned long long>(key.Size));
+		report += line;
+	}
+	return report;
+}
@@ -0,0 +1,67 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct Texture;
+
+/*
+	내용 해시로 텍스처 중복 제거. (GPU 작업 없음, 결과대로 AppD3D가 리소스와 SRV를 같이 쓰게 한다)
+
+	- Acquire(): DDS 이미지의 해시와 크기가 같은 텍스처가 이미 있으면 그 텍스처(원본)를 돌려주고 참조 수를 올린다.
+	  없으면 넘긴 텍스처가 원본이 된다. 별칭 텍스처는 리소스를 만들지 않고 원본의 리소스와 SRV를 쓴다.
+	- Release(): 참조를 놓는다. 마지막 참조가 풀리면 true. (그때 원본의 리소스를 해제)
+	  원본이 먼저 풀리고 별칭이 남아 있으면 남은 첫 텍스처가 원본이 된다. (호출한 쪽이 리소스를 옮긴다)
+	- 해시는 XXH64 (AssetCache::Hash). 크기까지 같아야 같은 이미지로 본다.
+*/
+class TextureDedup
+{
+public:
+	struct Stats
+	{
+		std::size_t UniqueCount = 0;	//리소스를 가진 이미지 수
+		std::size_t SharedCount = 0;	//다른 텍스처의 리소스를 쓰는 텍스처 수
+		std::uint64_t UniqueBytes = 0;
+		std::uint64_t SavedBytes = 0;	//별칭이 따로 올라갔다면 더 썼을 바이트 수
+	};
+
+	//이미 등록된 텍스처면 기존 원본을 그대로 돌려준다. (참조 수는 그대로)
+	Texture* Acquire(Texture* texture, std::uint64_t contentHash, std::uint64_t size);
+	bool Release(Texture* texture);
+
+	//texture가 쓰는 리소스의 원본. 모르는 텍스처면 nullptr.
+	Texture* Owner(const Texture* texture)const;
+	//원본을 같이 쓰는 텍스처 수. (원본 포함, 모르는 텍스처면 0)
+	std::uint32_t RefCount(const Texture* texture)const;
+
+	const Stats& GetStats()const { return mStats; }
+	//요약 한 줄 + 공유 중인 원본마다 한 줄.
+	std::string Report()const;
+
+private:
+	struct Key
+	{
+		std::uint64_t Hash = 0;
+		std::uint64_t Size = 0;
+
+		bool operator==(const Key& rhs)const { return Hash == rhs.Hash && Size == rhs.Size; }
+	};
+
+	struct KeyHasher
+	{
+		std::size_t operator()(const Key& key)const { return static_cast<std::size_t>(key.Hash ^ (key.Size * 0x9E3779B97F4A7C15ull)); }
+	};
+
+	struct Shared
+	{
+		Texture* Owner = nullptr;
+		std::vector<Texture*> Users;	//Owner 포함, Acquire 순서
+	};
+
+	std::unordered_map<Key, Shared, KeyHasher> mShared;
+	std::unordered_map<const Texture*, Key> mKeys;
+	Stats mStats;
+};
@@ -0,0 +1,614 @@
+﻿#include "TexturePack.h"
+#include "AssetCache.h"
+#include "DDSWriter.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <ppl.h>
+
+namespace
+{
+	constexpr std::uint32_t MinMatch = 4;
+	constexpr std::uint32_t MaxOffset = 0xffff;
+	constexpr std::uint32_t HashBits = 14;
+
+	//DDS 헤더에서 필요한 필드만. (magic 뒤 DDS_HEADER 기준 오프셋)
+	constexpr std::uint32_t DdsMagic = 0x20534444;	// "DDS "
+	constexpr std::size_t DdsHeaderSize = 4 + 124;
+	constexpr std::size_t DdsDx10Size = 20;
+	constexpr std::uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+	constexpr std::uint32_t DDSD_DEPTH = 0x800000;
+	constexpr std::uint32_t DDPF_FOURCC = 0x4;
+	constexpr std::uint32_t DDPF_RGB = 0x40;
+	constexpr std::uint32_t DDSCAPS2_CUBEMAP = 0x200;
+	constexpr std::uint32_t DDSCAPS2_VOLUME = 0x200000;
+	constexpr std::uint32_t DX10_DIMENSION_TEXTURE2D = 3;
+	constexpr std::uint32_t DX10_MISC_TEXTURECUBE = 0x4;
+
+	constexpr std::uint32_t MakeFourCC(char a, char b, char c, char d)
+	{
+		return std::uint32_t(std::uint8_t(a)) | (std::uint32_t(std::uint8_t(b)) << 8) |
+			(std::uint32_t(std::uint8_t(c)) << 16) | (std::uint32_t(std::uint8_t(d)) << 24);
+	}
+
+	inline std::uint32_t Read32(const std::uint8_t* p)
+	{
+		std::uint32_t v;
+		std::memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	inline std::uint64_t AlignUp(std::uint64_t v, std::uint64_t alignment)
+	{
+		return (v + alignment - 1) & ~(alignment - 1);
+	}
+
+	inline bool InRange(std::uint64_t offset, std::uint64_t size, std::uint64_t fileSize)
+	{
+		return offset <= fileSize && size <= fileSize - offset;
+	}
+
+	inline std::uint32_t HashSequence(std::uint32_t v)
+	{
+		return (v * 2654435761u) >> (32 - HashBits);
+	}
+
+	//15 이상의 길이는 255씩 이어 쓴다.
+	void WriteLength(std::vector<std::uint8_t>& out, std::size_t length)
+	{
+		for (; length >= 255; length -= 255)
+			out.push_back(255);
+		out.push_back(static_cast<std::uint8_t>(length));
+	}
+
+	bool ReadLength(const std::uint8_t*& ip, const std::uint8_t* end, std::size_t& length)
+	{
+		for (;;)
+		{
+			if (ip == end)
+				return false;
+			const std::uint8_t b = *ip++;
+			length += b;
+			if (b != 255)
+				return true;
+		}
+	}
+
+	void WriteSequence(std::vector<std::uint8_t>& out, const std::uint8_t* literals, std::size_t literalCount,
+		std::size_t offset, std::size_t matchLength)
+	{
+		const std::size_t matchCode = matchLength ? matchLength - MinMatch : 0;
+		out.push_back(static_cast<std::uint8_t>(((std::min)(literalCount, std::size_t(15)) << 4) | (std::min)(matchCode, std::size_t(15))));
+		if (literalCount >= 15)
+			WriteLength(out, literalCount - 15);
+		out.insert(out.end(), literals, literals + literalCount);
+
+		//마지막 시퀀스는 리터럴만.
+		if (matchLength == 0)
+			return;
+
+		out.push_back(static_cast<std::uint8_t>(offset & 0xff));
+		out.push_back(static_cast<std::uint8_t>(offset >> 8));
+		if (matchCode >= 15)
+			WriteLength(out, matchCode - 15);
+	}
+
+	//DDS 레거시 픽셀 형식 -> DXGI. 청크를 나누는 데만 쓰므로 DDSWriter가 크기를 아는 형식만.
+	DXGI_FORMAT LegacyFormat(const std::uint8_t* pf)
+	{
+		const std::uint32_t flags = Read32(pf + 4);
+		if (flags & DDPF_FOURCC)
+		{
+			switch (Read32(pf + 8))
+			{
+			case MakeFourCC('D', 'X', 'T', '1'): return DXGI_FORMAT_BC1_UNORM;
+			case MakeFourCC('D', 'X', 'T', '2'):
+			case MakeFourCC('D', 'X', 'T', '3'): return DXGI_FORMAT_BC2_UNORM;
+			case MakeFourCC('D', 'X', 'T', '4'):
+			case MakeFourCC('D', 'X', 'T', '5'): return DXGI_FORMAT_BC3_UNORM;
+			case MakeFourCC('A', 'T', 'I', '1'):
+			case MakeFourCC('B', 'C', '4', 'U'): return DXGI_FORMAT_BC4_UNORM;
+			case MakeFourCC('A', 'T', 'I', '2'):
+			case MakeFourCC('B', 'C', '5', 'U'): return DXGI_FORMAT_BC5_UNORM;
+			default: return DXGI_FORMAT_UNKNOWN;
+			}
+		}
+
+		if ((flags & DDPF_RGB) && Read32(pf + 12) == 32 &&
+			Read32(pf + 16) == 0x000000ff && Read32(pf + 20) == 0x0000ff00 && Read32(pf + 24) == 0x00ff0000)
+			return DXGI_FORMAT_R8G8B8A8_UNORM;
+
+		return DXGI_FORMAT_UNKNOWN;
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// 이름, LZ
+//--------------------------------------------------------------------------------------
+
+std::string TexturePack::NormalizeName(std::string_view name)
+{
+	std::string result(name);
+	for (char& c : result)
+		c = c == '\\' ? '/' : static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+	return result;
+}
+
+std::uint64_t TexturePack::HashName(std::string_view name)
+{
+	return AssetCache::Hash(NormalizeName(name));
+}
+
+bool TexturePack::CompressLZ(const std::uint8_t* src, std::size_t srcSize, std::vector<std::uint8_t>& outData)
+{
+	outData.clear();
+	if (srcSize < MinMatch * 2)
+		return false;
+
+	outData.reserve(srcSize);
+
+	//위치 + 1을 저장. (0 = 비어 있음)
+	std::vector<std::uint32_t> table(std::size_t(1) << HashBits, 0);
+
+	std::size_t anchor = 0;
+	std::size_t i = 0;
+	while (i + MinMatch <= srcSize)
+	{
+		const std::uint32_t sequence = Read32(src + i);
+		std::uint32_t& slot = table[HashSequence(sequence)];
+		const std::size_t candidate = slot;
+		slot = static_cast<std::uint32_t>(i + 1);
+
+		if (candidate != 0 && i - (candidate - 1) <= MaxOffset && Read32(src + candidate - 1) == sequence)
+		{
+			const std::size_t from = candidate - 1;
+			std::size_t length = MinMatch;
+			while (i + length < srcSize && src[from + length] == src[i + length])
+				length++;
+
+			WriteSequence(outData, src + anchor, i - anchor, i - from, length);
+			if (outData.size() >= srcSize)
+				return false;
+
+			//매치 끝 근처 위치도 등록해서 다음 매치를 찾기 쉽게.
+			const std::size_t tail = i + length - 2;
+			if (tail + MinMatch <= srcSize)
+				table[HashSequence(Read32(src + tail))] = static_cast<std::uint32_t>(tail + 1);
+
+			i += length;
+			anchor = i;
+			continue;
+		}
+
+		i++;
+	}
+
+	WriteSequence(outData, src + anchor, srcSize - anchor, 0, 0);
+	return outData.size() < srcSize;
+}
+
+bool TexturePack::DecompressLZ(const std::uint8_t* src, std::size_t srcSize, std::uint8_t* dst, std::size_t dstSize)
+{
+	const std::uint8_t* ip = src;
+	const std::uint8_t* const ipEnd = src + srcSize;
+	std::uint8_t* op = dst;
+	std::uint8_t* const opEnd = dst + dstSize;
+
+	for (;;)
+	{
+		if (ip == ipEnd)
+			return false;
+
+		const std::uint8_t token = *ip++;
+		std::size_t literalCount = token >> 4;
+		if (literalCount == 15 && !ReadLength(ip, ipEnd, literalCount))
+			return false;
+		if (literalCount > std::size_t(ipEnd - ip) || literalCount > std::size_t(opEnd - op))
+			return false;
+
+		std::memcpy(op, ip, literalCount);
+		ip += literalCount;
+		op += literalCount;
+
+		//마지막 시퀀스.
+		if (ip == ipEnd)
+			return op == opEnd;
+
+		if (ipEnd - ip < 2)
+			return false;
+		const std::size_t offset = std::size_t(ip[0]) | (std::size_t(ip[1]) << 8);
+		ip += 2;
+		if (offset == 0 || offset > std::size_t(op - dst))
+			return false;
+
+		std::size_t matchLength = token & 15;
+		if (matchLength == 15 && !ReadLength(ip, ipEnd, matchLength))
+			return false;
+		matchLength += MinMatch;
+		if (matchLength > std::size_t(opEnd - op))
+			return false;
+
+		//겹치는 매치(offset < 길이)는 반복 패턴이므로 앞에서부터 한 바이트씩.
+		const std::uint8_t* match = op - offset;
+		if (offset >= matchLength)
+		{
+			std::memcpy(op, match, matchLength);
+			op += matchLength;
+		}
+		else
+		{
+			for (std::size_t k = 0; k < matchLength; k++)
+				*op++ = *match++;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------
+// TexturePack (읽기)
+//--------------------------------------------------------------------------------------
+
+bool TexturePack::Open(const std::filesystem::path& path)
+{
+	Close();
+
+	if (!mFile.Open(path) || mFile.Size() < sizeof(TexturePackHeader))
+	{
+		mFile.Close();
+		return false;
+	}
+
+	mHeader = reinterpret_cast<const TexturePackHeader*>(mFile.Data());
+	mEntries = reinterpret_cast<const TexturePackEntry*>(mFile.Data() + mHeader->EntryTableOffset);
+	mChunks = reinterpret_cast<const TexturePackChunk*>(mFile.Data() + mHeader->ChunkTableOffset);
+	mStrings = mFile.Begin() + mHeader->StringTableOffset;
+	if (!Validate())
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void TexturePack::Close()
+{
+	mHeader = nullptr;
+	mEntries = nullptr;
+	mChunks = nullptr;
+	mStrings = nullptr;
+	mFile.Close();
+}
+
+bool TexturePack::Validate()const
+{
+	const TexturePackHeader& h = *mHeader;
+	const std::uint64_t fileSize = mFile.Size();
+
+	if (h.Magic != Magic || h.Version != Version || h.HeaderSize != sizeof(TexturePackHeader))
+		return false;
+	if (h.FileSize != fileSize || h.DataAlignment != DataAlignment)
+		return false;
+	if ((h.EntryTableOffset | h.ChunkTableOffset) % alignof(std::uint64_t) != 0)
+		return false;
+	if (!InRange(h.EntryTableOffset, std::uint64_t(h.EntryCount) * sizeof(TexturePackEntry), fileSize) ||
+		!InRange(h.ChunkTableOffset, std::uint64_t(h.ChunkCount) * sizeof(TexturePackChunk), fileSize) ||
+		!InRange(h.StringTableOffset, h.StringTableSize, fileSize))
+		return false;
+
+	//색인만 검사한다. 텍스처 데이터 페이지는 건드리지 않는다.
+	for (std::uint32_t i = 0; i < h.EntryCount; i++)
+	{
+		const TexturePackEntry& e = mEntries[i];
+		if (i > 0 && e.NameHash < mEntries[i - 1].NameHash)
+			return false;
+		if (!InRange(e.NameOffset, std::uint64_t(e.NameLength) + 1, h.StringTableSize) || mStrings[e.NameOffset + e.NameLength] != '\0')
+			return false;
+		if (e.DataOffset % DataAlignment != 0 || !InRange(e.DataOffset, e.StoredSize, fileSize))
+			return false;
+		if (e.ChunkCount == 0 || !InRange(e.FirstChunk, e.ChunkCount, h.ChunkCount))
+			return false;
+
+		//청크는 풀었을 때도, 저장된 상태로도 빈틈없이 이어져야 한다.
+		std::uint64_t rawOffset = 0;
+		std::uint64_t storedOffset = 0;
+		for (std::uint32_t c = 0; c < e.ChunkCount; c++)
+		{
+			const TexturePackChunk& chunk = mChunks[e.FirstChunk + c];
+			if (chunk.RawOffset != rawOffset || chunk.StoredOffset != storedOffset || chunk.StoredSize > chunk.RawSize)
+				return false;
+			rawOffset += chunk.RawSize;
+			storedOffset += chunk.StoredSize;
+		}
+		if (rawOffset != e.RawSize || storedOffset != e.StoredSize)
+			return false;
+	}
+
+	return true;
+}
+
+std::string_view TexturePack::EntryName(const TexturePackEntry& entry)const
+{
+	return std::string_view(mStrings + entry.NameOffset, entry.NameLength);
+}
+
+const TexturePackEntry* TexturePack::Find(std::string_view name)const
+{
+	if (!IsOpen())
+		return nullptr;
+
+	const std::string normalized = NormalizeName(name);
+	const std::uint64_t hash = AssetCache::Hash(normalized);
+
+	const TexturePackEntry* end = mEntries + mHeader->EntryCount;
+	const TexturePackEntry* it = std::lower_bound(mEntries, end, hash,
+		[](const TexturePackEntry& e, std::uint64_t h) { return e.NameHash < h; });
+
+	//해시 충돌이면 이름까지 비교.
+	for (; it != end && it->NameHash == hash; ++it)
+	{
+		if (EntryName(*it) == normalized)
+			return it;
+	}
+	return nullptr;
+}
+
+const std::uint8_t* TexturePack::View(const TexturePackEntry& entry)const
+{
+	//압축된 청크는 항상 원본보다 작으므로, 크기가 같으면 압축된 청크가 없다.
+	if (entry.StoredSize != entry.RawSize)
+		return nullptr;
+	return mFile.Data() + entry.DataOffset;
+}
+
+bool TexturePack::Read(const TexturePackEntry& entry, std::vector<std::uint8_t>& outData)const
+{
+	outData.resize(static_cast<std::size_t>(entry.RawSize));
+
+	const std::uint8_t* data = mFile.Data() + entry.DataOffset;
+	for (std::uint32_t c = 0; c < entry.ChunkCount; c++)
+	{
+		const TexturePackChunk& chunk = mChunks[entry.FirstChunk + c];
+		const std::uint8_t* src = data + chunk.StoredOffset;
+		std::uint8_t* dst = outData.data() + chunk.RawOffset;
+
+		if (chunk.StoredSize == chunk.RawSize)
+			std::memcpy(dst, src, chunk.RawSize);
+		else if (!DecompressLZ(src, chunk.StoredSize, dst, chunk.RawSize))
+			return false;
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------
+// TexturePackSource (쓰기)
+//--------------------------------------------------------------------------------------
+
+bool TexturePackSource::Add(std::string_view name, std::vector<std::uint8_t>&& ddsData)
+{
+	std::string normalized = TexturePack::NormalizeName(name);
+	if (normalized.empty())
+		return false;
+
+	for (const Item& item : Items)
+	{
+		if (item.Name == normalized)
+			return false;
+	}
+
+	Items.push_back({ std::move(normalized), std::move(ddsData) });
+	return true;
+}
+
+void TexturePackSource::SplitChunks(const std::uint8_t* dds, std::size_t size, std::vector<std::uint64_t>& outBoundaries)
+{
+	outBoundaries.clear();
+	outBoundaries.push_back(0);
+
+	if (size <= DdsHeaderSize || Read32(dds) != DdsMagic)
+	{
+		outBoundaries.push_back(size);
+		return;
+	}
+
+	const std::uint8_t* header = dds + 4;
+	const std::uint32_t flags = Read32(header + 4);
+	const std::uint32_t height = Read32(header + 8);
+	const std::uint32_t width = Read32(header + 12);
+	const std::uint32_t mipCount = (flags & DDSD_MIPMAPCOUNT) ? (std::max)(1u, Read32(header + 24)) : 1u;
+	const std::uint8_t* pixelFormat = header + 72;
+	const std::uint32_t caps2 = Read32(header + 108);
+
+	std::size_t headerSize = DdsHeaderSize;
+	DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+	bool plain2D = !(flags & DDSD_DEPTH) && !(caps2 & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME));
+
+	if ((Read32(pixelFormat + 4) & DDPF_FOURCC) && Read32(pixelFormat + 8) == MakeFourCC('D', 'X', '1', '0'))
+	{
+		headerSize += DdsDx10Size;
+		if (size > headerSize)
+		{
+			const std::uint8_t* dx10 = dds + DdsHeaderSize;
+			format = static_cast<DXGI_FORMAT>(Read32(dx10));
+			plain2D = plain2D && Read32(dx10 + 4) == DX10_DIMENSION_TEXTURE2D &&
+				!(Read32(dx10 + 8) & DX10_MISC_TEXTURECUBE) && Read32(dx10 + 12) <= 1;
+		}
+	}
+	else
+	{
+		format = LegacyFormat(pixelFormat);
+	}
+
+	//밉 경계를 모르면 헤더와 나머지로만 나눈다.
+	std::uint64_t offset = headerSize;
+	std::vector<std::uint64_t> mipEnds;
+	if (plain2D && DDSWriter::IsSupported(format) && width > 0 && height > 0)
+	{
+		for (std::uint32_t mip = 0; mip < mipCount && offset <= size; mip++)
+		{
+			offset += DDSWriter::LevelSize(format, (std::max)(1u, width >> mip), (std::max)(1u, height >> mip));
+			mipEnds.push_back(offset);
+		}
+	}
+	if (mipEnds.empty() || offset > size)
+		mipEnds.clear();
+
+	if (headerSize < size)
+		outBoundaries.push_back(headerSize);
+	for (std::uint64_t end : mipEnds)
+	{
+		if (end > outBoundaries.back() && end < size)
+			outBoundaries.push_back(end);
+	}
+	outBoundaries.push_back(size);
+}
+
+bool TexturePackSource::Write(const std::filesystem::path& path, bool compress, std::uint64_t* outStoredBytes)const
+{
+	struct Packed
+	{
+		std::vector<TexturePackChunk> Chunks;
+		std::vector<std::uint8_t> Data;		//압축이 없으면 비워 두고 원본을 그대로 쓴다.
+		bool Failed = false;
+	};
+
+	//청크 나누기와 압축은 텍스처 단위로 병렬.
+	std::vector<Packed> packed(Items.size());
+	concurrency::parallel_for(std::size_t(0), Items.size(), [&](std::size_t i)
+	{
+		const Item& item = Items[i];
+		Packed& p = packed[i];
+
+		std::vector<std::uint64_t> boundaries;
+		SplitChunks(item.Data.data(), item.Data.size(), boundaries);
+
+		bool anyCompressed = false;
+		std::vector<std::uint8_t> compressed;
+		for (std::size_t c = 0; c + 1 < boundaries.size(); c++)
+		{
+			const std::uint64_t rawSize = boundaries[c + 1] - boundaries[c];
+			if (rawSize > UINT32_MAX)
+			{
+				p.Failed = true;
+				return;
+			}
+
+			const std::uint8_t* src = item.Data.data() + boundaries[c];
+			TexturePackChunk chunk = {};
+			chunk.RawOffset = boundaries[c];
+			chunk.StoredOffset = p.Data.size();
+			chunk.RawSize = static_cast<std::uint32_t>(rawSize);
+
+			if (compress && TexturePack::CompressLZ(src, static_cast<std::size_t>(rawSize), compressed))
+			{
+				p.Data.insert(p.Data.end(), compressed.begin(), compressed.end());
+				anyCompressed = true;
+			}
+			else
+			{
+				p.Data.insert(p.Data.end(), src, src + rawSize);
+			}
+			chunk.StoredSize = static_cast<std::uint32_t>(p.Data.size() - chunk.StoredOffset);
+			p.Chunks.push_back(chunk);
+		}
+
+		if (!anyCompressed)
+			p.Data.clear();
+	});
+
+	//색인은 (해시, 이름) 순. 데이터는 넣은 순서 그대로.
+	std::vector<std::size_t> order(Items.size());
+	for (std::size_t i = 0; i < order.size(); i++)
+		order[i] = i;
+	std::vector<std::uint64_t> hashes(Items.size());
+	for (std::size_t i = 0; i < Items.size(); i++)
+		hashes[i] = AssetCache::Hash(Items[i].Name);
+	std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+	{
+		return hashes[a] != hashes[b] ? hashes[a] < hashes[b] : Items[a].Name < Items[b].Name;
+	});
+
+	TexturePackHeader header = {};
+	header.Magic = TexturePack::Magic;
+	header.Version = TexturePack::Version;
+	header.HeaderSize = sizeof(TexturePackHeader);
+	header.EntryCount = static_cast<std::uint32_t>(Items.size());
+	header.DataAlignment = static_cast<std::uint32_t>(TexturePack::DataAlignment);
+
+	std::vector<TexturePackEntry> entries(Items.size());
+	std::vector<TexturePackChunk> chunks;
+	std::string strings;
+	for (std::size_t i = 0; i < Items.size(); i++)
+	{
+		if (packed[i].Failed)
+			return false;
+
+		TexturePackEntry& e = entries[i];
+		e.NameHash = hashes[i];
+		e.NameOffset = static_cast<std::uint32_t>(strings.size());
+		e.NameLength = static_cast<std::uint32_t>(Items[i].Name.size());
+		strings += Items[i].Name;
+		strings += '\0';
+
+		e.FirstChunk = static_cast<std::uint32_t>(chunks.size());
+		e.ChunkCount = static_cast<std::uint32_t>(packed[i].Chunks.size());
+		chunks.insert(chunks.end(), packed[i].Chunks.begin(), packed[i].Chunks.end());
+		e.RawSize = Items[i].Data.size();
+		e.StoredSize = packed[i].Data.empty() ? e.RawSize : packed[i].Data.size();
+	}
+
+	header.ChunkCount = static_cast<std::uint32_t>(chunks.size());
+	header.StringTableSize = static_cast<std::uint32_t>(strings.size());
+	header.EntryTableOffset = sizeof(TexturePackHeader);
+	header.ChunkTableOffset = header.EntryTableOffset + entries.size() * sizeof(TexturePackEntry);
+	header.StringTableOffset = header.ChunkTableOffset + chunks.size() * sizeof(TexturePackChunk);
+
+	std::uint64_t offset = header.StringTableOffset + strings.size();
+	std::uint64_t storedBytes = 0;
+	for (TexturePackEntry& e : entries)
+	{
+		e.DataOffset = AlignUp(offset, TexturePack::DataAlignment);
+		offset = e.DataOffset + e.StoredSize;
+		storedBytes += e.StoredSize;
+	}
+	header.FileSize = offset;
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (!out)
+		return false;
+
+	auto writeAt = [&out](std::uint64_t at, const void* data, std::size_t size)
+	{
+		out.seekp(static_cast<std::streamoff>(at));
+		out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+	};
+
+	std::vector<TexturePackEntry> sortedEntries;
+	sortedEntries.reserve(entries.size());
+	for (std::size_t i : order)
+		sortedEntries.push_back(entries[i]);
+
+	writeAt(0, &header, sizeof(header));
+	writeAt(header.EntryTableOffset, sortedEntries.data(), sortedEntries.size() * sizeof(TexturePackEntry));
+	writeAt(header.ChunkTableOffset, chunks.data(), chunks.size() * sizeof(TexturePackChunk));
+	writeAt(header.StringTableOffset, strings.data(), strings.size());
+
+	//정렬 패딩은 0으로 채운다.
+	static const char zeros[TexturePack::DataAlignment] = {};
+	std::uint64_t written = header.StringTableOffset + strings.size();
+	for (std::size_t i = 0; i < Items.size(); i++)
+	{
+		const TexturePackEntry& e = entries[i];
+		out.write(zeros, static_cast<std::streamsize>(e.DataOffset - written));
+
+		const std::vector<std::uint8_t>& data = packed[i].Data.empty() ? Items[i].Data : packed[i].Data;
+		out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+		written = e.DataOffset + e.StoredSize;
+	}
+
+	if (outStoredBytes)
+		*outStoredBytes = storedBytes;
+	return static_cast<bool>(out);
+}
@@ -0,0 +1,139 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "MappedFile.h"
+
+/*
+	.d12pak 텍스처 묶음 파일 (리틀 엔디언, 버전 관리).
+
+	[TexturePackHeader]
+	[TexturePackEntry x EntryCount]  이름 해시 순으로 정렬
+	[TexturePackChunk x ChunkCount]
+	[문자열 테이블 (텍스처 이름, '\0' 종료)]
+	(4KB 정렬) [텍스처 0 데이터] (4KB 정렬) [텍스처 1 데이터] ...
+
+	텍스처 데이터는 DDS 파일 내용 그대로이고, 넣은 순서대로 이어 붙인다. (로드 순서대로 넣으면 순차 읽기)
+	데이터는 청크(DDS 헤더, 밉 레벨 하나)로 나뉘고, 압축해서 작아지는 청크만 LZ 압축으로 저장한다.
+	압축된 청크가 없는 텍스처는 매핑한 포인터를 복사 없이 그대로 쓸 수 있다.
+	헤더/색인/이름은 파일 앞쪽 몇 페이지에 모여 있어 열 때 읽는 양이 적다.
+*/
+
+struct TexturePackHeader
+{
+	std::uint32_t Magic;
+	std::uint32_t Version;
+	std::uint32_t HeaderSize;
+	std::uint32_t EntryCount;
+	std::uint64_t FileSize;
+
+	std::uint64_t EntryTableOffset;
+	std::uint64_t ChunkTableOffset;
+	std::uint32_t ChunkCount;
+	std::uint32_t StringTableSize;
+	std::uint64_t StringTableOffset;
+	std::uint32_t DataAlignment;
+	std::uint32_t Reserved;
+};
+
+struct TexturePackEntry
+{
+	std::uint64_t NameHash;			//TexturePack::HashName(이름)
+	std::uint32_t NameOffset;		//문자열 테이블 내 오프셋
+	std::uint32_t NameLength;
+	std::uint64_t DataOffset;		//파일 시작 기준, DataAlignment 정렬
+	std::uint64_t StoredSize;		//파일에 저장된 바이트 수
+	std::uint64_t RawSize;			//풀었을 때의 DDS 파일 크기
+	std::uint32_t FirstChunk;		//청크 테이블 내 시작
+	std::uint32_t ChunkCount;
+};
+
+//StoredSize < RawSize 이면 LZ 압축된 청크.
+struct TexturePackChunk
+{
+	std::uint64_t RawOffset;		//풀었을 때 DDS 내 오프셋
+	std::uint64_t StoredOffset;		//엔트리 DataOffset 기준
+	std::uint32_t RawSize;
+	std::uint32_t StoredSize;
+};
+
+static_assert(sizeof(TexturePackHeader) == 64, "TexturePackHeader layout");
+static_assert(sizeof(TexturePackEntry) == 48, "TexturePackEntry layout");
+static_assert(sizeof(TexturePackChunk) == 24, "TexturePackChunk layout");
+
+/*
+	.d12pak 읽기. 파일을 한 번만 매핑하고, 이름은 해시 색인 이진 탐색으로 찾는다. (O(log n))
+*/
+class TexturePack
+{
+public:
+	static constexpr std::uint32_t Magic = 0x50323144; // "D12P"
+	static constexpr std::uint32_t Version = 1;
+	static constexpr std::uint64_t DataAlignment = 4096;
+
+	TexturePack() = default;
+	TexturePack(const TexturePack& rhs) = delete;
+	TexturePack& operator=(const TexturePack& rhs) = delete;
+
+	bool Open(const std::filesystem::path& path);
+	void Close();
+	bool IsOpen()const { return mHeader != nullptr; }
+
+	std::size_t EntryCount()const { return mHeader ? mHeader->EntryCount : 0; }
+	const TexturePackEntry& Entry(std::size_t index)const { return mEntries[index]; }
+	std::string_view EntryName(const TexturePackEntry& entry)const;
+
+	//없으면 nullptr.
+	const TexturePackEntry* Find(std::string_view name)const;
+
+	//압축된 청크가 없으면 매핑 안의 DDS 이미지. 압축돼 있으면 nullptr. (Read()를 쓴다)
+	const std::uint8_t* View(const TexturePackEntry& entry)const;
+	//DDS 이미지를 outData에 풀어 쓴다. 데이터가 깨졌으면 false.
+	bool Read(const TexturePackEntry& entry, std::vector<std::uint8_t>& outData)const;
+
+	//이름 정규화(소문자, '/' 구분자) 후 해시. 빌더와 로더가 같은 키를 쓴다.
+	static std::string NormalizeName(std::string_view name);
+	static std::uint64_t HashName(std::string_view name);
+
+	//LZ 블록 (리터럴 길이/매치 길이 토큰 + 16비트 거리). 압축해도 작아지지 않으면 CompressLZ는 false.
+	static bool CompressLZ(const std::uint8_t* src, std::size_t srcSize, std::vector<std::uint8_t>& outData);
+	static bool DecompressLZ(const std::uint8_t* src, std::size_t srcSize, std::uint8_t* dst, std::size_t dstSize);
+
+private:
+	bool Validate()const;
+
+private:
+	MappedFile mFile;
+	const TexturePackHeader* mHeader = nullptr;
+	const TexturePackEntry* mEntries = nullptr;
+	const TexturePackChunk* mChunks = nullptr;
+	const char* mStrings = nullptr;
+};
+
+/*
+	.d12pak 쓰기용 원본 데이터. (오프라인 도구 Tools/TexturePacker에서 사용)
+*/
+struct TexturePackSource
+{
+	struct Item
+	{
+		std::string Name;
+		std::vector<std::uint8_t> Data;		//DDS 파일 내용
+	};
+
+	std::vector<Item> Items;
+
+	//이름이 겹치면 false.
+	bool Add(std::string_view name, std::vector<std::uint8_t>&& ddsData);
+
+	//compress: 청크별 LZ 압축 시도. outStoredBytes: 데이터 구간에 실제로 쓴 바이트 수. (정렬 패딩 제외)
+	bool Write(const std::filesystem::path& path, bool compress, std::uint64_t* outStoredBytes = nullptr)const;
+
+	//DDS 이미지를 헤더와 밉 레벨 경계로 나눈다. 모르는 형식이거나 배열/큐브/볼륨이면 헤더와 나머지 둘로.
+	static void SplitChunks(const std::uint8_t* dds, std::size_t size, std::vector<std::uint64_t>& outBoundaries);
+};
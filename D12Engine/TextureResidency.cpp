@@ -0,0 +1,180 @@
+﻿#include "TextureResidency.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+
+TextureResidency::Id TextureResidency::Register(std::uint32_t width, std::uint32_t height, std::vector<std::uint64_t> mipBytes, std::uint32_t maxBaseMip)
+{
+	if (mipBytes.empty())
+		return InvalidId;
+
+	Id id = static_cast<Id>(mEntries.size());
+	if (!mFreeIds.empty())
+	{
+		id = mFreeIds.back();
+		mFreeIds.pop_back();
+	}
+	else
+	{
+		mEntries.emplace_back();
+	}
+
+	Entry& entry = mEntries[id];
+	entry = Entry();
+	entry.Width = width;
+	entry.Height = height;
+	entry.MipBytes = std::move(mipBytes);
+	const std::uint32_t mipCount = static_cast<std::uint32_t>(entry.MipBytes.size());
+	entry.TailMip = (std::min)(mipCount > mTailMips ? mipCount - mTailMips : 0, maxBaseMip);
+	entry.TargetMip = entry.TailMip;
+	entry.DesiredMip = entry.TailMip;
+	entry.Active = true;
+
+	for (std::uint32_t mip = entry.TailMip; mip < mipCount; mip++)
+		mUsed += entry.MipBytes[mip];
+	return id;
+}
+
+void TextureResidency::Unregister(Id id)
+{
+	if (id >= mEntries.size() || !mEntries[id].Active)
+		return;
+
+	Entry& entry = mEntries[id];
+	for (std::uint32_t mip = entry.TargetMip; mip < entry.MipBytes.size(); mip++)
+		mUsed -= entry.MipBytes[mip];
+	entry = Entry();
+	mFreeIds.push_back(id);
+}
+
+void TextureResidency::Touch(Id id, std::uint64_t frame, float screenPixels)
+{
+	if (id >= mEntries.size() || !mEntries[id].Active)
+		return;
+
+	Entry& entry = mEntries[id];
+	if (entry.LastUsedFrame != frame)
+		entry.ScreenPixels = 0.0f;
+	entry.LastUsedFrame = frame;
+	entry.ScreenPixels = (std::max)(entry.ScreenPixels, screenPixels);
+
+	//밉 하나당 텍셀 수가 1/4. 텍셀 수가 화면 픽셀 수 이하가 되는 가장 상세한 밉.
+	std::uint32_t desired = entry.TailMip;
+	if (entry.ScreenPixels >= 1.0f)
+	{
+		const float texels = float(entry.Width) * float(entry.Height);
+		const float mip = 0.5f * std::log2(texels / entry.ScreenPixels);
+		desired = mip <= 0.0f ? 0 : (std::min)(entry.TailMip, static_cast<std::uint32_t>(mip));
+	}
+	entry.DesiredMip = desired;
+}
+
+bool TextureResidency::Evict(std::uint64_t needed, Id requester, std::uint64_t frame)
+{
+	const Entry* request = requester != InvalidId ? &mEntries[requester] : nullptr;
+
+	struct Candidate
+	{
+		Id Texture;
+		std::uint32_t FloorMip;	//여기까지 뺄 수 있다
+		bool Hot;
+	};
+	FrameVector<Candidate> candidates;
+	std::uint64_t available = 0;
+	for (Id id = 0; id < mEntries.size(); id++)
+	{
+		const Entry& entry = mEntries[id];
+		if (!entry.Active || id == requester)
+			continue;
+
+		//차가운 텍스처와 요청보다 화면에서 작은 텍스처는 밉 꼬리까지, 그 외에는 필요 이상으로 올라간 밉만.
+		const bool hot = IsHot(entry, frame);
+		std::uint32_t floorMip = entry.TailMip;
+		if (hot && request && entry.ScreenPixels >= request->ScreenPixels)
+			floorMip = (std::max)(entry.DesiredMip, entry.TargetMip);
+
+		if (entry.TargetMip >= floorMip)
+			continue;
+
+		for (std::uint32_t mip = entry.TargetMip; mip < floorMip; mip++)
+			available += entry.MipBytes[mip];
+		candidates.push_back({ id, floorMip, hot });
+	}
+
+	if (available < needed)
+		return false;
+
+	//차가운 것부터 오래된 순, 같으면 화면에서 작은 순.
+	std::sort(candidates.begin(), candidates.end(), [this](const Candidate& a, const Candidate& b)
+		{
+			if (a.Hot != b.Hot)
+				return !a.Hot;
+			const Entry& ea = mEntries[a.Texture];
+			const Entry& eb = mEntries[b.Texture];
+			if (ea.LastUsedFrame != eb.LastUsedFrame)
+				return ea.LastUsedFrame < eb.LastUsedFrame;
+			return ea.ScreenPixels < eb.ScreenPixels;
+		});
+
+	std::uint64_t freed = 0;
+	for (const Candidate& candidate : candidates)
+	{
+		Entry& entry = mEntries[candidate.Texture];
+		while (entry.TargetMip < candidate.FloorMip && freed < needed)
+		{
+			freed += entry.MipBytes[entry.TargetMip];
+			entry.TargetMip++;
+		}
+		if (freed >= needed)
+			break;
+	}
+
+	mUsed -= freed;
+	return true;
+}
+
+void TextureResidency::Update(std::uint64_t frame, FrameVector<Change>& outChanges)
+{
+	//프레임마다 부르므로 임시 목록은 프레임 아레나에.
+	FrameVector<std::uint32_t> before(mEntries.size());
+	for (std::size_t i = 0; i < mEntries.size(); i++)
+		before[i] = mEntries[i].TargetMip;
+
+	//예산이 줄었으면 먼저 맞춘다.
+	if (mUsed > mBudget)
+		Evict(mUsed - mBudget, InvalidId, frame);
+
+	//이번 프레임에 쓰였는데 필요한 밉이 없는 텍스처. 화면에서 큰 것부터.
+	std::priority_queue<std::pair<float, Id>, FrameVector<std::pair<float, Id>>> requests;
+	for (Id id = 0; id < mEntries.size(); id++)
+	{
+		const Entry& entry = mEntries[id];
+		if (entry.Active && entry.LastUsedFrame == frame && entry.TargetMip > entry.DesiredMip)
+			requests.push({ entry.ScreenPixels, id });
+	}
+
+	while (!requests.empty())
+	{
+		const Id id = requests.top().second;
+		requests.pop();
+
+		Entry& entry = mEntries[id];
+		while (entry.TargetMip > entry.DesiredMip)
+		{
+			const std::uint64_t bytes = entry.MipBytes[entry.TargetMip - 1];
+			if (mUsed + bytes > mBudget && !Evict(mUsed + bytes - mBudget, id, frame))
+				break;
+
+			entry.TargetMip--;
+			mUsed += bytes;
+		}
+	}
+
+	for (Id id = 0; id < mEntries.size(); id++)
+	{
+		if (mEntries[id].Active && mEntries[id].TargetMip != before[id])
+			outChanges.push_back({ id, mEntries[id].TargetMip });
+	}
+}
@@ -0,0 +1,88 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "FrameArena.h"
+
+/*
+	텍스처 상주 메모리 관리 정책. (GPU 작업은 TextureStreamer::SetTargetMip)
+
+	- 텍스처마다 목표 밉(TargetMip)을 정한다. 목표보다 상세한 밉은 메모리에 두지 않는다.
+	- Touch(): 이번 프레임에 텍스처가 화면에서 덮는 픽셀 수. 텍셀 수와 비교해 필요한 밉(DesiredMip)을 정한다.
+	- Update(): 필요한 밉보다 덜 올라간 텍스처를 화면 크기가 큰 순서(우선순위 큐)로 예산 안에서 배정한다.
+	  예산이 모자라면 오래 안 쓴(LRU) 텍스처, 그다음 화면에서 더 작은 텍스처의 가장 상세한 밉부터 뺏는다.
+	  이번 프레임에 쓴 텍스처는 자기보다 작은 텍스처의 밉만 뺏을 수 있어서 서로 번갈아 뺏지 않는다.
+	- 가장 작은 TailMips개의 밉(밉 꼬리)은 항상 상주한다. (예산 계산에는 포함)
+
+	GPU 리소스를 모르고 바이트 수만 다루므로 CPU에서 그대로 검증할 수 있다.
+	바이트 수는 파일 기준 근사값. (리소스 정렬, 64KB 배치 단위는 무시)
+*/
+class TextureResidency
+{
+public:
+	using Id = std::uint32_t;
+	static constexpr Id InvalidId = ~0u;
+
+	//밉 꼬리. 512x512 텍스처라면 8x8까지.
+	static constexpr std::uint32_t DefaultTailMips = 4;
+	//이 프레임 수 동안 Touch되지 않으면 차갑다고 본다.
+	static constexpr std::uint64_t DefaultColdFrames = 60;
+
+	struct Change
+	{
+		Id Texture = InvalidId;
+		std::uint32_t TargetMip = 0;
+	};
+
+	explicit TextureResidency(std::uint64_t budgetBytes, std::uint32_t tailMips = DefaultTailMips) :
+		mBudget(budgetBytes), mTailMips(tailMips) {}
+
+	//mipBytes[0]이 가장 상세한 밉. 처음 목표는 밉 꼬리만.
+	//maxBaseMip: 리소스의 첫 밉이 될 수 있는 가장 작은 밉. (BC 포맷, TextureStreamer::MaxBaseMip)
+	//밉 꼬리와 목표 밉은 이보다 작은 밉으로 내려가지 않는다.
+	Id Register(std::uint32_t width, std::uint32_t height, std::vector<std::uint64_t> mipBytes, std::uint32_t maxBaseMip = ~0u);
+	void Unregister(Id id);
+
+	//screenPixels: 텍스처 한 장이 화면에서 덮는 픽셀 수. 한 프레임에 여러 번 불리면 가장 큰 값.
+	void Touch(Id id, std::uint64_t frame, float screenPixels);
+
+	//목표 밉이 바뀐 텍스처를 outChanges에 담는다.
+	void Update(std::uint64_t frame, FrameVector<Change>& outChanges);
+
+	void SetBudget(std::uint64_t budgetBytes) { mBudget = budgetBytes; }
+	std::uint64_t Budget()const { return mBudget; }
+	//목표 밉 기준 사용량.
+	std::uint64_t UsedBytes()const { return mUsed; }
+
+	std::uint32_t TargetMip(Id id)const { return mEntries[id].TargetMip; }
+	std::uint32_t DesiredMip(Id id)const { return mEntries[id].DesiredMip; }
+
+private:
+	struct Entry
+	{
+		std::uint32_t Width = 0;
+		std::uint32_t Height = 0;
+		std::vector<std::uint64_t> MipBytes;
+		std::uint32_t TailMip = 0;	//항상 상주하는 가장 상세한 밉
+		std::uint32_t TargetMip = 0;
+		std::uint32_t DesiredMip = 0;
+		std::uint64_t LastUsedFrame = 0;
+		float ScreenPixels = 0.0f;	//마지막으로 쓰인 프레임 기준
+		bool Active = false;
+	};
+
+	bool IsHot(const Entry& entry, std::uint64_t frame)const { return entry.LastUsedFrame + DefaultColdFrames > frame; }
+
+	//requester를 위해 다른 텍스처의 밉을 빼서 needed 바이트 이상을 비운다. 충분히 비울 수 없으면 아무것도 하지 않고 false.
+	//requester가 InvalidId면 예산 초과분 정리. (쓰인 텍스처도 화면에서 작은 것부터 밉 꼬리까지 뺏는다)
+	bool Evict(std::uint64_t needed, Id requester, std::uint64_t frame);
+
+private:
+	std::uint64_t mBudget = 0;
+	std::uint32_t mTailMips = DefaultTailMips;
+	std::uint64_t mUsed = 0;
+
+	std::vector<Entry> mEntries;
+	std::vector<Id> mFreeIds;
+};
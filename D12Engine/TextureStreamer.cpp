@@ -0,0 +1,408 @@
+﻿#include "TextureStreamer.h"
+
+using namespace DirectX;
+using Microsoft::WRL::ComPtr;
+
+namespace
+{
+	bool IsBlockCompressed(DXGI_FORMAT format)
+	{
+		return (format >= DXGI_FORMAT_BC1_TYPELESS && format <= DXGI_FORMAT_BC5_SNORM) ||
+			(format >= DXGI_FORMAT_BC6H_TYPELESS && format <= DXGI_FORMAT_BC7_UNORM_SRGB);
+	}
+}
+
+HRESULT TextureStreamer::Add(Texture* texture, MappedFile&& file)
+{
+	if (texture == nullptr || !file.IsOpen())
+		return E_INVALIDARG;
+
+	auto stream = std::make_unique<Stream>();
+	stream->File = std::move(file);
+	return AddStream(texture, std::move(stream));
+}
+
+HRESULT TextureStreamer::Add(Texture* texture, std::vector<std::uint8_t>&& ddsData)
+{
+	if (texture == nullptr || ddsData.empty())
+		return E_INVALIDARG;
+
+	auto stream = std::make_unique<Stream>();
+	stream->Memory = std::move(ddsData);
+	return AddStream(texture, std::move(stream));
+}
+
+HRESULT TextureStreamer::Add(Texture* texture, const std::uint8_t* ddsData, std::size_t ddsSize)
+{
+	if (texture == nullptr || ddsData == nullptr || ddsSize == 0)
+		return E_INVALIDARG;
+
+	auto stream = std::make_unique<Stream>();
+	stream->External = ddsData;
+	stream->ExternalSize = ddsSize;
+	return AddStream(texture, std::move(stream));
+}
+
+HRESULT TextureStreamer::AddStream(Texture* texture, std::unique_ptr<Stream> stream)
+{
+	HRESULT hr = ProbeDDSFromMemory(stream->Data(), stream->Size(), stream->Info);
+	if (FAILED(hr))
+		return hr;
+
+	//리소스는 목표 밉이 정해진 뒤 Update()에서 만든다. (처음부터 전체 크기로 잡지 않도록)
+	texture->Resource = nullptr;
+	texture->UploadHeap = nullptr;
+	texture->BaseMip = 0;
+	texture->ResidentMip = stream->Info.mipCount;
+
+	stream->MaxBaseMip = MaxBaseMip(stream->Info);
+	stream->Tex = texture;
+
+	const auto [it, inserted] = mStreamIndices.try_emplace(texture, mStreams.size());
+	if (inserted)
+		mStreams.push_back(std::move(stream));
+	else
+		mStreams[it->second] = std::move(stream);
+	return S_OK;
+}
+
+void TextureStreamer::SetTargetMip(const Texture* texture, UINT mip)
+{
+	const auto it = mStreamIndices.find(texture);
+	if (it == mStreamIndices.end())
+		return;
+
+	Stream& stream = *mStreams[it->second];
+	stream.TargetMip = (std::min)(mip, stream.MaxBaseMip);
+}
+
+const DDS_TEXTURE_INFO* TextureStreamer::FindInfo(const Texture* texture)const
+{
+	const auto it = mStreamIndices.find(texture);
+	return it != mStreamIndices.end() ? &mStreams[it->second]->Info : nullptr;
+}
+
+UINT64 TextureStreamer::MipByteSize(const DDS_TEXTURE_INFO& info, UINT mip)
+{
+	UINT64 bytes = 0;
+	for (UINT slice = 0; slice < info.arraySize; slice++)
+		bytes += info.subresources[slice * info.mipCount + mip].size;
+	return bytes;
+}
+
+UINT TextureStreamer::MaxBaseMip(const DDS_TEXTURE_INFO& info)
+{
+	if (info.mipCount == 0)
+		return 0;
+	if (!IsBlockCompressed(info.format))
+		return info.mipCount - 1;
+
+	//첫 밉이 4의 배수면 4의 배수가 아니게 되는 밉 전까지는 모두 4의 배수다.
+	UINT mip = 0;
+	while (mip + 1 < info.mipCount)
+	{
+		const UINT width = info.width >> (mip + 1);
+		const UINT height = info.height >> (mip + 1);
+		if (width < 4 || height < 4 || (width & 3) != 0 || (height & 3) != 0)
+			break;
+		mip++;
+	}
+	return mip;
+}
+
+bool TextureStreamer::NeedsWork(const Stream& stream)
+{
+	const Texture* texture = stream.Tex;
+	return texture->Resource == nullptr || texture->BaseMip != stream.TargetMip || texture->ResidentMip > stream.TargetMip;
+}
+
+bool TextureStreamer::IsStreaming()const
+{
+	return std::any_of(mStreams.begin(), mStreams.end(), [](const std::unique_ptr<Stream>& stream) { return NeedsWork(*stream); });
+}
+
+std::size_t TextureStreamer::StreamingCount()const
+{
+	return static_cast<std::size_t>(std::count_if(mStreams.begin(), mStreams.end(),
+		[](const std::unique_ptr<Stream>& stream) { return NeedsWork(*stream); }));
+}
+
+ComPtr<ID3D12Resource> TextureStreamer::CreateResource(D3D12_HEAP_TYPE heapType, const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES initialState)
+{
+	if (mHeapAllocator != nullptr)
+		return mHeapAllocator->CreateResource(heapType, desc, initialState);
+
+	ComPtr<ID3D12Resource> resource;
+	CD3DX12_HEAP_PROPERTIES heapProps(heapType);
+	ThrowIfFailed(mDevice->CreateCommittedResource(
+		&heapProps,
+		D3D12_HEAP_FLAG_NONE,
+		&desc,
+		initialState,
+		nullptr,
+		IID_PPV_ARGS(resource.GetAddressOf())));
+	return resource;
+}
+
+void TextureStreamer::ReleaseResource(ComPtr<ID3D12Resource>& resource, UINT64 fenceValue)
+{
+	if (mHeapAllocator != nullptr)
+		mHeapAllocator->Free(resource, fenceValue);
+	else
+		mReleaseQueue.Enqueue(resource, fenceValue);
+}
+
+void TextureStreamer::Rebuild(Stream& stream, ID3D12GraphicsCommandList* cmdList, UINT64 fenceValue)
+{
+	const DDS_TEXTURE_INFO& info = stream.Info;
+	Texture* texture = stream.Tex;
+	const UINT newBase = stream.TargetMip;
+	const UINT newMips = info.mipCount - newBase;
+
+	D3D12_RESOURCE_DESC desc = {};
+	desc.Dimension = info.dimension;
+	desc.Width = (std::max)(1u, info.width >> newBase);
+	desc.Height = (std::max)(1u, info.height >> newBase);
+	desc.DepthOrArraySize = static_cast<UINT16>(info.dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D ? (std::max)(1u, info.depth >> newBase) : info.arraySize);
+	desc.MipLevels = static_cast<UINT16>(newMips);
+	desc.Format = info.format;
+	desc.SampleDesc.Count = 1;
+	desc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+	desc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+	//데이터가 없는 밉은 COPY_DEST로 남는다. 올라간 서브리소스만 전이.
+	ComPtr<ID3D12Resource> resource = CreateResource(D3D12_HEAP_TYPE_DEFAULT, desc, D3D12_RESOURCE_STATE_COPY_DEST);
+
+	//두 리소스에 모두 있는 상주 밉은 GPU에서 복사. 새 리소스에서 빠지는 상세 밉은 버린다.
+	const UINT firstCopy = (std::max)(texture->ResidentMip, newBase);
+	if (texture->Resource != nullptr && firstCopy < info.mipCount)
+	{
+		const UINT oldBase = texture->BaseMip;
+		const UINT oldMips = info.mipCount - oldBase;
+
+		FrameVector<CD3DX12_RESOURCE_BARRIER> toSource;
+		FrameVector<CD3DX12_RESOURCE_BARRIER> toShader;
+		for (UINT mip = firstCopy; mip < info.mipCount; mip++)
+		{
+			for (UINT slice = 0; slice < info.arraySize; slice++)
+			{
+				const UINT oldSub = D3D12CalcSubresource(mip - oldBase, slice, 0, oldMips, info.arraySize);
+				const UINT newSub = D3D12CalcSubresource(mip - newBase, slice, 0, newMips, info.arraySize);
+				toSource.push_back(CD3DX12_RESOURCE_BARRIER::Transition(texture->Resource.Get(),
+					D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_COPY_SOURCE, oldSub));
+				toShader.push_back(CD3DX12_RESOURCE_BARRIER::Transition(resource.Get(),
+					D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, newSub));
+			}
+		}
+		cmdList->ResourceBarrier(static_cast<UINT>(toSource.size()), toSource.data());
+
+		for (UINT mip = firstCopy; mip < info.mipCount; mip++)
+		{
+			for (UINT slice = 0; slice < info.arraySize; slice++)
+			{
+				CD3DX12_TEXTURE_COPY_LOCATION dst(resource.Get(), D3D12CalcSubresource(mip - newBase, slice, 0, newMips, info.arraySize));
+				CD3DX12_TEXTURE_COPY_LOCATION src(texture->Resource.Get(), D3D12CalcSubresource(mip - oldBase, slice, 0, oldMips, info.arraySize));
+				cmdList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+			}
+		}
+		cmdList->ResourceBarrier(static_cast<UINT>(toShader.size()), toShader.data());
+	}
+
+	//앞서 제출한 프레임이 아직 이전 리소스를 읽고 있을 수 있다.
+	ReleaseResource(texture->Resource, fenceValue);
+
+	texture->Resource = std::move(resource);
+	texture->BaseMip = newBase;
+	texture->ResidentMip = firstCopy;
+}
+
+UINT64 TextureStreamer::LayoutMip(const Stream& stream, UINT mip, UINT64 baseOffset, FrameVector<Copy>* outCopies)const
+{
+	ID3D12Resource* resource = stream.Tex->Resource.Get();
+	const D3D12_RESOURCE_DESC desc = resource->GetDesc();
+
+	const UINT base = stream.Tex->BaseMip;
+
+	UINT64 offset = baseOffset;
+	for (UINT slice = 0; slice < stream.Info.arraySize; slice++)
+	{
+		Copy copy = {};
+		copy.Dest = resource;
+		copy.Subresource = D3D12CalcSubresource(mip - base, slice, 0, stream.Info.mipCount - base, stream.Info.arraySize);
+		copy.Source = &stream.Info.subresources[D3D12CalcSubresource(mip, slice, 0, stream.Info.mipCount, stream.Info.arraySize)];
+		copy.FileData = stream.Data();
+
+		UINT64 totalBytes = 0;
+		offset = (offset + D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1) & ~UINT64(D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1);
+		mDevice->GetCopyableFootprints(&desc, copy.Subresource, 1, offset, &copy.Footprint, &copy.NumRows, &copy.RowSize, &totalBytes);
+		offset += totalBytes;
+
+		if (outCopies)
+			outCopies->push_back(copy);
+	}
+	return offset - baseOffset;
+}
+
+UINT64 TextureStreamer::Update(ID3D12GraphicsCommandList* cmdList, UINT64 byteBudget, UINT64 fenceValue, FrameVector<Texture*>& outChanged)
+{
+	if (mStreams.empty())
+		return 0;
+
+	//목표 밉이 바뀐 텍스처는 리소스부터 다시 만든다. 상주 밉이 있으면 SRV도 바뀌어야 하므로 outChanged에 담는다.
+	//(처음 만든 리소스는 아직 상주 밉이 없으므로 자리표시자 SRV를 그대로 둔다)
+	FrameVector<Texture*> rebuilt;
+	FrameVector<bool> wasRebuilt(mStreams.size(), false);
+	for (std::size_t i = 0; i < mStreams.size(); i++)
+	{
+		Stream& stream = *mStreams[i];
+		if (stream.Tex->Resource == nullptr || stream.Tex->BaseMip != stream.TargetMip)
+		{
+			Rebuild(stream, cmdList, fenceValue);
+			if (stream.Tex->ResidentMip < stream.Info.mipCount)
+			{
+				rebuilt.push_back(stream.Tex);
+				wasRebuilt[i] = true;
+			}
+		}
+	}
+
+	FrameVector<UINT> resident(mStreams.size());
+	for (std::size_t i = 0; i < mStreams.size(); i++)
+		resident[i] = mStreams[i]->Tex->ResidentMip;
+
+	//올릴 밉 고르기. 모든 텍스처를 통틀어 다음 밉이 가장 작은 것부터, 예산을 넘기 전까지.
+	//텍스처마다 다음 밉을 최소 힙에 넣어 두고, 하나 고를 때마다 그 텍스처의 다음 밉만 다시 넣는다.
+	//고른 밉마다 링에서 스테이징 구간을 잡고 서브리소스 배치를 구한다.
+	struct Candidate
+	{
+		UINT64 Size = 0;
+		std::size_t Index = 0;
+	};
+	//크기가 같으면 앞 텍스처부터.
+	const auto later = [](const Candidate& a, const Candidate& b) { return a.Size != b.Size ? a.Size > b.Size : a.Index > b.Index; };
+
+	FrameVector<Candidate> candidates;
+	for (std::size_t i = 0; i < mStreams.size(); i++)
+	{
+		if (resident[i] > mStreams[i]->TargetMip)
+			candidates.push_back({ MipByteSize(mStreams[i]->Info, resident[i] - 1), i });
+	}
+	std::make_heap(candidates.begin(), candidates.end(), later);
+
+	FrameVector<Copy> copies;
+	UINT64 budgetUsed = 0;
+	UINT64 stagingUsed = 0;
+	bool picked = false;
+	while (!candidates.empty())
+	{
+		const std::size_t best = candidates.front().Index;
+		const UINT64 bestSize = candidates.front().Size;
+
+		//예산보다 큰 밉도 언젠가는 올라가야 하므로 프레임마다 최소 하나는 올린다.
+		if (picked && budgetUsed + bestSize > byteBudget)
+			break;
+
+		const Stream& stream = *mStreams[best];
+		const UINT mip = resident[best] - 1;
+		const UINT64 stagingSize = LayoutMip(stream, mip, 0, nullptr);
+
+		UploadRing::Allocation allocation;
+		if (!mRing.Allocate(stagingSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT, allocation))
+		{
+			//링이 차 있으면 다음 프레임에. 링보다 큰 밉만 전용 버퍼를 만든다.
+			if (stagingSize <= mRing.Capacity())
+				break;
+
+			ComPtr<ID3D12Resource> staging = CreateResource(D3D12_HEAP_TYPE_UPLOAD, CD3DX12_RESOURCE_DESC::Buffer(stagingSize), D3D12_RESOURCE_STATE_GENERIC_READ);
+
+			CD3DX12_RANGE readRange(0, 0);
+			ThrowIfFailed(staging->Map(0, &readRange, reinterpret_cast<void**>(&allocation.CpuData)));
+			allocation.Buffer = staging.Get();
+			allocation.Offset = 0;
+			//큐가 참조를 들고 있으므로 이번 복사 기록 동안 유효하다.
+			ReleaseResource(staging, fenceValue);
+		}
+
+		const std::size_t first = copies.size();
+		LayoutMip(stream, mip, allocation.Offset, &copies);
+		for (std::size_t i = first; i < copies.size(); i++)
+		{
+			copies[i].Staging = allocation.Buffer;
+			copies[i].StagingData = allocation.CpuData - allocation.Offset;
+		}
+
+		std::pop_heap(candidates.begin(), candidates.end(), later);
+		candidates.pop_back();
+		resident[best]--;
+		if (resident[best] > stream.TargetMip)
+		{
+			candidates.push_back({ MipByteSize(stream.Info, resident[best] - 1), best });
+			std::push_heap(candidates.begin(), candidates.end(), later);
+		}
+
+		budgetUsed += bestSize;
+		stagingUsed += stagingSize;
+		picked = true;
+	}
+
+	if (copies.empty())
+	{
+		outChanged.insert(outChanged.end(), rebuilt.begin(), rebuilt.end());
+		return 0;
+	}
+
+	//매핑된 DDS에서 행 단위로 복사. (파일의 행 간격과 업로드 힙의 256바이트 정렬 간격이 다르다)
+	for (const Copy& copy : copies)
+	{
+		const std::uint8_t* src = copy.FileData + copy.Source->offset;
+		BYTE* dst = copy.StagingData + copy.Footprint.Offset;
+		const std::size_t rowBytes = static_cast<std::size_t>((std::min)(copy.RowSize, UINT64(copy.Source->rowPitch)));
+
+		for (UINT z = 0; z < copy.Source->depth; z++)
+		{
+			for (UINT row = 0; row < copy.NumRows; row++)
+			{
+				memcpy(dst + (SIZE_T(z) * copy.NumRows + row) * copy.Footprint.Footprint.RowPitch,
+					src + SIZE_T(z) * copy.Source->slicePitch + SIZE_T(row) * copy.Source->rowPitch,
+					rowBytes);
+			}
+		}
+	}
+
+	FrameVector<CD3DX12_RESOURCE_BARRIER> barriers;
+	barriers.reserve(copies.size());
+	for (const Copy& copy : copies)
+	{
+		CD3DX12_TEXTURE_COPY_LOCATION dst(copy.Dest, copy.Subresource);
+		CD3DX12_TEXTURE_COPY_LOCATION src(copy.Staging, copy.Footprint);
+		cmdList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+
+		barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(copy.Dest,
+			D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, copy.Subresource));
+	}
+	cmdList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+
+	mRing.Submit(fenceValue);
+
+	//상주 밉 갱신. 목록에서 빼지 않는다. (내린 밉을 다시 올릴 때 매핑된 파일을 그대로 쓴다)
+	for (std::size_t i = 0; i < mStreams.size(); i++)
+	{
+		Texture* texture = mStreams[i]->Tex;
+		if (texture->ResidentMip != resident[i] || wasRebuilt[i])
+		{
+			texture->ResidentMip = resident[i];
+			outChanged.push_back(texture);
+		}
+	}
+
+	return stagingUsed;
+}
+
+void TextureStreamer::ReleaseCompleted(UINT64 completedFence)
+{
+	mRing.Reclaim(completedFence);
+
+	//올릴 것이 없으면 링 메모리도 돌려준다. (목표 밉이 바뀌면 다시 만든다)
+	if (!IsStreaming())
+		mRing.Trim();
+}
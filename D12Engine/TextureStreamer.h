@@ -0,0 +1,129 @@
+﻿#pragma once
+
+#include "d3dUtil.h"
+#include "MappedFile.h"
+#include "UploadRing.h"
+#include "GpuHeapAllocator.h"
+#include "DeferredReleaseQueue.h"
+#include "FrameArena.h"
+
+/*
+	DDS 텍스처 점진적 밉 스트리밍.
+
+	Add()         : 헤더만 읽어 스트리밍 목록에 넣는다. 리소스는 다음 Update()에서 만든다.
+	SetTargetMip(): 상주시킬 가장 상세한 밉. (기본 0 = 전부, TextureResidency가 예산에 맞춰 조정)
+	Update()      : 리소스가 목표 밉과 다르게 만들어져 있으면 [목표 밉, 끝) 밉만 가진 리소스로 다시 만들고
+	                두 리소스에 모두 있는 상주 밉은 GPU에서 복사한다. (상세 밉을 내려 메모리를 돌려주거나 다시 늘린다)
+	                그다음 byteBudget 안에서 가장 작은 밉부터 목표 밉까지 복사 명령을 기록한다.
+	                올라간 서브리소스만 PIXEL_SHADER_RESOURCE로 전이하고 Texture::ResidentMip을 낮춘다.
+	                SRV는 호출한 쪽에서 ResourceMinLODClamp = ResidentMip - BaseMip 으로 다시 만든다.
+
+	픽셀 데이터는 매핑된 파일에서 필요한 구간만 읽는다. (접근한 페이지만 OS가 읽어 온다)
+	내린 밉을 다시 올릴 수 있도록 매핑은 텍스처가 목록에 있는 동안 유지한다.
+	스테이징은 모든 텍스처가 같이 쓰는 UploadRing에서 밉 단위로 잘라 쓰고, 한 프레임의 복사는 명령 리스트 하나에 모인다.
+	링 구간은 기록한 명령의 펜스 값에 묶였다가 ReleaseCompleted()에서 돌아오고, 할 일이 없으면 링 자체를 해제한다.
+	링보다 큰 밉만 전용 스테이징 버퍼를 만든다. 전용 버퍼와 다시 만들기 전의 리소스는 DeferredReleaseQueue로 넘긴다.
+	GpuHeapAllocator를 주면 텍스처와 전용 스테이징 버퍼를 그 힙에 배치하고, 놓을 때는 할당기의 Free()로 펜스와 함께 돌려준다.
+*/
+class TextureStreamer
+{
+public:
+	//한 프레임에 올릴 기본 바이트 수.
+	static constexpr UINT64 DefaultFrameBudget = 4 * 1024 * 1024;
+	//스테이징 링 크기. 앞 프레임의 업로드가 아직 GPU에 있어도 한 프레임 분량은 들어간다.
+	static constexpr UINT64 DefaultRingSize = 2 * DefaultFrameBudget;
+
+	//releaseQueue는 스트리머보다 오래 살아야 한다.
+	TextureStreamer(ID3D12Device* device, DeferredReleaseQueue& releaseQueue, GpuHeapAllocator* heapAllocator = nullptr, UINT64 ringSize = DefaultRingSize) :
+		mDevice(device), mReleaseQueue(releaseQueue), mHeapAllocator(heapAllocator), mRing(device, ringSize) {}
+	TextureStreamer(const TextureStreamer& rhs) = delete;
+	TextureStreamer& operator=(const TextureStreamer& rhs) = delete;
+
+	//스트리밍 목록에 넣는다. 이 시점에 ResidentMip = MipLevels. (상주 밉 없음) 이미 있는 텍스처면 새 이미지로 바꾼다.
+	HRESULT Add(Texture* texture, MappedFile&& file);
+	//메모리에 있는 DDS 이미지. (로드 시 만든 밉 체인 등)
+	HRESULT Add(Texture* texture, std::vector<std::uint8_t>&& ddsData);
+	//다른 곳에 매핑된 DDS 이미지. (TexturePack 등, 텍스처가 목록에 있는 동안 호출한 쪽이 유지)
+	HRESULT Add(Texture* texture, const std::uint8_t* ddsData, std::size_t ddsSize);
+
+	//fenceValue: 이번에 기록한 명령이 끝나면 시그널될 값.
+	//ResidentMip이 바뀐 텍스처를 outChanged에 담는다. 사용한 스테이징 바이트 수를 반환.
+	//링에 공간이 없으면 GPU가 앞선 업로드를 끝낼 때까지 다음 밉을 미룬다.
+	UINT64 Update(ID3D12GraphicsCommandList* cmdList, UINT64 byteBudget, UINT64 fenceValue, FrameVector<Texture*>& outChanged);
+
+	//GPU가 끝낸 업로드의 스테이징 구간 회수.
+	void ReleaseCompleted(UINT64 completedFence);
+
+	//mip은 MaxBaseMip()으로 제한된다. 목록에 없는 텍스처면 무시.
+	void SetTargetMip(const Texture* texture, UINT mip);
+
+	//목록에 있는 텍스처의 DDS 정보. 없으면 nullptr.
+	const DirectX::DDS_TEXTURE_INFO* FindInfo(const Texture* texture)const;
+
+	//밉 레벨 하나(모든 배열 슬라이스)의 바이트 수.
+	static UINT64 MipByteSize(const DirectX::DDS_TEXTURE_INFO& info, UINT mip);
+
+	//리소스의 가장 상세한 밉으로 쓸 수 있는 가장 작은 밉. (보통 밉 수 - 1)
+	//BC 포맷은 리소스의 첫 밉 가로세로가 4의 배수여야 하므로 그 조건을 만족하는 마지막 밉까지만.
+	//예) 512x128 BC -> 5 (16x4), 8x2 같은 밉 꼬리는 첫 밉이 될 수 없다.
+	static UINT MaxBaseMip(const DirectX::DDS_TEXTURE_INFO& info);
+
+	//다시 만들거나 올릴 밉이 남은 텍스처가 있는가.
+	bool IsStreaming()const;
+	std::size_t StreamingCount()const;
+
+private:
+	struct Stream
+	{
+		Texture* Tex = nullptr;
+		MappedFile File;
+		std::vector<std::uint8_t> Memory;	//File 대신 메모리 이미지를 쓸 때
+		const std::uint8_t* External = nullptr;	//소유하지 않는 이미지
+		std::size_t ExternalSize = 0;
+		DirectX::DDS_TEXTURE_INFO Info = {};
+		UINT TargetMip = 0;
+		UINT MaxBaseMip = 0;
+
+		const std::uint8_t* Data()const { return External ? External : File.IsOpen() ? File.Data() : Memory.data(); }
+		std::size_t Size()const { return External ? ExternalSize : File.IsOpen() ? File.Size() : Memory.size(); }
+	};
+
+	struct Copy
+	{
+		ID3D12Resource* Dest = nullptr;
+		UINT Subresource = 0;	//Dest 기준 (Texture::BaseMip만큼 밀려 있다)
+		const DirectX::DDS_SUBRESOURCE_LAYOUT* Source = nullptr;
+		const std::uint8_t* FileData = nullptr;
+		ID3D12Resource* Staging = nullptr;
+		BYTE* StagingData = nullptr;	//Staging의 매핑 시작 주소
+		D3D12_PLACED_SUBRESOURCE_FOOTPRINT Footprint = {};
+		UINT NumRows = 0;
+		UINT64 RowSize = 0;
+	};
+
+	//stream의 DDS 헤더를 읽고 목록에 넣는다.
+	HRESULT AddStream(Texture* texture, std::unique_ptr<Stream> stream);
+
+	static bool NeedsWork(const Stream& stream);
+
+	//[TargetMip, 끝) 밉을 가진 리소스를 새로 만들고 남는 상주 밉을 복사. 이전 리소스는 fenceValue까지 보관.
+	void Rebuild(Stream& stream, ID3D12GraphicsCommandList* cmdList, UINT64 fenceValue);
+
+	//밉 하나(모든 배열 슬라이스)를 스테이징 baseOffset부터 배치. 필요한 스테이징 바이트 수를 반환.
+	//outCopies가 nullptr이면 크기만 구한다.
+	UINT64 LayoutMip(const Stream& stream, UINT mip, UINT64 baseOffset, FrameVector<Copy>* outCopies)const;
+
+	//mHeapAllocator가 있으면 배치 리소스, 없으면 커밋 리소스.
+	Microsoft::WRL::ComPtr<ID3D12Resource> CreateResource(D3D12_HEAP_TYPE heapType, const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES initialState);
+	//CreateResource()로 만든 리소스를 fenceValue가 지나면 놓는다. (힙 구간은 할당기로)
+	void ReleaseResource(Microsoft::WRL::ComPtr<ID3D12Resource>& resource, UINT64 fenceValue);
+
+private:
+	ID3D12Device* mDevice = nullptr;
+	DeferredReleaseQueue& mReleaseQueue;
+	GpuHeapAllocator* mHeapAllocator = nullptr;
+
+	std::vector<std::unique_ptr<Stream>> mStreams;
+	std::unordered_map<const Texture*, std::size_t> mStreamIndices;	//텍스처 -> mStreams 번호
+	UploadRing mRing;
+};
@@ -0,0 +1,266 @@
+﻿#include "TlsfAllocator.h"
+
+#include <algorithm>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace
+{
+	inline std::uint32_t BitScanForward(std::uint64_t v)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward64(&index, v);
+		return index;
+#else
+		return static_cast<std::uint32_t>(__builtin_ctzll(v));
+#endif
+	}
+
+	inline std::uint32_t BitScanReverse(std::uint64_t v)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse64(&index, v);
+		return index;
+#else
+		return 63u - static_cast<std::uint32_t>(__builtin_clzll(v));
+#endif
+	}
+
+	inline std::uint64_t AlignUp(std::uint64_t v, std::uint64_t alignment)
+	{
+		return (v + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+TlsfAllocator::TlsfAllocator(std::uint64_t size, std::uint64_t granularity) :
+	mSize(size & ~(granularity - 1)), mGranularity(granularity), mGranularityLog2(BitScanReverse(granularity))
+{
+	for (auto& heads : mFreeHeads)
+		std::fill(std::begin(heads), std::end(heads), Null);
+
+	if (mSize == 0)
+		return;
+
+	const std::uint32_t index = NewBlock();
+	mBlocks[index].Offset = 0;
+	mBlocks[index].Size = mSize;
+	InsertFree(index);
+}
+
+void TlsfAllocator::Mapping(std::uint64_t units, std::uint32_t& fl, std::uint32_t& sl)
+{
+	//작은 블록은 1단계 0에 단위 수 그대로.
+	if (units < SlCount)
+	{
+		fl = 0;
+		sl = static_cast<std::uint32_t>(units);
+		return;
+	}
+
+	const std::uint32_t log2 = BitScanReverse(units);
+	fl = log2 - SlLog2 + 1;
+	sl = static_cast<std::uint32_t>(units >> (log2 - SlLog2)) - SlCount;
+}
+
+std::uint32_t TlsfAllocator::NewBlock()
+{
+	if (!mUnusedBlocks.empty())
+	{
+		const std::uint32_t index = mUnusedBlocks.back();
+		mUnusedBlocks.pop_back();
+		mBlocks[index] = Block();
+		return index;
+	}
+
+	mBlocks.emplace_back();
+	return static_cast<std::uint32_t>(mBlocks.size() - 1);
+}
+
+void TlsfAllocator::InsertFree(std::uint32_t index)
+{
+	Block& block = mBlocks[index];
+	std::uint32_t fl, sl;
+	Mapping(block.Size >> mGranularityLog2, fl, sl);
+
+	block.IsFree = true;
+	block.PrevFree = Null;
+	block.NextFree = mFreeHeads[fl][sl];
+	if (block.NextFree != Null)
+		mBlocks[block.NextFree].PrevFree = index;
+	mFreeHeads[fl][sl] = index;
+
+	mFlBitmap |= 1ull << fl;
+	mSlBitmap[fl] |= 1u << sl;
+}
+
+void TlsfAllocator::RemoveFree(std::uint32_t index)
+{
+	Block& block = mBlocks[index];
+	std::uint32_t fl, sl;
+	Mapping(block.Size >> mGranularityLog2, fl, sl);
+
+	if (block.PrevFree != Null)
+		mBlocks[block.PrevFree].NextFree = block.NextFree;
+	else
+		mFreeHeads[fl][sl] = block.NextFree;
+	if (block.NextFree != Null)
+		mBlocks[block.NextFree].PrevFree = block.PrevFree;
+
+	if (mFreeHeads[fl][sl] == Null)
+	{
+		mSlBitmap[fl] &= ~(1u << sl);
+		if (mSlBitmap[fl] == 0)
+			mFlBitmap &= ~(1ull << fl);
+	}
+
+	block.IsFree = false;
+	block.PrevFree = block.NextFree = Null;
+}
+
+std::uint32_t TlsfAllocator::Split(std::uint32_t index, std::uint64_t size)
+{
+	const std::uint32_t rest = NewBlock();
+	//NewBlock()이 mBlocks를 늘릴 수 있으므로 참조는 그 뒤에 잡는다.
+	Block& block = mBlocks[index];
+	Block& restBlock = mBlocks[rest];
+
+	restBlock.Offset = block.Offset + size;
+	restBlock.Size = block.Size - size;
+	restBlock.PrevPhys = index;
+	restBlock.NextPhys = block.NextPhys;
+	if (block.NextPhys != Null)
+		mBlocks[block.NextPhys].PrevPhys = rest;
+
+	block.Size = size;
+	block.NextPhys = rest;
+	return rest;
+}
+
+void TlsfAllocator::Merge(std::uint32_t index, std::uint32_t next)
+{
+	Block& block = mBlocks[index];
+	const Block& nextBlock = mBlocks[next];
+
+	block.Size += nextBlock.Size;
+	block.NextPhys = nextBlock.NextPhys;
+	if (block.NextPhys != Null)
+		mBlocks[block.NextPhys].PrevPhys = index;
+
+	mUnusedBlocks.push_back(next);
+}
+
+std::uint32_t TlsfAllocator::FindFree(std::uint64_t units)const
+{
+	//요청보다 작은 블록이 섞인 리스트를 피하도록 다음 2단계 구간으로 올려서 찾는다.
+	if (units >= SlCount)
+		units += (1ull << (BitScanReverse(units) - SlLog2)) - 1;
+
+	std::uint32_t fl, sl;
+	Mapping(units, fl, sl);
+	if (fl >= FlCount)
+		return Null;
+
+	std::uint32_t slMap = mSlBitmap[fl] & (~0u << sl);
+	if (slMap == 0)
+	{
+		const std::uint64_t flMap = fl + 1 < 64 ? mFlBitmap & (~0ull << (fl + 1)) : 0;
+		if (flMap == 0)
+			return Null;
+		fl = BitScanForward(flMap);
+		slMap = mSlBitmap[fl];
+	}
+
+	return mFreeHeads[fl][BitScanForward(slMap)];
+}
+
+std::uint64_t TlsfAllocator::Allocate(std::uint64_t size, std::uint64_t alignment)
+{
+	size = AlignUp((std::max)(size, std::uint64_t(1)), mGranularity);
+	alignment = (std::max)(alignment, mGranularity);
+	if (size > mSize)
+		return InvalidOffset;
+
+	//정렬 여백까지 들어가는 블록을 찾는다.
+	const std::uint64_t searchSize = size + (alignment - mGranularity);
+	std::uint32_t index = FindFree(searchSize >> mGranularityLog2);
+	if (index == Null)
+		return InvalidOffset;
+
+	RemoveFree(index);
+
+	//앞쪽 여백은 빈 블록으로 돌려준다.
+	const std::uint64_t padding = AlignUp(mBlocks[index].Offset, alignment) - mBlocks[index].Offset;
+	if (padding > 0)
+	{
+		const std::uint32_t aligned = Split(index, padding);
+		InsertFree(index);
+		index = aligned;
+	}
+
+	if (mBlocks[index].Size > size)
+		InsertFree(Split(index, size));
+
+	mAllocations[mBlocks[index].Offset] = index;
+	mUsedBytes += size;
+	return mBlocks[index].Offset;
+}
+
+void TlsfAllocator::Free(std::uint64_t offset)
+{
+	const auto it = mAllocations.find(offset);
+	if (it == mAllocations.end())
+		return;
+
+	std::uint32_t index = it->second;
+	mAllocations.erase(it);
+	mUsedBytes -= mBlocks[index].Size;
+
+	//앞뒤 빈 블록과 합친다.
+	const std::uint32_t next = mBlocks[index].NextPhys;
+	if (next != Null && mBlocks[next].IsFree)
+	{
+		RemoveFree(next);
+		Merge(index, next);
+	}
+
+	const std::uint32_t prev = mBlocks[index].PrevPhys;
+	if (prev != Null && mBlocks[prev].IsFree)
+	{
+		RemoveFree(prev);
+		Merge(prev, index);
+		index = prev;
+	}
+
+	InsertFree(index);
+}
+
+std::uint64_t TlsfAllocator::AllocationSize(std::uint64_t offset)const
+{
+	const auto it = mAllocations.find(offset);
+	return it != mAllocations.end() ? mBlocks[it->second].Size : 0;
+}
+
+TlsfAllocator::Stats TlsfAllocator::GetStats()const
+{
+	Stats stats;
+	stats.Size = mSize;
+	stats.UsedBytes = mUsedBytes;
+	stats.FreeBytes = mSize - mUsedBytes;
+	stats.AllocationCount = static_cast<std::uint32_t>(mAllocations.size());
+
+	for (std::uint32_t fl = 0; fl < FlCount; fl++)
+	{
+		for (std::uint32_t sl = 0; sl < SlCount; sl++)
+		{
+			for (std::uint32_t index = mFreeHeads[fl][sl]; index != Null; index = mBlocks[index].NextFree)
+			{
+				stats.FreeBlockCount++;
+				stats.LargestFreeBlock = (std::max)(stats.LargestFreeBlock, mBlocks[index].Size);
+			}
+		}
+	}
+	return stats;
+}
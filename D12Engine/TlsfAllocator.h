@@ -0,0 +1,93 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/*
+	TLSF(Two-Level Segregated Fit) 구간 할당기. [0, Size) 범위의 오프셋만 다룬다. (실제 메모리는 모름, GPU 쪽은 GpuHeapAllocator)
+
+	- 빈 블록을 크기의 log2(1단계)와 그 구간을 16등분한 값(2단계)으로 분류한 리스트에 둔다.
+	  비트맵 두 단계로 들어갈 수 있는 가장 작은 리스트를 O(1)에 찾는다. (best-fit 근사)
+	- 모든 크기와 오프셋은 Granularity 배수. 정렬이 Granularity보다 크면 앞쪽 여백을 빈 블록으로 떼어 낸다.
+	- Free()는 물리적으로 이웃한 빈 블록과 바로 합친다.
+	- 통계: 빈 바이트, 가장 큰 빈 블록, 빈 블록 수, 단편화 비율 (1 - 가장 큰 빈 블록 / 빈 바이트)
+*/
+class TlsfAllocator
+{
+public:
+	static constexpr std::uint64_t InvalidOffset = ~0ull;
+
+	struct Stats
+	{
+		std::uint64_t Size = 0;
+		std::uint64_t UsedBytes = 0;
+		std::uint64_t FreeBytes = 0;
+		std::uint64_t LargestFreeBlock = 0;
+		std::uint32_t AllocationCount = 0;
+		std::uint32_t FreeBlockCount = 0;
+
+		//0 = 빈 공간이 한 덩어리, 1에 가까울수록 잘게 쪼개져 있다.
+		float Fragmentation()const { return FreeBytes ? 1.0f - float(LargestFreeBlock) / float(FreeBytes) : 0.0f; }
+	};
+
+	//granularity는 2의 거듭제곱. size는 granularity 배수로 내림.
+	TlsfAllocator(std::uint64_t size, std::uint64_t granularity);
+
+	//alignment는 2의 거듭제곱. 공간이 없으면 InvalidOffset.
+	std::uint64_t Allocate(std::uint64_t size, std::uint64_t alignment);
+	//Allocate()가 준 오프셋.
+	void Free(std::uint64_t offset);
+
+	//할당된 크기. (granularity 배수로 올림된 값, 모르는 오프셋이면 0)
+	std::uint64_t AllocationSize(std::uint64_t offset)const;
+
+	bool IsEmpty()const { return mAllocations.empty(); }
+	std::uint64_t Size()const { return mSize; }
+	Stats GetStats()const;
+
+private:
+	static constexpr std::uint32_t SlLog2 = 4;
+	static constexpr std::uint32_t SlCount = 1u << SlLog2;
+	static constexpr std::uint32_t FlCount = 64 - SlLog2;
+	static constexpr std::uint32_t Null = ~0u;
+
+	struct Block
+	{
+		std::uint64_t Offset = 0;
+		std::uint64_t Size = 0;
+		std::uint32_t PrevPhys = Null;
+		std::uint32_t NextPhys = Null;
+		std::uint32_t PrevFree = Null;
+		std::uint32_t NextFree = Null;
+		bool IsFree = false;
+	};
+
+	//단위(granularity) 수 -> (1단계, 2단계)
+	static void Mapping(std::uint64_t units, std::uint32_t& fl, std::uint32_t& sl);
+
+	std::uint32_t NewBlock();
+	void InsertFree(std::uint32_t index);
+	void RemoveFree(std::uint32_t index);
+	//index 블록을 앞에서 size 바이트와 나머지로 나눈다. 나머지 블록 번호를 반환.
+	std::uint32_t Split(std::uint32_t index, std::uint64_t size);
+	//index와 물리적으로 다음 블록을 합친다. (둘 다 빈 블록, 리스트에서 빠진 상태)
+	void Merge(std::uint32_t index, std::uint32_t next);
+	//units 이상인 빈 블록이 있는 리스트를 찾는다.
+	std::uint32_t FindFree(std::uint64_t units)const;
+
+private:
+	std::uint64_t mSize = 0;
+	std::uint64_t mGranularity = 0;
+	std::uint32_t mGranularityLog2 = 0;
+
+	std::vector<Block> mBlocks;
+	std::vector<std::uint32_t> mUnusedBlocks;	//mBlocks에서 다시 쓸 자리
+	std::uint64_t mFlBitmap = 0;
+	std::uint32_t mSlBitmap[FlCount] = {};
+	std::uint32_t mFreeHeads[FlCount][SlCount];
+
+	std::unordered_map<std::uint64_t, std::uint32_t> mAllocations;	//오프셋 -> 블록
+	std::uint64_t mUsedBytes = 0;
+};
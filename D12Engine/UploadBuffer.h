@@ -1,6 +1,7 @@
 #pragma once
 
 #include "d3dUtil.h"
+#include "WriteCombined.h"
 
 template<typename T>
 class UploadBuffer
@@ -9,9 +10,10 @@ public:
 	UploadBuffer(ID3D12Device* device, UINT elementCount, bool isConstantBuffer) : mIsconstantBuffer(isConstantBuffer)
 	{
 		mElementByteSize = sizeof(T);
+		mElementCount = elementCount;
 
-		//   Ҵ 256Ʈ  մϴ.
-		// ̴ ϵ  ͸ m * 256Ʈ ° n * 256Ʈ ̷θ   ֱ Դϴ.
+		// 상수 버퍼 요소는 256바이트의 배수여야 합니다.
+		// 이는 하드웨어가 상수 데이터를 m * 256바이트 오프셋과 n * 256바이트 길이로만 볼 수 있기 때문입니다.
 		if (isConstantBuffer)
 			mElementByteSize = d3dUtil::CalcConstantBufferByteSize(sizeof(T));
 
@@ -20,16 +22,19 @@ public:
 
 		ThrowIfFailed(device->CreateCommittedResource(
 			&heapProps,
-			D3D12_HEAP_FLAG_NONE,				//(޸) å. ) ؽó.
+			D3D12_HEAP_FLAG_NONE,				//힙(메모리) 정책. 예) 텍스처만.
 			&resDesc,
-			D3D12_RESOURCE_STATE_GENERIC_READ,	//ҽ å. ) RT ؽó, DS ؽó ..
+			D3D12_RESOURCE_STATE_GENERIC_READ,	//리소스 정책. 예) RT 텍스처, DS 텍스처 등등..
 			nullptr,
 			IID_PPV_ARGS(&mUploadBuffer)));
 
 		ThrowIfFailed(mUploadBuffer->Map(0, nullptr, reinterpret_cast<void**>(&mMappedData)));
 
-		//ҽ "" Ϸ  Unmap ϸ ȵ.
-		//GPU ҽ  ȿ ҽ  ۾ ؼ ȵȴ.(ȭ  )
+		//UPLOAD_READ_GUARD를 켜면 쓰기 도구로 쓰는 동안에만 접근 가능. (UploadReadGuard 참고)
+		mGuard.Attach(mMappedData, mElementByteSize * elementCount);
+
+		//리소스의 "사용"이 완료될 때까지 Unmap 하면 안됨.
+		//GPU에서 리소스가 사용중인 동안에는 리소스에 쓰기 작업을 해선 안된다.(동기화 기술 사용)
 	}
 
 	UploadBuffer(const UploadBuffer& rhs) = delete;
@@ -38,7 +43,10 @@ public:
 	~UploadBuffer()
 	{
 		if (mUploadBuffer != nullptr)
+		{
+			mGuard.Detach();
 			mUploadBuffer->Unmap(0, nullptr);
+		}
 		mMappedData = nullptr;
 	}
 
@@ -49,12 +57,34 @@ public:
 
 	void CopyData(int elementIndex, const T& data)
 	{
-		memcpy(&mMappedData[elementIndex * mElementByteSize], &data, sizeof(T));
+		CopyRange(elementIndex, &data, 1);
+	}
+
+	//[first, first + count) 요소를 한 번에. 매핑 메모리는 write-combined이므로 스트리밍 저장으로 쓴다.
+	//상수 버퍼면 요소 간격은 256바이트 배수.
+	//쓰는 구간의 페이지만 연다.
+	void CopyRange(UINT first, const T* data, UINT count)
+	{
+		assert(first + count <= mElementCount);
+		UploadWriter<T>(mMappedData + UINT64(first) * mElementByteSize, mElementByteSize, count, &mGuard).CopyRange(0, data, count);
+	}
+
+	void CopyRange(UINT first, const std::vector<T>& data)
+	{
+		CopyRange(first, data.data(), (UINT)data.size());
+	}
+
+	//요소를 하나씩 만들어 쓸 때. 쓰기 도구가 사라질 때 Flush().
+	UploadWriter<T> Writer()
+	{
+		return UploadWriter<T>(mMappedData, mElementByteSize, mElementCount, &mGuard);
 	}
 
 private:
 	Microsoft::WRL::ComPtr<ID3D12Resource> mUploadBuffer;
 	BYTE* mMappedData = nullptr;
 	UINT mElementByteSize = 0;
+	UINT mElementCount = 0;
 	bool mIsconstantBuffer = false;
+	UploadReadGuard mGuard;
 };
\ No newline at end of file
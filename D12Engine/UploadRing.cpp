@@ -0,0 +1,106 @@
+﻿#include "UploadRing.h"
+
+UploadRing::~UploadRing()
+{
+	if (mBuffer != nullptr)
+		mBuffer->Unmap(0, nullptr);
+}
+
+void UploadRing::CreateBuffer()
+{
+	CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(mCapacity);
+	ThrowIfFailed(mDevice->CreateCommittedResource(
+		&heapProps,
+		D3D12_HEAP_FLAG_NONE,
+		&bufferDesc,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(mBuffer.ReleaseAndGetAddressOf())));
+
+	//GPU는 읽기만 하므로 계속 매핑해 둔다.
+	CD3DX12_RANGE readRange(0, 0);
+	ThrowIfFailed(mBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mMappedData)));
+}
+
+bool UploadRing::Allocate(UINT64 size, UINT64 alignment, Allocation& outAllocation)
+{
+	if (size == 0 || size > mCapacity)
+		return false;
+
+	if (mBuffer == nullptr)
+		CreateBuffer();
+
+	//비어 있으면 처음부터. (조각난 채로 남지 않게)
+	if (mUsed == 0)
+		mHead = mTail = 0;
+
+	const UINT64 offset = (mHead + alignment - 1) & ~(alignment - 1);
+	UINT64 start = 0;
+	UINT64 consumed = 0;
+	if (mHead >= mTail && mUsed < mCapacity)
+	{
+		//[head, capacity) 뒤에 들어가거나, 끝을 버리고 [0, tail) 앞에 들어간다.
+		if (offset + size <= mCapacity)
+		{
+			start = offset;
+			consumed = offset + size - mHead;
+		}
+		else if (size <= mTail)
+		{
+			start = 0;
+			consumed = (mCapacity - mHead) + size;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	else
+	{
+		//이미 한 바퀴 돌았다. [head, tail) 안에서만.
+		if (offset + size > mTail || mUsed == mCapacity)
+			return false;
+		start = offset;
+		consumed = offset + size - mHead;
+	}
+
+	mHead = start + size;
+	mUsed += consumed;
+	mPendingBytes += consumed;
+
+	outAllocation.Buffer = mBuffer.Get();
+	outAllocation.Offset = start;
+	outAllocation.CpuData = mMappedData + start;
+	return true;
+}
+
+void UploadRing::Submit(UINT64 fenceValue)
+{
+	if (mPendingBytes == 0)
+		return;
+
+	mBatches.push_back({ fenceValue, mHead, mPendingBytes });
+	mPendingBytes = 0;
+}
+
+void UploadRing::Reclaim(UINT64 completedFence)
+{
+	while (!mBatches.empty() && mBatches.front().Fence <= completedFence)
+	{
+		mTail = mBatches.front().Head;
+		mUsed -= mBatches.front().Bytes;
+		mBatches.pop_front();
+	}
+}
+
+void UploadRing::Trim()
+{
+	if (mUsed != 0 || mBuffer == nullptr)
+		return;
+
+	mBuffer->Unmap(0, nullptr);
+	mBuffer = nullptr;
+	mMappedData = nullptr;
+	mHead = mTail = 0;
+}
@@ -0,0 +1,65 @@
+﻿#pragma once
+
+#include "d3dUtil.h"
+#include <deque>
+
+/*
+	업로드 힙 링 버퍼. (여러 업로드가 하나의 스테이징 버퍼를 나눠 쓴다)
+
+	Allocate() : 머리(head)에서 정렬된 구간을 잘라 준다. 끝에 공간이 없으면 앞으로 돌아간다.
+	Submit()   : 지난 Submit 이후의 할당을 이번에 기록한 명령의 펜스 값에 묶는다.
+	Reclaim()  : GPU가 끝낸 펜스까지의 구간을 꼬리(tail)부터 돌려준다.
+	Trim()     : 비어 있으면 버퍼를 해제. 다음 Allocate()에서 다시 만든다.
+
+	버퍼는 만들 때 한 번 매핑해 두고 해제할 때까지 유지한다.
+*/
+class UploadRing
+{
+public:
+	struct Allocation
+	{
+		ID3D12Resource* Buffer = nullptr;
+		UINT64 Offset = 0;	//Buffer 안의 위치
+		BYTE* CpuData = nullptr;	//Offset 위치의 매핑 주소
+	};
+
+	UploadRing(ID3D12Device* device, UINT64 capacity) : mDevice(device), mCapacity(capacity) {}
+	UploadRing(const UploadRing& rhs) = delete;
+	UploadRing& operator=(const UploadRing& rhs) = delete;
+	~UploadRing();
+
+	//alignment는 2의 거듭제곱. 남은 공간이 모자라면 false. (size > Capacity()면 항상 false)
+	bool Allocate(UINT64 size, UINT64 alignment, Allocation& outAllocation);
+
+	void Submit(UINT64 fenceValue);
+	void Reclaim(UINT64 completedFence);
+	void Trim();
+
+	UINT64 Capacity()const { return mCapacity; }
+	//정렬 여백을 포함해 사용 중인 바이트 수.
+	UINT64 UsedBytes()const { return mUsed; }
+	bool IsEmpty()const { return mUsed == 0; }
+
+private:
+	struct Batch
+	{
+		UINT64 Fence = 0;
+		UINT64 Head = 0;	//이 배치의 끝. 해제되면 꼬리가 여기로 온다.
+		UINT64 Bytes = 0;
+	};
+
+	void CreateBuffer();
+
+private:
+	ID3D12Device* mDevice = nullptr;
+	UINT64 mCapacity = 0;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> mBuffer;
+	BYTE* mMappedData = nullptr;
+
+	UINT64 mHead = 0;
+	UINT64 mTail = 0;
+	UINT64 mUsed = 0;
+	UINT64 mPendingBytes = 0;	//아직 Submit하지 않은 할당
+	std::deque<Batch> mBatches;
+};
@@ -5,7 +5,7 @@
 using namespace DirectX;
 
 /*
-    ĵ  .
+    파동 방정식 사용.
 */
 Waves::Waves(int m, int n, float dx, float dt, float speed, float damping)
 {
@@ -87,7 +87,7 @@ void Waves::Update(float dt)
             {
                 for (int j = 1; j < mNumCols - 1; j++)
                 {
-                    //+z Ʒ.  ε Ʒ ϴ Ͱ ϰ .
+                    //+z축은 아래쪽. 행 인덱스가 아래쪽으로 향하는 것과 일관성 유지.
                     mPrevSolution[i * mNumCols + j].y =
                         mK1 * mPrevSolution[i * mNumCols + j].y +
                         mK2 * mCurrSolution[i * mNumCols + j].y +
@@ -98,7 +98,7 @@ void Waves::Update(float dt)
                 }
             });
 
-        //U^(t-1) / U^(t) / U^(t+1) 3 ۰ ʿ 2 ۷  .
+        //U^(t-1) / U^(t) / U^(t+1) 3개 버퍼가 필요하지만 2개 버퍼로 연산 가능.
         std::swap(mPrevSolution, mCurrSolution);
         t = 0;
 
@@ -1,8 +1,8 @@
 #pragma once
 
 /*
-* ĵ ùķ̼ .   ۾x
-* Ʈ     ۿ .
+* 파동 시뮬레이션 계산. 렌더링 관련 작업x
+* 업데이트 후 렌더링을 위해 정점 버퍼에 복사.
 */
 
 #include <vector>
@@ -0,0 +1,168 @@
+﻿#include "WriteCombined.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define WC_SIMD 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+void WriteCombined::Copy(void* dst, const void* src, std::size_t size)
+{
+	std::uint8_t* d = static_cast<std::uint8_t*>(dst);
+	const std::uint8_t* s = static_cast<const std::uint8_t*>(src);
+
+#if defined(WC_SIMD)
+	//16바이트 경계까지 일반 쓰기.
+	const std::size_t head = (std::min)(size, (16 - (reinterpret_cast<std::uintptr_t>(d) & 15)) & 15);
+	std::memcpy(d, s, head);
+	d += head;
+	s += head;
+	size -= head;
+
+	//WC 버퍼(64바이트)를 한 번에 채운다. 원본은 정렬을 가정하지 않는다.
+	for (; size >= 64; d += 64, s += 64, size -= 64)
+	{
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+		const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+		_mm_stream_si128(reinterpret_cast<__m128i*>(d), a);
+		_mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), b);
+		_mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), c);
+		_mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), e);
+	}
+	for (; size >= 16; d += 16, s += 16, size -= 16)
+		_mm_stream_si128(reinterpret_cast<__m128i*>(d), _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+#endif
+
+	std::memcpy(d, s, size);
+}
+
+void WriteCombined::CopyStrided(void* dst, std::size_t dstStride, const void* src, std::size_t srcStride, std::size_t elementSize, std::size_t count)
+{
+	//간격이 원소 크기와 같으면 한 덩어리.
+	if (dstStride == elementSize && srcStride == elementSize)
+	{
+		Copy(dst, src, elementSize * count);
+		return;
+	}
+
+	std::uint8_t* d = static_cast<std::uint8_t*>(dst);
+	const std::uint8_t* s = static_cast<const std::uint8_t*>(src);
+	for (std::size_t i = 0; i < count; i++, d += dstStride, s += srcStride)
+		Copy(d, s, elementSize);
+}
+
+void WriteCombined::Flush()
+{
+#if defined(WC_SIMD)
+	_mm_sfence();
+#endif
+}
+
+#if UPLOAD_READ_GUARD && defined(_WIN32)
+namespace
+{
+	//구간을 덮는 페이지 범위.
+	bool PageRange(void* data, std::size_t size, void*& outBase, std::size_t& outSize)
+	{
+		if (data == nullptr || size == 0)
+			return false;
+
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		const std::uintptr_t pageMask = info.dwPageSize - 1;
+		const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(data) & ~pageMask;
+		const std::uintptr_t end = (reinterpret_cast<std::uintptr_t>(data) + size + pageMask) & ~pageMask;
+		outBase = reinterpret_cast<void*>(begin);
+		outSize = end - begin;
+		return true;
+	}
+}
+
+void UploadReadGuard::Attach(void* data, std::size_t size)
+{
+	Detach();
+
+	void* base;
+	std::size_t bytes;
+	if (!PageRange(data, size, base, bytes))
+		return;
+
+	//드라이버 매핑이 보호 변경을 거부하면 이 매핑만 검사하지 않는다.
+	DWORD oldProtect;
+	if (!VirtualProtect(base, bytes, PAGE_NOACCESS, &oldProtect))
+	{
+		OutputDebugStringW(L"upload read guard: VirtualProtect failed, mapping left unguarded\n");
+		return;
+	}
+
+	mData = data;
+	mSize = size;
+	mOriginalProtect = oldProtect;
+	mEnabled = true;
+}
+
+void UploadReadGuard::Detach()
+{
+	if (!mEnabled)
+		return;
+
+	void* base;
+	std::size_t bytes;
+	DWORD oldProtect;
+	if (PageRange(mData, mSize, base, bytes))
+		VirtualProtect(base, bytes, mOriginalProtect, &oldProtect);
+
+	mData = nullptr;
+	mSize = 0;
+	mEnabled = false;
+}
+
+void UploadReadGuard::Open(void* data, std::size_t size)
+{
+	void* base;
+	std::size_t bytes;
+	if (!mEnabled || !PageRange(data, size, base, bytes))
+		return;
+
+	DWORD oldProtect;
+	if (!VirtualProtect(base, bytes, mOriginalProtect, &oldProtect))
+		OutputDebugStringW(L"upload read guard: failed to open range\n");
+}
+
+void UploadReadGuard::Close(void* data, std::size_t size)
+{
+	void* base;
+	std::size_t bytes;
+	if (!mEnabled || !PageRange(data, size, base, bytes))
+		return;
+
+	//실패하면 그 페이지는 열린 채로 둔다. (검사만 빠지고 쓰기는 계속 된다)
+	DWORD oldProtect;
+	if (!VirtualProtect(base, bytes, PAGE_NOACCESS, &oldProtect))
+		OutputDebugStringW(L"upload read guard: failed to close range\n");
+}
+#else
+void UploadReadGuard::Attach(void*, std::size_t)
+{
+}
+
+void UploadReadGuard::Detach()
+{
+}
+
+void UploadReadGuard::Open(void*, std::size_t)
+{
+}
+
+void UploadReadGuard::Close(void*, std::size_t)
+{
+}
+#endif
@@ -0,0 +1,110 @@
+﻿#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//업로드 메모리 읽기 검사. 기본은 꺼져 있다. (쓰고 싶으면 1로 정의)
+#if !defined(UPLOAD_READ_GUARD)
+#define UPLOAD_READ_GUARD 0
+#endif
+
+/*
+	쓰기 결합(write-combined) 메모리 쓰기. (업로드 힙 매핑)
+
+	WC 메모리는 캐시를 거치지 않아 읽기가 아주 느리고, 쓰기는 64바이트 버퍼를 채워 순서대로 내보낼 때 가장 빠르다.
+	- Copy()       : 목적지가 16바이트 정렬된 구간은 non-temporal SIMD 저장으로 64바이트씩. 앞뒤 자투리는 memcpy.
+	- CopyStrided(): 원소마다 dstStride 간격으로 Copy(). (상수 버퍼는 256바이트 간격)
+	- Flush()      : 스트리밍 저장 마무리(sfence). GPU가 읽기 전에(명령 리스트 제출 전에) 한 번.
+*/
+class WriteCombined
+{
+public:
+	static void Copy(void* dst, const void* src, std::size_t size);
+	static void CopyStrided(void* dst, std::size_t dstStride, const void* src, std::size_t srcStride, std::size_t elementSize, std::size_t count);
+	static void Flush();
+};
+
+/*
+	업로드 매핑 하나의 읽기 검사. UPLOAD_READ_GUARD가 0이면 아무것도 안 한다.
+
+	- Attach(): 매핑 전체를 접근 불가로 막고, 그때 돌려받은 원래 보호 속성(write-combine 포함)을 기억한다.
+	- Open()/Close(): UploadWriter가 쓰는 구간의 페이지만 원래 속성으로 열었다가 다시 막는다.
+	  그 밖에서 매핑 포인터를 읽으면 그 자리에서 접근 위반이 난다.
+	- Detach(): 매핑 전체를 원래 속성으로 되돌린다. Unmap 전에 부른다.
+	처음 막기에 실패한 매핑은 검사하지 않는다. 다시 막기에 실패하면 그 페이지는 열린 채로 둔다. (다른 매핑에는 영향 없음)
+*/
+class UploadReadGuard
+{
+public:
+	UploadReadGuard() = default;
+	UploadReadGuard(const UploadReadGuard& rhs) = delete;
+	UploadReadGuard& operator=(const UploadReadGuard& rhs) = delete;
+	~UploadReadGuard() { Detach(); }
+
+	void Attach(void* data, std::size_t size);
+	void Detach();
+
+	void Open(void* data, std::size_t size);
+	void Close(void* data, std::size_t size);
+
+	bool IsEnabled()const { return mEnabled; }
+
+private:
+	void* mData = nullptr;
+	std::size_t mSize = 0;
+	std::uint32_t mOriginalProtect = 0;
+	bool mEnabled = false;
+};
+
+/*
+	WC 메모리에 T를 stride 간격으로 쓰는 도구. 소멸할 때 Flush()한다.
+	guard를 주면 [data, data + count 원소) 페이지만 열었다가 소멸할 때 다시 막는다.
+	같은 페이지를 쓰는 UploadWriter를 동시에 둘 이상 두지 않는다.
+*/
+template<typename T>
+class UploadWriter
+{
+public:
+	UploadWriter(void* data, std::size_t stride, std::size_t count, UploadReadGuard* guard = nullptr) :
+		mData(static_cast<std::uint8_t*>(data)), mStride(stride), mCount(count), mGuard(guard)
+	{
+		assert(stride >= sizeof(T));
+		if (mGuard != nullptr)
+			mGuard->Open(mData, ByteSize());
+	}
+	UploadWriter(const UploadWriter& rhs) = delete;
+	UploadWriter& operator=(const UploadWriter& rhs) = delete;
+	~UploadWriter()
+	{
+		WriteCombined::Flush();
+		if (mGuard != nullptr)
+			mGuard->Close(mData, ByteSize());
+	}
+
+	void Write(std::size_t index, const T& value)
+	{
+		assert(index < mCount);
+		WriteCombined::Copy(mData + index * mStride, &value, sizeof(T));
+	}
+
+	//[first, first + count) 원소를 한 번에.
+	void CopyRange(std::size_t first, const T* values, std::size_t count)
+	{
+		assert(first + count <= mCount);
+		WriteCombined::CopyStrided(mData + first * mStride, mStride, values, sizeof(T), sizeof(T), count);
+	}
+	void CopyRange(std::size_t first, const std::vector<T>& values) { CopyRange(first, values.data(), values.size()); }
+
+	std::size_t Count()const { return mCount; }
+
+private:
+	std::size_t ByteSize()const { return mCount ? (mCount - 1) * mStride + sizeof(T) : 0; }
+
+private:
+	std::uint8_t* mData = nullptr;
+	std::size_t mStride = 0;
+	std::size_t mCount = 0;
+	UploadReadGuard* mGuard = nullptr;
+};
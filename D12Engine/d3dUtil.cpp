@@ -1,8 +1,47 @@
 #include "d3dUtil.h"
+#include "AssetCache.h"
+#include "GpuHeapAllocator.h"
 #include <comdef.h> // For _com_error
+#include <cstring>
+#include <filesystem>
+#include <unordered_set>
 
 using namespace Microsoft::WRL;
 
+namespace
+{
+	//#include "..." 로 끌어오는 파일까지 재귀적으로 해시. (D3D_COMPILE_STANDARD_FILE_INCLUDE와 같이 포함한 파일 기준 상대 경로)
+	bool HashShaderSource(AssetCache& cache, const std::filesystem::path& file, std::unordered_set<std::wstring>& visited, std::uint64_t& inOutHash)
+	{
+		if (!visited.insert(file.lexically_normal().wstring()).second)
+			return true;
+
+		std::uint64_t fileHash = 0;
+		if (!cache.HashFile(file, fileHash))
+			return false;
+		inOutHash = AssetCache::Combine(inOutHash, fileHash);
+
+		std::ifstream in(file);
+		std::string line;
+		while (std::getline(in, line))
+		{
+			const size_t directive = line.find_first_not_of(" \t");
+			if (directive == std::string::npos || line.compare(directive, 8, "#include") != 0)
+				continue;
+
+			const size_t open = line.find('"', directive + 8);
+			const size_t close = open == std::string::npos ? std::string::npos : line.find('"', open + 1);
+			if (close == std::string::npos)
+				continue;
+
+			const std::filesystem::path include = file.parent_path() / line.substr(open + 1, close - open - 1);
+			if (!HashShaderSource(cache, include, visited, inOutHash))
+				return false;
+		}
+		return true;
+	}
+}
+
 std::wstring DxException::ToString() const
 {
 	_com_error err(ErrorCode);
@@ -12,9 +51,9 @@ std::wstring DxException::ToString() const
 }
 
 /*
-	defines: ó ܰ迡 . (  ٲ)
-	entrypoint: ϳ HLSL Ͽ  ̴   
-	target: ̴ ܰ +   
+	defines: 전처리 단계에서만 쓰임. (컴파일 결과를 바꿈)
+	entrypoint: 하나의 HLSL 파일에 여러 셰이더가 있을 때 선택
+	target: 셰이더 단계 + 모델 버전 결정
 */
 Microsoft::WRL::ComPtr<ID3DBlob> d3dUtil::CompileShader(const std::wstring& filename, const D3D_SHADER_MACRO* defines, const std::string& entrypoint, const std::string& target)
 {
@@ -23,9 +62,30 @@ Microsoft::WRL::ComPtr<ID3DBlob> d3dUtil::CompileShader(const std::wstring& file
 	compileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
 #endif
 
+	//키 = 소스 + include 파일 내용 + 엔트리/타깃/플래그/매크로. 하나라도 바뀌면 다시 컴파일.
+	AssetCache& cache = AssetCache::Default();
+	std::uint64_t key = 0;
+	std::unordered_set<std::wstring> visited;
+	bool hasKey = HashShaderSource(cache, filename, visited, key);
+	if (hasKey)
+	{
+		std::string params = "CompileShader/1|" + entrypoint + "|" + target + "|" + std::to_string(compileFlags);
+		for (const D3D_SHADER_MACRO* d = defines; d != nullptr && d->Name != nullptr; d++)
+			params += std::string("|") + d->Name + "=" + (d->Definition ? d->Definition : "");
+		key = AssetCache::Combine(key, AssetCache::Hash(params));
+	}
+
 	HRESULT hr = S_OK;
 
 	ComPtr<ID3DBlob> byteCode = nullptr;
+	std::vector<std::uint8_t> cached;
+	if (hasKey && cache.Load(key, cached) && !cached.empty())
+	{
+		ThrowIfFailed(D3DCreateBlob(cached.size(), &byteCode));
+		std::memcpy(byteCode->GetBufferPointer(), cached.data(), cached.size());
+		return byteCode;
+	}
+
 	ComPtr<ID3DBlob> errors;
 	hr = D3DCompileFromFile(
 		filename.c_str(),
@@ -43,41 +103,51 @@ Microsoft::WRL::ComPtr<ID3DBlob> d3dUtil::CompileShader(const std::wstring& file
 
 	ThrowIfFailed(hr);
 
+	if (hasKey)
+		cache.Store(key, byteCode->GetBufferPointer(), byteCode->GetBufferSize());
+
 	return byteCode;
 }
 
-Microsoft::WRL::ComPtr<ID3D12Resource> d3dUtil::CreateDefaultBuffer(ID3D12Device* device, ID3D12GraphicsCommandList* cmdList, const void* initData, UINT64 byteSize, Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer)
+Microsoft::WRL::ComPtr<ID3D12Resource> d3dUtil::CreateDefaultBuffer(ID3D12Device* device, ID3D12GraphicsCommandList* cmdList, const void* initData, UINT64 byteSize, Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer, GpuHeapAllocator* heapAllocator)
 {
 	ComPtr<ID3D12Resource> defaultBuffer;
 
-	CD3DX12_HEAP_PROPERTIES defaultHeapProps(D3D12_HEAP_TYPE_DEFAULT);
-	CD3DX12_RESOURCE_DESC defaultResourceDesc = CD3DX12_RESOURCE_DESC::Buffer(byteSize);
-	ThrowIfFailed(device->CreateCommittedResource(
-		&defaultHeapProps,
-		D3D12_HEAP_FLAG_NONE,
-		&defaultResourceDesc,
-		D3D12_RESOURCE_STATE_COMMON,
-		nullptr,
-		IID_PPV_ARGS(defaultBuffer.GetAddressOf())));
-
-	CD3DX12_HEAP_PROPERTIES uploadHeapProps(D3D12_HEAP_TYPE_UPLOAD);
-	CD3DX12_RESOURCE_DESC uploadResourceDesc = CD3DX12_RESOURCE_DESC::Buffer(byteSize);
-	ThrowIfFailed(device->CreateCommittedResource(
-		&uploadHeapProps,
-		D3D12_HEAP_FLAG_NONE,
-		&uploadResourceDesc,
-		D3D12_RESOURCE_STATE_GENERIC_READ,
-		nullptr,
-		IID_PPV_ARGS(uploadBuffer.GetAddressOf())));
+	CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(byteSize);
+	if (heapAllocator != nullptr)
+	{
+		defaultBuffer = heapAllocator->CreateResource(D3D12_HEAP_TYPE_DEFAULT, bufferDesc, D3D12_RESOURCE_STATE_COMMON);
+		uploadBuffer = heapAllocator->CreateResource(D3D12_HEAP_TYPE_UPLOAD, bufferDesc, D3D12_RESOURCE_STATE_GENERIC_READ);
+	}
+	else
+	{
+		CD3DX12_HEAP_PROPERTIES defaultHeapProps(D3D12_HEAP_TYPE_DEFAULT);
+		ThrowIfFailed(device->CreateCommittedResource(
+			&defaultHeapProps,
+			D3D12_HEAP_FLAG_NONE,
+			&bufferDesc,
+			D3D12_RESOURCE_STATE_COMMON,
+			nullptr,
+			IID_PPV_ARGS(defaultBuffer.GetAddressOf())));
+
+		CD3DX12_HEAP_PROPERTIES uploadHeapProps(D3D12_HEAP_TYPE_UPLOAD);
+		ThrowIfFailed(device->CreateCommittedResource(
+			&uploadHeapProps,
+			D3D12_HEAP_FLAG_NONE,
+			&bufferDesc,
+			D3D12_RESOURCE_STATE_GENERIC_READ,
+			nullptr,
+			IID_PPV_ARGS(uploadBuffer.GetAddressOf())));
+	}
 
 	D3D12_SUBRESOURCE_DATA subResourceData = {};
 	subResourceData.pData = initData;
 	subResourceData.RowPitch = byteSize;
 	subResourceData.SlicePitch = byteSize;
 
-	// ⺻(Default)  ҽ  縦 Ŀǵ Ʈ ().
-	//  Լ UpdateSubresources CPU ޸𸮸 ߰ ε   ,
-	// Ŀǵ Ʈ Copy  Ͽ ε  ͸ ⺻ ۷ .
+	// 기본(Default) 버퍼 리소스로의 데이터 복사를 커맨드 리스트에 기록(예약).
+	// 헬퍼 함수 UpdateSubresources는 CPU 메모리를 중간 업로드 힙에 복사한 뒤,
+	// 커맨드 리스트에 Copy 명령을 기록하여 업로드 힙의 데이터를 기본 버퍼로 복사.
 	CD3DX12_RESOURCE_BARRIER barrier1 = CD3DX12_RESOURCE_BARRIER::Transition(
 		defaultBuffer.Get(),
 		D3D12_RESOURCE_STATE_COMMON,
@@ -92,9 +162,9 @@ Microsoft::WRL::ComPtr<ID3D12Resource> d3dUtil::CreateDefaultBuffer(ID3D12Device
 		D3D12_RESOURCE_STATE_GENERIC_READ);
 	cmdList->ResourceBarrier(1, &barrier2);
 
-	// :  Լ ȣ Ŀ uploadBuffer  Ǿ .
-	// cmdList      .
-	// ȣڴ 簡 Ǿ Ȯ Ŀ uploadBuffer  .
+	// 참고: 위 함수 호출 후에도 uploadBuffer는 계속 유지되어야 함.
+	// cmdList에 명령을 기록했을 뿐 아직 실행되지 않음.
+	// 호출자는 복사가 실행되었음을 확인한 후에 uploadBuffer를 해제 가능.
 
 	return defaultBuffer;
 }
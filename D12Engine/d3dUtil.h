@@ -26,6 +26,8 @@
 
 extern const int gNumFrameResources;
 
+class GpuHeapAllocator;
+
 class DxException
 {
 public:
@@ -71,7 +73,7 @@ public:
 	static std::string ToString(HRESULT hr);
 	static UINT CalcConstantBufferByteSize(UINT byteSize)
 	{
-		// ۴ ּ ϵ Ҵ ũ(256Ʈ)  .
+		//상수 버퍼는 최소 하드웨어 할당 크기(256바이트)의 배수여야 함.
 		return (byteSize + 255) & ~255;
 	}
 
@@ -86,7 +88,8 @@ public:
 		ID3D12GraphicsCommandList* cmdList,
 		const void* initData,
 		UINT64 byteSize,
-		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer);
+		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer,
+		GpuHeapAllocator* heapAllocator = nullptr);	//있으면 두 버퍼를 할당기의 힙에 배치. (놓을 때는 할당기의 Free())
 };
 
 struct SubmeshGeometry
@@ -95,17 +98,17 @@ struct SubmeshGeometry
 	UINT StartIndexLocation = 0;
 	INT BaseVertexLocation = 0;
 
-	//  ޽÷ ǵ    .
-	// ߿ ο...
+	// 이 서브메시로 정의된 기하 도형의 경계 상자.
+	// 나중에 공부예정...
 	DirectX::BoundingBox Bounds;
 };
 
 struct MeshGeometry
 {
-	std::string Name;	//̸ ˻
+	std::string Name;	//이름 검색용
 
-	//ý ޸ 纻. /ε  Ϲȭ  Ƿ Blob .
-	//  ȯ Ŭ̾Ʈ å.
+	//시스템 메모리 복사본. 정점/인덱스 형식을 일반화할 수 있으므로 Blob을 사용.
+	// 적절한 형변환은 클라이언트의 책임.
 	Microsoft::WRL::ComPtr<ID3DBlob> VertexBufferCPU;
 	Microsoft::WRL::ComPtr<ID3DBlob> IndexBufferCPU = nullptr;
 
@@ -117,17 +120,19 @@ struct MeshGeometry
 
 	UINT VertexByteStride;
 	UINT VertexBufferByteSize;
+	//VertexBufferGPU 안의 시작 위치. (프레임 업로드 할당기에서 잘라 쓰는 동적 정점 등)
+	UINT64 VertexBufferOffset = 0;
 	DXGI_FORMAT IndexFormat = DXGI_FORMAT_R16_UINT;
 	UINT IndexBufferByteSize = 0;
 
-	//MeshGeometry ϳ /ε ۿ  Ʈ  .
-	//޽ Ʈ ϸ ޽ø   .
+	//MeshGeometry는 하나의 정점/인덱스 버퍼에 여러개의 지오메트리를 저장 가능.
+	//서브메시 지오메트리를 정의하면 서브메시를 개별적으로 렌더링 가능.
 	std::unordered_map<std::string, SubmeshGeometry> DrawArgs;
 
 	D3D12_VERTEX_BUFFER_VIEW VertexBufferView() const
 	{
 		D3D12_VERTEX_BUFFER_VIEW vbv;
-		vbv.BufferLocation = VertexBufferGPU->GetGPUVirtualAddress();
+		vbv.BufferLocation = VertexBufferGPU->GetGPUVirtualAddress() + VertexBufferOffset;
 		vbv.StrideInBytes = VertexByteStride;
 		vbv.SizeInBytes = VertexBufferByteSize;
 
@@ -144,8 +149,8 @@ struct MeshGeometry
 		return ibv;
 	}
 
-	//ComPtr RAII̹Ƿ nullptr  ҽ .
-	//GPU ε尡 ϷǸ  .
+	//ComPtr은 RAII이므로 nullptr대입 시 리소스 해제.
+	//GPU에 업로드가 완료되면 해제 가능. (펜스를 기다리지 않으려면 DeferredReleaseQueue에 넘긴다)
 	void DisposeUploaders()
 	{
 		VertexBufferUploader = nullptr;
@@ -170,19 +175,18 @@ struct Light
 
 #define MaxLights 16
 
-//   Material Ŭ     ִ.
+// 실제 엔진에서는 Material 클래스 계층 구조로 존재할 수 있다.
 struct Material
 {
 	std::string Name;
 	int MatCBIndex = -1;
-	//ǻ ؽó  SRV  ε.
+	//디퓨즈 텍스처에 대한 SRV 힙 인덱스.
 	int DiffuseSrvHeapIndex = -1;
-	// ؽó  SRV  ε.
+	//노멀 텍스처에 대한 SRV 힙 인덱스.
 	int NormalSrvHeapIndex = -1;
 
-	int NumFramesDirty = gNumFrameResources;
-
-	//HLSL Ǵ  ۿ  .
+	//HLSL에서 사용되는 상수 버퍼에 대한 데이터.
+	//수정하면 AppD3D::SetMaterialConstants()로 다시 등록해야 GPU에 반영된다.
 	DirectX::XMFLOAT4 DiffuseAlbedo = { 1.0f, 1.0f , 1.0f , 1.0f };
 	DirectX::XMFLOAT3 FresnelR0 = { 0.01f, 0.01f, 0.01f };
 	float Roughness = 0.25f;
@@ -195,7 +199,7 @@ struct MaterialConstants
 	DirectX::XMFLOAT3 FresnelR0 = { 0.01f, 0.01f, 0.01f};
 	float Roughness = 0.25f;
 
-	//ؽ ο .
+	//텍스쳐 매핑에 사용.
 	DirectX::XMFLOAT4X4 MatTransform = MathHelper::Identity4x4();
 };
 
@@ -206,6 +210,11 @@ struct Texture
 	Microsoft::WRL::ComPtr<ID3D12Resource> Resource = nullptr;
 	Microsoft::WRL::ComPtr<ID3D12Resource> UploadHeap = nullptr;
 
-	//srv  ؽó  ε. ؽó   迭   ִ.
+	//srv 힙에서 텍스처에 대한 인덱스. 텍스처가 여러개일 경우 배열로 관리할 수 있다.
 	int DiffuseSrvHeapIndex = -1;
+
+	//업로드가 끝난 가장 상세한 밉. 스트리밍 중이면 이보다 상세한 밉은 샘플링하지 않도록 SRV에서 막는다. (TextureStreamer 참고)
+	UINT ResidentMip = 0;
+	//Resource의 밉 0이 원본의 몇 번째 밉인지. 상주 예산 때문에 상세 밉을 내리면 리소스를 작게 다시 만든다. (TextureResidency 참고)
+	UINT BaseMip = 0;
 };
\ No newline at end of file
@@ -0,0 +1,73 @@
+﻿#include "TestCommon.h"
+
+#include "AssetLoader.h"
+
+#include <atomic>
+#include <future>
+
+TEST(FinishedRequestsAreCleanedUp)
+{
+	AssetLoader loader(2);
+	std::atomic<int> finalized = 0;
+
+	std::vector<AssetHandle> handles;
+	for (int i = 0; i < 100; i++)
+		handles.push_back(loader.Submit([]() { return true; }, [&](bool loaded) { finalized += loaded; return loaded; }));
+
+	loader.WaitIdle();
+	for (AssetHandle handle : handles)
+		CHECK_EQ(loader.GetState(handle), AssetState::Loaded);
+
+	CHECK_EQ(loader.Pump(), 100u);
+	CHECK_EQ(finalized.load(), 100);
+	CHECK_EQ(loader.PendingCount(), 0u);
+	for (AssetHandle handle : handles)
+	{
+		CHECK_EQ(loader.GetState(handle), AssetState::Finished);
+		CHECK(loader.IsFinished(handle));
+	}
+}
+
+TEST(UnknownHandleIsInvalid)
+{
+	AssetLoader loader(1);
+	CHECK_EQ(loader.GetState(AssetHandle()), AssetState::Invalid);
+	CHECK_EQ(loader.GetState(AssetHandle{ 42 }), AssetState::Invalid);
+	CHECK(!loader.IsFinished(AssetHandle{ 42 }));
+}
+
+TEST(FailedLoadStillFinalizes)
+{
+	AssetLoader loader(1);
+	bool sawFailure = false;
+	const AssetHandle handle = loader.Submit([]() -> bool { throw 1; }, [&](bool loaded) { sawFailure = !loaded; return loaded; });
+
+	loader.WaitIdle();
+	loader.Pump();
+	CHECK(sawFailure);
+	CHECK_EQ(loader.GetState(handle), AssetState::Finished);
+}
+
+TEST(CancelledRequestSkipsFinalize)
+{
+	AssetLoader loader(1);
+
+	//워커 하나를 막아 두고 그 뒤 요청을 취소한다.
+	std::promise<void> release;
+	std::shared_future<void> gate = release.get_future().share();
+	const AssetHandle blocker = loader.Submit([gate]() { gate.wait(); return true; }, nullptr, AssetPriority::Critical);
+	bool finalized = false;
+	const AssetHandle cancelled = loader.Submit([]() { return true; }, [&](bool) { finalized = true; return true; }, AssetPriority::Low);
+
+	CHECK(loader.Cancel(cancelled));
+	CHECK(!loader.Cancel(cancelled));
+	CHECK_EQ(loader.GetState(cancelled), AssetState::Cancelled);
+	CHECK(loader.IsFinished(cancelled));
+
+	release.set_value();
+	loader.WaitIdle();
+	loader.Pump();
+	CHECK(!finalized);
+	CHECK_EQ(loader.GetState(cancelled), AssetState::Finished);
+	CHECK_EQ(loader.GetState(blocker), AssetState::Finished);
+}
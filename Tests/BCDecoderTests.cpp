@@ -0,0 +1,98 @@
+﻿#include "TestCommon.h"
+
+#include "BCReferenceBlocks.h"
+
+#include <cstring>
+#include <random>
+
+namespace
+{
+	bool Matches(const BCReferenceBlock& reference, const std::uint8_t* decoded)
+	{
+		const std::size_t bytes = 16 * BCDecoder::PixelBytes(reference.Format);
+		if (std::memcmp(decoded, reference.Expected, bytes) == 0)
+			return true;
+
+		std::printf("  %s: decoded output differs from reference\n", reference.Name);
+		return false;
+	}
+}
+
+TEST(ReferencePathMatchesReferenceBlocks)
+{
+	for (const BCReferenceBlock& reference : BCReferenceBlocks)
+	{
+		std::uint8_t decoded[64] = {};
+		BCDecoder::DecodeBlockReference(reference.Format, reference.Block, decoded, 4 * BCDecoder::PixelBytes(reference.Format));
+		CHECK(Matches(reference, decoded));
+	}
+}
+
+TEST(SimdPathsMatchReferenceBlocks)
+{
+	//이 CPU에서 쓸 수 있는 경로마다. (0 = 스칼라, 1 = SSSE3, 2 = AVX2)
+	for (int level = 0; level <= BCDecoder::SimdLevel(); level++)
+	{
+		for (const BCReferenceBlock& reference : BCReferenceBlocks)
+		{
+			std::uint8_t decoded[64] = {};
+			BCDecoder::DecodeBlockAtLevel(level, reference.Format, reference.Block, decoded, 4 * BCDecoder::PixelBytes(reference.Format));
+			CHECK(Matches(reference, decoded));
+		}
+	}
+
+	for (const BCReferenceBlock& reference : BCReferenceBlocks)
+	{
+		std::uint8_t decoded[64] = {};
+		BCDecoder::DecodeBlock(reference.Format, reference.Block, decoded, 4 * BCDecoder::PixelBytes(reference.Format));
+		CHECK(Matches(reference, decoded));
+	}
+}
+
+TEST(SimdPathsMatchReferencePathOnRandomBlocks)
+{
+	const BCFormat formats[] = { BCFormat::BC1, BCFormat::BC2, BCFormat::BC3, BCFormat::BC4, BCFormat::BC5, BCFormat::BC7 };
+	std::mt19937 rng(34);
+	for (BCFormat format : formats)
+	{
+		for (int i = 0; i < 2000; i++)
+		{
+			std::uint8_t block[16];
+			for (std::uint8_t& b : block)
+				b = static_cast<std::uint8_t>(rng());
+
+			std::uint8_t expected[64];
+			BCDecoder::DecodeBlockReference(format, block, expected, 4 * BCDecoder::PixelBytes(format));
+			for (int level = 1; level <= BCDecoder::SimdLevel(); level++)
+			{
+				std::uint8_t decoded[64];
+				BCDecoder::DecodeBlockAtLevel(level, format, block, decoded, 4 * BCDecoder::PixelBytes(format));
+				CHECK(std::memcmp(decoded, expected, 16 * BCDecoder::PixelBytes(format)) == 0);
+			}
+		}
+	}
+}
+
+TEST(DecodeClipsEdgeBlocks)
+{
+	//6x5 BC1 이미지 = 2x2 블록. 가장자리 블록은 이미지 안쪽만 기록한다.
+	const BCReferenceBlock& reference = BCReferenceBlocks[0];
+	std::uint8_t blocks[4 * 8];
+	for (int i = 0; i < 4; i++)
+		std::memcpy(blocks + i * 8, reference.Block, 8);
+
+	const std::size_t pitch = 6 * 4 + 8;
+	std::uint8_t image[pitch * 5];
+	std::memset(image, 0xCD, sizeof(image));
+	CHECK(BCDecoder::Decode(BCFormat::BC1, blocks, sizeof(blocks), 6, 5, image, pitch));
+
+	for (std::size_t y = 0; y < 5; y++)
+	{
+		for (std::size_t x = 0; x < 6; x++)
+			CHECK(std::memcmp(image + y * pitch + x * 4, reference.Expected + ((y % 4) * 4 + (x % 4)) * 4, 4) == 0);
+		for (std::size_t x = 6 * 4; x < pitch; x++)
+			CHECK_EQ(image[y * pitch + x], 0xCD);
+	}
+
+	CHECK(!BCDecoder::Decode(BCFormat::BC1, blocks, sizeof(blocks) - 1, 6, 5, image, pitch));
+}
@@ -0,0 +1,222 @@
+﻿#pragma once
+
+#include "BCDecoder.h"
+
+#include <cstdint>
+
+/*
+	BC 기준 블록과 기대 출력. (블록 하나 = 4x4 픽셀, 행 순서)
+
+	기대 출력은 Pillow 12.3의 DDS 디코더(BcnDecode.c)로 만든 값이다. 엔진 디코더는 쓰지 않았다.
+	- BC1~BC5는 모드마다 하나씩. (BC1 4색/3색+투명, BC2/BC3은 c0 <= c1이어도 4색, BC3·BC4 알파 8단계/6단계)
+	- BC7은 모드 0~7 하나씩, 그리고 모드 비트가 없는 블록.
+	  모드 비트가 없는 블록만 Pillow(불투명한 검정) 대신 D3D 규격 값(투명한 검정, 모두 0)을 넣었다.
+	- BC4는 R8, BC5는 RG8, 나머지는 RGBA8.
+*/
+struct BCReferenceBlock
+{
+	const char* Name;
+	BCFormat Format;
+	std::uint8_t Block[16];
+	std::uint8_t Expected[64];
+};
+
+inline const BCReferenceBlock BCReferenceBlocks[] =
+{
+	{
+		"BC1FourColor", BCFormat::BC1,
+		{
+			0x1f, 0xf8, 0xe0, 0x07, 0xd7, 0x3a, 0xe6, 0x07,
+		},
+		{
+			0x55, 0xaa, 0x55, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x55, 0xaa, 0x55, 0xff,
+			0xaa, 0x55, 0xaa, 0xff, 0xaa, 0x55, 0xaa, 0xff, 0x55, 0xaa, 0x55, 0xff, 0xff, 0x00, 0xff, 0xff,
+			0xaa, 0x55, 0xaa, 0xff, 0x00, 0xff, 0x00, 0xff, 0xaa, 0x55, 0xaa, 0xff, 0x55, 0xaa, 0x55, 0xff,
+			0x55, 0xaa, 0x55, 0xff, 0x00, 0xff, 0x00, 0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0x00, 0xff, 0xff,
+		},
+	},
+	{
+		"BC1ThreeColorTransparent", BCFormat::BC1,
+		{
+			0x1f, 0x00, 0x00, 0xf8, 0xf2, 0x10, 0x6c, 0xf4,
+		},
+		{
+			0x7f, 0x00, 0x7f, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xff,
+			0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x00, 0x7f, 0xff, 0xff, 0x00, 0x00, 0xff,
+			0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		},
+	},
+	{
+		"BC2ExplicitAlpha", BCFormat::BC2,
+		{
+			0x4e, 0x57, 0x18, 0x95, 0x82, 0xd2, 0x27, 0x18, 0x34, 0x12, 0xcd, 0xab, 0xc6, 0x27, 0xc0, 0x86,
+		},
+		{
+			0x44, 0x56, 0x91, 0xee, 0xad, 0x79, 0x6b, 0x44, 0x10, 0x45, 0xa5, 0x77, 0x78, 0x67, 0x7e, 0x55,
+			0x78, 0x67, 0x7e, 0x88, 0xad, 0x79, 0x6b, 0x11, 0x44, 0x56, 0x91, 0x55, 0x10, 0x45, 0xa5, 0x99,
+			0x10, 0x45, 0xa5, 0x22, 0x10, 0x45, 0xa5, 0x88, 0x10, 0x45, 0xa5, 0x22, 0x78, 0x67, 0x7e, 0xdd,
+			0x44, 0x56, 0x91, 0x77, 0xad, 0x79, 0x6b, 0x22, 0x10, 0x45, 0xa5, 0x88, 0x44, 0x56, 0x91, 0x11,
+		},
+	},
+	{
+		"BC3EightAlpha", BCFormat::BC3,
+		{
+			0xe6, 0x11, 0x0f, 0x5e, 0x41, 0xbd, 0x8d, 0xb4, 0xe0, 0xff, 0x1f, 0x04, 0xef, 0x2a, 0x96, 0xdf,
+		},
+		{
+			0x55, 0xab, 0xaa, 0x2f, 0x55, 0xab, 0xaa, 0x11, 0xaa, 0xd5, 0x55, 0xe6, 0x55, 0xab, 0xaa, 0x2f,
+			0xaa, 0xd5, 0x55, 0x6c, 0xaa, 0xd5, 0x55, 0xc7, 0xaa, 0xd5, 0x55, 0xe6, 0xff, 0xff, 0x00, 0xc7,
+			0xaa, 0xd5, 0x55, 0x6c, 0x00, 0x82, 0xff, 0x2f, 0x00, 0x82, 0xff, 0x4d, 0xaa, 0xd5, 0x55, 0x4d,
+			0x55, 0xab, 0xaa, 0xe6, 0x55, 0xab, 0xaa, 0x11, 0x00, 0x82, 0xff, 0x6c, 0x55, 0xab, 0xaa, 0x6c,
+		},
+	},
+	{
+		"BC3SixAlpha", BCFormat::BC3,
+		{
+			0x28, 0xc8, 0x4a, 0x61, 0x50, 0x36, 0x34, 0x73, 0xef, 0x7b, 0x10, 0x84, 0x92, 0xb7, 0x64, 0x8b,
+		},
+		{
+			0x7e, 0x7e, 0x7e, 0x48, 0x7b, 0x7d, 0x7b, 0xc8, 0x84, 0x82, 0x84, 0xa8, 0x7e, 0x7e, 0x7e, 0x28,
+			0x81, 0x80, 0x81, 0x00, 0x84, 0x82, 0x84, 0x28, 0x81, 0x80, 0x81, 0x88, 0x7e, 0x7e, 0x7e, 0x48,
+			0x7b, 0x7d, 0x7b, 0x00, 0x84, 0x82, 0x84, 0x00, 0x7e, 0x7e, 0x7e, 0x28, 0x84, 0x82, 0x84, 0x48,
+			0x81, 0x80, 0x81, 0x68, 0x7e, 0x7e, 0x7e, 0x00, 0x7b, 0x7d, 0x7b, 0x88, 0x7e, 0x7e, 0x7e, 0x68,
+		},
+	},
+	{
+		"BC4EightValue", BCFormat::BC4,
+		{
+			0xfa, 0x03, 0x3f, 0xaf, 0xd0, 0x1c, 0x94, 0xab,
+		},
+		{
+			0x26, 0x26, 0x90, 0x26, 0xd6, 0x03, 0x90, 0x49, 0x90, 0xb3, 0xfa, 0xd6, 0x03, 0x26, 0xd6, 0x6c,
+		},
+	},
+	{
+		"BC4SixValue", BCFormat::BC4,
+		{
+			0x09, 0xbe, 0xcf, 0x71, 0x47, 0x6a, 0x1d, 0x94,
+		},
+		{
+			0xff, 0xbe, 0xff, 0x09, 0xff, 0x00, 0xbe, 0x2d, 0x2d, 0x99, 0x99, 0x00, 0xbe, 0x09, 0x99, 0x75,
+		},
+	},
+	{
+		"BC5", BCFormat::BC5,
+		{
+			0xc9, 0x42, 0xe8, 0x32, 0xca, 0x2c, 0x67, 0xc7, 0x0c, 0xb4, 0x57, 0x73, 0xdd, 0xe8, 0x17, 0x85,
+		},
+		{
+			0xc9, 0xff, 0x7b, 0x2d, 0xa2, 0x92, 0x42, 0xb4, 0xa2, 0xff, 0x8f, 0x2d, 0xb5, 0xff, 0x68, 0x00,
+			0x8f, 0x0c, 0x7b, 0x92, 0x8f, 0xff, 0xa2, 0x4f, 0x68, 0xb4, 0x68, 0x2d, 0x42, 0xb4, 0x68, 0x70,
+		},
+	},
+	{
+		"BC7Mode0", BCFormat::BC7,
+		{
+			0xbd, 0xd3, 0xfa, 0x79, 0x6b, 0xdd, 0x76, 0x5c, 0x21, 0x71, 0x46, 0x23, 0x3b, 0x28, 0x4b, 0x4f,
+		},
+		{
+			0xde, 0xbd, 0x39, 0xff, 0xcb, 0xa1, 0x6c, 0xff, 0x94, 0xca, 0x5f, 0xff, 0x63, 0xb5, 0xa5, 0xff,
+			0xd5, 0xaf, 0x53, 0xff, 0x94, 0xca, 0x5f, 0xff, 0xd6, 0xe7, 0x00, 0xff, 0xff, 0x6b, 0x9c, 0xff,
+			0xa5, 0xd2, 0x46, 0xff, 0x83, 0xc3, 0x77, 0xff, 0xd5, 0xb1, 0x8e, 0xff, 0xf1, 0x82, 0x98, 0xff,
+			0x83, 0xc3, 0x77, 0xff, 0xce, 0xbd, 0x8c, 0xff, 0xf8, 0x77, 0x9a, 0xff, 0xf8, 0x77, 0x9a, 0xff,
+		},
+	},
+	{
+		"BC7Mode1", BCFormat::BC7,
+		{
+			0x12, 0xea, 0x4c, 0x84, 0x1a, 0x95, 0x86, 0x4c, 0x68, 0xee, 0x3a, 0x68, 0xf1, 0xd8, 0x4f, 0xc3,
+		},
+		{
+			0xb3, 0x61, 0x48, 0xff, 0xb8, 0x5e, 0x54, 0xff, 0xa9, 0x68, 0x30, 0xff, 0xb3, 0x61, 0x48, 0xff,
+			0xb8, 0x5e, 0x54, 0xff, 0xae, 0x65, 0x3c, 0xff, 0xc8, 0x53, 0x79, 0xff, 0x43, 0x9a, 0xbe, 0xff,
+			0xbe, 0x5a, 0x61, 0xff, 0xc3, 0x57, 0x6d, 0xff, 0xcd, 0x50, 0x85, 0xff, 0x43, 0x9a, 0xbe, 0xff,
+			0xb3, 0x61, 0x48, 0xff, 0xb8, 0x5e, 0x54, 0xff, 0x12, 0xa7, 0x9b, 0xff, 0x43, 0x9a, 0xbe, 0xff,
+		},
+	},
+	{
+		"BC7Mode2", BCFormat::BC7,
+		{
+			0x8c, 0xeb, 0xe5, 0xb9, 0xc2, 0x5a, 0xf7, 0xbe, 0x9c, 0xd3, 0xde, 0x74, 0x10, 0x12, 0xbb, 0x0c,
+		},
+		{
+			0xad, 0xad, 0xe7, 0xff, 0xa0, 0xcb, 0x92, 0xff, 0xad, 0xbd, 0xd6, 0xff, 0xad, 0xbd, 0xd6, 0xff,
+			0xb2, 0xad, 0xd1, 0xff, 0xd6, 0xde, 0x96, 0xff, 0xe7, 0xde, 0xef, 0xff, 0xd6, 0xde, 0x96, 0xff,
+			0xb2, 0xad, 0xd1, 0xff, 0x84, 0xe7, 0x08, 0xff, 0xa0, 0xcb, 0x92, 0xff, 0xa0, 0xcb, 0x92, 0xff,
+			0xb8, 0xad, 0xbb, 0xff, 0xdf, 0xde, 0xc4, 0xff, 0xe7, 0xde, 0xef, 0xff, 0xe7, 0xde, 0xef, 0xff,
+		},
+	},
+	{
+		"BC7Mode3", BCFormat::BC7,
+		{
+			0x58, 0x68, 0x52, 0x2c, 0xc5, 0x2f, 0xbd, 0x6a, 0x57, 0x7b, 0x5d, 0xa9, 0x47, 0x00, 0xef, 0xb6,
+		},
+		{
+			0x3e, 0x9a, 0x9b, 0xff, 0x34, 0x7e, 0xaa, 0xff, 0x2b, 0xb0, 0xac, 0xff, 0x59, 0x57, 0xbb, 0xff,
+			0x34, 0x7e, 0xaa, 0xff, 0x59, 0x57, 0xbb, 0xff, 0x59, 0x57, 0xbb, 0xff, 0x2b, 0xb0, 0xac, 0xff,
+			0x53, 0xd3, 0x7b, 0xff, 0x43, 0x82, 0xb4, 0xff, 0x15, 0xdb, 0xa5, 0xff, 0x43, 0x82, 0xb4, 0xff,
+			0x15, 0xdb, 0xa5, 0xff, 0x2b, 0xb0, 0xac, 0xff, 0x43, 0x82, 0xb4, 0xff, 0x43, 0x82, 0xb4, 0xff,
+		},
+	},
+	{
+		"BC7Mode4", BCFormat::BC7,
+		{
+			0x90, 0xa3, 0x42, 0x83, 0x88, 0xc9, 0x0e, 0x29, 0x45, 0x1e, 0x80, 0x43, 0xf9, 0x15, 0xdb, 0xaa,
+		},
+		{
+			0x18, 0x84, 0x42, 0xa2, 0x18, 0x84, 0x42, 0xa2, 0x98, 0x3d, 0x26, 0x9a, 0x2d, 0x78, 0x3d, 0xaa,
+			0x6e, 0x54, 0x2f, 0x9a, 0x42, 0x6d, 0x39, 0xa2, 0x98, 0x3d, 0x26, 0xa2, 0xad, 0x31, 0x21, 0xaa,
+			0x83, 0x48, 0x2a, 0xaa, 0x42, 0x6d, 0x39, 0x9a, 0x6e, 0x54, 0x2f, 0xaa, 0x83, 0x48, 0x2a, 0x9a,
+			0x83, 0x48, 0x2a, 0xb2, 0x83, 0x48, 0x2a, 0xb2, 0x42, 0x6d, 0x39, 0x9a, 0x83, 0x48, 0x2a, 0x9a,
+		},
+	},
+	{
+		"BC7Mode5", BCFormat::BC7,
+		{
+			0xa0, 0x75, 0xc3, 0x24, 0x40, 0xa5, 0xb1, 0xe5, 0xff, 0xc6, 0x27, 0x77, 0xee, 0x2e, 0xfc, 0xa6,
+		},
+		{
+			0xa2, 0x9a, 0x94, 0x1a, 0x0c, 0xf9, 0x68, 0x02, 0x0c, 0xcb, 0x68, 0x02, 0xa2, 0xf9, 0x94, 0x1a,
+			0x0c, 0xcb, 0x68, 0x02, 0xeb, 0xf9, 0xa9, 0x26, 0x55, 0xcb, 0x7d, 0x0e, 0x0c, 0x6c, 0x68, 0x02,
+			0x0c, 0x6c, 0x68, 0x02, 0xeb, 0xf9, 0xa9, 0x26, 0xa2, 0xf9, 0x94, 0x1a, 0x55, 0xf9, 0x7d, 0x0e,
+			0x0c, 0xcb, 0x68, 0x02, 0x55, 0x9a, 0x7d, 0x0e, 0x0c, 0xcb, 0x68, 0x02, 0xeb, 0xcb, 0xa9, 0x26,
+		},
+	},
+	{
+		"BC7Mode6", BCFormat::BC7,
+		{
+			0x40, 0xbc, 0xd0, 0x60, 0xfd, 0xec, 0x25, 0x1c, 0x76, 0x53, 0x98, 0x2c, 0xcb, 0x21, 0x44, 0xbe,
+		},
+		{
+			0xda, 0x2d, 0x63, 0x28, 0xbd, 0x57, 0x94, 0x2d, 0xda, 0x2d, 0x63, 0x28, 0xcd, 0x41, 0x7a, 0x2b,
+			0xb7, 0x61, 0xa0, 0x2f, 0xb0, 0x6b, 0xab, 0x30, 0x9a, 0x8c, 0xd1, 0x34, 0xe1, 0x23, 0x58, 0x27,
+			0xa1, 0x82, 0xc5, 0x33, 0x9a, 0x8c, 0xd1, 0x34, 0xe9, 0x16, 0x4a, 0x25, 0xe1, 0x23, 0x58, 0x27,
+			0xd3, 0x37, 0x6f, 0x29, 0xd3, 0x37, 0x6f, 0x29, 0x8b, 0xa2, 0xeb, 0x37, 0xa1, 0x82, 0xc5, 0x33,
+		},
+	},
+	{
+		"BC7Mode7", BCFormat::BC7,
+		{
+			0x80, 0x73, 0xb4, 0xd1, 0xdb, 0x8d, 0xbc, 0xd4, 0xdc, 0xf9, 0x9a, 0x91, 0x8b, 0xf7, 0x76, 0x05,
+		},
+		{
+			0x8a, 0xb2, 0x92, 0xf3, 0x98, 0xc1, 0xa9, 0xdc, 0x8a, 0xb2, 0x92, 0xf3, 0xb6, 0xdf, 0xd7, 0xae,
+			0xb6, 0xdf, 0xd7, 0xae, 0xd5, 0xbd, 0x9a, 0x72, 0xb6, 0xdf, 0xd7, 0xae, 0x98, 0xc1, 0xa9, 0xdc,
+			0xb0, 0x7f, 0xc2, 0xa2, 0xb0, 0x7f, 0xc2, 0xa2, 0xf7, 0xf7, 0x75, 0x45, 0x98, 0xc1, 0xa9, 0xdc,
+			0x98, 0xc1, 0xa9, 0xdc, 0xb0, 0x7f, 0xc2, 0xa2, 0x8a, 0xb2, 0x92, 0xf3, 0x8a, 0xb2, 0x92, 0xf3,
+		},
+	},
+	{
+		"BC7NoModeBit", BCFormat::BC7,
+		{
+			0x00, 0xd2, 0x76, 0x9f, 0x7e, 0xa1, 0x64, 0x2b, 0x25, 0x13, 0x65, 0x66, 0xf1, 0x85, 0x4e, 0xe0,
+		},
+		{
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		},
+	},
+};
@@ -0,0 +1,74 @@
+﻿#include "TestCommon.h"
+
+#include "ConstantStore.h"
+
+#include <utility>
+
+namespace
+{
+	//Flush()가 부른 (first, count) 목록.
+	std::vector<std::pair<std::size_t, std::size_t>> FlushRanges(ConstantStore<int>& store, std::size_t frame)
+	{
+		std::vector<std::pair<std::size_t, std::size_t>> ranges;
+		store.Flush(frame, [&](std::size_t first, const int*, std::size_t count) { ranges.push_back({ first, count }); });
+		return ranges;
+	}
+}
+
+TEST(EmptyStoreIsNeverDirty)
+{
+	ConstantStore<int> store(0, 3);
+	CHECK_EQ(store.Count(), 0u);
+	for (std::size_t frame = 0; frame < 3; frame++)
+	{
+		CHECK(!store.IsDirty(frame));
+		CHECK(FlushRanges(store, frame).empty());
+	}
+	store.MarkAllDirty();
+	CHECK(!store.IsDirty(0));
+}
+
+TEST(ResetMarksEverythingDirtyPerFrame)
+{
+	ConstantStore<int> store(130, 2);
+	for (std::size_t frame = 0; frame < 2; frame++)
+	{
+		CHECK(store.IsDirty(frame));
+		const auto ranges = FlushRanges(store, frame);
+		CHECK_EQ(ranges.size(), 1u);
+		CHECK(ranges[0] == std::make_pair(std::size_t(0), std::size_t(130)));
+		CHECK(!store.IsDirty(frame));
+	}
+}
+
+TEST(FlushMergesAdjacentChangesAcrossWords)
+{
+	ConstantStore<int> store(200, 1);
+	FlushRanges(store, 0);
+
+	store.Set(3, 1);
+	for (std::size_t i = 60; i < 70; i++)
+		store.Edit(i) = int(i);
+	store.Set(199, 2);
+
+	const auto ranges = FlushRanges(store, 0);
+	CHECK_EQ(ranges.size(), 3u);
+	CHECK(ranges[0] == std::make_pair(std::size_t(3), std::size_t(1)));
+	CHECK(ranges[1] == std::make_pair(std::size_t(60), std::size_t(10)));
+	CHECK(ranges[2] == std::make_pair(std::size_t(199), std::size_t(1)));
+	CHECK_EQ(store.Get(65), 65);
+	CHECK(!store.IsDirty(0));
+}
+
+TEST(EachFrameResourceKeepsItsOwnDirtyBits)
+{
+	ConstantStore<int> store(10, 3);
+	for (std::size_t frame = 0; frame < 3; frame++)
+		FlushRanges(store, frame);
+
+	store.Set(4, 7);
+	CHECK_EQ(FlushRanges(store, 0).size(), 1u);
+	CHECK(!store.IsDirty(0));
+	CHECK(store.IsDirty(1));
+	CHECK(store.IsDirty(2));
+}
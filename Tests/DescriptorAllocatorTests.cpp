@@ -0,0 +1,147 @@
+﻿#include "TestCommon.h"
+
+#include "DescriptorAllocator.h"
+
+TEST(AllocatesFirstFitFromFront)
+{
+	DescriptorAllocator allocator(16, 4, 3);
+	CHECK_EQ(allocator.Capacity(), 16u + 4u * 3u);
+
+	CHECK_EQ(allocator.Allocate(4), 0u);
+	CHECK_EQ(allocator.Allocate(2), 4u);
+	CHECK_EQ(allocator.Allocate(10), 6u);
+	CHECK_EQ(allocator.Allocate(1), DescriptorAllocator::InvalidIndex);
+	CHECK_EQ(allocator.Allocate(0), DescriptorAllocator::InvalidIndex);
+	CHECK_EQ(allocator.GetStats().PersistentUsed, 16u);
+}
+
+TEST(FreeCoalescesNeighbours)
+{
+	DescriptorAllocator allocator(12, 0, 1);
+	const std::uint32_t a = allocator.Allocate(4);
+	const std::uint32_t b = allocator.Allocate(4);
+	const std::uint32_t c = allocator.Allocate(4);
+
+	allocator.Free(a);
+	allocator.Free(c);
+	CHECK_EQ(allocator.GetStats().FreeRangeCount, 2u);
+	CHECK_EQ(allocator.GetStats().LargestFreeRange, 4u);
+	CHECK_EQ(allocator.Allocate(8), DescriptorAllocator::InvalidIndex);
+
+	//가운데를 풀면 세 구간이 하나로.
+	allocator.Free(b);
+	CHECK_EQ(allocator.GetStats().FreeRangeCount, 1u);
+	CHECK_EQ(allocator.GetStats().LargestFreeRange, 12u);
+	CHECK_EQ(allocator.GetStats().PersistentUsed, 0u);
+	CHECK_EQ(allocator.Allocate(12), 0u);
+}
+
+TEST(FreeIgnoresUnknownIndex)
+{
+	DescriptorAllocator allocator(8, 0, 1);
+	const std::uint32_t a = allocator.Allocate(2);
+	allocator.Free(a + 1);
+	allocator.Free(a);
+	allocator.Free(a);
+	CHECK_EQ(allocator.GetStats().PersistentUsed, 0u);
+	CHECK_EQ(allocator.GetStats().LargestFreeRange, 8u);
+}
+
+TEST(FenceDeferredRelease)
+{
+	DescriptorAllocator allocator(4, 0, 1);
+	const std::uint32_t a = allocator.Allocate(2);
+	const std::uint32_t b = allocator.Allocate(2);
+
+	allocator.Free(a, 5);
+	allocator.Free(b, 7);
+	CHECK_EQ(allocator.GetStats().PersistentPending, 4u);
+	CHECK_EQ(allocator.Allocate(1), DescriptorAllocator::InvalidIndex);
+
+	//펜스가 지나기 전에는 돌아오지 않는다.
+	allocator.ReleaseCompleted(4);
+	CHECK_EQ(allocator.Allocate(1), DescriptorAllocator::InvalidIndex);
+
+	allocator.ReleaseCompleted(5);
+	CHECK_EQ(allocator.GetStats().PersistentPending, 2u);
+	CHECK_EQ(allocator.GetStats().PersistentUsed, 2u);
+
+	allocator.ReleaseCompleted(7);
+	CHECK_EQ(allocator.GetStats().PersistentPending, 0u);
+	CHECK_EQ(allocator.GetStats().PersistentUsed, 0u);
+	CHECK_EQ(allocator.Allocate(4), 0u);
+}
+
+TEST(DoubleFreeKeepsFirstFence)
+{
+	DescriptorAllocator allocator(1, 0, 1);
+	const std::uint32_t a = allocator.Allocate();
+
+	//해제 대기 중인 인덱스를 다시 놓아도 먼저 건 펜스까지 돌아오지 않는다.
+	allocator.Free(a, 5);
+	allocator.Free(a);
+	allocator.Free(a, 9);
+	CHECK_EQ(allocator.GetStats().PersistentPending, 1u);
+	CHECK_EQ(allocator.Allocate(), DescriptorAllocator::InvalidIndex);
+
+	allocator.ReleaseCompleted(5);
+	const std::uint32_t b = allocator.Allocate();
+	CHECK_EQ(b, a);
+
+	//새 주인의 인덱스는 이전 해제 펜스가 지나도 그대로.
+	allocator.ReleaseCompleted(9);
+	CHECK_EQ(allocator.GetStats().PersistentUsed, 1u);
+	CHECK_EQ(allocator.GetStats().PersistentPending, 0u);
+	CHECK_EQ(allocator.Allocate(), DescriptorAllocator::InvalidIndex);
+}
+
+TEST(TransientResetsPerFrame)
+{
+	const std::uint32_t persistent = 8;
+	const std::uint32_t perFrame = 4;
+	DescriptorAllocator allocator(persistent, perFrame, 3);
+
+	for (std::uint32_t frame = 0; frame < 6; frame++)
+	{
+		allocator.BeginFrame(frame);
+		const std::uint32_t base = persistent + (frame % 3) * perFrame;
+		CHECK_EQ(allocator.AllocateTransient(3), base);
+		CHECK_EQ(allocator.AllocateTransient(1), base + 3);
+		CHECK_EQ(allocator.AllocateTransient(1), DescriptorAllocator::InvalidIndex);
+		CHECK_EQ(allocator.GetStats().TransientUsed, perFrame);
+	}
+	CHECK_EQ(allocator.GetStats().TransientPeak, perFrame);
+
+	//상주 영역과 겹치지 않는다.
+	CHECK_EQ(allocator.Allocate(persistent), 0u);
+	CHECK_EQ(allocator.Allocate(1), DescriptorAllocator::InvalidIndex);
+}
+
+TEST(PersistentIndicesStayStable)
+{
+	DescriptorAllocator allocator(64, 0, 1);
+	std::vector<std::uint32_t> kept;
+	std::vector<std::uint32_t> churn;
+	for (int i = 0; i < 16; i++)
+	{
+		kept.push_back(allocator.Allocate(1));
+		churn.push_back(allocator.Allocate(2));
+	}
+
+	//다른 구간을 여러 번 풀고 다시 잡아도 남아 있는 인덱스는 그대로이고 새 구간과 겹치지 않는다.
+	for (int round = 0; round < 8; round++)
+	{
+		for (std::uint32_t& index : churn)
+		{
+			allocator.Free(index, round + 1);
+			allocator.ReleaseCompleted(round + 1);
+			index = allocator.Allocate(2);
+			CHECK(index != DescriptorAllocator::InvalidIndex);
+			for (std::uint32_t k : kept)
+				CHECK(k < index || k >= index + 2);
+		}
+	}
+	for (std::size_t i = 0; i < kept.size(); i++)
+		CHECK_EQ(kept[i], static_cast<std::uint32_t>(i * 3));
+	CHECK_EQ(allocator.GetStats().PersistentUsed, 16u * 3u);
+}
@@ -0,0 +1,57 @@
+﻿#include "TestCommon.h"
+
+#include "FrameArena.h"
+
+#include <thread>
+
+TEST(HighWaterClearsOnReset)
+{
+	FrameArena arena(1024);
+	arena.Allocate(512, 1);
+	arena.Allocate(256, 1);
+	CHECK_EQ(arena.GetStats().HighWaterBytes, 768u);
+
+	//끝난 프레임의 최고 사용량은 내보낸 통계에 남고, 아레나의 값은 다음 프레임부터 다시 잰다.
+	arena.Reset();
+	CHECK_EQ(arena.GetStats().HighWaterBytes, 0u);
+	CHECK_EQ(arena.PublishedStats().HighWaterBytes, 768u);
+
+	arena.Allocate(128, 1);
+	arena.Reset();
+	CHECK_EQ(arena.PublishedStats().HighWaterBytes, 128u);
+	CHECK_EQ(arena.PublishedStats().ResetCount, 1u);
+}
+
+TEST(RewindPublishesStats)
+{
+	FrameArena arena(1024);
+	{
+		FrameArenaScope scope(arena);
+		arena.Allocate(300, 1);
+	}
+	CHECK_EQ(arena.PublishedStats().UsedBytes, 0u);
+	CHECK_EQ(arena.PublishedStats().HighWaterBytes, 300u);
+	CHECK_EQ(arena.PublishedStats().BlockCount, 1u);
+}
+
+TEST(ReportReadsOtherThreadsArenas)
+{
+	//다른 스레드가 할당하는 중에 Report()를 불러도 된다. (내보낸 값만 읽는다)
+	std::thread worker([]
+		{
+			FrameArena& arena = FrameArena::ThreadLocal();
+			for (int frame = 0; frame < 1000; frame++)
+			{
+				for (int i = 0; i < 16; i++)
+					arena.Allocate(64);
+				arena.Reset();
+			}
+		});
+	for (int i = 0; i < 100; i++)
+		FrameArena::Report();
+	worker.join();
+
+	FrameArena::ThreadLocal().Allocate(64);
+	FrameArena::ThreadLocal().Reset();
+	CHECK(!FrameArena::Report().empty());
+}
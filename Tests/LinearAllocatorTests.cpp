@@ -0,0 +1,45 @@
+﻿#include "TestCommon.h"
+
+#include "LinearAllocator.h"
+
+TEST(AllocatesAlignedWithinPage)
+{
+	LinearAllocator allocator(1024);
+	const LinearAllocator::Allocation a = allocator.Allocate(10, 1);
+	const LinearAllocator::Allocation b = allocator.Allocate(16, 256);
+	CHECK_EQ(a.Page, 0u);
+	CHECK_EQ(a.Offset, 0u);
+	CHECK_EQ(b.Page, 0u);
+	CHECK_EQ(b.Offset, 256u);
+	CHECK_EQ(allocator.UsedBytes(), 256u + 16u);
+}
+
+TEST(OpensPageWhenFull)
+{
+	LinearAllocator allocator(1024);
+	allocator.Allocate(1000, 1);
+	const LinearAllocator::Allocation a = allocator.Allocate(100, 1);
+	CHECK_EQ(a.Page, 1u);
+	CHECK_EQ(a.Offset, 0u);
+
+	//페이지보다 큰 요청은 그만큼의 페이지.
+	const LinearAllocator::Allocation big = allocator.Allocate(3000, 1);
+	CHECK_EQ(big.Page, 2u);
+	CHECK(allocator.PageSize(2) >= 3000u);
+}
+
+TEST(ResetConsolidatesPages)
+{
+	LinearAllocator allocator(1024);
+	for (int i = 0; i < 5; i++)
+		allocator.Allocate(600, 1);
+	CHECK_EQ(allocator.PageCount(), 5u);
+
+	//여러 페이지를 썼으면 한 페이지로 합치고 다음 프레임은 그 안에 들어간다.
+	CHECK(allocator.Reset());
+	CHECK_EQ(allocator.PageCount(), 1u);
+	CHECK_EQ(allocator.UsedBytes(), 0u);
+	for (int i = 0; i < 5; i++)
+		CHECK_EQ(allocator.Allocate(600, 1).Page, 0u);
+	CHECK(!allocator.Reset());
+}
@@ -0,0 +1,88 @@
+﻿#include "TestCommon.h"
+
+#include "ObjectPool.h"
+
+#include <string>
+
+namespace
+{
+	struct Item
+	{
+		explicit Item(int value) : Value(value) { Alive++; }
+		~Item() { Alive--; }
+		int Value;
+		static int Alive;
+	};
+	int Item::Alive = 0;
+}
+
+TEST(StaleHandleIsRejected)
+{
+	ObjectPool<Item> pool;
+	const auto a = pool.Create(1);
+	CHECK(pool.IsAlive(a));
+	CHECK_EQ(pool.Get(a)->Value, 1);
+
+	pool.Destroy(a);
+	CHECK(!pool.IsAlive(a));
+	CHECK(pool.Get(a) == nullptr);
+
+	//같은 슬롯을 다시 써도 세대가 달라 예전 핸들은 무효.
+	const auto b = pool.Create(2);
+	CHECK_EQ(b.Index(), a.Index());
+	CHECK(b != a);
+	CHECK(pool.Get(a) == nullptr);
+	CHECK_EQ(pool.Get(b)->Value, 2);
+
+	CHECK(pool.Get(ObjectPool<Item>::HandleType()) == nullptr);
+}
+
+TEST(AddressesStayStable)
+{
+	ObjectPool<Item, 4> pool;
+	std::vector<ObjectPool<Item, 4>::HandleType> handles;
+	std::vector<Item*> addresses;
+	for (int i = 0; i < 100; i++)
+	{
+		handles.push_back(pool.Create(i));
+		addresses.push_back(pool.Get(handles.back()));
+	}
+
+	for (int i = 0; i < 100; i += 3)
+		pool.Destroy(handles[i]);
+	for (int i = 0; i < 50; i++)
+		pool.Create(1000 + i);
+
+	for (int i = 0; i < 100; i++)
+	{
+		if (i % 3 == 0)
+			continue;
+		CHECK(pool.Get(handles[i]) == addresses[i]);
+		CHECK_EQ(pool.Get(handles[i])->Value, i);
+	}
+}
+
+TEST(ForEachVisitsLiveObjectsOnly)
+{
+	{
+		ObjectPool<Item> pool;
+		std::vector<ObjectPool<Item>::HandleType> handles;
+		for (int i = 0; i < 10; i++)
+			handles.push_back(pool.Create(i));
+		pool.Destroy(handles[0]);
+		pool.Destroy(handles[5]);
+		pool.Destroy(handles[5]);
+
+		int sum = 0;
+		int count = 0;
+		pool.ForEach([&](Item& item) { sum += item.Value; count++; });
+		CHECK_EQ(count, 8);
+		CHECK_EQ(sum, 45 - 0 - 5);
+		CHECK_EQ(pool.Size(), 8u);
+		CHECK_EQ(Item::Alive, 8);
+
+		for (std::size_t i = 0; i < pool.Size(); i++)
+			CHECK(pool.Get(pool.HandleAt(i)) == &pool.At(i));
+	}
+	CHECK_EQ(Item::Alive, 0);
+}
@@ -0,0 +1,56 @@
+﻿#pragma once
+
+#include <cstdio>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/*
+	테스트 도구. (외부 프레임워크 없이)
+
+	TEST(Name) { ... }      : 테스트 하나를 등록한다. TestMain.cpp가 등록된 순서대로 모두 실행한다.
+	CHECK(expr)             : 실패하면 위치를 출력하고 그 테스트를 실패로 기록한다. (계속 진행)
+	CHECK_EQ(actual, expected)
+*/
+namespace Test
+{
+	struct Case
+	{
+		const char* Name;
+		std::function<void()> Run;
+	};
+
+	inline std::vector<Case>& Cases()
+	{
+		static std::vector<Case> cases;
+		return cases;
+	}
+
+	inline int& Failures()
+	{
+		static int failures = 0;
+		return failures;
+	}
+
+	struct Registrar
+	{
+		Registrar(const char* name, std::function<void()> run) { Cases().push_back({ name, std::move(run) }); }
+	};
+
+	inline void Fail(const char* file, int line, const char* expr)
+	{
+		std::printf("%s(%d): CHECK failed: %s\n", file, line, expr);
+		Failures()++;
+	}
+}
+
+#define TEST(name) \
+	static void name(); \
+	static Test::Registrar name##Registrar(#name, name); \
+	static void name()
+
+#define CHECK(expr) \
+	do { if (!(expr)) Test::Fail(__FILE__, __LINE__, #expr); } while (0)
+
+#define CHECK_EQ(actual, expected) \
+	do { if (!((actual) == (expected))) Test::Fail(__FILE__, __LINE__, #actual " == " #expected); } while (0)
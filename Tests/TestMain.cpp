@@ -0,0 +1,18 @@
+﻿#include "TestCommon.h"
+
+int main()
+{
+	int failedCases = 0;
+	for (const Test::Case& testCase : Test::Cases())
+	{
+		const int before = Test::Failures();
+		testCase.Run();
+		const bool passed = Test::Failures() == before;
+		std::printf("[%s] %s\n", passed ? "  OK  " : " FAIL ", testCase.Name);
+		if (!passed)
+			failedCases++;
+	}
+
+	std::printf("%zu tests, %d failed\n", Test::Cases().size(), failedCases);
+	return failedCases == 0 ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+﻿#include "TestCommon.h"
+
+#include "TextureResidency.h"
+
+namespace
+{
+	//w x h, 밉마다 바이트 수가 1/4. (마지막 밉까지)
+	std::vector<std::uint64_t> MipChain(std::uint32_t width, std::uint32_t height)
+	{
+		std::vector<std::uint64_t> mips;
+		while (true)
+		{
+			mips.push_back(std::uint64_t(width) * height * 4);
+			if (width == 1 && height == 1)
+				break;
+			width = width > 1 ? width / 2 : 1;
+			height = height > 1 ? height / 2 : 1;
+		}
+		return mips;
+	}
+}
+
+TEST(RegisterStartsAtMipTail)
+{
+	TextureResidency residency(1 << 30);
+	const auto id = residency.Register(512, 512, MipChain(512, 512));
+	CHECK_EQ(residency.TargetMip(id), 10u - TextureResidency::DefaultTailMips);
+
+	//BC처럼 첫 밉이 될 수 있는 밉이 제한되면 밉 꼬리도 그 안에서.
+	const auto clamped = residency.Register(512, 128, MipChain(512, 128), 5);
+	CHECK_EQ(residency.TargetMip(clamped), 5u);
+}
+
+TEST(TouchedTextureStreamsInWithinBudget)
+{
+	const auto mips = MipChain(256, 256);
+	TextureResidency residency(1 << 30);
+	const auto id = residency.Register(256, 256, mips);
+
+	FrameArena arena;
+	FrameVector<TextureResidency::Change> changes{ FrameAllocator<TextureResidency::Change>(arena) };
+	residency.Touch(id, 1, 256.0f * 256.0f);
+	residency.Update(1, changes);
+	CHECK_EQ(changes.size(), 1u);
+	CHECK_EQ(residency.TargetMip(id), 0u);
+
+	std::uint64_t total = 0;
+	for (std::uint64_t bytes : mips)
+		total += bytes;
+	CHECK_EQ(residency.UsedBytes(), total);
+}
+
+TEST(LargerTextureEvictsSmallerOne)
+{
+	const auto mips = MipChain(256, 256);
+	std::uint64_t total = 0;
+	for (std::uint64_t bytes : mips)
+		total += bytes;
+	std::uint64_t tail = 0;
+	for (std::size_t mip = mips.size() - TextureResidency::DefaultTailMips; mip < mips.size(); mip++)
+		tail += mips[mip];
+
+	//한 장은 전부, 다른 한 장은 밉 꼬리만 올릴 수 있는 예산.
+	TextureResidency residency(total + tail);
+	const auto small = residency.Register(256, 256, mips);
+	const auto large = residency.Register(256, 256, mips);
+
+	FrameArena arena;
+	FrameVector<TextureResidency::Change> changes{ FrameAllocator<TextureResidency::Change>(arena) };
+	residency.Touch(small, 1, 256.0f * 256.0f);
+	residency.Update(1, changes);
+	CHECK_EQ(residency.TargetMip(small), 0u);
+
+	//화면에서 더 큰 텍스처가 작은 텍스처의 상세 밉을 가져간다.
+	changes.clear();
+	residency.Touch(small, 2, 64.0f * 64.0f);
+	residency.Touch(large, 2, 256.0f * 256.0f);
+	residency.Update(2, changes);
+	CHECK_EQ(residency.TargetMip(large), 0u);
+	CHECK(residency.TargetMip(small) > 0u);
+	CHECK(residency.UsedBytes() <= residency.Budget());
+}
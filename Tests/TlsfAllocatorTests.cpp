@@ -0,0 +1,91 @@
+﻿#include "TestCommon.h"
+
+#include "TlsfAllocator.h"
+
+#include <algorithm>
+#include <random>
+
+TEST(AllocateRespectsAlignmentAndGranularity)
+{
+	TlsfAllocator allocator(1 << 20, 256);
+
+	const std::uint64_t a = allocator.Allocate(100, 256);
+	CHECK_EQ(a % 256, 0u);
+	CHECK_EQ(allocator.AllocationSize(a), 256u);
+
+	const std::uint64_t b = allocator.Allocate(1000, 64 * 1024);
+	CHECK(b != TlsfAllocator::InvalidOffset);
+	CHECK_EQ(b % (64 * 1024), 0u);
+	CHECK(b >= a + 256);
+
+	CHECK_EQ(allocator.Allocate(2 << 20, 256), TlsfAllocator::InvalidOffset);
+}
+
+TEST(FreeCoalescesToSingleBlock)
+{
+	TlsfAllocator allocator(4096, 16);
+	std::vector<std::uint64_t> offsets;
+	for (int i = 0; i < 16; i++)
+		offsets.push_back(allocator.Allocate(256, 16));
+	CHECK_EQ(allocator.Allocate(16, 16), TlsfAllocator::InvalidOffset);
+
+	//하나 걸러 풀면 단편화, 나머지를 풀면 한 덩어리.
+	for (std::size_t i = 0; i < offsets.size(); i += 2)
+		allocator.Free(offsets[i]);
+	CHECK_EQ(allocator.GetStats().FreeBlockCount, 8u);
+	CHECK_EQ(allocator.GetStats().LargestFreeBlock, 256u);
+	CHECK(allocator.GetStats().Fragmentation() > 0.5f);
+
+	for (std::size_t i = 1; i < offsets.size(); i += 2)
+		allocator.Free(offsets[i]);
+	CHECK(allocator.IsEmpty());
+	CHECK_EQ(allocator.GetStats().FreeBlockCount, 1u);
+	CHECK_EQ(allocator.GetStats().LargestFreeBlock, 4096u);
+	CHECK_EQ(allocator.GetStats().Fragmentation(), 0.0f);
+	CHECK_EQ(allocator.Allocate(4096, 16), 0u);
+}
+
+TEST(RandomAllocationsNeverOverlap)
+{
+	const std::uint64_t size = 1 << 16;
+	TlsfAllocator allocator(size, 1);
+	std::mt19937 rng(1234);
+
+	struct Live
+	{
+		std::uint64_t Offset;
+		std::uint64_t Size;
+	};
+	std::vector<Live> live;
+	for (int step = 0; step < 20000; step++)
+	{
+		if (live.empty() || rng() % 3 != 0)
+		{
+			const std::uint64_t bytes = 1 + rng() % 700;
+			const std::uint64_t alignment = 1ull << (rng() % 5);
+			const std::uint64_t offset = allocator.Allocate(bytes, alignment);
+			if (offset == TlsfAllocator::InvalidOffset)
+				continue;
+			CHECK_EQ(offset % alignment, 0u);
+			CHECK(offset + bytes <= size);
+			live.push_back({ offset, bytes });
+		}
+		else
+		{
+			const std::size_t i = rng() % live.size();
+			allocator.Free(live[i].Offset);
+			live[i] = live.back();
+			live.pop_back();
+		}
+	}
+
+	std::sort(live.begin(), live.end(), [](const Live& a, const Live& b) { return a.Offset < b.Offset; });
+	for (std::size_t i = 1; i < live.size(); i++)
+		CHECK(live[i - 1].Offset + live[i - 1].Size <= live[i].Offset);
+	CHECK_EQ(allocator.GetStats().AllocationCount, static_cast<std::uint32_t>(live.size()));
+
+	for (const Live& allocation : live)
+		allocator.Free(allocation.Offset);
+	CHECK(allocator.IsEmpty());
+	CHECK_EQ(allocator.GetStats().LargestFreeBlock, size);
+}
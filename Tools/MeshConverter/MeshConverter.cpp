@@ -0,0 +1,131 @@
+﻿/*
+	.d12mesh 변환기.
+
+	사용법:
+		MeshConverter -o <출력.d12mesh> <입력> [--lod <입력> [--screen <크기>]]... [<입력> ...]
+
+	입력은 skull.txt 형식(.txt) 또는 OBJ(.obj). 입력 하나가 서브메시 하나가 되며
+	이름은 파일 이름(확장자 제외). --lod는 바로 앞 서브메시에 LOD를 추가한다.
+	입력 파일(LOD 포함)의 내용 해시를 헤더에 적는다. 원본이 바뀌면 엔진은 이 파일을 쓰지 않는다.
+
+	예) MeshConverter -o Resource/skull.d12mesh Resource/skull.txt
+*/
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "MeshFile.h"
+#include "ModelLoader.h"
+#include "ObjImporter.h"
+
+namespace
+{
+	bool LoadMesh(const std::filesystem::path& path, GeometryGenerator::MeshData& outMesh)
+	{
+		std::string ext = path.extension().string();
+		for (char& c : ext)
+			c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+		if (ext == ".obj")
+		{
+			ObjModel model;
+			if (!ObjImporter::Import(path, model))
+				return false;
+			outMesh = std::move(model.Mesh);
+			return true;
+		}
+		return ModelLoader::LoadTextModel(path, outMesh);
+	}
+
+	void PrintUsage()
+	{
+		std::printf("usage: MeshConverter -o <out.d12mesh> <input> [--lod <input> [--screen <size>]]... [<input> ...]\n");
+		std::printf("  input: skull.txt format (.txt) or Wavefront OBJ (.obj)\n");
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::filesystem::path outPath;
+	MeshFileSource source;
+	std::vector<std::filesystem::path> inputs;
+	bool hasSubmesh = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+
+		if (arg == "-o" && i + 1 < argc)
+		{
+			outPath = argv[++i];
+		}
+		else if (arg == "--lod" && i + 1 < argc)
+		{
+			if (!hasSubmesh)
+			{
+				std::fprintf(stderr, "--lod must follow an input mesh\n");
+				return 1;
+			}
+
+			std::filesystem::path lodPath = argv[++i];
+			float screenSize = 0.0f;
+			if (i + 2 < argc && std::string(argv[i + 1]) == "--screen")
+			{
+				screenSize = static_cast<float>(std::atof(argv[i + 2]));
+				i += 2;
+			}
+
+			GeometryGenerator::MeshData mesh;
+			if (!LoadMesh(lodPath, mesh))
+			{
+				std::fprintf(stderr, "failed to load %s\n", lodPath.string().c_str());
+				return 1;
+			}
+			source.AddLod(source.Submeshes.size() - 1, mesh, screenSize);
+			inputs.push_back(lodPath);
+		}
+		else if (!arg.empty() && arg[0] == '-')
+		{
+			PrintUsage();
+			return 1;
+		}
+		else
+		{
+			std::filesystem::path inPath = arg;
+			GeometryGenerator::MeshData mesh;
+			if (!LoadMesh(inPath, mesh))
+			{
+				std::fprintf(stderr, "failed to load %s\n", inPath.string().c_str());
+				return 1;
+			}
+			source.AddSubmesh(inPath.stem().string(), mesh);
+			inputs.push_back(inPath);
+			hasSubmesh = true;
+		}
+	}
+
+	if (outPath.empty() || !hasSubmesh)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	if (!MeshFile::SourceHash(inputs, source.SourceHash))
+	{
+		std::fprintf(stderr, "failed to hash inputs\n");
+		return 1;
+	}
+
+	if (!source.Write(outPath))
+	{
+		std::fprintf(stderr, "failed to write %s\n", outPath.string().c_str());
+		return 1;
+	}
+
+	std::printf("%s: %zu submeshes, %zu vertices, %zu indices\n", outPath.string().c_str(),
+		source.Submeshes.size(), source.Vertices.size(), source.Indices.size());
+	return 0;
+}
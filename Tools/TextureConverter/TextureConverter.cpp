@@ -0,0 +1,343 @@
+﻿/*
+	BMP -> BC 압축 DDS 변환기.
+
+	사용법:
+		TextureConverter -f <bc1|bc2|bc3|bc4|bc5|bc7> [-q fast|normal|high] [-m box|kaiser|lanczos] [--coverage <ref>]
+			[--srgb] [--no-mips] -o <출력.dds> <입력.bmp>
+
+	입력은 무압축 24/32비트 BMP. MipGenerator로 밉 체인을 만들어(-m 필터, 기본 kaiser)
+	각 레벨을 BCEncoder로 인코딩하고(모든 코어 사용) DDSWriter로 쓴다.
+	--srgb는 밉 필터링을 선형 공간에서 하고 _SRGB 형식으로 저장.
+	--coverage는 알파 테스트 기준값. 밉마다 기준값을 넘는 알파 비율을 밉 0과 같게 유지한다. (나뭇잎, 철망 등)
+
+	예) TextureConverter -f bc3 -q high --coverage 0.5 -o Textures/tree0.dds Textures/tree0.bmp
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <dxgiformat.h>
+
+#include "BCEncoder.h"
+#include "DDSWriter.h"
+#include "MipGenerator.h"
+
+namespace
+{
+	struct Image
+	{
+		std::uint32_t Width = 0;
+		std::uint32_t Height = 0;
+		std::vector<std::uint8_t> Pixels;	//RGBA8, 빈틈없이
+	};
+
+#pragma pack(push, 1)
+	struct BmpFileHeader
+	{
+		std::uint16_t Type;
+		std::uint32_t Size;
+		std::uint16_t Reserved1;
+		std::uint16_t Reserved2;
+		std::uint32_t OffBits;
+	};
+
+	struct BmpInfoHeader
+	{
+		std::uint32_t Size;
+		std::int32_t Width;
+		std::int32_t Height;
+		std::uint16_t Planes;
+		std::uint16_t BitCount;
+		std::uint32_t Compression;
+		std::uint32_t SizeImage;
+		std::int32_t XPelsPerMeter;
+		std::int32_t YPelsPerMeter;
+		std::uint32_t ClrUsed;
+		std::uint32_t ClrImportant;
+	};
+#pragma pack(pop)
+
+	static_assert(sizeof(BmpFileHeader) == 14, "BMP file header size mismatch");
+	static_assert(sizeof(BmpInfoHeader) == 40, "BMP info header size mismatch");
+
+	constexpr std::uint32_t BMP_RGB = 0;		//BI_RGB
+	constexpr std::uint32_t BMP_BITFIELDS = 3;	//BI_BITFIELDS
+
+	//BI_RGB 24/32비트, BI_BITFIELDS 32비트. 32비트인데 알파가 모두 0이면 불투명으로 본다.
+	bool LoadBmp(const std::filesystem::path& path, Image& outImage)
+	{
+		std::ifstream fin(path, std::ios::binary);
+		if (!fin)
+			return false;
+
+		BmpFileHeader fileHeader = {};
+		BmpInfoHeader info = {};
+		fin.read(reinterpret_cast<char*>(&fileHeader), sizeof(fileHeader));
+		fin.read(reinterpret_cast<char*>(&info), sizeof(info));
+		if (!fin || fileHeader.Type != 0x4D42 || info.Size < sizeof(BmpInfoHeader) || info.Width <= 0 || info.Height == 0)
+			return false;
+		if (info.BitCount != 24 && info.BitCount != 32)
+			return false;
+
+		//BI_BITFIELDS: 정보 헤더 뒤의 채널 마스크. (BGRA 배치만 지원)
+		if (info.Compression == BMP_BITFIELDS && info.BitCount == 32)
+		{
+			std::uint32_t masks[3] = {};
+			fin.seekg(sizeof(BmpFileHeader) + info.Size);
+			fin.read(reinterpret_cast<char*>(masks), sizeof(masks));
+			if (!fin || masks[0] != 0x00FF0000 || masks[1] != 0x0000FF00 || masks[2] != 0x000000FF)
+				return false;
+		}
+		else if (info.Compression != BMP_RGB)
+		{
+			return false;
+		}
+
+		//음수 높이 = 위에서 아래로 저장.
+		const bool topDown = info.Height < 0;
+		const std::uint32_t width = static_cast<std::uint32_t>(info.Width);
+		const std::uint32_t height = static_cast<std::uint32_t>(topDown ? -info.Height : info.Height);
+		const std::uint32_t bytesPerPixel = info.BitCount / 8;
+		const std::size_t rowSize = (std::size_t(width) * bytesPerPixel + 3) & ~std::size_t(3);
+
+		std::vector<std::uint8_t> row(rowSize);
+		outImage.Width = width;
+		outImage.Height = height;
+		outImage.Pixels.assign(std::size_t(width) * height * 4, 255);
+
+		bool anyAlpha = false;
+		fin.seekg(fileHeader.OffBits);
+		for (std::uint32_t y = 0; y < height; y++)
+		{
+			fin.read(reinterpret_cast<char*>(row.data()), rowSize);
+			if (!fin)
+				return false;
+
+			const std::uint32_t dstY = topDown ? y : height - 1 - y;
+			std::uint8_t* dst = outImage.Pixels.data() + std::size_t(dstY) * width * 4;
+			for (std::uint32_t x = 0; x < width; x++)
+			{
+				const std::uint8_t* src = row.data() + std::size_t(x) * bytesPerPixel;
+				dst[x * 4 + 0] = src[2];
+				dst[x * 4 + 1] = src[1];
+				dst[x * 4 + 2] = src[0];
+				if (bytesPerPixel == 4)
+				{
+					dst[x * 4 + 3] = src[3];
+					anyAlpha |= src[3] != 0;
+				}
+			}
+		}
+
+		if (bytesPerPixel == 4 && !anyAlpha)
+		{
+			for (std::size_t i = 3; i < outImage.Pixels.size(); i += 4)
+				outImage.Pixels[i] = 255;
+		}
+		return true;
+	}
+
+	DXGI_FORMAT ToDXGIFormat(BCFormat format, bool srgb)
+	{
+		switch (format)
+		{
+		case BCFormat::BC1: return srgb ? DXGI_FORMAT_BC1_UNORM_SRGB : DXGI_FORMAT_BC1_UNORM;
+		case BCFormat::BC2: return srgb ? DXGI_FORMAT_BC2_UNORM_SRGB : DXGI_FORMAT_BC2_UNORM;
+		case BCFormat::BC3: return srgb ? DXGI_FORMAT_BC3_UNORM_SRGB : DXGI_FORMAT_BC3_UNORM;
+		case BCFormat::BC4: return DXGI_FORMAT_BC4_UNORM;
+		case BCFormat::BC5: return DXGI_FORMAT_BC5_UNORM;
+		case BCFormat::BC7: return srgb ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_BC7_UNORM;
+		}
+		return DXGI_FORMAT_UNKNOWN;
+	}
+
+	bool ParseFormat(const std::string& name, BCFormat& outFormat)
+	{
+		static const std::pair<const char*, BCFormat> formats[] =
+		{
+			{ "bc1", BCFormat::BC1 }, { "bc2", BCFormat::BC2 }, { "bc3", BCFormat::BC3 },
+			{ "bc4", BCFormat::BC4 }, { "bc5", BCFormat::BC5 }, { "bc7", BCFormat::BC7 },
+		};
+		for (const auto& f : formats)
+		{
+			if (name == f.first)
+			{
+				outFormat = f.second;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool ParseFilter(const std::string& name, MipFilter& outFilter)
+	{
+		if (name == "box")
+			outFilter = MipFilter::Box;
+		else if (name == "kaiser")
+			outFilter = MipFilter::Kaiser;
+		else if (name == "lanczos")
+			outFilter = MipFilter::Lanczos;
+		else
+			return false;
+		return true;
+	}
+
+	bool ParseQuality(const std::string& name, BCQuality& outQuality)
+	{
+		if (name == "fast")
+			outQuality = BCQuality::Fast;
+		else if (name == "normal")
+			outQuality = BCQuality::Normal;
+		else if (name == "high")
+			outQuality = BCQuality::High;
+		else
+			return false;
+		return true;
+	}
+
+	void PrintUsage()
+	{
+		std::printf("usage: TextureConverter -f <bc1|bc2|bc3|bc4|bc5|bc7> [-q fast|normal|high] [-m box|kaiser|lanczos] [--coverage <ref>] [--srgb] [--no-mips] -o <out.dds> <input.bmp>\n");
+		std::printf("  input: uncompressed 24/32-bit BMP\n");
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::filesystem::path outPath;
+	std::filesystem::path inPath;
+	BCFormat format = BCFormat::BC7;
+	BCQuality quality = BCQuality::Normal;
+	MipOptions mipOptions;
+	bool hasFormat = false;
+	bool mips = true;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+
+		if (arg == "-o" && i + 1 < argc)
+		{
+			outPath = argv[++i];
+		}
+		else if (arg == "-f" && i + 1 < argc)
+		{
+			if (!ParseFormat(argv[++i], format))
+			{
+				std::fprintf(stderr, "unknown format %s\n", argv[i]);
+				return 1;
+			}
+			hasFormat = true;
+		}
+		else if (arg == "-q" && i + 1 < argc)
+		{
+			if (!ParseQuality(argv[++i], quality))
+			{
+				std::fprintf(stderr, "unknown quality %s\n", argv[i]);
+				return 1;
+			}
+		}
+		else if (arg == "-m" && i + 1 < argc)
+		{
+			if (!ParseFilter(argv[++i], mipOptions.Filter))
+			{
+				std::fprintf(stderr, "unknown filter %s\n", argv[i]);
+				return 1;
+			}
+		}
+		else if (arg == "--coverage" && i + 1 < argc)
+		{
+			mipOptions.AlphaCoverageRef = static_cast<float>(std::atof(argv[++i]));
+			if (mipOptions.AlphaCoverageRef <= 0.0f || mipOptions.AlphaCoverageRef >= 1.0f)
+			{
+				std::fprintf(stderr, "--coverage must be in (0, 1)\n");
+				return 1;
+			}
+		}
+		else if (arg == "--srgb")
+		{
+			mipOptions.SRGB = true;
+		}
+		else if (arg == "--no-mips")
+		{
+			mips = false;
+		}
+		else if (!arg.empty() && arg[0] == '-')
+		{
+			PrintUsage();
+			return 1;
+		}
+		else
+		{
+			inPath = arg;
+		}
+	}
+
+	if (outPath.empty() || inPath.empty() || !hasFormat)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	if (mipOptions.SRGB && (format == BCFormat::BC4 || format == BCFormat::BC5))
+	{
+		std::fprintf(stderr, "--srgb is not valid for bc4/bc5\n");
+		return 1;
+	}
+
+	Image image;
+	if (!LoadBmp(inPath, image))
+	{
+		std::fprintf(stderr, "failed to load %s\n", inPath.string().c_str());
+		return 1;
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+
+	std::vector<MipLevel> chain;
+	mipOptions.MaxLevels = mips ? 0 : 1;
+	if (!MipGenerator::Generate(image.Pixels.data(), image.Width, image.Height, std::size_t(image.Width) * 4, mipOptions, chain))
+	{
+		std::fprintf(stderr, "failed to generate mips\n");
+		return 1;
+	}
+
+	//레벨마다 인코딩. (레벨 안에서 블록 행 단위 병렬)
+	std::vector<std::vector<std::uint8_t>> levels;
+	std::size_t sourceBytes = 0;
+	for (const MipLevel& level : chain)
+	{
+		std::vector<std::uint8_t> blocks(BCEncoder::EncodedSize(format, level.Width, level.Height));
+		if (!BCEncoder::Encode(format, quality, level.Pixels.data(), level.Width, level.Height, std::size_t(level.Width) * 4,
+			blocks.data(), blocks.size()))
+		{
+			std::fprintf(stderr, "failed to encode %ux%u\n", level.Width, level.Height);
+			return 1;
+		}
+		sourceBytes += level.Pixels.size();
+		levels.push_back(std::move(blocks));
+	}
+
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	if (!DDSWriter::Save(outPath, ToDXGIFormat(format, mipOptions.SRGB), image.Width, image.Height, levels))
+	{
+		std::fprintf(stderr, "failed to write %s\n", outPath.string().c_str());
+		return 1;
+	}
+
+	std::size_t encodedBytes = 0;
+	for (const auto& l : levels)
+		encodedBytes += l.size();
+
+	std::printf("%s: %ux%u, %zu mips, %zu -> %zu bytes (%.1fx), %.2fs\n", outPath.string().c_str(),
+		image.Width, image.Height, levels.size(), sourceBytes, encodedBytes,
+		double(sourceBytes) / double(encodedBytes), seconds);
+	return 0;
+}
@@ -0,0 +1,180 @@
+﻿/*
+	DDS 파일들 -> .d12pak 텍스처 묶음 파일.
+
+	사용법:
+		TexturePacker [-z] -o <출력.d12pak> <입력.dds | 입력 폴더> ...
+
+	폴더는 안의 .dds 파일을 이름 순으로 넣는다. (하위 폴더 포함, 이름은 폴더 기준 상대 경로)
+	파일은 파일 이름으로 넣는다. 데이터는 인자 순서대로 놓이므로 먼저 로드할 텍스처를 앞에 둔다.
+	-z는 DDS 헤더와 밉 레벨마다 LZ 압축을 시도하고, 작아지는 청크만 압축해서 저장한다.
+	쓴 뒤 다시 열어서 모든 텍스처가 원본과 같은지 확인한다.
+
+	예) TexturePacker -z -o Textures/textures.d12pak Textures
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "TexturePack.h"
+
+namespace
+{
+	bool ReadFile(const std::filesystem::path& path, std::vector<std::uint8_t>& outData)
+	{
+		std::ifstream fin(path, std::ios::binary | std::ios::ate);
+		if (!fin)
+			return false;
+
+		outData.resize(static_cast<std::size_t>(fin.tellg()));
+		fin.seekg(0);
+		fin.read(reinterpret_cast<char*>(outData.data()), static_cast<std::streamsize>(outData.size()));
+		return static_cast<bool>(fin);
+	}
+
+	bool IsDds(const std::filesystem::path& path)
+	{
+		return TexturePack::NormalizeName(path.extension().string()) == ".dds";
+	}
+
+	//(넣을 이름, 파일 경로)
+	bool CollectInputs(const std::filesystem::path& input,
+		std::vector<std::pair<std::string, std::filesystem::path>>& outInputs)
+	{
+		std::error_code ec;
+		if (!std::filesystem::is_directory(input, ec))
+		{
+			outInputs.emplace_back(input.filename().generic_string(), input);
+			return std::filesystem::is_regular_file(input, ec);
+		}
+
+		std::vector<std::filesystem::path> files;
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(input, ec))
+		{
+			if (entry.is_regular_file() && IsDds(entry.path()))
+				files.push_back(entry.path());
+		}
+		if (ec)
+			return false;
+
+		std::sort(files.begin(), files.end());
+		for (const auto& file : files)
+			outInputs.emplace_back(std::filesystem::relative(file, input).generic_string(), file);
+		return true;
+	}
+
+	void PrintUsage()
+	{
+		std::printf("usage: TexturePacker [-z] -o <out.d12pak> <input.dds | input dir> ...\n");
+		std::printf("  -z: LZ-compress the DDS header and each mip level when it gets smaller\n");
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::filesystem::path outPath;
+	std::vector<std::filesystem::path> inputs;
+	bool compress = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+
+		if (arg == "-o" && i + 1 < argc)
+		{
+			outPath = argv[++i];
+		}
+		else if (arg == "-z")
+		{
+			compress = true;
+		}
+		else if (!arg.empty() && arg[0] == '-')
+		{
+			PrintUsage();
+			return 1;
+		}
+		else
+		{
+			inputs.push_back(arg);
+		}
+	}
+
+	if (outPath.empty() || inputs.empty())
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::vector<std::pair<std::string, std::filesystem::path>> files;
+	for (const auto& input : inputs)
+	{
+		if (!CollectInputs(input, files))
+		{
+			std::fprintf(stderr, "failed to read %s\n", input.string().c_str());
+			return 1;
+		}
+	}
+
+	TexturePackSource source;
+	std::uint64_t rawBytes = 0;
+	for (auto& [name, path] : files)
+	{
+		//출력 파일이 입력 폴더 안에 있을 수 있다.
+		std::error_code ec;
+		if (std::filesystem::equivalent(path, outPath, ec))
+			continue;
+
+		std::vector<std::uint8_t> data;
+		if (!ReadFile(path, data))
+		{
+			std::fprintf(stderr, "failed to read %s\n", path.string().c_str());
+			return 1;
+		}
+
+		rawBytes += data.size();
+		if (!source.Add(name, std::move(data)))
+		{
+			std::fprintf(stderr, "duplicate texture name %s\n", name.c_str());
+			return 1;
+		}
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+
+	std::uint64_t storedBytes = 0;
+	if (!source.Write(outPath, compress, &storedBytes))
+	{
+		std::fprintf(stderr, "failed to write %s\n", outPath.string().c_str());
+		return 1;
+	}
+
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	//다시 열어서 확인.
+	TexturePack pack;
+	if (!pack.Open(outPath) || pack.EntryCount() != source.Items.size())
+	{
+		std::fprintf(stderr, "failed to verify %s\n", outPath.string().c_str());
+		return 1;
+	}
+
+	std::vector<std::uint8_t> check;
+	for (const auto& item : source.Items)
+	{
+		const TexturePackEntry* entry = pack.Find(item.Name);
+		if (entry == nullptr || !pack.Read(*entry, check) || check != item.Data)
+		{
+			std::fprintf(stderr, "failed to verify %s in %s\n", item.Name.c_str(), outPath.string().c_str());
+			return 1;
+		}
+	}
+
+	std::printf("%s: %zu textures, %llu -> %llu bytes (%.1f%%), %.2fs\n", outPath.string().c_str(), source.Items.size(),
+		static_cast<unsigned long long>(rawBytes), static_cast<unsigned long long>(storedBytes),
+		rawBytes ? 100.0 * double(storedBytes) / double(rawBytes) : 100.0, seconds);
+	return 0;
+}